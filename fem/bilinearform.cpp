@@ -13,7 +13,9 @@
 
 #include "fem.hpp"
 #include "../general/device.hpp"
+#include "../general/tic_toc.hpp"
 #include <cmath>
+#include <iomanip>
 
 namespace mfem
 {
@@ -79,6 +81,8 @@ BilinearForm::BilinearForm(FiniteElementSpace * f)
    assembly = AssemblyLevel::LEGACYFULL;
    batch = 1;
    ext = NULL;
+   auto_max_bytes = infinity();
+   auto_bench_applies = auto_print_level = 0;
 }
 
 BilinearForm::BilinearForm (FiniteElementSpace * f, BilinearForm * bf, int ps)
@@ -97,6 +101,8 @@ BilinearForm::BilinearForm (FiniteElementSpace * f, BilinearForm * bf, int ps)
    assembly = AssemblyLevel::LEGACYFULL;
    batch = 1;
    ext = NULL;
+   auto_max_bytes = infinity();
+   auto_bench_applies = auto_print_level = 0;
 
    // Copy the pointers to the integrators
    dbfi = bf->dbfi;
@@ -135,6 +141,9 @@ void BilinearForm::SetAssemblyLevel(AssemblyLevel assembly_level)
       case AssemblyLevel::NONE:
          ext = new MFBilinearFormExtension(this);
          break;
+      case AssemblyLevel::AUTO:
+         // The level is selected in the first call to Assemble()
+         break;
       default:
          mfem_error("Unknown assembly level");
    }
@@ -143,7 +152,8 @@ void BilinearForm::SetAssemblyLevel(AssemblyLevel assembly_level)
 void BilinearForm::EnableStaticCondensation()
 {
    delete static_cond;
-   if (assembly != AssemblyLevel::LEGACYFULL)
+   if (assembly != AssemblyLevel::LEGACYFULL &&
+       assembly != AssemblyLevel::AUTO)
    {
       static_cond = NULL;
       MFEM_WARNING("Static condensation not supported for this assembly level");
@@ -168,7 +178,8 @@ void BilinearForm::EnableHybridization(FiniteElementSpace *constr_space,
                                        const Array<int> &ess_tdof_list)
 {
    delete hybridization;
-   if (assembly != AssemblyLevel::LEGACYFULL)
+   if (assembly != AssemblyLevel::LEGACYFULL &&
+       assembly != AssemblyLevel::AUTO)
    {
       delete constr_integ;
       hybridization = NULL;
@@ -373,8 +384,264 @@ void BilinearForm::AssembleBdrElementMatrix(
    }
 }
 
+bool BilinearForm::SupportsAssemblyLevel(AssemblyLevel level) const
+{
+   if (level == AssemblyLevel::LEGACYFULL) { return true; }
+   if (level == AssemblyLevel::AUTO || static_cond || hybridization ||
+       bbfi.Size() > 0)
+   {
+      return false;
+   }
+   // The matrix-free extension only applies the domain integrators, and the
+   // other extensions do not use the boundary face markers
+   if (level == AssemblyLevel::NONE && (fbfi.Size() > 0 || bfbfi.Size() > 0))
+   {
+      return false;
+   }
+   for (int i = 0; i < bfbfi_marker.Size(); i++)
+   {
+      if (bfbfi_marker[i]) { return false; }
+   }
+   const Array<BilinearFormIntegrator*> *integs[3] = { &dbfi, &fbfi, &bfbfi };
+   for (int k = 0; k < 3; k++)
+   {
+      for (int i = 0; i < integs[k]->Size(); i++)
+      {
+         if (!(*integs[k])[i]->SupportsAssemblyLevel(level, *fes))
+         {
+            return false;
+         }
+      }
+   }
+   return true;
+}
+
+AssemblyCost BilinearForm::EstimateAssemblyCost(AssemblyLevel level) const
+{
+   AssemblyCost cost = { 0.0, 0.0, 0.0, 0.0 };
+   const int ne = fes->GetNE();
+   if (ne == 0) { return cost; }
+
+   const Mesh *mesh = fes->GetMesh();
+   const int dim = mesh->Dimension();
+   const int vdim = fes->GetVDim();
+   const FiniteElement &fe = *fes->GetFE(0);
+   const double d1d = fe.GetOrder() + 1, q1d = fe.GetOrder() + 2;
+   const double nq = pow(q1d, dim), nqf = pow(q1d, dim - 1);
+   const double nd = vdim*fe.GetDof(), ndf = vdim*pow(d1d, dim - 1);
+   const double n = fes->GetVSize(), nev = ne*nd;
+   const double ni = dbfi.Size(), nfi = fbfi.Size() + bfbfi.Size();
+   const double nf = (nfi > 0) ? mesh->GetNumFaces() : 0.0;
+
+   // Flops of the sum factorized interpolation of one component
+   double sf = 0.0;
+   for (int k = 1; k <= dim; k++)
+   {
+      sf += 2.0*pow(d1d, dim - k + 1)*pow(q1d, k);
+   }
+   // Bytes moved by the element restriction and its transpose, which are
+   // skipped on L2 spaces, plus the E-vector read and written by the kernels,
+   // and by the face restrictions
+   const double restr_bytes = fes->IsDGSpace() ? 16.0*n :
+                              16.0*n + 32.0*nev + 8.0*nev;
+   const double face_bytes = 32.0*nf*ndf*nfi;
+   // Quadrature point data of one domain integrator
+   const double nc = dim*(dim + 1)/2;
+   const double pa_flops = ne*ni*vdim*(2.0*dim*sf + 2.0*nc*nq) +
+                           nf*nfi*vdim*(8.0*(dim - 1)*d1d*nqf + 8.0*nqf);
+   const double pa_setup = ne*(dim*dim*sf + 10.0*dim*dim*nq*ni);
+
+   switch (level)
+   {
+      case AssemblyLevel::LEGACYFULL:
+      case AssemblyLevel::FULL:
+      {
+         // The element blocks overlap on the shared dofs: the square root of
+         // the sharing ratio n/nev is a fair estimate for H1 spaces and exact
+         // for L2 spaces, where the faces couple the dofs of two elements
+         const double nnz = ne*nd*nd*sqrt(n/nev) + 2.0*nf*ndf*ndf;
+         cost.storage = 12.0*nnz + 4.0*(n + 1);
+         cost.apply_bytes = cost.storage + 16.0*n;
+         cost.apply_flops = 2.0*nnz;
+         cost.setup_flops =
+            (level == AssemblyLevel::LEGACYFULL ? dim + 1.0 : 1.0) *
+            2.0*nq*nd*nd*ne*ni + 8.0*nqf*ndf*ndf*nf*nfi;
+         break;
+      }
+      case AssemblyLevel::ELEMENT:
+         cost.storage = 8.0*(ne*nd*nd + 4.0*nf*ndf*ndf);
+         cost.apply_bytes = cost.storage + restr_bytes + face_bytes;
+         cost.apply_flops = 2.0*(ne*nd*nd + 4.0*nf*ndf*ndf);
+         cost.setup_flops = pa_setup + 2.0*nq*nd*nd*ne*ni +
+                            8.0*nqf*ndf*ndf*nf*nfi;
+         break;
+      case AssemblyLevel::PARTIAL:
+         cost.storage = 8.0*(ne*nq*nc*ni + 2.0*nf*nqf*nfi);
+         cost.apply_bytes = cost.storage + restr_bytes + face_bytes;
+         cost.apply_flops = pa_flops;
+         cost.setup_flops = pa_setup;
+         break;
+      case AssemblyLevel::NONE:
+      {
+         // The geometric factors are recomputed from the mesh nodes
+         const GridFunction *nodes = mesh->GetNodes();
+         const double ndn = nodes ? nodes->FESpace()->GetFE(0)->GetDof() :
+                            pow(2.0, dim);
+         cost.apply_bytes = restr_bytes + face_bytes + 12.0*ne*ndn*dim;
+         cost.apply_flops = pa_flops + pa_setup;
+         break;
+      }
+      default:
+         MFEM_ABORT("Invalid assembly level");
+   }
+   return cost;
+}
+
+static const char *AssemblyLevelName(AssemblyLevel level)
+{
+   switch (level)
+   {
+      case AssemblyLevel::LEGACYFULL: return "LEGACYFULL";
+      case AssemblyLevel::FULL: return "FULL";
+      case AssemblyLevel::ELEMENT: return "ELEMENT";
+      case AssemblyLevel::PARTIAL: return "PARTIAL";
+      case AssemblyLevel::NONE: return "NONE";
+      default: return "AUTO";
+   }
+}
+
+AssemblyLevel BilinearForm::SelectAssemblyLevel()
+{
+   // The setup is amortized over this number of actions. The time is
+   // measured in bytes moved to/from memory, assuming that this many flops
+   // can be done in the time one byte is moved (the machine balance).
+   const double num_applies = 100.0, flops_per_byte = 10.0;
+
+   int myid = 0;
+   bool serial = true;
+#ifdef MFEM_USE_MPI
+   const ParFiniteElementSpace *pfes =
+      dynamic_cast<const ParFiniteElementSpace*>(fes);
+   if (pfes) { myid = pfes->GetMyRank(); serial = false; }
+#endif
+   const int nl = 5;
+   const AssemblyLevel levels[nl] =
+   {
+      AssemblyLevel::LEGACYFULL, AssemblyLevel::FULL, AssemblyLevel::ELEMENT,
+      AssemblyLevel::PARTIAL, AssemblyLevel::NONE
+   };
+
+   // The device compatible sparse matrix is used instead of the legacy one
+   // with serial spaces on devices, when supported
+   const bool full = Device::IsEnabled() && serial &&
+                     SupportsAssemblyLevel(AssemblyLevel::FULL);
+
+   // For each level: unsupported flag, storage, time of an action and of the
+   // setup. The maximum over the ranks is used, so that they all agree.
+   double data[nl][4];
+   for (int l = 0; l < nl; l++)
+   {
+      const AssemblyCost cost = EstimateAssemblyCost(levels[l]);
+      const bool skip = (levels[l] == AssemblyLevel::LEGACYFULL && full) ||
+                        (levels[l] == AssemblyLevel::FULL && !full);
+      data[l][0] = (!skip && SupportsAssemblyLevel(levels[l])) ? 0.0 : 1.0;
+      data[l][1] = cost.storage;
+      data[l][2] = std::max(cost.apply_bytes,
+                            cost.apply_flops/flops_per_byte);
+      data[l][3] = cost.setup_flops/flops_per_byte;
+   }
+#ifdef MFEM_USE_MPI
+   if (pfes)
+   {
+      MPI_Allreduce(MPI_IN_PLACE, &data[0][0], 4*nl, MPI_DOUBLE, MPI_MAX,
+                    pfes->GetComm());
+   }
+#endif
+
+   const bool bench = (auto_bench_applies > 0 && serial);
+   double measured[nl][2] = { { 0.0, 0.0 } }, best_time = infinity();
+   int best = -1, smallest = -1;
+   for (int l = 0; l < nl; l++)
+   {
+      if (data[l][0] != 0.0) { continue; }
+      if (smallest < 0 || data[l][1] < data[smallest][1]) { smallest = l; }
+      if (data[l][1] > auto_max_bytes) { continue; }
+      double time = data[l][2] + data[l][3]/num_applies;
+      if (bench)
+      {
+         // Assemble a temporary form sharing the integrators of this form
+         BilinearForm a(fes, this);
+         a.SetAssemblyLevel(levels[l]);
+         StopWatch sw;
+         sw.Start();
+         a.Assemble();
+         a.Finalize();
+         sw.Stop();
+         measured[l][1] = sw.RealTime();
+         Vector x(Height()), y(Height());
+         x.UseDevice(true);
+         y.UseDevice(true);
+         x.Randomize(1);
+         a.Mult(x, y);
+         sw.Clear();
+         sw.Start();
+         for (int k = 0; k < auto_bench_applies; k++) { a.Mult(x, y); }
+         y.HostRead();
+         sw.Stop();
+         measured[l][0] = sw.RealTime()/auto_bench_applies;
+         time = measured[l][0] + measured[l][1]/num_applies;
+      }
+      if (time < best_time)
+      {
+         best = l;
+         best_time = time;
+      }
+   }
+   if (best < 0)
+   {
+      MFEM_WARNING("No assembly level fits in the memory limit, using the "
+                   "one with the smallest storage.");
+      best = smallest;
+   }
+
+   if (auto_print_level > 0 && myid == 0)
+   {
+      mfem::out << "AssemblyLevel::AUTO estimates (MB stored, MB moved and "
+                << "MFlops per action, MFlops of setup):\n";
+      for (int l = 0; l < nl; l++)
+      {
+         mfem::out << "   " << std::left << std::setw(11)
+                   << AssemblyLevelName(levels[l]) << std::right;
+         if (data[l][0] != 0.0)
+         {
+            mfem::out << "   not used\n";
+            continue;
+         }
+         const AssemblyCost cost = EstimateAssemblyCost(levels[l]);
+         mfem::out << std::setw(12) << 1e-6*cost.storage
+                   << std::setw(12) << 1e-6*cost.apply_bytes
+                   << std::setw(12) << 1e-6*cost.apply_flops
+                   << std::setw(12) << 1e-6*cost.setup_flops;
+         if (bench && data[l][1] <= auto_max_bytes)
+         {
+            mfem::out << ", measured: apply " << measured[l][0]
+                      << " s, setup " << measured[l][1] << " s";
+         }
+         mfem::out << '\n';
+      }
+      mfem::out << "   selected " << AssemblyLevelName(levels[best])
+                << std::endl;
+   }
+   return levels[best];
+}
+
 void BilinearForm::Assemble(int skip_zeros)
 {
+   if (assembly == AssemblyLevel::AUTO)
+   {
+      SetAssemblyLevel(SelectAssemblyLevel());
+   }
+
    if (ext)
    {
       ext->Assemble();
@@ -1032,6 +1299,19 @@ void BilinearForm::Mult(const Vector &x, Vector &y) const
    }
 }
 
+void BilinearForm::MultTranspose(const Vector &x, Vector &y) const
+{
+   if (ext)
+   {
+      ext->MultTranspose(x, y);
+   }
+   else
+   {
+      y = 0.0;
+      AddMultTranspose(x, y);
+   }
+}
+
 void BilinearForm::Update(FiniteElementSpace *nfes)
 {
    bool full_update;
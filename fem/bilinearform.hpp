@@ -44,6 +44,20 @@ enum class AssemblyLevel
    /// "Matrix-free" form that computes all of its action on-the-fly without any
    /// substantial storage.
    NONE,
+   /// Automatic selection of one of the levels above when the form is first
+   /// assembled, based on a cost model and optionally on timings, see
+   /// BilinearForm::SetAssemblyLevel().
+   AUTO,
+};
+
+/** @brief Estimated costs of a BilinearForm with a given AssemblyLevel, see
+    BilinearForm::EstimateAssemblyCost(). */
+struct AssemblyCost
+{
+   double setup_flops; ///< Floating point operations of the assembly
+   double apply_flops; ///< Floating point operations of one action (Mult)
+   double apply_bytes; ///< Bytes read and written by one action (Mult)
+   double storage;     ///< Bytes stored by the assembled form
 };
 
 
@@ -73,6 +87,10 @@ protected:
        Partial Assembly (PA), or Matrix Free assembly (MF). */
    BilinearFormExtension *ext;
 
+   /// Options of AssemblyLevel::AUTO, see SetAutoAssemblyMemoryLimit() etc.
+   double auto_max_bytes;
+   int auto_bench_applies, auto_print_level;
+
    /** @brief Indicates the Mesh::sequence corresponding to the current state of
        the BilinearForm. */
    long sequence;
@@ -125,8 +143,14 @@ protected:
       assembly = AssemblyLevel::LEGACYFULL;
       batch = 1;
       ext = NULL;
+      auto_max_bytes = infinity();
+      auto_bench_applies = auto_print_level = 0;
    }
 
+   /** @brief Select the assembly level of AssemblyLevel::AUTO, among the levels
+       supported by the form, see SupportsAssemblyLevel(). */
+   AssemblyLevel SelectAssemblyLevel();
+
 private:
    /// Copy construction is not supported; body is undefined.
    BilinearForm(const BilinearForm &);
@@ -162,13 +186,60 @@ public:
        - AssemblyLevel::PARTIAL
        - AssemblyLevel::ELEMENT
        - AssemblyLevel::NONE
-
-       This method must be called before assembly. */
+       - AssemblyLevel::AUTO
+
+       This method must be called before assembly.
+
+       With AssemblyLevel::AUTO, the level is selected in the first call to
+       Assemble(), among the levels supported by the integrators and the space,
+       see SupportsAssemblyLevel(). The selected level minimizes the estimated
+       time of an action plus the setup time amortized over 100 actions, and
+       stores at most SetAutoAssemblyMemoryLimit() bytes. The time is estimated
+       with a roofline model of the costs from EstimateAssemblyCost(), or
+       measured if SetAutoAssemblyBenchmark() is used. After the selection,
+       GetAssemblyLevel() returns the selected level. */
    void SetAssemblyLevel(AssemblyLevel assembly_level);
 
    /// Returns the assembly level
    AssemblyLevel GetAssemblyLevel() const { return assembly; }
 
+   /** @brief Set the maximum number of bytes stored by the form assembled with
+       AssemblyLevel::AUTO (default: no limit). */
+   /** If no supported level fits, the one with the smallest storage is used. In
+       parallel, the limit applies to the storage of each rank. */
+   void SetAutoAssemblyMemoryLimit(double max_bytes)
+   { auto_max_bytes = max_bytes; }
+
+   /** @brief With AssemblyLevel::AUTO, assemble each candidate level and time
+       @a num_applies actions instead of using the cost model (default: 0). */
+   /** The candidates are assembled on temporary forms sharing the integrators
+       of this form, so the selected level is assembled twice. The benchmark is
+       only used with serial spaces, since the timings of the ranks could lead
+       to different selections. */
+   void SetAutoAssemblyBenchmark(int num_applies)
+   { auto_bench_applies = num_applies; }
+
+   /** @brief Print the estimated (and measured) costs of the candidate levels
+       and the selection of AssemblyLevel::AUTO to mfem::out (default: 0). */
+   void SetAutoAssemblyPrintLevel(int print_level)
+   { auto_print_level = print_level; }
+
+   /** @brief Return true if the form, with its current integrators and
+       settings, can be assembled with the given @a level. */
+   /** This requires that all integrators support @a level on the space, see
+       BilinearFormIntegrator::SupportsAssemblyLevel(). Static condensation,
+       hybridization and boundary integrators are only supported by
+       AssemblyLevel::LEGACYFULL. */
+   bool SupportsAssemblyLevel(AssemblyLevel level) const;
+
+   /** @brief Estimate the costs of the form assembled with the given @a level,
+       on this rank, from the space and the number of integrators. */
+   /** The estimates assume a tensor product quadrature rule with p+2 points in
+       each direction, p being the order of the space, and for PARTIAL a
+       symmetric dim x dim matrix of data at each quadrature point and domain
+       integrator. */
+   AssemblyCost EstimateAssemblyCost(AssemblyLevel level) const;
+
    /** @brief Enable the use of static condensation. For details see the
        description for class StaticCondensation in fem/staticcond.hpp This method
        should be called before assembly. If the number of unknowns after static
@@ -276,8 +347,7 @@ public:
    { mat->AddMultTranspose(x, y); mat_e->AddMultTranspose(x, y); }
 
    /// Matrix transpose vector multiplication:  \f$ y = M^T x \f$
-   virtual void MultTranspose(const Vector & x, Vector & y) const
-   { y = 0.0; AddMultTranspose (x, y); }
+   virtual void MultTranspose(const Vector & x, Vector & y) const;
 
    /// Compute \f$ y^T M x \f$
    double InnerProduct(const Vector &x, const Vector &y) const
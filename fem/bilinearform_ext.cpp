@@ -246,6 +246,9 @@ PABilinearFormExtension::PABilinearFormExtension(BilinearForm *form)
    elem_restrict = NULL;
    int_face_restrict_lex = NULL;
    bdr_face_restrict_lex = NULL;
+   l2_elem_identity = false;
+   fused_faces = false;
+   fused_elem_faces = false;
 }
 
 void PABilinearFormExtension::SetupRestrictionOperators(const L2FaceValues m)
@@ -283,6 +286,46 @@ void PABilinearFormExtension::SetupRestrictionOperators(const L2FaceValues m)
       faceBdrY.SetSize(bdr_face_restrict_lex->Height(), Device::GetMemoryType());
       faceBdrY.UseDevice(true); // ensure 'faceBoundY = 0.0' is done on device
    }
+
+   l2_elem_identity = dynamic_cast<const L2ElementRestriction*>(elem_restrict)
+                      && trialFes->GetVDim() == 1;
+   const bool can_fuse = (m == L2FaceValues::DoubleValued) &&
+                         CanFuseFaceIntegrators();
+   // The fused face kernels accumulate their results with AtomicAdd(), which
+   // is not atomic on the host, so they are not used with OpenMP. The element
+   // kernel of fused_elem_faces does not need atomic operations, it is set up
+   // in Assemble().
+   fused_faces = can_fuse && !Device::Allows(Backend::OMP_MASK);
+   fused_elem_faces = can_fuse;
+}
+
+bool PABilinearFormExtension::CanFuseFaceIntegrators() const
+{
+   if (!l2_elem_identity) { return false; }
+#ifdef MFEM_USE_MPI
+   // Shared faces need the face-neighbor data exchanged by the
+   // ParL2FaceRestriction.
+   if (dynamic_cast<const ParFiniteElementSpace*>(trialFes)) { return false; }
+#endif
+   const Operator *face_restrict[2] = { int_face_restrict_lex,
+                                        bdr_face_restrict_lex
+                                      };
+   Array<BilinearFormIntegrator*> *face_integs[2] = { a->GetFBFI(),
+                                                      a->GetBFBFI()
+                                                    };
+   for (int k = 0; k < 2; k++)
+   {
+      if (face_integs[k]->Size() == 0) { continue; }
+      if (!dynamic_cast<const L2FaceRestriction*>(face_restrict[k]))
+      {
+         return false;
+      }
+      for (int i = 0; i < face_integs[k]->Size(); i++)
+      {
+         if (!(*face_integs[k])[i]->SupportsPAFused()) { return false; }
+      }
+   }
+   return true;
 }
 
 void PABilinearFormExtension::Assemble()
@@ -312,6 +355,63 @@ void PABilinearFormExtension::Assemble()
    {
       bdrFaceIntegrators[i]->AssemblePABoundaryFaces(*a->FESpace());
    }
+
+   fused_elem_faces = fused_elem_faces && SetupFusedElementFaces();
+}
+
+bool PABilinearFormExtension::SetupFusedElementFaces()
+{
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   if (integrators.Size() != 1) { return false; }
+   ConvectionIntegrator *conv =
+      dynamic_cast<ConvectionIntegrator*>(integrators[0]);
+   if (!conv || !conv->UseFusedFaces()) { return false; }
+   const int dim = trialFes->GetMesh()->Dimension();
+   const int NE = trialFes->GetNE();
+   if (NE == 0) { return false; }
+   const int ND = trialFes->GetFE(0)->GetDof();
+
+   Array<BilinearFormIntegrator*> *face_integs[2] = { a->GetFBFI(),
+                                                      a->GetBFBFI()
+                                                    };
+   const Operator *face_restrict[2] = { int_face_restrict_lex,
+                                        bdr_face_restrict_lex
+                                      };
+   // Each element lists its faces, at most 2*dim, with the term k and the
+   // side of the element in the face, see the face restrictions.
+   Array<int> nfaces(NE);
+   nfaces = 0;
+   elem_faces.SetSize(2*dim*NE);
+   elem_faces = -1;
+   for (int k = 0; k < 2; k++)
+   {
+      face_terms[k].nf = 0;
+      const int nfi = face_integs[k]->Size();
+      if (nfi == 0) { continue; }
+      if (nfi > 1 || !(*face_integs[k])[0]->GetPAFaceTerm(face_terms[k]))
+      {
+         return false;
+      }
+      const int NF = face_terms[k].nf;
+      if (NF == 0) { continue; }
+      const int D1D = face_terms[k].maps->ndof;
+      const int NDF = (dim == 2) ? D1D : D1D*D1D;
+      if (NDF*D1D != ND) { return false; }
+      const L2FaceRestriction &restr =
+         *static_cast<const L2FaceRestriction*>(face_restrict[k]);
+      for (int side = 0; side < 2; side++)
+      {
+         const int *idx = restr.GetScatterIndices(side).HostRead();
+         for (int f = 0; f < NF; f++)
+         {
+            if (idx[NDF*f] < 0) { continue; }
+            const int e = idx[NDF*f] / ND;
+            if (nfaces[e] == 2*dim) { return false; }
+            elem_faces[2*dim*e + nfaces[e]++] = 4*f + 2*side + k;
+         }
+      }
+   }
+   return true;
 }
 
 void PABilinearFormExtension::AssembleDiagonal(Vector &y) const
@@ -358,6 +458,9 @@ void PABilinearFormExtension::Update()
    elem_restrict = nullptr;
    int_face_restrict_lex = nullptr;
    bdr_face_restrict_lex = nullptr;
+   l2_elem_identity = false;
+   fused_faces = false;
+   fused_elem_faces = false;
 }
 
 void PABilinearFormExtension::FormSystemMatrix(const Array<int> &ess_tdof_list,
@@ -383,8 +486,22 @@ void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
 {
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
 
+   if (fused_elem_faces)
+   {
+      const L2FaceRestriction *restr[2] =
+      {
+         static_cast<const L2FaceRestriction*>(int_face_restrict_lex),
+         static_cast<const L2FaceRestriction*>(bdr_face_restrict_lex)
+      };
+      y.UseDevice(true);
+      y = 0.0;
+      static_cast<ConvectionIntegrator*>(integrators[0])->
+      AddMultPAFusedFaces(2, face_terms, restr, elem_faces, x, y);
+      return;
+   }
+
    const int iSz = integrators.Size();
-   if (DeviceCanUseCeed() || !elem_restrict)
+   if (DeviceCanUseCeed() || !elem_restrict || l2_elem_identity)
    {
       y.UseDevice(true); // typically this is a large vector, so store on device
       y = 0.0;
@@ -404,6 +521,8 @@ void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
       elem_restrict->MultTranspose(localY, y);
    }
 
+   if (fused_faces) { AddMultFusedFaces(x, y, false); return; }
+
    Array<BilinearFormIntegrator*> &intFaceIntegrators = *a->GetFBFI();
    const int iFISz = intFaceIntegrators.Size();
    if (int_face_restrict_lex && iFISz>0)
@@ -441,7 +560,7 @@ void PABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
 {
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
    const int iSz = integrators.Size();
-   if (elem_restrict)
+   if (elem_restrict && !l2_elem_identity)
    {
       elem_restrict->Mult(x, localX);
       localY = 0.0;
@@ -461,6 +580,8 @@ void PABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
       }
    }
 
+   if (fused_faces) { AddMultFusedFaces(x, y, true); return; }
+
    Array<BilinearFormIntegrator*> &intFaceIntegrators = *a->GetFBFI();
    const int iFISz = intFaceIntegrators.Size();
    if (int_face_restrict_lex && iFISz>0)
@@ -494,6 +615,37 @@ void PABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
    }
 }
 
+void PABilinearFormExtension::AddMultFusedFaces(const Vector &x, Vector &y,
+                                                const bool transpose) const
+{
+   // Apply the face integrators directly to the L-vectors, without the face
+   // E-vectors faceIntX, faceIntY, faceBdrX and faceBdrY.
+   Array<BilinearFormIntegrator*> *face_integs[2] = { a->GetFBFI(),
+                                                      a->GetBFBFI()
+                                                    };
+   const Operator *face_restrict[2] = { int_face_restrict_lex,
+                                        bdr_face_restrict_lex
+                                      };
+   for (int k = 0; k < 2; k++)
+   {
+      const int nfi = face_integs[k]->Size();
+      if (nfi == 0) { continue; }
+      const L2FaceRestriction &restr =
+         *static_cast<const L2FaceRestriction*>(face_restrict[k]);
+      for (int i = 0; i < nfi; i++)
+      {
+         if (transpose)
+         {
+            (*face_integs[k])[i]->AddMultTransposePAFused(restr, x, y);
+         }
+         else
+         {
+            (*face_integs[k])[i]->AddMultPAFused(restr, x, y);
+         }
+      }
+   }
+}
+
 // Data and methods for element-assembled bilinear forms
 EABilinearFormExtension::EABilinearFormExtension(BilinearForm *form)
    : PABilinearFormExtension(form),
@@ -73,6 +73,22 @@ protected:
    const Operator *elem_restrict; // Not owned
    const Operator *int_face_restrict_lex; // Not owned
    const Operator *bdr_face_restrict_lex; // Not owned
+   /** For L2 spaces with vdim = 1 the element restriction is the identity,
+       and the domain integrators are applied directly to the L-vectors. */
+   bool l2_elem_identity;
+   /** On serial L2 spaces with vdim = 1, face integrators that support it are
+       applied directly to the L-vectors, see
+       BilinearFormIntegrator::AddMultPAFused(). */
+   bool fused_faces;
+   /** With a single ConvectionIntegrator and DG face terms, see PAFaceTerm,
+       on the spaces of fused_faces, the face terms are applied in the element
+       kernel ConvectionIntegrator::AddMultPAFusedFaces() in Mult(), if
+       ConvectionIntegrator::UseFusedFaces(). */
+   bool fused_elem_faces;
+   /// The face terms of the interior and boundary faces, see fused_elem_faces
+   PAFaceTerm face_terms[2];
+   /// The faces of the elements, see ConvectionIntegrator::AddMultPAFusedFaces()
+   Array<int> elem_faces;
 
 public:
    PABilinearFormExtension(BilinearForm*);
@@ -90,6 +106,14 @@ public:
 
 protected:
    void SetupRestrictionOperators(const L2FaceValues m);
+   /// Can the face integrators be applied with fused L-vector kernels?
+   bool CanFuseFaceIntegrators() const;
+   /** @brief Set up face_terms and elem_faces after the assembly, and return
+       true if the face terms can be applied in the element kernel. */
+   bool SetupFusedElementFaces();
+   /// Add the (transposed) action of the face integrators, see fused_faces.
+   void AddMultFusedFaces(const Vector &x, Vector &y,
+                          const bool transpose) const;
 };
 
 /// Data and methods for element-assembled bilinear forms
@@ -12,6 +12,8 @@
 // Implementation of Bilinear Form Integrators
 
 #include "fem.hpp"
+#include "libceed/ceed.hpp"
+#include "../general/forall.hpp"
 #include <cmath>
 #include <algorithm>
 
@@ -96,6 +98,83 @@ void BilinearFormIntegrator::AddMultTransposePA(const Vector &, Vector &) const
                "   is not implemented for this class.");
 }
 
+void BilinearFormIntegrator::AddMultPAFused(const L2FaceRestriction &,
+                                            const Vector &, Vector &) const
+{
+   mfem_error ("BilinearFormIntegrator::AddMultPAFused(...)\n"
+               "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AddMultTransposePAFused(const L2FaceRestriction &,
+                                                     const Vector &,
+                                                     Vector &) const
+{
+   mfem_error ("BilinearFormIntegrator::AddMultTransposePAFused(...)\n"
+               "   is not implemented for this class.");
+}
+
+// Copy (and convert) the n entries of x into y, on the device
+template <typename TX, typename TY>
+static void ConvertPAData(const int n, const TX *x, TY *y)
+{
+   MFEM_FORALL(i, n, y[i] = static_cast<TY>(x[i]););
+}
+
+static void ToSinglePrecision(const Array<double> &x, Array<float> &y)
+{
+   y.SetSize(x.Size(), Device::GetDeviceMemoryType());
+   ConvertPAData(x.Size(), x.Read(), y.Write());
+}
+
+void SinglePrecisionPAData::Setup(Vector &pa_data, const DofToQuad &maps,
+                                  bool grad)
+{
+   D.SetSize(pa_data.Size(), Device::GetDeviceMemoryType());
+   ConvertPAData(pa_data.Size(), pa_data.Read(), D.Write());
+   pa_data.Destroy();
+   ToSinglePrecision(maps.B, B);
+   ToSinglePrecision(maps.Bt, Bt);
+   if (grad)
+   {
+      ToSinglePrecision(maps.G, G);
+      ToSinglePrecision(maps.Gt, Gt);
+   }
+   else
+   {
+      G.DeleteAll();
+      Gt.DeleteAll();
+   }
+}
+
+void SinglePrecisionPAData::GetData(Vector &pa_data) const
+{
+   pa_data.SetSize(D.Size(), Device::GetDeviceMemoryType());
+   ConvertPAData(D.Size(), D.Read(), pa_data.Write());
+}
+
+bool BilinearFormIntegrator::SupportsAssemblyLevel(
+   AssemblyLevel level, const FiniteElementSpace &) const
+{
+   return level == AssemblyLevel::LEGACYFULL;
+}
+
+// Is @a fes supported by the element, partial and matrix-free assembly
+// kernels, i.e. a single tensor product element type of moderate order in 2D
+// or 3D? The number of 1D quadrature points is assumed to be at most p+2.
+static bool TensorKernelSpace(const FiniteElementSpace &fes)
+{
+   const Mesh *mesh = fes.GetMesh();
+   const int dim = mesh->Dimension();
+   if (dim < 2 || fes.GetNURBSext() || mesh->GetNumGeometries(dim) > 1)
+   {
+      return false;
+   }
+   if (fes.GetNE() == 0) { return true; }
+   const FiniteElement *fe = fes.GetFE(0);
+   return dynamic_cast<const TensorBasisElement*>(fe) &&
+          fe->GetOrder() + 2 <= MAX_Q1D;
+}
+
 void BilinearFormIntegrator::AssembleMF(const FiniteElementSpace &fes)
 {
    mfem_error ("BilinearFormIntegrator::AssembleMF(...)\n"
@@ -202,6 +281,13 @@ void TransposeIntegrator::AssembleFaceMatrix (
    elmat.Transpose (bfi_elmat);
 }
 
+bool TransposeIntegrator::SupportsAssemblyLevel(
+   AssemblyLevel level, const FiniteElementSpace &fes) const
+{
+   return level != AssemblyLevel::NONE &&
+          bfi->SupportsAssemblyLevel(level, fes);
+}
+
 void LumpedIntegrator::AssembleElementMatrix (
    const FiniteElement &el, ElementTransformation &Trans, DenseMatrix &elmat)
 {
@@ -542,6 +628,245 @@ const IntegrationRule &GradientIntegrator::GetRule(const FiniteElement
 }
 
 
+// Returns the number of points per direction if the points of 'ir' form a
+// tensor product grid with x running fastest, as the rules of IntRules on
+// squares and cubes do; otherwise returns 0.
+static int TensorRuleSize1D(const IntegrationRule &ir, const int dim)
+{
+   const int NQ = ir.GetNPoints();
+   const int Q1D = (int)floor(pow(NQ, 1.0/dim) + 0.5);
+   const int Q2D = Q1D*Q1D;
+   if (NQ == 0 || (dim == 2 ? Q2D : Q2D*Q1D) != NQ) { return 0; }
+   for (int q = 0; q < NQ; q++)
+   {
+      const IntegrationPoint &ip = ir.IntPoint(q);
+      if (ip.x != ir.IntPoint(q % Q1D).x ||
+          ip.y != ir.IntPoint(((q / Q1D) % Q1D)*Q1D).y ||
+          (dim == 3 && ip.z != ir.IntPoint((q / Q2D)*Q2D).z))
+      {
+         return 0;
+      }
+   }
+   return Q1D;
+}
+
+// Returns the 1D tensor maps of 'el' at 'ir' and sets 'dof_map' to its
+// lexicographic dof ordering, if the element matrices of 'el' can be assembled
+// with sum factorization. This requires a scalar tensor product element of
+// order at least 2 on a square or a cube, a tensor product rule and a space
+// of the same dimension. Otherwise returns NULL.
+static const DofToQuad *SumFactorizationMaps(const FiniteElement &el,
+                                             ElementTransformation &Trans,
+                                             const IntegrationRule &ir,
+                                             const Array<int> *&dof_map)
+{
+   const TensorBasisElement *tbe =
+      dynamic_cast<const TensorBasisElement*>(&el);
+   const int dim = el.GetDim();
+   if (!tbe || el.GetOrder() < 2 || (dim != 2 && dim != 3) ||
+       el.GetRangeType() != FiniteElement::SCALAR ||
+       Trans.GetSpaceDim() != dim || TensorRuleSize1D(ir, dim) == 0)
+   {
+      return NULL;
+   }
+   dof_map = &tbe->GetDofMap();
+   return &el.GetDofToQuad(ir, DofToQuad::TENSOR);
+}
+
+// Adds to the lexicographically ordered matrix 'A' the entries
+//    A(i,j) += sum_q L_x(qx,ix) R_x(qx,jx) L_y(qy,iy) R_y(qy,jy)
+//                    [L_z(qz,iz) R_z(qz,jz)] D(q),
+// where the (Q1D x D1D) matrices L_x, R_x, ... are given in 'L' and 'R'. The
+// sums over the quadrature points are done one direction at a time, which
+// costs O(Q1D D1D^{2 dim}) operations instead of O(Q1D^dim D1D^{2 dim}).
+static void AddSumFactorized(const int dim, const int D1D, const int Q1D,
+                             const double * const *L, const double * const *R,
+                             const double *D, double *A, Vector &work)
+{
+   const int DD = D1D*D1D;
+   const int ND = (dim == 2) ? DD : DD*D1D;
+   work.SetSize(dim*DD*Q1D + DD*Q1D*Q1D + DD*DD*Q1D);
+   // P_d(k,(i,j)) = L_d(k,i) R_d(k,j)
+   double *P[3];
+   for (int d = 0; d < dim; d++)
+   {
+      P[d] = work.GetData() + d*DD*Q1D;
+      for (int i = 0; i < D1D; i++)
+      {
+         for (int j = 0; j < D1D; j++)
+         {
+            for (int k = 0; k < Q1D; k++)
+            {
+               P[d][(i*D1D + j)*Q1D + k] = L[d][k + Q1D*i]*R[d][k + Q1D*j];
+            }
+         }
+      }
+   }
+   double *T = work.GetData() + dim*DD*Q1D;
+   double *T2 = T + DD*Q1D*Q1D;
+   if (dim == 2)
+   {
+      // T(k1,(i2,j2)) = sum_k2 P_y(k2,(i2,j2)) D(k1,k2)
+      for (int ij2 = 0; ij2 < DD; ij2++)
+      {
+         for (int k1 = 0; k1 < Q1D; k1++)
+         {
+            double s = 0.0;
+            for (int k2 = 0; k2 < Q1D; k2++)
+            {
+               s += P[1][ij2*Q1D + k2]*D[k1 + Q1D*k2];
+            }
+            T[ij2*Q1D + k1] = s;
+         }
+      }
+      for (int ij2 = 0; ij2 < DD; ij2++)
+      {
+         const int i2 = ij2 / D1D, j2 = ij2 % D1D;
+         for (int ij1 = 0; ij1 < DD; ij1++)
+         {
+            const int i1 = ij1 / D1D, j1 = ij1 % D1D;
+            double s = 0.0;
+            for (int k1 = 0; k1 < Q1D; k1++)
+            {
+               s += P[0][ij1*Q1D + k1]*T[ij2*Q1D + k1];
+            }
+            A[(i1 + D1D*i2) + ND*(j1 + D1D*j2)] += s;
+         }
+      }
+      return;
+   }
+   // T(k1,k2,(i3,j3)) = sum_k3 P_z(k3,(i3,j3)) D(k1,k2,k3)
+   for (int ij3 = 0; ij3 < DD; ij3++)
+   {
+      for (int k2 = 0; k2 < Q1D; k2++)
+      {
+         for (int k1 = 0; k1 < Q1D; k1++)
+         {
+            double s = 0.0;
+            for (int k3 = 0; k3 < Q1D; k3++)
+            {
+               s += P[2][ij3*Q1D + k3]*D[k1 + Q1D*(k2 + Q1D*k3)];
+            }
+            T[(ij3*Q1D + k2)*Q1D + k1] = s;
+         }
+      }
+   }
+   // T2(k1,(i2,j2),(i3,j3)) = sum_k2 P_y(k2,(i2,j2)) T(k1,k2,(i3,j3))
+   for (int ij3 = 0; ij3 < DD; ij3++)
+   {
+      for (int ij2 = 0; ij2 < DD; ij2++)
+      {
+         for (int k1 = 0; k1 < Q1D; k1++)
+         {
+            double s = 0.0;
+            for (int k2 = 0; k2 < Q1D; k2++)
+            {
+               s += P[1][ij2*Q1D + k2]*T[(ij3*Q1D + k2)*Q1D + k1];
+            }
+            T2[(ij3*DD + ij2)*Q1D + k1] = s;
+         }
+      }
+   }
+   for (int ij3 = 0; ij3 < DD; ij3++)
+   {
+      const int i3 = ij3 / D1D, j3 = ij3 % D1D;
+      for (int ij2 = 0; ij2 < DD; ij2++)
+      {
+         const int i2 = ij2 / D1D, j2 = ij2 % D1D;
+         const double *t2 = T2 + (ij3*DD + ij2)*Q1D;
+         for (int ij1 = 0; ij1 < DD; ij1++)
+         {
+            const int i1 = ij1 / D1D, j1 = ij1 % D1D;
+            const double *p1 = P[0] + ij1*Q1D;
+            double s = 0.0;
+            for (int k1 = 0; k1 < Q1D; k1++)
+            {
+               s += p1[k1]*t2[k1];
+            }
+            A[(i1 + D1D*(i2 + D1D*i3)) + ND*(j1 + D1D*(j2 + D1D*j3))] += s;
+         }
+      }
+   }
+}
+
+// Assembles in 'elmat' the element matrix of a tensor product element with 1D
+// maps 'maps' and lexicographic ordering 'dof_map'. When 'grad' is false,
+// 'qdata' holds one weight w_q per point and the matrix is
+//    sum_q w_q phi_i(x_q) phi_j(x_q),
+// otherwise it holds a (dim x dim) matrix W_q per point, with layout
+// (NQ, dim, dim), and the matrix is
+//    sum_q grad phi_i(x_q)^T W_q grad phi_j(x_q),
+// with reference gradients.
+static void AssembleSumFactorized(const DofToQuad &maps,
+                                  const Array<int> &dof_map,
+                                  const int dim, const bool grad,
+                                  const Vector &qdata, DenseMatrix &elmat)
+{
+   const int D1D = maps.ndof, Q1D = maps.nqpt;
+   const int NQ = (dim == 2) ? Q1D*Q1D : Q1D*Q1D*Q1D;
+   const int ND = (dim == 2) ? D1D*D1D : D1D*D1D*D1D;
+   const double *B = maps.B.HostRead(), *G = maps.G.HostRead();
+   DenseMatrix A(ND);
+   Vector work;
+   A = 0.0;
+   if (!grad)
+   {
+      const double *L[3] = { B, B, B };
+      AddSumFactorized(dim, D1D, Q1D, L, L, qdata.GetData(), A.Data(), work);
+   }
+   else
+   {
+      const double *L[3], *R[3];
+      for (int a = 0; a < dim; a++)
+      {
+         for (int b = 0; b < dim; b++)
+         {
+            for (int d = 0; d < dim; d++)
+            {
+               L[d] = (d == a) ? G : B;
+               R[d] = (d == b) ? G : B;
+            }
+            AddSumFactorized(dim, D1D, Q1D, L, R,
+                             qdata.GetData() + NQ*(a + dim*b), A.Data(),
+                             work);
+         }
+      }
+   }
+   elmat.SetSize(ND);
+   if (dof_map.Size() == 0)
+   {
+      elmat = A;
+      return;
+   }
+   for (int j = 0; j < ND; j++)
+   {
+      for (int i = 0; i < ND; i++)
+      {
+         elmat(dof_map[i], dof_map[j]) = A(i,j);
+      }
+   }
+}
+
+bool DiffusionIntegrator::SupportsAssemblyLevel(
+   AssemblyLevel level, const FiniteElementSpace &fes) const
+{
+   if (level == AssemblyLevel::LEGACYFULL) { return true; }
+   if (fes.GetVDim() != 1) { return false; }
+   switch (level)
+   {
+      case AssemblyLevel::PARTIAL:
+         return fes.GetNURBSext() || TensorKernelSpace(fes);
+      case AssemblyLevel::FULL:
+      case AssemblyLevel::ELEMENT:
+         // The element matrices assume symmetric quadrature point data
+         return MQ == NULL && TensorKernelSpace(fes);
+      case AssemblyLevel::NONE:
+         return DeviceCanUseCeed() && TensorKernelSpace(fes);
+      default:
+         return false;
+   }
+}
+
 void DiffusionIntegrator::AssembleElementMatrix
 ( const FiniteElement &el, ElementTransformation &Trans,
   DenseMatrix &elmat )
@@ -565,6 +890,48 @@ void DiffusionIntegrator::AssembleElementMatrix
 
    const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, el);
 
+   const Array<int> *dof_map;
+   if (const DofToQuad *maps = SumFactorizationMaps(el, Trans, *ir, dof_map))
+   {
+      // W_q = w_q adj(J) K adj(J)^T / det(J) for the coefficient K
+      const int NQ = ir->GetNPoints();
+      Vector qdata(NQ*dim*dim);
+      DenseMatrix K(dim), AK(dim), W(dim);
+      for (int q = 0; q < NQ; q++)
+      {
+         const IntegrationPoint &ip = ir->IntPoint(q);
+         Trans.SetIntPoint(&ip);
+         w = ip.weight;
+         if (MQ) { MQ->Eval(K, Trans, ip); }
+         else if (VQ) { VQ->Eval(D, Trans, ip); }
+         else if (Q) { w *= Q->Eval(Trans, ip); }
+         w /= Trans.Weight();
+         const DenseMatrix &adj = Trans.AdjugateJacobian();
+         if (MQ)
+         {
+            Mult(adj, K, AK);
+            MultABt(AK, adj, W);
+         }
+         else if (VQ)
+         {
+            MultADAt(adj, D, W);
+         }
+         else
+         {
+            MultAAt(adj, W);
+         }
+         for (int b = 0; b < dim; b++)
+         {
+            for (int a = 0; a < dim; a++)
+            {
+               qdata(q + NQ*(a + dim*b)) = w*W(a,b);
+            }
+         }
+      }
+      AssembleSumFactorized(*maps, *dof_map, dim, true, qdata, elmat);
+      return;
+   }
+
    elmat = 0.0;
    for (int i = 0; i < ir->GetNPoints(); i++)
    {
@@ -887,6 +1254,25 @@ const IntegrationRule &DiffusionIntegrator::GetRule(
 }
 
 
+bool MassIntegrator::SupportsAssemblyLevel(
+   AssemblyLevel level, const FiniteElementSpace &fes) const
+{
+   if (level == AssemblyLevel::LEGACYFULL) { return true; }
+   if (fes.GetVDim() != 1) { return false; }
+   switch (level)
+   {
+      case AssemblyLevel::PARTIAL:
+         return fes.GetNURBSext() || TensorKernelSpace(fes);
+      case AssemblyLevel::FULL:
+      case AssemblyLevel::ELEMENT:
+         return TensorKernelSpace(fes);
+      case AssemblyLevel::NONE:
+         return DeviceCanUseCeed() && TensorKernelSpace(fes);
+      default:
+         return false;
+   }
+}
+
 void MassIntegrator::AssembleElementMatrix
 ( const FiniteElement &el, ElementTransformation &Trans,
   DenseMatrix &elmat )
@@ -903,6 +1289,21 @@ void MassIntegrator::AssembleElementMatrix
 
    const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, el, Trans);
 
+   const Array<int> *dof_map;
+   if (const DofToQuad *maps = SumFactorizationMaps(el, Trans, *ir, dof_map))
+   {
+      const int NQ = ir->GetNPoints();
+      Vector qdata(NQ);
+      for (int q = 0; q < NQ; q++)
+      {
+         const IntegrationPoint &ip = ir->IntPoint(q);
+         Trans.SetIntPoint(&ip);
+         qdata(q) = Trans.Weight() * ip.weight * (Q ? Q->Eval(Trans, ip) : 1.0);
+      }
+      AssembleSumFactorized(*maps, *dof_map, el.GetDim(), false, qdata, elmat);
+      return;
+   }
+
    elmat = 0.0;
    for (int i = 0; i < ir->GetNPoints(); i++)
    {
@@ -1018,6 +1419,14 @@ void BoundaryMassIntegrator::AssembleFaceMatrix(
    }
 }
 
+bool ConvectionIntegrator::SupportsAssemblyLevel(
+   AssemblyLevel level, const FiniteElementSpace &fes) const
+{
+   if (level == AssemblyLevel::LEGACYFULL) { return true; }
+   return level != AssemblyLevel::NONE && fes.GetVDim() == 1 &&
+          TensorKernelSpace(fes);
+}
+
 void ConvectionIntegrator::AssembleElementMatrix(
    const FiniteElement &el, ElementTransformation &Trans, DenseMatrix &elmat)
 {
@@ -1134,6 +1543,25 @@ const IntegrationRule &ConvectionIntegrator::GetRule(
    return GetRule(el,el,Trans);
 }
 
+bool VectorMassIntegrator::SupportsAssemblyLevel(
+   AssemblyLevel level, const FiniteElementSpace &fes) const
+{
+   if (level == AssemblyLevel::LEGACYFULL) { return true; }
+   // The PA kernels only support constant scalar coefficients
+   const bool vector_space = fes.GetVDim() == fes.GetMesh()->Dimension() &&
+                             VQ == NULL && MQ == NULL &&
+                             (Q == NULL || dynamic_cast<ConstantCoefficient*>(Q));
+   switch (level)
+   {
+      case AssemblyLevel::PARTIAL:
+         return vector_space && TensorKernelSpace(fes);
+      case AssemblyLevel::NONE:
+         return vector_space && DeviceCanUseCeed() && TensorKernelSpace(fes);
+      default:
+         return false;
+   }
+}
+
 void VectorMassIntegrator::AssembleElementMatrix
 ( const FiniteElement &el, ElementTransformation &Trans,
   DenseMatrix &elmat )
@@ -2245,6 +2673,25 @@ void DivDivIntegrator::AssembleElementMatrix(
 }
 
 
+bool VectorDiffusionIntegrator::SupportsAssemblyLevel(
+   AssemblyLevel level, const FiniteElementSpace &fes) const
+{
+   if (level == AssemblyLevel::LEGACYFULL) { return true; }
+   // The PA kernels only support constant coefficients
+   const bool vector_space =
+      fes.GetVDim() == fes.GetMesh()->SpaceDimension() &&
+      (Q == NULL || dynamic_cast<ConstantCoefficient*>(Q));
+   switch (level)
+   {
+      case AssemblyLevel::PARTIAL:
+         return vector_space && TensorKernelSpace(fes);
+      case AssemblyLevel::NONE:
+         return vector_space && DeviceCanUseCeed() && TensorKernelSpace(fes);
+      default:
+         return false;
+   }
+}
+
 void VectorDiffusionIntegrator::AssembleElementMatrix(
    const FiniteElement &el,
    ElementTransformation &Trans,
@@ -2594,6 +3041,14 @@ double ElasticityIntegrator::ComputeFluxEnergy(const FiniteElement &fluxelem,
    return energy;
 }
 
+bool DGTraceIntegrator::SupportsAssemblyLevel(
+   AssemblyLevel level, const FiniteElementSpace &fes) const
+{
+   if (level == AssemblyLevel::LEGACYFULL) { return true; }
+   return level != AssemblyLevel::NONE && fes.IsDGSpace() &&
+          fes.GetVDim() == 1 && TensorKernelSpace(fes);
+}
+
 void DGTraceIntegrator::AssembleFaceMatrix(const FiniteElement &el1,
                                            const FiniteElement &el2,
                                            FaceElementTransformations &Trans,
@@ -20,6 +20,8 @@
 namespace mfem
 {
 
+enum class AssemblyLevel; // defined in bilinearform.hpp
+
 // Local maximum size of dofs and quads in 1D
 constexpr int HCURL_MAX_D1D = 5;
 constexpr int HCURL_MAX_Q1D = 6;
@@ -27,6 +29,88 @@ constexpr int HCURL_MAX_Q1D = 6;
 constexpr int HDIV_MAX_D1D = 5;
 constexpr int HDIV_MAX_Q1D = 6;
 
+/** @brief Tensor product basis data for the partial assembly of integrators
+    on NURBS spaces. */
+/** The basis functions of a NURBS element are the tensor products of the 1D
+    B-splines of its knot spans, multiplied by the NURBS weights w_i of the
+    element dofs and divided by the weight function W = sum_i w_i B_i. Here,
+    the 1D B-splines and their derivatives are evaluated once for each knot
+    span, at the points of a 1D quadrature rule, and shared by all elements
+    with the same knot span in a given direction. Only spaces with the same
+    order in all directions are supported. */
+class NURBSDofToQuad
+{
+public:
+   /// Dimension, number of elements, and number of 1D dofs and points
+   int dim, ne, ndof, nqpt;
+
+   /// Number of distinct 1D knot spans
+   int nspans;
+
+   /// 1D B-splines of the knot spans at the points, nqpt x ndof x nspans
+   Array<double> B;
+
+   /// 1D B-spline derivatives of the knot spans, nqpt x ndof x nspans
+   Array<double> G;
+
+   /// Knot span (index in B and G) of each element in each direction
+   Array<int> spans;
+
+   /// NURBS weights of the (lexicographically ordered) element dofs
+   Vector weights;
+
+   /** @brief Construct the basis data of the NURBS space @a fes at the points
+       of the tensor product integration rule @a ir. */
+   NURBSDofToQuad(const FiniteElementSpace &fes, const IntegrationRule &ir);
+
+   /** @brief Evaluate the weight function W and its reference gradient @a dW
+       at the points of element @a e, on the host. */
+   void CalcWeightFunction(int e, Vector &W, DenseMatrix &dW) const;
+};
+
+/** @brief Single precision storage of the partially assembled quadrature data
+    and of the 1D basis tables of an integrator. */
+/** The PA actions of the Mass and Diffusion integrators are bandwidth bound,
+    and most of the streamed memory is the quadrature data. Storing it (and the
+    basis tables) in single precision halves this traffic, while the kernels
+    still accumulate in double precision. The relative accuracy of the action
+    is then ~1e-7, see IterativeRefinementSolver for recovering the full
+    accuracy of a linear solve. */
+class SinglePrecisionPAData
+{
+public:
+   /// Quadrature data, same layout as the double precision pa_data
+   Array<float> D;
+
+   /// 1D basis functions and gradients, and their transposes
+   Array<float> B, Bt, G, Gt;
+
+   /** @brief Convert @a pa_data and the basis tables of @a maps (with their
+       gradients, if @a grad is true) to single precision. */
+   /** The memory of @a pa_data is released. */
+   void Setup(Vector &pa_data, const DofToQuad &maps, bool grad);
+
+   /// Convert the quadrature data back to double precision in @a pa_data.
+   void GetData(Vector &pa_data) const;
+};
+
+/** @brief Partially assembled data of a DG face integrator whose action is
+    given by 2x2 blocks, coupling the two sides of each face, at the face
+    quadrature points, as in DGTraceIntegrator. */
+/** It is used to evaluate the face terms in element kernels, see
+    ConvectionIntegrator::AddMultPAFusedFaces(). */
+struct PAFaceTerm
+{
+   /// The blocks, of size Q1D^(dim-1) x 2 x 2 x NF
+   const Vector *op;
+   /// The 1D basis functions at the face quadrature points
+   const DofToQuad *maps;
+   /// Number of faces
+   int nf;
+   /// Apply the transposed blocks
+   bool transpose;
+};
+
 /// Abstract base class BilinearFormIntegrator
 class BilinearFormIntegrator : public NonlinearFormIntegrator
 {
@@ -85,6 +169,42 @@ public:
        called. */
    virtual void AddMultTransposePA(const Vector &x, Vector &y) const;
 
+   /** @brief Return true if the integrator implements the assembly level
+       @a level on the space @a fes. */
+   /** This is used by AssemblyLevel::AUTO. The default implementation only
+       returns true for AssemblyLevel::LEGACYFULL. */
+   virtual bool SupportsAssemblyLevel(AssemblyLevel level,
+                                      const FiniteElementSpace &fes) const;
+
+   /// Does the face integrator support AddMultPAFused()?
+   virtual bool SupportsPAFused() const { return false; }
+
+   /// Method for fused partially assembled action of face integrators.
+   /** Perform the action of the face integrator on the input @a x and add the
+       result to the output @a y. Both @a x and @a y are L-vectors of an L2
+       space with vdim = 1: the face values are read from @a x with the
+       indices of the face restriction @a restr, and the face contributions
+       are added directly to @a y, without forming face E-vectors.
+
+       This method can be called only after the method
+       AssemblePAInteriorFaces() or AssemblePABoundaryFaces() matching @a restr
+       has been called. */
+   virtual void AddMultPAFused(const L2FaceRestriction &restr,
+                               const Vector &x, Vector &y) const;
+
+   /// Method for fused partially assembled transposed action.
+   /** Same as AddMultPAFused(), for the transposed action. */
+   virtual void AddMultTransposePAFused(const L2FaceRestriction &restr,
+                                        const Vector &x, Vector &y) const;
+
+   /** @brief Fill in the given PAFaceTerm with the partially assembled data
+       of the face integrator, if it has the form described by PAFaceTerm. */
+   /** Return false if the integrator does not support it (the default).
+       This method can be called only after the method
+       AssemblePAInteriorFaces() or AssemblePABoundaryFaces() has been
+       called. */
+   virtual bool GetPAFaceTerm(PAFaceTerm &) const { return false; }
+
    /// Method defining element assembly.
    /** The result of the element assembly is added to the @a emat Vector if
        @a add is true. Otherwise, if @a add is false, we set @a emat. */
@@ -300,6 +420,30 @@ public:
       bfi->AddMultTransposePA(x, y);
    }
 
+   virtual bool SupportsAssemblyLevel(AssemblyLevel level,
+                                      const FiniteElementSpace &fes) const;
+
+   virtual bool SupportsPAFused() const { return bfi->SupportsPAFused(); }
+
+   virtual void AddMultPAFused(const L2FaceRestriction &restr,
+                               const Vector &x, Vector &y) const
+   {
+      bfi->AddMultTransposePAFused(restr, x, y);
+   }
+
+   virtual void AddMultTransposePAFused(const L2FaceRestriction &restr,
+                                        const Vector &x, Vector &y) const
+   {
+      bfi->AddMultPAFused(restr, x, y);
+   }
+
+   virtual bool GetPAFaceTerm(PAFaceTerm &term) const
+   {
+      if (!bfi->GetPAFaceTerm(term)) { return false; }
+      term.transpose = !term.transpose;
+      return true;
+   }
+
    virtual void AssembleEA(const FiniteElementSpace &fes, Vector &emat,
                            const bool add);
 
@@ -1917,37 +2061,48 @@ private:
    int dim, ne, dofs1D, quad1D;
    Vector pa_data;
    bool symmetric = true; ///< False if using a nonsymmetric matrix coefficient
+   NURBSDofToQuad *nurbs_maps;    ///< Owned, used on NURBS spaces
+   bool single_pa = false;        ///< See SetSinglePrecisionPA()
+   bool pa_sp_built = false;      ///< True if AssemblePA() set up pa_sp
+   SinglePrecisionPAData pa_sp;   ///< Used if pa_sp_built is true
    // CEED extension
    CeedData* ceedDataPtr;
 
+   // Partial assembly on NURBS spaces, see NURBSDofToQuad
+   void AssemblePANURBS(const FiniteElementSpace &fes,
+                        const IntegrationRule &ir);
+   void AddMultPANURBS(const Vector &x, Vector &y) const;
+   void AssembleDiagonalPANURBS(Vector &diag) const;
+
 public:
    /// Construct a diffusion integrator with coefficient Q = 1
    DiffusionIntegrator()
       : Q(NULL), VQ(NULL), MQ(NULL), SMQ(NULL), maps(NULL), geom(NULL),
-        ceedDataPtr(NULL) { }
+        nurbs_maps(NULL), ceedDataPtr(NULL) { }
 
    /// Construct a diffusion integrator with a scalar coefficient q
    DiffusionIntegrator(Coefficient &q)
       : Q(&q), VQ(NULL), MQ(NULL), SMQ(NULL), maps(NULL), geom(NULL),
-        ceedDataPtr(NULL) { }
+        nurbs_maps(NULL), ceedDataPtr(NULL) { }
 
    /// Construct a diffusion integrator with a vector coefficient q
    DiffusionIntegrator(VectorCoefficient &q)
       : Q(NULL), VQ(&q), MQ(NULL), SMQ(NULL), maps(NULL), geom(NULL),
-        ceedDataPtr(NULL) { }
+        nurbs_maps(NULL), ceedDataPtr(NULL) { }
 
    /// Construct a diffusion integrator with a matrix coefficient q
    DiffusionIntegrator(MatrixCoefficient &q)
       : Q(NULL), VQ(NULL), MQ(&q), SMQ(NULL), maps(NULL), geom(NULL),
-        ceedDataPtr(NULL) { }
+        nurbs_maps(NULL), ceedDataPtr(NULL) { }
 
    /// Construct a diffusion integrator with a symmetric matrix coefficient q
    DiffusionIntegrator(SymmetricMatrixCoefficient &q)
       : Q(NULL), VQ(NULL), MQ(NULL), SMQ(&q), maps(NULL), geom(NULL),
-        ceedDataPtr(NULL) { }
+        nurbs_maps(NULL), ceedDataPtr(NULL) { }
 
    virtual ~DiffusionIntegrator()
    {
+      delete nurbs_maps;
       delete ceedDataPtr;
    }
 
@@ -1977,12 +2132,28 @@ public:
                                     ElementTransformation &Trans,
                                     Vector &flux, Vector *d_energy = NULL);
 
+   /** @brief Store the partially assembled data and the 1D basis tables in
+       single precision, see SinglePrecisionPAData. */
+   /** Takes effect at the next AssemblePA(); until then, the data assembled
+       before is used. The action still accumulates in double precision, but
+       its relative accuracy is only ~1e-7. The option is ignored on NURBS
+       spaces and with libCEED; the element and full assembly levels always
+       use double precision. The 3D SIMD host kernels are double precision
+       only, so the option mainly benefits bandwidth bound devices. */
+   void SetSinglePrecisionPA(bool single = true) { single_pa = single; }
+
+   /// Return true if SetSinglePrecisionPA() was enabled.
+   bool GetSinglePrecisionPA() const { return single_pa; }
+
    using BilinearFormIntegrator::AssemblePA;
 
    virtual void AssembleMF(const FiniteElementSpace &fes);
 
    virtual void AssemblePA(const FiniteElementSpace &fes);
 
+   virtual bool SupportsAssemblyLevel(AssemblyLevel level,
+                                      const FiniteElementSpace &fes) const;
+
    virtual void AssembleEA(const FiniteElementSpace &fes, Vector &emat,
                            const bool add);
 
@@ -2001,6 +2172,7 @@ public:
 /** Class for local mass matrix assembling a(u,v) := (Q u, v) */
 class MassIntegrator: public BilinearFormIntegrator
 {
+   friend class DGMassInverse;
 protected:
 #ifndef MFEM_THREAD_SAFE
    Vector shape, te_shape;
@@ -2012,22 +2184,33 @@ protected:
    const DofToQuad *maps;         ///< Not owned
    const GeometricFactors *geom;  ///< Not owned
    int dim, ne, nq, dofs1D, quad1D;
+   NURBSDofToQuad *nurbs_maps;    ///< Owned, used on NURBS spaces
+   bool single_pa = false;        ///< See SetSinglePrecisionPA()
+   bool pa_sp_built = false;      ///< True if AssemblePA() set up pa_sp
+   SinglePrecisionPAData pa_sp;   ///< Used if pa_sp_built is true
 
    // CEED extension
    CeedData* ceedDataPtr;
 
+   // Partial assembly on NURBS spaces, see NURBSDofToQuad
+   void AssemblePANURBS(const FiniteElementSpace &fes,
+                        const IntegrationRule &ir);
+   void AddMultPANURBS(const Vector &x, Vector &y) const;
+   void AssembleDiagonalPANURBS(Vector &diag) const;
+
 public:
    MassIntegrator(const IntegrationRule *ir = NULL)
       : BilinearFormIntegrator(ir), Q(NULL), maps(NULL), geom(NULL),
-        ceedDataPtr(NULL) { }
+        nurbs_maps(NULL), ceedDataPtr(NULL) { }
 
    /// Construct a mass integrator with coefficient q
    MassIntegrator(Coefficient &q, const IntegrationRule *ir = NULL)
       : BilinearFormIntegrator(ir), Q(&q), maps(NULL), geom(NULL),
-        ceedDataPtr(NULL) { }
+        nurbs_maps(NULL), ceedDataPtr(NULL) { }
 
    virtual ~MassIntegrator()
    {
+      delete nurbs_maps;
       delete ceedDataPtr;
    }
    /** Given a particular Finite Element computes the element mass matrix
@@ -2040,12 +2223,28 @@ public:
                                        ElementTransformation &Trans,
                                        DenseMatrix &elmat);
 
+   /** @brief Store the partially assembled data and the 1D basis tables in
+       single precision, see SinglePrecisionPAData. */
+   /** Takes effect at the next AssemblePA(); until then, the data assembled
+       before is used. The action still accumulates in double precision, but
+       its relative accuracy is only ~1e-7. The option is ignored on NURBS
+       spaces and with libCEED; the element and full assembly levels always
+       use double precision. The 3D SIMD host kernels are double precision
+       only, so the option mainly benefits bandwidth bound devices. */
+   void SetSinglePrecisionPA(bool single = true) { single_pa = single; }
+
+   /// Return true if SetSinglePrecisionPA() was enabled.
+   bool GetSinglePrecisionPA() const { return single_pa; }
+
    using BilinearFormIntegrator::AssemblePA;
 
    virtual void AssembleMF(const FiniteElementSpace &fes);
 
    virtual void AssemblePA(const FiniteElementSpace &fes);
 
+   virtual bool SupportsAssemblyLevel(AssemblyLevel level,
+                                      const FiniteElementSpace &fes) const;
+
    virtual void AssembleEA(const FiniteElementSpace &fes, Vector &emat,
                            const bool add);
 
@@ -2087,6 +2286,7 @@ protected:
    const DofToQuad *maps;         ///< Not owned
    const GeometricFactors *geom;  ///< Not owned
    int dim, ne, nq, dofs1D, quad1D;
+   bool fused_faces; ///< See SetFusedFaces()
 
 private:
 #ifndef MFEM_THREAD_SAFE
@@ -2096,7 +2296,7 @@ private:
 
 public:
    ConvectionIntegrator(VectorCoefficient &q, double a = 1.0)
-      : Q(&q) { alpha = a; }
+      : Q(&q), fused_faces(false) { alpha = a; }
    virtual void AssembleElementMatrix(const FiniteElement &,
                                       ElementTransformation &,
                                       DenseMatrix &);
@@ -2105,11 +2305,46 @@ public:
 
    virtual void AssemblePA(const FiniteElementSpace&);
 
+   virtual bool SupportsAssemblyLevel(AssemblyLevel level,
+                                      const FiniteElementSpace &fes) const;
+
    virtual void AssembleEA(const FiniteElementSpace &fes, Vector &emat,
                            const bool add);
 
    virtual void AddMultPA(const Vector&, Vector&) const;
 
+   virtual void AddMultTransposePA(const Vector&, Vector&) const;
+
+   /** @brief Add the action of this integrator and of the DG face terms
+       @a terms in a single pass over the elements. */
+   /** Both @a x and @a y are L-vectors of an L2 space with vdim = 1, for which
+       the element restriction is the identity. The face values of term k are
+       read with the indices of the double-valued face restriction
+       @a restr[k]. For each element, @a elem_faces lists 2*dim face entries,
+       either -1 or 4*f + 2*side + k, where f is a face of term k and side (0
+       or 1) is the side of the element in f. Each element adds its own part
+       of the face terms, so the face fluxes are evaluated on both sides of
+       the faces, but the result is written without atomic operations.
+
+       This method can be called only after AssemblePA() and the face
+       assembly of the terms. At most two terms are supported, with the same
+       basis and quadrature points. */
+   void AddMultPAFusedFaces(int nterms, const PAFaceTerm *terms,
+                            const L2FaceRestriction *const *restr,
+                            const Array<int> &elem_faces,
+                            const Vector &x, Vector &y) const;
+
+   /** @brief Select whether a partially assembled form with this integrator
+       and DG face terms applies them with AddMultPAFusedFaces() in its
+       Mult(). */
+   /** The default is false. On a single CPU core, evaluating the face terms on
+       both sides of the faces costs about as much as the separate face pass
+       saves. */
+   void SetFusedFaces(bool fuse) { fused_faces = fuse; }
+
+   /// Return true if AddMultPAFusedFaces() is used, see SetFusedFaces().
+   bool UseFusedFaces() const { return fused_faces; }
+
    static const IntegrationRule &GetRule(const FiniteElement &el,
                                          ElementTransformation &Trans);
 
@@ -2200,6 +2435,8 @@ public:
                                        DenseMatrix &elmat);
    using BilinearFormIntegrator::AssemblePA;
    virtual void AssemblePA(const FiniteElementSpace &fes);
+   virtual bool SupportsAssemblyLevel(AssemblyLevel level,
+                                      const FiniteElementSpace &fes) const;
    virtual void AssembleMF(const FiniteElementSpace &fes);
    virtual void AssembleDiagonalPA(Vector &diag);
    virtual void AssembleDiagonalMF(Vector &diag);
@@ -2603,6 +2840,8 @@ public:
                                       const Vector &elfun, Vector &elvect);
    using BilinearFormIntegrator::AssemblePA;
    virtual void AssemblePA(const FiniteElementSpace &fes);
+   virtual bool SupportsAssemblyLevel(AssemblyLevel level,
+                                      const FiniteElementSpace &fes) const;
    virtual void AssembleMF(const FiniteElementSpace &fes);
    virtual void AssembleDiagonalPA(Vector &diag);
    virtual void AssembleDiagonalMF(Vector &diag);
@@ -2716,6 +2955,23 @@ public:
 
    virtual void AddMultPA(const Vector&, Vector&) const;
 
+   virtual bool SupportsAssemblyLevel(AssemblyLevel level,
+                                      const FiniteElementSpace &fes) const;
+
+   virtual bool SupportsPAFused() const { return true; }
+
+   /** Fuses L2FaceRestriction::Mult(), AddMultPA() and
+       L2FaceRestriction::MultTranspose() in one pass over the faces, which
+       accumulates the face contributions in @a y with AtomicAdd(). The face
+       restriction @a restr must be double-valued. */
+   virtual void AddMultPAFused(const L2FaceRestriction &restr,
+                               const Vector &x, Vector &y) const;
+
+   virtual void AddMultTransposePAFused(const L2FaceRestriction &restr,
+                                        const Vector &x, Vector &y) const;
+
+   virtual bool GetPAFaceTerm(PAFaceTerm &term) const;
+
    virtual void AssembleEAInteriorFaces(const FiniteElementSpace& fes,
                                         Vector &ea_data_int,
                                         Vector &ea_data_ext,
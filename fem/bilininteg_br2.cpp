@@ -58,8 +58,12 @@ DGDiffusionBR2Integrator::DGDiffusionBR2Integrator(FiniteElementSpace *fes,
    Minv.SetSize(Minv_offsets[nel]);
    ipiv.SetSize(ipiv_offsets[nel]);
 
-   // Assemble the local mass matrices and compute LU factorization
+   // Assemble the local mass matrices, then compute their LU factorizations
+   // in batches of matrices of the same size
    MassIntegrator mi;
+   Array<int> sizes(nel);
+   Array<double*> Minv_data(nel);
+   Array<int*> ipiv_data(nel);
    for (int i=0; i<nel; ++i)
    {
       const FiniteElement *fe = NULL;
@@ -82,9 +86,11 @@ DGDiffusionBR2Integrator::DGDiffusionBR2Integrator(FiniteElementSpace *fes,
       int *ipiv_el = &ipiv[ipiv_offsets[i]];
       DenseMatrix Me(Minv_el, dof, dof);
       mi.AssembleElementMatrix(*fe, *tr, Me);
-      LUFactors lu(Minv_el, ipiv_el);
-      lu.Factor(dof);
+      sizes[i] = dof;
+      Minv_data[i] = Minv_el;
+      ipiv_data[i] = ipiv_el;
    }
+   BatchLUFactor(sizes, Minv_data, ipiv_data);
 }
 
 void DGDiffusionBR2Integrator::AssembleFaceMatrix(
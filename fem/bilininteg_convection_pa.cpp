@@ -12,6 +12,7 @@
 #include "../general/forall.hpp"
 #include "bilininteg.hpp"
 #include "gridfunc.hpp"
+#include "restriction.hpp"
 
 using namespace std;
 
@@ -876,4 +877,735 @@ void ConvectionIntegrator::AddMultPA(const Vector &x, Vector &y) const
                      pa_data, x, y);
 }
 
+// PA Convection Apply Transpose 2D kernel
+template<int T_D1D = 0, int T_Q1D = 0> static
+void PAConvectionApplyT2D(const int ne,
+                          const Array<double> &b,
+                          const Array<double> &bt,
+                          const Array<double> &gt,
+                          const Vector &_op,
+                          const Vector &_x,
+                          Vector &_y,
+                          const int d1d = 0,
+                          const int q1d = 0)
+{
+   const int NE = ne;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt.Read(), D1D, Q1D);
+   auto op = Reshape(_op.Read(), Q1D, Q1D, 2, NE);
+   auto x = Reshape(_x.Read(), D1D, D1D, NE);
+   auto y = Reshape(_y.ReadWrite(), D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+
+      double Bu[max_D1D][max_Q1D];
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            Bu[dy][qx] = 0.0;
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               Bu[dy][qx] += B(qx,dx) * x(dx,dy,e);
+            }
+         }
+      }
+      // the velocity times the values at the quadrature points
+      double DBu[2][max_Q1D][max_Q1D];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            double BBu = 0.0;
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               BBu += B(qy,dy) * Bu[dy][qx];
+            }
+            DBu[0][qy][qx] = op(qx,qy,0,e) * BBu;
+            DBu[1][qy][qx] = op(qx,qy,1,e) * BBu;
+         }
+      }
+      // apply the transposed gradient
+      double GDBu[max_Q1D][max_D1D];
+      double BDBu[max_Q1D][max_D1D];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            GDBu[qy][dx] = 0.0;
+            BDBu[qy][dx] = 0.0;
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               GDBu[qy][dx] += Gt(dx,qx) * DBu[0][qy][qx];
+               BDBu[qy][dx] += Bt(dx,qx) * DBu[1][qy][qx];
+            }
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            double GtDBu = 0.0;
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               GtDBu += Bt(dy,qy) * GDBu[qy][dx] + Gt(dy,qy) * BDBu[qy][dx];
+            }
+            y(dx,dy,e) += GtDBu;
+         }
+      }
+   });
+}
+
+// PA Convection Apply Transpose 3D kernel
+template<int T_D1D = 0, int T_Q1D = 0> static
+void PAConvectionApplyT3D(const int ne,
+                          const Array<double> &b,
+                          const Array<double> &bt,
+                          const Array<double> &gt,
+                          const Vector &_op,
+                          const Vector &_x,
+                          Vector &_y,
+                          const int d1d = 0,
+                          const int q1d = 0)
+{
+   const int NE = ne;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt.Read(), D1D, Q1D);
+   auto op = Reshape(_op.Read(), Q1D, Q1D, Q1D, 3, NE);
+   auto x = Reshape(_x.Read(), D1D, D1D, D1D, NE);
+   auto y = Reshape(_y.ReadWrite(), D1D, D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+
+      double Bu[max_D1D][max_D1D][max_Q1D];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               Bu[dz][dy][qx] = 0.0;
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  Bu[dz][dy][qx] += B(qx,dx) * x(dx,dy,dz,e);
+               }
+            }
+         }
+      }
+      double BBu[max_D1D][max_Q1D][max_Q1D];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               BBu[dz][qy][qx] = 0.0;
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  BBu[dz][qy][qx] += B(qy,dy) * Bu[dz][dy][qx];
+               }
+            }
+         }
+      }
+      // the velocity times the values at the quadrature points
+      double DBu[3][max_Q1D][max_Q1D][max_Q1D];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               double BBBu = 0.0;
+               for (int dz = 0; dz < D1D; ++dz)
+               {
+                  BBBu += B(qz,dz) * BBu[dz][qy][qx];
+               }
+               for (int c = 0; c < 3; ++c)
+               {
+                  DBu[c][qz][qy][qx] = op(qx,qy,qz,c,e) * BBBu;
+               }
+            }
+         }
+      }
+      // apply the transposed gradient, one direction at a time
+      double X[3][max_Q1D][max_Q1D][max_D1D];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               X[0][qz][qy][dx] = 0.0;
+               X[1][qz][qy][dx] = 0.0;
+               X[2][qz][qy][dx] = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  X[0][qz][qy][dx] += Gt(dx,qx) * DBu[0][qz][qy][qx];
+                  X[1][qz][qy][dx] += Bt(dx,qx) * DBu[1][qz][qy][qx];
+                  X[2][qz][qy][dx] += Bt(dx,qx) * DBu[2][qz][qy][qx];
+               }
+            }
+         }
+      }
+      // Y[0] is followed by Bt in z, Y[1] by Gt in z
+      double Y[2][max_Q1D][max_D1D][max_D1D];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               Y[0][qz][dy][dx] = 0.0;
+               Y[1][qz][dy][dx] = 0.0;
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  Y[0][qz][dy][dx] += Bt(dy,qy) * X[0][qz][qy][dx] +
+                                      Gt(dy,qy) * X[1][qz][qy][dx];
+                  Y[1][qz][dy][dx] += Bt(dy,qy) * X[2][qz][qy][dx];
+               }
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double GtDBu = 0.0;
+               for (int qz = 0; qz < Q1D; ++qz)
+               {
+                  GtDBu += Bt(dz,qz) * Y[0][qz][dy][dx] +
+                           Gt(dz,qz) * Y[1][qz][dy][dx];
+               }
+               y(dx,dy,dz,e) += GtDBu;
+            }
+         }
+      }
+   });
+}
+
+static void PAConvectionApplyTranspose(const int dim,
+                                       const int D1D,
+                                       const int Q1D,
+                                       const int NE,
+                                       const Array<double> &B,
+                                       const Array<double> &Bt,
+                                       const Array<double> &Gt,
+                                       const Vector &op,
+                                       const Vector &x,
+                                       Vector &y)
+{
+   if (dim == 2)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x22: return PAConvectionApplyT2D<2,2>(NE,B,Bt,Gt,op,x,y);
+         case 0x33: return PAConvectionApplyT2D<3,3>(NE,B,Bt,Gt,op,x,y);
+         case 0x44: return PAConvectionApplyT2D<4,4>(NE,B,Bt,Gt,op,x,y);
+         case 0x55: return PAConvectionApplyT2D<5,5>(NE,B,Bt,Gt,op,x,y);
+         case 0x66: return PAConvectionApplyT2D<6,6>(NE,B,Bt,Gt,op,x,y);
+         default:   return PAConvectionApplyT2D(NE,B,Bt,Gt,op,x,y,D1D,Q1D);
+      }
+   }
+   else if (dim == 3)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x23: return PAConvectionApplyT3D<2,3>(NE,B,Bt,Gt,op,x,y);
+         case 0x34: return PAConvectionApplyT3D<3,4>(NE,B,Bt,Gt,op,x,y);
+         case 0x45: return PAConvectionApplyT3D<4,5>(NE,B,Bt,Gt,op,x,y);
+         case 0x56: return PAConvectionApplyT3D<5,6>(NE,B,Bt,Gt,op,x,y);
+         default:   return PAConvectionApplyT3D(NE,B,Bt,Gt,op,x,y,D1D,Q1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+// PA Convection Apply Transpose kernel
+void ConvectionIntegrator::AddMultTransposePA(const Vector &x, Vector &y) const
+{
+   PAConvectionApplyTranspose(dim, dofs1D, quad1D, ne,
+                              maps->B, maps->Bt, maps->Gt, pa_data, x, y);
+}
+
+// Add the action of the convection operator on one 2D element to y, where op
+// holds the Q1D x Q1D x 2 quadrature data of the element.
+template<int MD1, int MQ1> MFEM_HOST_DEVICE inline
+void PAConvectionAddElement2D(const int D1D, const int Q1D,
+                              const double *B, const double *G,
+                              const double *op, const double *x, double *y)
+{
+   double Bu[MD1*MQ1], Gu[MD1*MQ1], DGu[MQ1*MQ1];
+   for (int dy = 0; dy < D1D; ++dy)
+   {
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         double bu = 0.0, gu = 0.0;
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            const double u = x[dx + D1D*dy];
+            bu += B[qx + Q1D*dx] * u;
+            gu += G[qx + Q1D*dx] * u;
+         }
+         Bu[qx + Q1D*dy] = bu;
+         Gu[qx + Q1D*dy] = gu;
+      }
+   }
+   for (int qy = 0; qy < Q1D; ++qy)
+   {
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         double gradX = 0.0, gradY = 0.0;
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            gradX += B[qy + Q1D*dy] * Gu[qx + Q1D*dy];
+            gradY += G[qy + Q1D*dy] * Bu[qx + Q1D*dy];
+         }
+         const int q = qx + Q1D*qy;
+         DGu[q] = op[q] * gradX + op[q + Q1D*Q1D] * gradY;
+      }
+   }
+   // Bu now holds B^T DGu in y
+   for (int dy = 0; dy < D1D; ++dy)
+   {
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         double s = 0.0;
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            s += B[qy + Q1D*dy] * DGu[qx + Q1D*qy];
+         }
+         Bu[qx + Q1D*dy] = s;
+      }
+   }
+   for (int dy = 0; dy < D1D; ++dy)
+   {
+      for (int dx = 0; dx < D1D; ++dx)
+      {
+         double s = 0.0;
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            s += B[qx + Q1D*dx] * Bu[qx + Q1D*dy];
+         }
+         y[dx + D1D*dy] += s;
+      }
+   }
+}
+
+// Add the action of the convection operator on one 3D element to y, where op
+// holds the Q1D x Q1D x Q1D x 3 quadrature data of the element.
+template<int MD1, int MQ1> MFEM_HOST_DEVICE inline
+void PAConvectionAddElement3D(const int D1D, const int Q1D,
+                              const double *B, const double *G,
+                              const double *op, const double *x, double *y)
+{
+   double Bu[MD1*MD1*MQ1], Gu[MD1*MD1*MQ1];
+   double BBu[MD1*MQ1*MQ1], GBu[MD1*MQ1*MQ1], BGu[MD1*MQ1*MQ1];
+   double DGu[MQ1*MQ1*MQ1];
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            double bu = 0.0, gu = 0.0;
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double u = x[dx + D1D*(dy + D1D*dz)];
+               bu += B[qx + Q1D*dx] * u;
+               gu += G[qx + Q1D*dx] * u;
+            }
+            Bu[qx + Q1D*(dy + D1D*dz)] = bu;
+            Gu[qx + Q1D*(dy + D1D*dz)] = gu;
+         }
+      }
+   }
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            double bbu = 0.0, gbu = 0.0, bgu = 0.0;
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const double b = B[qy + Q1D*dy], g = G[qy + Q1D*dy];
+               bbu += b * Bu[qx + Q1D*(dy + D1D*dz)];
+               gbu += g * Bu[qx + Q1D*(dy + D1D*dz)];
+               bgu += b * Gu[qx + Q1D*(dy + D1D*dz)];
+            }
+            BBu[qx + Q1D*(qy + Q1D*dz)] = bbu;
+            GBu[qx + Q1D*(qy + Q1D*dz)] = gbu;
+            BGu[qx + Q1D*(qy + Q1D*dz)] = bgu;
+         }
+      }
+   }
+   const int Q3D = Q1D*Q1D*Q1D;
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            double gradX = 0.0, gradY = 0.0, gradZ = 0.0;
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               const double b = B[qz + Q1D*dz];
+               gradX += b * BGu[qx + Q1D*(qy + Q1D*dz)];
+               gradY += b * GBu[qx + Q1D*(qy + Q1D*dz)];
+               gradZ += G[qz + Q1D*dz] * BBu[qx + Q1D*(qy + Q1D*dz)];
+            }
+            const int q = qx + Q1D*(qy + Q1D*qz);
+            DGu[q] = op[q] * gradX + op[q + Q3D] * gradY + op[q + 2*Q3D] * gradZ;
+         }
+      }
+   }
+   // BBu now holds B^T DGu in z, and Bu holds B^T B^T DGu in z and y
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            double s = 0.0;
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               s += B[qz + Q1D*dz] * DGu[qx + Q1D*(qy + Q1D*qz)];
+            }
+            BBu[qx + Q1D*(qy + Q1D*dz)] = s;
+         }
+      }
+   }
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            double s = 0.0;
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               s += B[qy + Q1D*dy] * BBu[qx + Q1D*(qy + Q1D*dz)];
+            }
+            Bu[qx + Q1D*(dy + D1D*dz)] = s;
+         }
+      }
+   }
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            double s = 0.0;
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               s += B[qx + Q1D*dx] * Bu[qx + Q1D*(dy + D1D*dz)];
+            }
+            y[dx + D1D*(dy + D1D*dz)] += s;
+         }
+      }
+   }
+}
+
+// Value at the face quadrature point q of the result of a PAFaceTerm on the
+// side 'side' of the face, given the values u0 and u1 of both sides at q and
+// the 2x2 blocks op of the face, op(q,i,j) = op[q + NQ*(i + 2*j)].
+MFEM_HOST_DEVICE inline
+double PAFaceTermValue(const int NQ, const int q, const double *op,
+                       const int side, const bool transpose,
+                       const double u0, const double u1)
+{
+   if (transpose)
+   {
+      return op[q + NQ*side] * u0 + op[q + NQ*(side + 2)] * u1;
+   }
+   const double Du = op[q] * u0 + op[q + NQ] * u1;
+   return side == 0 ? Du : -Du;
+}
+
+// Add to y the part of a PAFaceTerm on the side 'side' of a 2D face, where
+// i0 and i1 are the indices of the face dofs of both sides in x and y (-1 for
+// a missing neighbor).
+template<int MD1, int MQ1> MFEM_HOST_DEVICE inline
+void PAFaceTermAddSide2D(const int D1D, const int Q1D, const double *B,
+                         const double *op, const int *i0, const int *i1,
+                         const int side, const bool transpose,
+                         const double *x, double *y)
+{
+   double u0[MD1], u1[MD1], Du[MQ1];
+   for (int d = 0; d < D1D; ++d)
+   {
+      u0[d] = x[i0[d]];
+      u1[d] = i1[d] < 0 ? 0.0 : x[i1[d]];
+   }
+   for (int q = 0; q < Q1D; ++q)
+   {
+      double Bu0 = 0.0, Bu1 = 0.0;
+      for (int d = 0; d < D1D; ++d)
+      {
+         Bu0 += B[q + Q1D*d] * u0[d];
+         Bu1 += B[q + Q1D*d] * u1[d];
+      }
+      Du[q] = PAFaceTermValue(Q1D, q, op, side, transpose, Bu0, Bu1);
+   }
+   const int *is = side == 0 ? i0 : i1;
+   for (int d = 0; d < D1D; ++d)
+   {
+      double s = 0.0;
+      for (int q = 0; q < Q1D; ++q)
+      {
+         s += B[q + Q1D*d] * Du[q];
+      }
+      y[is[d]] += s;
+   }
+}
+
+// Add to y the part of a PAFaceTerm on the side 'side' of a 3D face, see
+// PAFaceTermAddSide2D().
+template<int MD1, int MQ1> MFEM_HOST_DEVICE inline
+void PAFaceTermAddSide3D(const int D1D, const int Q1D, const double *B,
+                         const double *op, const int *i0, const int *i1,
+                         const int side, const bool transpose,
+                         const double *x, double *y)
+{
+   double u0[MD1*MD1], u1[MD1*MD1];
+   double Bu0[MQ1*MD1], Bu1[MQ1*MD1], Du[MQ1*MQ1];
+   for (int d = 0; d < D1D*D1D; ++d)
+   {
+      u0[d] = x[i0[d]];
+      u1[d] = i1[d] < 0 ? 0.0 : x[i1[d]];
+   }
+   for (int d2 = 0; d2 < D1D; ++d2)
+   {
+      for (int q1 = 0; q1 < Q1D; ++q1)
+      {
+         double b0 = 0.0, b1 = 0.0;
+         for (int d1 = 0; d1 < D1D; ++d1)
+         {
+            b0 += B[q1 + Q1D*d1] * u0[d1 + D1D*d2];
+            b1 += B[q1 + Q1D*d1] * u1[d1 + D1D*d2];
+         }
+         Bu0[q1 + Q1D*d2] = b0;
+         Bu1[q1 + Q1D*d2] = b1;
+      }
+   }
+   for (int q2 = 0; q2 < Q1D; ++q2)
+   {
+      for (int q1 = 0; q1 < Q1D; ++q1)
+      {
+         double v0 = 0.0, v1 = 0.0;
+         for (int d2 = 0; d2 < D1D; ++d2)
+         {
+            v0 += B[q2 + Q1D*d2] * Bu0[q1 + Q1D*d2];
+            v1 += B[q2 + Q1D*d2] * Bu1[q1 + Q1D*d2];
+         }
+         const int q = q1 + Q1D*q2;
+         Du[q] = PAFaceTermValue(Q1D*Q1D, q, op, side, transpose, v0, v1);
+      }
+   }
+   // Bu0 now holds B^T Du in the second direction
+   for (int d2 = 0; d2 < D1D; ++d2)
+   {
+      for (int q1 = 0; q1 < Q1D; ++q1)
+      {
+         double s = 0.0;
+         for (int q2 = 0; q2 < Q1D; ++q2)
+         {
+            s += B[q2 + Q1D*d2] * Du[q1 + Q1D*q2];
+         }
+         Bu0[q1 + Q1D*d2] = s;
+      }
+   }
+   const int *is = side == 0 ? i0 : i1;
+   for (int d2 = 0; d2 < D1D; ++d2)
+   {
+      for (int d1 = 0; d1 < D1D; ++d1)
+      {
+         double s = 0.0;
+         for (int q1 = 0; q1 < Q1D; ++q1)
+         {
+            s += B[q1 + Q1D*d1] * Bu0[q1 + Q1D*d2];
+         }
+         y[is[d1 + D1D*d2]] += s;
+      }
+   }
+}
+
+// PA Convection Apply kernel fused with face terms, see
+// ConvectionIntegrator::AddMultPAFusedFaces()
+template<int T_DIM, int T_D1D = 0, int T_Q1D = 0, int T_QF1D = 0> static
+void PAConvectionApplyFusedFaces(const int NE,
+                                 const Array<double> &b,
+                                 const Array<double> &g,
+                                 const Vector &_op,
+                                 const Array<double> &bf,
+                                 const Array<int> &elem_faces,
+                                 const Vector *const *fop,
+                                 const Array<int> *const *fidx,
+                                 const bool *ftr,
+                                 const Vector &x,
+                                 Vector &y,
+                                 const int d1d = 0,
+                                 const int q1d = 0,
+                                 const int qf1d = 0)
+{
+   constexpr int DIM = T_DIM;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const int QF1D = T_QF1D ? T_QF1D : qf1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   MFEM_VERIFY(QF1D <= MAX_Q1D, "");
+   const int ND = DIM == 2 ? D1D*D1D : D1D*D1D*D1D;
+   const int NQ = DIM == 2 ? Q1D*Q1D : Q1D*Q1D*Q1D;
+   const int NDF = DIM == 2 ? D1D : D1D*D1D;
+   const int NQF = DIM == 2 ? QF1D : QF1D*QF1D;
+   auto B = b.Read();
+   auto G = g.Read();
+   auto op = _op.Read();
+   auto BF = bf.Read();
+   auto EF = elem_faces.Read();
+   // a missing term has no faces in elem_faces
+   const double *FOP0 = fop[0] ? fop[0]->Read() : nullptr;
+   const double *FOP1 = fop[1] ? fop[1]->Read() : nullptr;
+   const int *I00 = fop[0] ? fidx[0]->Read() : nullptr;
+   const int *I01 = fop[0] ? fidx[1]->Read() : nullptr;
+   const int *I10 = fop[1] ? fidx[2]->Read() : nullptr;
+   const int *I11 = fop[1] ? fidx[3]->Read() : nullptr;
+   const bool TR0 = ftr[0], TR1 = ftr[1];
+   auto X = x.Read();
+   auto Y = y.ReadWrite();
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      const int QF1D = T_QF1D ? T_QF1D : qf1d;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      constexpr int MQF = T_QF1D ? T_QF1D : MAX_Q1D;
+      if (DIM == 2)
+      {
+         PAConvectionAddElement2D<MD1,MQ1>(D1D, Q1D, B, G, op + 2*NQ*e,
+                                           X + ND*e, Y + ND*e);
+      }
+      else
+      {
+         PAConvectionAddElement3D<MD1,MQ1>(D1D, Q1D, B, G, op + 3*NQ*e,
+                                           X + ND*e, Y + ND*e);
+      }
+      for (int j = 0; j < 2*DIM; ++j)
+      {
+         const int code = EF[j + 2*DIM*e];
+         if (code < 0) { continue; }
+         const int k = code & 1, side = (code >> 1) & 1, f = code >> 2;
+         const double *fo = (k == 0 ? FOP0 : FOP1) + 4*NQF*f;
+         const int *i0 = (k == 0 ? I00 : I10) + NDF*f;
+         const int *i1 = (k == 0 ? I01 : I11) + NDF*f;
+         const bool tr = k == 0 ? TR0 : TR1;
+         if (DIM == 2)
+         {
+            PAFaceTermAddSide2D<MD1,MQF>(D1D, QF1D, BF, fo, i0, i1, side, tr,
+                                         X, Y);
+         }
+         else
+         {
+            PAFaceTermAddSide3D<MD1,MQF>(D1D, QF1D, BF, fo, i0, i1, side, tr,
+                                         X, Y);
+         }
+      }
+   });
+}
+
+void ConvectionIntegrator::AddMultPAFusedFaces(
+   int nterms, const PAFaceTerm *terms,
+   const L2FaceRestriction *const *restr,
+   const Array<int> &elem_faces, const Vector &x, Vector &y) const
+{
+   MFEM_VERIFY(nterms <= 2, "at most two face terms are supported");
+   const Vector *fop[2] = { nullptr, nullptr };
+   const Array<int> *fidx[4] = { nullptr, nullptr, nullptr, nullptr };
+   bool ftr[2] = { false, false };
+   const DofToQuad *fmaps = nullptr;
+   for (int k = 0; k < nterms; k++)
+   {
+      if (terms[k].nf == 0) { continue; }
+      MFEM_VERIFY(fmaps == nullptr || (terms[k].maps->ndof == fmaps->ndof &&
+                                       terms[k].maps->nqpt == fmaps->nqpt),
+                  "the face terms use different bases");
+      fmaps = terms[k].maps;
+      fop[k] = terms[k].op;
+      fidx[2*k] = &restr[k]->GetScatterIndices(0);
+      fidx[2*k+1] = &restr[k]->GetScatterIndices(1);
+      ftr[k] = terms[k].transpose;
+   }
+   // without face terms, any basis can be passed, it is not used
+   const DofToQuad &fm = fmaps ? *fmaps : *maps;
+   MFEM_VERIFY(fm.ndof == dofs1D, "the face terms use a different basis");
+   const int D1D = dofs1D, Q1D = quad1D, QF1D = fm.nqpt;
+   const Array<double> &B = maps->B, &G = maps->G, &BF = fm.B;
+   if (dim == 2)
+   {
+      if (QF1D == Q1D)
+      {
+         switch ((D1D << 4 ) | Q1D)
+         {
+            case 0x22: return PAConvectionApplyFusedFaces<2,2,2,2>(
+                                 ne,B,G,pa_data,BF,elem_faces,fop,fidx,ftr,x,y);
+            case 0x33: return PAConvectionApplyFusedFaces<2,3,3,3>(
+                                 ne,B,G,pa_data,BF,elem_faces,fop,fidx,ftr,x,y);
+            case 0x44: return PAConvectionApplyFusedFaces<2,4,4,4>(
+                                 ne,B,G,pa_data,BF,elem_faces,fop,fidx,ftr,x,y);
+            case 0x55: return PAConvectionApplyFusedFaces<2,5,5,5>(
+                                 ne,B,G,pa_data,BF,elem_faces,fop,fidx,ftr,x,y);
+            case 0x66: return PAConvectionApplyFusedFaces<2,6,6,6>(
+                                 ne,B,G,pa_data,BF,elem_faces,fop,fidx,ftr,x,y);
+         }
+      }
+      return PAConvectionApplyFusedFaces<2>(ne,B,G,pa_data,BF,elem_faces,
+                                            fop,fidx,ftr,x,y,D1D,Q1D,QF1D);
+   }
+   else if (dim == 3)
+   {
+      if (QF1D == Q1D)
+      {
+         switch ((D1D << 4 ) | Q1D)
+         {
+            case 0x23: return PAConvectionApplyFusedFaces<3,2,3,3>(
+                                 ne,B,G,pa_data,BF,elem_faces,fop,fidx,ftr,x,y);
+            case 0x34: return PAConvectionApplyFusedFaces<3,3,4,4>(
+                                 ne,B,G,pa_data,BF,elem_faces,fop,fidx,ftr,x,y);
+            case 0x45: return PAConvectionApplyFusedFaces<3,4,5,5>(
+                                 ne,B,G,pa_data,BF,elem_faces,fop,fidx,ftr,x,y);
+            case 0x56: return PAConvectionApplyFusedFaces<3,5,6,6>(
+                                 ne,B,G,pa_data,BF,elem_faces,fop,fidx,ftr,x,y);
+         }
+      }
+      return PAConvectionApplyFusedFaces<3>(ne,B,G,pa_data,BF,elem_faces,
+                                            fop,fidx,ftr,x,y,D1D,Q1D,QF1D);
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
 } // namespace mfem
@@ -1144,4 +1144,282 @@ void DGTraceIntegrator::AddMultTransposePA(const Vector &x, Vector &y) const
                            pa_data, x, y);
 }
 
+// Fused PA DGTrace Apply (or Apply Transpose, if TRANSPOSE is true) 2D kernel
+// on L-vectors for Gauss-Lobatto/Bernstein
+template<bool TRANSPOSE, int T_D1D = 0, int T_Q1D = 0> static
+void PADGTraceApplyFused2D(const int NF,
+                           const Array<double> &b,
+                           const Array<double> &bt,
+                           const Vector &_op,
+                           const Array<int> &indices1,
+                           const Array<int> &indices2,
+                           const Vector &_x,
+                           Vector &_y,
+                           const int d1d = 0,
+                           const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt.Read(), D1D, Q1D);
+   auto op = Reshape(_op.Read(), Q1D, 2, 2, NF);
+   auto idx1 = Reshape(indices1.Read(), D1D, NF);
+   auto idx2 = Reshape(indices2.Read(), D1D, NF);
+   auto x = _x.Read();
+   auto y = _y.ReadWrite();
+
+   MFEM_FORALL(f, NF,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      double u0[max_D1D];
+      double u1[max_D1D];
+      for (int d = 0; d < D1D; d++)
+      {
+         const int i2 = idx2(d,f);
+         u0[d] = x[idx1(d,f)];
+         u1[d] = i2 < 0 ? 0.0 : x[i2];
+      }
+      double DBu0[max_Q1D];
+      double DBu1[max_Q1D];
+      for (int q = 0; q < Q1D; ++q)
+      {
+         double Bu0 = 0.0, Bu1 = 0.0;
+         for (int d = 0; d < D1D; ++d)
+         {
+            const double b = B(q,d);
+            Bu0 += b*u0[d];
+            Bu1 += b*u1[d];
+         }
+         if (TRANSPOSE)
+         {
+            DBu0[q] = op(q,0,0,f)*Bu0 + op(q,0,1,f)*Bu1;
+            DBu1[q] = op(q,1,0,f)*Bu0 + op(q,1,1,f)*Bu1;
+         }
+         else
+         {
+            DBu0[q] = op(q,0,0,f)*Bu0 + op(q,1,0,f)*Bu1;
+         }
+      }
+      for (int d = 0; d < D1D; ++d)
+      {
+         double BDBu0 = 0.0, BDBu1 = 0.0;
+         for (int q = 0; q < Q1D; ++q)
+         {
+            const double b = Bt(d,q);
+            BDBu0 += b*DBu0[q];
+            if (TRANSPOSE) { BDBu1 += b*DBu1[q]; }
+         }
+         if (!TRANSPOSE) { BDBu1 = -BDBu0; }
+         const int i2 = idx2(d,f);
+         AtomicAdd(y[idx1(d,f)], BDBu0);
+         if (i2 >= 0) { AtomicAdd(y[i2], BDBu1); }
+      }
+   });
+}
+
+// Fused PA DGTrace Apply (or Apply Transpose, if TRANSPOSE is true) 3D kernel
+// on L-vectors for Gauss-Lobatto/Bernstein
+template<bool TRANSPOSE, int T_D1D = 0, int T_Q1D = 0> static
+void PADGTraceApplyFused3D(const int NF,
+                           const Array<double> &b,
+                           const Array<double> &bt,
+                           const Vector &_op,
+                           const Array<int> &indices1,
+                           const Array<int> &indices2,
+                           const Vector &_x,
+                           Vector &_y,
+                           const int d1d = 0,
+                           const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt.Read(), D1D, Q1D);
+   auto op = Reshape(_op.Read(), Q1D, Q1D, 2, 2, NF);
+   auto idx1 = Reshape(indices1.Read(), D1D, D1D, NF);
+   auto idx2 = Reshape(indices2.Read(), D1D, D1D, NF);
+   auto x = _x.Read();
+   auto y = _y.ReadWrite();
+
+   MFEM_FORALL(f, NF,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      double u0[max_D1D][max_D1D];
+      double u1[max_D1D][max_D1D];
+      for (int d1 = 0; d1 < D1D; d1++)
+      {
+         for (int d2 = 0; d2 < D1D; d2++)
+         {
+            const int i2 = idx2(d1,d2,f);
+            u0[d1][d2] = x[idx1(d1,d2,f)];
+            u1[d1][d2] = i2 < 0 ? 0.0 : x[i2];
+         }
+      }
+      double Bu0[max_Q1D][max_D1D];
+      double Bu1[max_Q1D][max_D1D];
+      for (int q1 = 0; q1 < Q1D; ++q1)
+      {
+         for (int d2 = 0; d2 < D1D; d2++)
+         {
+            Bu0[q1][d2] = 0.0;
+            Bu1[q1][d2] = 0.0;
+            for (int d1 = 0; d1 < D1D; ++d1)
+            {
+               const double b = B(q1,d1);
+               Bu0[q1][d2] += b*u0[d1][d2];
+               Bu1[q1][d2] += b*u1[d1][d2];
+            }
+         }
+      }
+      double DBBu0[max_Q1D][max_Q1D];
+      double DBBu1[max_Q1D][max_Q1D];
+      for (int q1 = 0; q1 < Q1D; ++q1)
+      {
+         for (int q2 = 0; q2 < Q1D; q2++)
+         {
+            double BBu0 = 0.0, BBu1 = 0.0;
+            for (int d2 = 0; d2 < D1D; ++d2)
+            {
+               const double b = B(q2,d2);
+               BBu0 += b*Bu0[q1][d2];
+               BBu1 += b*Bu1[q1][d2];
+            }
+            if (TRANSPOSE)
+            {
+               DBBu0[q1][q2] = op(q1,q2,0,0,f)*BBu0 + op(q1,q2,0,1,f)*BBu1;
+               DBBu1[q1][q2] = op(q1,q2,1,0,f)*BBu0 + op(q1,q2,1,1,f)*BBu1;
+            }
+            else
+            {
+               DBBu0[q1][q2] = op(q1,q2,0,0,f)*BBu0 + op(q1,q2,1,0,f)*BBu1;
+            }
+         }
+      }
+      double BDBBu0[max_Q1D][max_D1D];
+      double BDBBu1[max_Q1D][max_D1D];
+      for (int q1 = 0; q1 < Q1D; ++q1)
+      {
+         for (int d2 = 0; d2 < D1D; d2++)
+         {
+            BDBBu0[q1][d2] = 0.0;
+            BDBBu1[q1][d2] = 0.0;
+            for (int q2 = 0; q2 < Q1D; ++q2)
+            {
+               const double b = Bt(d2,q2);
+               BDBBu0[q1][d2] += b*DBBu0[q1][q2];
+               if (TRANSPOSE) { BDBBu1[q1][d2] += b*DBBu1[q1][q2]; }
+            }
+         }
+      }
+      for (int d1 = 0; d1 < D1D; ++d1)
+      {
+         for (int d2 = 0; d2 < D1D; d2++)
+         {
+            double BBDBBu0 = 0.0, BBDBBu1 = 0.0;
+            for (int q1 = 0; q1 < Q1D; ++q1)
+            {
+               const double b = Bt(d1,q1);
+               BBDBBu0 += b*BDBBu0[q1][d2];
+               if (TRANSPOSE) { BBDBBu1 += b*BDBBu1[q1][d2]; }
+            }
+            if (!TRANSPOSE) { BBDBBu1 = -BBDBBu0; }
+            const int i2 = idx2(d1,d2,f);
+            AtomicAdd(y[idx1(d1,d2,f)], BBDBBu0);
+            if (i2 >= 0) { AtomicAdd(y[i2], BBDBBu1); }
+         }
+      }
+   });
+}
+
+template<bool T> static
+void PADGTraceApplyFused(const int dim,
+                         const int D1D,
+                         const int Q1D,
+                         const int NF,
+                         const Array<double> &B,
+                         const Array<double> &Bt,
+                         const Vector &op,
+                         const Array<int> &i1,
+                         const Array<int> &i2,
+                         const Vector &x,
+                         Vector &y)
+{
+   if (dim == 2)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x22: return PADGTraceApplyFused2D<T,2,2>(NF,B,Bt,op,i1,i2,x,y);
+         case 0x33: return PADGTraceApplyFused2D<T,3,3>(NF,B,Bt,op,i1,i2,x,y);
+         case 0x44: return PADGTraceApplyFused2D<T,4,4>(NF,B,Bt,op,i1,i2,x,y);
+         case 0x55: return PADGTraceApplyFused2D<T,5,5>(NF,B,Bt,op,i1,i2,x,y);
+         case 0x66: return PADGTraceApplyFused2D<T,6,6>(NF,B,Bt,op,i1,i2,x,y);
+         case 0x77: return PADGTraceApplyFused2D<T,7,7>(NF,B,Bt,op,i1,i2,x,y);
+         case 0x88: return PADGTraceApplyFused2D<T,8,8>(NF,B,Bt,op,i1,i2,x,y);
+         case 0x99: return PADGTraceApplyFused2D<T,9,9>(NF,B,Bt,op,i1,i2,x,y);
+         default: return PADGTraceApplyFused2D<T>(NF,B,Bt,op,i1,i2,x,y,
+                                                     D1D,Q1D);
+      }
+   }
+   else if (dim == 3)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x23: return PADGTraceApplyFused3D<T,2,3>(NF,B,Bt,op,i1,i2,x,y);
+         case 0x34: return PADGTraceApplyFused3D<T,3,4>(NF,B,Bt,op,i1,i2,x,y);
+         case 0x45: return PADGTraceApplyFused3D<T,4,5>(NF,B,Bt,op,i1,i2,x,y);
+         case 0x56: return PADGTraceApplyFused3D<T,5,6>(NF,B,Bt,op,i1,i2,x,y);
+         case 0x67: return PADGTraceApplyFused3D<T,6,7>(NF,B,Bt,op,i1,i2,x,y);
+         case 0x78: return PADGTraceApplyFused3D<T,7,8>(NF,B,Bt,op,i1,i2,x,y);
+         case 0x89: return PADGTraceApplyFused3D<T,8,9>(NF,B,Bt,op,i1,i2,x,y);
+         default: return PADGTraceApplyFused3D<T>(NF,B,Bt,op,i1,i2,x,y,
+                                                     D1D,Q1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+// PA DGTraceIntegrator fused Apply kernel on L-vectors
+void DGTraceIntegrator::AddMultPAFused(const L2FaceRestriction &restr,
+                                       const Vector &x, Vector &y) const
+{
+   if (nf == 0) { return; }
+   PADGTraceApplyFused<false>(dim, dofs1D, quad1D, nf,
+                              maps->B, maps->Bt, pa_data,
+                              restr.GetScatterIndices(0),
+                              restr.GetScatterIndices(1), x, y);
+}
+
+// PA DGTraceIntegrator fused Apply Transpose kernel on L-vectors
+void DGTraceIntegrator::AddMultTransposePAFused(const L2FaceRestriction &restr,
+                                                const Vector &x,
+                                                Vector &y) const
+{
+   if (nf == 0) { return; }
+   PADGTraceApplyFused<true>(dim, dofs1D, quad1D, nf,
+                             maps->B, maps->Bt, pa_data,
+                             restr.GetScatterIndices(0),
+                             restr.GetScatterIndices(1), x, y);
+}
+
+bool DGTraceIntegrator::GetPAFaceTerm(PAFaceTerm &term) const
+{
+   term.op = &pa_data;
+   term.maps = maps;
+   term.nf = nf;
+   term.transpose = false;
+   return true;
+}
+
 } // namespace mfem
@@ -10,6 +10,7 @@
 // CONTRIBUTING.md for details.
 
 #include "../general/forall.hpp"
+#include "../linalg/simd.hpp"
 #include "bilininteg.hpp"
 #include "gridfunc.hpp"
 #include "libceed/diffusion.hpp"
@@ -357,6 +358,9 @@ void DiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
    if (mesh->GetNE() == 0) { return; }
    const FiniteElement &el = *fes.GetFE(0);
    const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, el);
+   delete nurbs_maps;
+   nurbs_maps = NULL;
+   if (fes.GetNURBSext()) { return AssemblePANURBS(fes, *ir); }
    if (DeviceCanUseCeed())
    {
       delete ceedDataPtr;
@@ -475,21 +479,14 @@ void DiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
    }
    else
    {
-      coeff.SetSize(nq * ne);
-      auto C = Reshape(coeff.HostWrite(), nq, ne);
-      for (int e = 0; e < ne; ++e)
-      {
-         ElementTransformation& T = *fes.GetElementTransformation(e);
-         for (int q = 0; q < nq; ++q)
-         {
-            C(q,e) = Q->Eval(T, ir->IntPoint(q));
-         }
-      }
+      Q->EvalBatch(coeff, *mesh, *ir);
    }
    pa_data.SetSize((symmetric ? symmDims : MQfullDim) * nq * ne,
                    Device::GetDeviceMemoryType());
    PADiffusionSetup(dim, sdim, dofs1D, quad1D, coeffDim, ne, ir->GetWeights(),
                     geom->J, coeff, pa_data);
+   pa_sp_built = single_pa;
+   if (pa_sp_built) { pa_sp.Setup(pa_data, *maps, true); }
 }
 
 template<int T_D1D = 0, int T_Q1D = 0>
@@ -916,10 +913,21 @@ static void PADiffusionAssembleDiagonal(const int dim,
 
 void DiffusionIntegrator::AssembleDiagonalPA(Vector &diag)
 {
-   if (DeviceCanUseCeed())
+   if (nurbs_maps)
+   {
+      AssembleDiagonalPANURBS(diag);
+   }
+   else if (DeviceCanUseCeed())
    {
       CeedAssembleDiagonal(ceedDataPtr, diag);
    }
+   else if (pa_sp_built)
+   {
+      Vector d;
+      pa_sp.GetData(d);
+      PADiffusionAssembleDiagonal(dim, dofs1D, quad1D, ne, symmetric,
+                                  maps->B, maps->G, d, diag);
+   }
    else
    {
       if (pa_data.Size()==0) { AssemblePA(*fespace); }
@@ -1030,14 +1038,14 @@ static void OccaPADiffusionApply3D(const int D1D,
 #endif // MFEM_USE_OCCA
 
 // PA Diffusion Apply 2D kernel
-template<int T_D1D = 0, int T_Q1D = 0>
+template<int T_D1D = 0, int T_Q1D = 0, typename TB, typename TD>
 static void PADiffusionApply2D(const int NE,
                                const bool symmetric,
-                               const Array<double> &b_,
-                               const Array<double> &g_,
-                               const Array<double> &bt_,
-                               const Array<double> &gt_,
-                               const Vector &d_,
+                               const TB &b_,
+                               const TB &g_,
+                               const TB &bt_,
+                               const TB &gt_,
+                               const TD &d_,
                                const Vector &x_,
                                Vector &y_,
                                const int d1d = 0,
@@ -1152,12 +1160,12 @@ static void PADiffusionApply2D(const int NE,
 }
 
 // Shared memory PA Diffusion Apply 2D kernel
-template<int T_D1D = 0, int T_Q1D = 0, int T_NBZ = 0>
+template<int T_D1D = 0, int T_Q1D = 0, int T_NBZ = 0, typename TB, typename TD>
 static void SmemPADiffusionApply2D(const int NE,
                                    const bool symmetric,
-                                   const Array<double> &b_,
-                                   const Array<double> &g_,
-                                   const Vector &d_,
+                                   const TB &b_,
+                                   const TB &g_,
+                                   const TD &d_,
                                    const Vector &x_,
                                    Vector &y_,
                                    const int d1d = 0,
@@ -1310,14 +1318,14 @@ static void SmemPADiffusionApply2D(const int NE,
 }
 
 // PA Diffusion Apply 3D kernel
-template<int T_D1D = 0, int T_Q1D = 0>
+template<int T_D1D = 0, int T_Q1D = 0, typename TB, typename TD>
 static void PADiffusionApply3D(const int NE,
                                const bool symmetric,
-                               const Array<double> &b,
-                               const Array<double> &g,
-                               const Array<double> &bt,
-                               const Array<double> &gt,
-                               const Vector &d_,
+                               const TB &b,
+                               const TB &g,
+                               const TB &bt,
+                               const TB &gt,
+                               const TD &d_,
                                const Vector &x_,
                                Vector &y_,
                                int d1d = 0, int q1d = 0)
@@ -1529,12 +1537,12 @@ static MFEM_HOST_DEVICE inline double sign(const int q, const int d)
    return (q<=d) ? -1.0 : 1.0;
 }
 
-template<int T_D1D = 0, int T_Q1D = 0>
+template<int T_D1D = 0, int T_Q1D = 0, typename TB, typename TD>
 static void SmemPADiffusionApply3D(const int NE,
                                    const bool symmetric,
-                                   const Array<double> &b_,
-                                   const Array<double> &g_,
-                                   const Vector &d_,
+                                   const TB &b_,
+                                   const TB &g_,
+                                   const TD &d_,
                                    const Vector &x_,
                                    Vector &y_,
                                    const int d1d = 0,
@@ -1823,35 +1831,265 @@ static void SmemPADiffusionApply3D(const int NE,
    });
 }
 
-static void PADiffusionApply(const int dim,
-                             const int D1D,
-                             const int Q1D,
-                             const int NE,
-                             const bool symm,
-                             const Array<double> &B,
-                             const Array<double> &G,
-                             const Array<double> &Bt,
-                             const Array<double> &Gt,
-                             const Vector &D,
-                             const Vector &X,
-                             Vector &Y)
+// Host PA Diffusion Apply 3D kernel with cross-element vectorization, see
+// SimdPAMassApply3DKernel in bilininteg_mass_pa.cpp.
+template<int T_D1D, int T_Q1D, int VS>
+static inline MFEM_ALWAYS_INLINE
+void SimdPADiffusionApply3DKernel(const int NE,
+                                  const bool symmetric,
+                                  const Array<double> &b,
+                                  const Array<double> &g,
+                                  const Vector &d_,
+                                  const Vector &x_,
+                                  Vector &y_)
 {
-#ifdef MFEM_USE_OCCA
-   if (DeviceCanUseOcca())
+   typedef AutoSIMD<double,VS,VS*sizeof(double)> vreal_t;
+   constexpr int D1D = T_D1D;
+   constexpr int Q1D = T_Q1D;
+   const auto B = Reshape(b.HostRead(), Q1D, D1D);
+   const auto G = Reshape(g.HostRead(), Q1D, D1D);
+   const int ND = symmetric ? 6 : 9;
+   const auto D = Reshape(d_.HostRead(), Q1D*Q1D*Q1D, ND, NE);
+   const auto X = Reshape(x_.HostRead(), D1D, D1D, D1D, NE);
+   auto Y = Reshape(y_.HostReadWrite(), D1D, D1D, D1D, NE);
+   // The contractions alternate between the buffers W0 and W1, allocated once
+   // on the heap, see SimdPAMassApply3DKernel.
+   constexpr int DDD_size = D1D*D1D*D1D, DQQ_size = 3*D1D*Q1D*Q1D;
+   constexpr int DDQ_size = 2*D1D*D1D*Q1D, QQQ_size = 3*Q1D*Q1D*Q1D;
+   constexpr int W0_size = (DDD_size > DQQ_size) ? DDD_size : DQQ_size;
+   constexpr int W1_size = (DDQ_size > QQQ_size) ? DDQ_size : QQQ_size;
+   std::vector<double> buf;
+   vreal_t *W0 = AlignedSimdArray<vreal_t>(buf, W0_size + W1_size);
+   vreal_t *W1 = W0 + W0_size;
+   vreal_t (*DDD)[D1D][D1D] = (vreal_t (*)[D1D][D1D]) W0;
+   vreal_t (*DDQ)[D1D][D1D][Q1D] = (vreal_t (*)[D1D][D1D][Q1D]) W1;
+   vreal_t (*DQQ)[D1D][Q1D][Q1D] = (vreal_t (*)[D1D][Q1D][Q1D]) W0;
+   vreal_t (*QQQ)[Q1D][Q1D][Q1D] = (vreal_t (*)[Q1D][Q1D][Q1D]) W1;
+   vreal_t (*QQD)[Q1D][Q1D][D1D] = (vreal_t (*)[Q1D][Q1D][D1D]) W0;
+   vreal_t (*QDD)[Q1D][D1D][D1D] = (vreal_t (*)[Q1D][D1D][D1D]) W1;
+   for (int e0 = 0; e0 < NE; e0 += VS)
    {
-      if (dim == 2)
+      const int nv = (NE - e0 < VS) ? NE - e0 : VS;
+      for (int dz = 0; dz < D1D; ++dz)
       {
-         OccaPADiffusionApply2D(D1D,Q1D,NE,B,G,Bt,Gt,D,X,Y);
-         return;
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               DDD[dz][dy][dx] = 0.0;
+               for (int v = 0; v < nv; ++v)
+               {
+                  DDD[dz][dy][dx][v] = X(dx,dy,dz,e0+v);
+               }
+            }
+         }
       }
-      if (dim == 3)
+      // DDQ[0] = B.X, DDQ[1] = G.X (contraction in x)
+      for (int dz = 0; dz < D1D; ++dz)
       {
-         OccaPADiffusionApply3D(D1D,Q1D,NE,B,G,Bt,Gt,D,X,Y);
-         return;
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               vreal_t u, v; u = 0.0; v = 0.0;
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  u.fma(DDD[dz][dy][dx], B(qx,dx));
+                  v.fma(DDD[dz][dy][dx], G(qx,dx));
+               }
+               DDQ[0][dz][dy][qx] = u;
+               DDQ[1][dz][dy][qx] = v;
+            }
+         }
+      }
+      // DQQ[0] = B.G.X, DQQ[1] = G.B.X, DQQ[2] = B.B.X (contraction in y)
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               vreal_t u, v, w; u = 0.0; v = 0.0; w = 0.0;
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  u.fma(DDQ[1][dz][dy][qx], B(qy,dy));
+                  v.fma(DDQ[0][dz][dy][qx], G(qy,dy));
+                  w.fma(DDQ[0][dz][dy][qx], B(qy,dy));
+               }
+               DQQ[0][dz][qy][qx] = u;
+               DQQ[1][dz][qy][qx] = v;
+               DQQ[2][dz][qy][qx] = w;
+            }
+         }
+      }
+      // Reference gradient (contraction in z) followed by the qdata
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               vreal_t gX, gY, gZ; gX = 0.0; gY = 0.0; gZ = 0.0;
+               for (int dz = 0; dz < D1D; ++dz)
+               {
+                  gX.fma(DQQ[0][dz][qy][qx], B(qz,dz));
+                  gY.fma(DQQ[1][dz][qy][qx], B(qz,dz));
+                  gZ.fma(DQQ[2][dz][qy][qx], G(qz,dz));
+               }
+               const int q = qx + (qy + qz * Q1D) * Q1D;
+               vreal_t O[9];
+               for (int k = 0; k < ND; ++k)
+               {
+                  O[k] = 0.0;
+                  for (int v = 0; v < nv; ++v)
+                  {
+                     O[k][v] = D(q,k,e0+v);
+                  }
+               }
+               const vreal_t &O11 = O[0];
+               const vreal_t &O12 = O[1];
+               const vreal_t &O13 = O[2];
+               const vreal_t &O21 = symmetric ? O[1] : O[3];
+               const vreal_t &O22 = symmetric ? O[3] : O[4];
+               const vreal_t &O23 = symmetric ? O[4] : O[5];
+               const vreal_t &O31 = symmetric ? O[2] : O[6];
+               const vreal_t &O32 = symmetric ? O[4] : O[7];
+               const vreal_t &O33 = symmetric ? O[5] : O[8];
+               QQQ[0][qz][qy][qx] = O11*gX + O12*gY + O13*gZ;
+               QQQ[1][qz][qy][qx] = O21*gX + O22*gY + O23*gZ;
+               QQQ[2][qz][qy][qx] = O31*gX + O32*gY + O33*gZ;
+            }
+         }
+      }
+      // Apply the transposed basis
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               vreal_t u, v, w; u = 0.0; v = 0.0; w = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  u.fma(QQQ[0][qz][qy][qx], G(qx,dx));
+                  v.fma(QQQ[1][qz][qy][qx], B(qx,dx));
+                  w.fma(QQQ[2][qz][qy][qx], B(qx,dx));
+               }
+               QQD[0][qz][qy][dx] = u;
+               QQD[1][qz][qy][dx] = v;
+               QQD[2][qz][qy][dx] = w;
+            }
+         }
+      }
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               vreal_t u, v, w; u = 0.0; v = 0.0; w = 0.0;
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  u.fma(QQD[0][qz][qy][dx], B(qy,dy));
+                  v.fma(QQD[1][qz][qy][dx], G(qy,dy));
+                  w.fma(QQD[2][qz][qy][dx], B(qy,dy));
+               }
+               QDD[0][qz][dy][dx] = u;
+               QDD[1][qz][dy][dx] = v;
+               QDD[2][qz][dy][dx] = w;
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               vreal_t u; u = 0.0;
+               for (int qz = 0; qz < Q1D; ++qz)
+               {
+                  u.fma(QDD[0][qz][dy][dx], B(qz,dz));
+                  u.fma(QDD[1][qz][dy][dx], B(qz,dz));
+                  u.fma(QDD[2][qz][dy][dx], G(qz,dz));
+               }
+               for (int v = 0; v < nv; ++v)
+               {
+                  Y(dx,dy,dz,e0+v) += u[v];
+               }
+            }
+         }
       }
-      MFEM_ABORT("OCCA PADiffusionApply unknown kernel!");
    }
-#endif // MFEM_USE_OCCA
+}
+
+#ifdef MFEM_SIMD_DISPATCH
+template<int T_D1D, int T_Q1D> MFEM_SIMD_TARGET_AVX2
+static void SimdPADiffusionApply3DAVX2(const int NE,
+                                       const bool symmetric,
+                                       const Array<double> &b,
+                                       const Array<double> &g,
+                                       const Vector &d_,
+                                       const Vector &x_,
+                                       Vector &y_)
+{
+   SimdPADiffusionApply3DKernel<T_D1D,T_Q1D,4>(NE,symmetric,b,g,d_,x_,y_);
+}
+
+template<int T_D1D, int T_Q1D> MFEM_SIMD_TARGET_AVX512
+static void SimdPADiffusionApply3DAVX512(const int NE,
+                                         const bool symmetric,
+                                         const Array<double> &b,
+                                         const Array<double> &g,
+                                         const Vector &d_,
+                                         const Vector &x_,
+                                         Vector &y_)
+{
+   SimdPADiffusionApply3DKernel<T_D1D,T_Q1D,8>(NE,symmetric,b,g,d_,x_,y_);
+}
+#endif
+
+// Select the variant of SimdPADiffusionApply3DKernel for the SIMD width
+// detected at startup, see Device::GetSimdBytes().
+template<int T_D1D, int T_Q1D>
+static void SimdPADiffusionApply3D(const int NE,
+                                   const bool symm,
+                                   const Array<double> &b,
+                                   const Array<double> &g,
+                                   const Vector &d_,
+                                   const Vector &x_,
+                                   Vector &y_)
+{
+#ifdef MFEM_SIMD_DISPATCH
+   switch (Device::GetSimdBytes())
+   {
+      case 64:
+         return SimdPADiffusionApply3DAVX512<T_D1D,T_Q1D>(NE,symm,b,g,d_,x_,y_);
+      case 32:
+         return SimdPADiffusionApply3DAVX2<T_D1D,T_Q1D>(NE,symm,b,g,d_,x_,y_);
+   }
+#endif
+   constexpr int VS = MFEM_SIMD_BYTES/sizeof(double);
+   SimdPADiffusionApply3DKernel<T_D1D,T_Q1D,VS>(NE,symm,b,g,d_,x_,y_);
+}
+
+// Dispatch of the shared memory and generic kernels. The basis tables (TB) and
+// the quadrature data (TD) are either double (Array<double> and Vector) or
+// single precision (Array<float>), see SinglePrecisionPAData.
+template<typename TB, typename TD>
+static void PADiffusionApplyKernels(const int dim,
+                                    const int D1D,
+                                    const int Q1D,
+                                    const int NE,
+                                    const bool symm,
+                                    const TB &B,
+                                    const TB &G,
+                                    const TB &Bt,
+                                    const TB &Gt,
+                                    const TD &D,
+                                    const Vector &X,
+                                    Vector &Y)
+{
    const int ID = (D1D << 4) | Q1D;
 
    if (dim == 2)
@@ -1889,13 +2127,71 @@ static void PADiffusionApply(const int dim,
    MFEM_ABORT("Unknown kernel.");
 }
 
+static void PADiffusionApply(const int dim,
+                             const int D1D,
+                             const int Q1D,
+                             const int NE,
+                             const bool symm,
+                             const Array<double> &B,
+                             const Array<double> &G,
+                             const Array<double> &Bt,
+                             const Array<double> &Gt,
+                             const Vector &D,
+                             const Vector &X,
+                             Vector &Y)
+{
+#ifdef MFEM_USE_OCCA
+   if (DeviceCanUseOcca())
+   {
+      if (dim == 2)
+      {
+         OccaPADiffusionApply2D(D1D,Q1D,NE,B,G,Bt,Gt,D,X,Y);
+         return;
+      }
+      if (dim == 3)
+      {
+         OccaPADiffusionApply3D(D1D,Q1D,NE,B,G,Bt,Gt,D,X,Y);
+         return;
+      }
+      MFEM_ABORT("OCCA PADiffusionApply unknown kernel!");
+   }
+#endif // MFEM_USE_OCCA
+   if (dim == 3 && DeviceCanUseSimd())
+   {
+      switch ((D1D << 4) | Q1D)
+      {
+         case 0x23: return SimdPADiffusionApply3D<2,3>(NE,symm,B,G,D,X,Y);
+         case 0x34: return SimdPADiffusionApply3D<3,4>(NE,symm,B,G,D,X,Y);
+         case 0x45: return SimdPADiffusionApply3D<4,5>(NE,symm,B,G,D,X,Y);
+         case 0x46: return SimdPADiffusionApply3D<4,6>(NE,symm,B,G,D,X,Y);
+         case 0x56: return SimdPADiffusionApply3D<5,6>(NE,symm,B,G,D,X,Y);
+         case 0x58: return SimdPADiffusionApply3D<5,8>(NE,symm,B,G,D,X,Y);
+         case 0x67: return SimdPADiffusionApply3D<6,7>(NE,symm,B,G,D,X,Y);
+         case 0x78: return SimdPADiffusionApply3D<7,8>(NE,symm,B,G,D,X,Y);
+         case 0x89: return SimdPADiffusionApply3D<8,9>(NE,symm,B,G,D,X,Y);
+         default:   return PADiffusionApply3D(NE,symm,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+      }
+   }
+   PADiffusionApplyKernels(dim,D1D,Q1D,NE,symm,B,G,Bt,Gt,D,X,Y);
+}
+
 // PA Diffusion Apply kernel
 void DiffusionIntegrator::AddMultPA(const Vector &x, Vector &y) const
 {
-   if (DeviceCanUseCeed())
+   if (nurbs_maps)
+   {
+      AddMultPANURBS(x, y);
+   }
+   else if (DeviceCanUseCeed())
    {
       CeedAddMult(ceedDataPtr, x, y);
    }
+   else if (pa_sp_built)
+   {
+      PADiffusionApplyKernels(dim, dofs1D, quad1D, ne, symmetric,
+                              pa_sp.B, pa_sp.G, pa_sp.Bt, pa_sp.Gt,
+                              pa_sp.D, x, y);
+   }
    else
    {
       PADiffusionApply(dim, dofs1D, quad1D, ne, symmetric,
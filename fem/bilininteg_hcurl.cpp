@@ -963,9 +963,9 @@ void CurlCurlIntegrator::AssemblePA(const FiniteElementSpace &fes)
 
    Vector coeff(coeffDim * ne * nq);
    coeff = 1.0;
-   auto coeffh = Reshape(coeff.HostWrite(), coeffDim, nq, ne);
-   if (Q || DQ || MQ || SMQ)
+   if (DQ || MQ || SMQ)
    {
+      auto coeffh = Reshape(coeff.HostWrite(), coeffDim, nq, ne);
       Vector D(DQ ? coeffDim : 0);
       DenseMatrix M;
       DenseSymmetricMatrix SM;
@@ -1022,13 +1022,13 @@ void CurlCurlIntegrator::AssemblePA(const FiniteElementSpace &fes)
                   coeffh(i, p, e) = D[i];
                }
             }
-            else
-            {
-               coeffh(0, p, e) = Q->Eval(*tr, ir->IntPoint(p));
-            }
          }
       }
    }
+   else if (Q)
+   {
+      Q->EvalBatch(coeff, *mesh, *ir);
+   }
 
    if (el->GetDerivType() != mfem::FiniteElement::CURL)
    {
@@ -2904,14 +2904,11 @@ void MixedVectorCurlIntegrator::AssemblePA(const FiniteElementSpace &trial_fes,
 
    Vector coeff(coeffDim * nq * ne);
    coeff = 1.0;
-   auto coeffh = Reshape(coeff.HostWrite(), coeffDim, nq, ne);
-   if (Q || DQ)
+   if (DQ)
    {
+      auto coeffh = Reshape(coeff.HostWrite(), coeffDim, nq, ne);
       Vector V(coeffDim);
-      if (DQ)
-      {
-         MFEM_VERIFY(DQ->GetVDim() == coeffDim, "");
-      }
+      MFEM_VERIFY(DQ->GetVDim() == coeffDim, "");
 
       for (int e=0; e<ne; ++e)
       {
@@ -2919,21 +2916,18 @@ void MixedVectorCurlIntegrator::AssemblePA(const FiniteElementSpace &trial_fes,
 
          for (int p=0; p<nq; ++p)
          {
-            if (DQ)
-            {
-               DQ->Eval(V, *tr, ir->IntPoint(p));
-               for (int i=0; i<coeffDim; ++i)
-               {
-                  coeffh(i, p, e) = V[i];
-               }
-            }
-            else
+            DQ->Eval(V, *tr, ir->IntPoint(p));
+            for (int i=0; i<coeffDim; ++i)
             {
-               coeffh(0, p, e) = Q->Eval(*tr, ir->IntPoint(p));
+               coeffh(i, p, e) = V[i];
             }
          }
       }
    }
+   else if (Q)
+   {
+      Q->EvalBatch(coeff, *mesh, *ir);
+   }
 
    if (testType == mfem::FiniteElement::CURL &&
        trialType == mfem::FiniteElement::CURL && dim == 3)
@@ -4024,14 +4018,11 @@ void MixedVectorWeakCurlIntegrator::AssemblePA(const FiniteElementSpace
 
    Vector coeff(coeffDim * nq * ne);
    coeff = 1.0;
-   auto coeffh = Reshape(coeff.HostWrite(), coeffDim, nq, ne);
-   if (Q || DQ)
+   if (DQ)
    {
+      auto coeffh = Reshape(coeff.HostWrite(), coeffDim, nq, ne);
       Vector V(coeffDim);
-      if (DQ)
-      {
-         MFEM_VERIFY(DQ->GetVDim() == coeffDim, "");
-      }
+      MFEM_VERIFY(DQ->GetVDim() == coeffDim, "");
 
       for (int e=0; e<ne; ++e)
       {
@@ -4039,21 +4030,18 @@ void MixedVectorWeakCurlIntegrator::AssemblePA(const FiniteElementSpace
 
          for (int p=0; p<nq; ++p)
          {
-            if (DQ)
-            {
-               DQ->Eval(V, *tr, ir->IntPoint(p));
-               for (int i=0; i<coeffDim; ++i)
-               {
-                  coeffh(i, p, e) = V[i];
-               }
-            }
-            else
+            DQ->Eval(V, *tr, ir->IntPoint(p));
+            for (int i=0; i<coeffDim; ++i)
             {
-               coeffh(0, p, e) = Q->Eval(*tr, ir->IntPoint(p));
+               coeffh(i, p, e) = V[i];
             }
          }
       }
    }
+   else if (Q)
+   {
+      Q->EvalBatch(coeff, *mesh, *ir);
+   }
 
    testType = test_el->GetDerivType();
    trialType = trial_el->GetDerivType();
@@ -928,17 +928,7 @@ void DivDivIntegrator::AssemblePA(const FiniteElementSpace &fes)
 
    Vector coeff(ne * nq);
    coeff = 1.0;
-   if (Q)
-   {
-      for (int e=0; e<ne; ++e)
-      {
-         ElementTransformation *tr = mesh->GetElementTransformation(e);
-         for (int p=0; p<nq; ++p)
-         {
-            coeff[p + (e * nq)] = Q->Eval(*tr, ir->IntPoint(p));
-         }
-      }
-   }
+   if (Q) { Q->EvalBatch(coeff, *mesh, *ir); }
 
    if (el->GetDerivType() == mfem::FiniteElement::DIV && dim == 3)
    {
@@ -1198,17 +1188,7 @@ VectorFEDivergenceIntegrator::AssemblePA(const FiniteElementSpace &trial_fes,
 
    Vector coeff(ne * nq);
    coeff = 1.0;
-   if (Q)
-   {
-      for (int e=0; e<ne; ++e)
-      {
-         ElementTransformation *tr = mesh->GetElementTransformation(e);
-         for (int p=0; p<nq; ++p)
-         {
-            coeff[p + (e * nq)] = Q->Eval(*tr, ir->IntPoint(p));
-         }
-      }
-   }
+   if (Q) { Q->EvalBatch(coeff, *mesh, *ir); }
 
    if (trial_el->GetDerivType() == mfem::FiniteElement::DIV && dim == 3)
    {
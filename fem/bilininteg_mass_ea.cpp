@@ -227,7 +227,10 @@ void MassIntegrator::AssembleEA(const FiniteElementSpace &fes,
                                 Vector &ea_data,
                                 const bool add)
 {
+   const bool single = single_pa;
+   single_pa = false; // element assembly uses the double precision data
    AssemblePA(fes);
+   single_pa = single;
    const int ne = fes.GetMesh()->GetNE();
    const Array<double> &B = maps->B;
    if (dim == 1)
@@ -10,6 +10,7 @@
 // CONTRIBUTING.md for details.
 
 #include "../general/forall.hpp"
+#include "../linalg/simd.hpp"
 #include "bilininteg.hpp"
 #include "gridfunc.hpp"
 #include "libceed/mass.hpp"
@@ -32,6 +33,9 @@ void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
    const FiniteElement &el = *fes.GetFE(0);
    ElementTransformation *T = mesh->GetElementTransformation(0);
    const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, el, *T);
+   delete nurbs_maps;
+   nurbs_maps = NULL;
+   if (fes.GetNURBSext()) { return AssemblePANURBS(fes, *ir); }
    if (DeviceCanUseCeed())
    {
       delete ceedDataPtr;
@@ -74,16 +78,7 @@ void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
    }
    else
    {
-      coeff.SetSize(nq * ne);
-      auto C = Reshape(coeff.HostWrite(), nq, ne);
-      for (int e = 0; e < ne; ++e)
-      {
-         ElementTransformation& T = *fes.GetElementTransformation(e);
-         for (int q = 0; q < nq; ++q)
-         {
-            C(q,e) = Q->Eval(T, ir->IntPoint(q));
-         }
-      }
+      Q->EvalBatch(coeff, *mesh, *ir);
    }
    if (dim==1) { MFEM_ABORT("Not supported yet... stay tuned!"); }
    if (dim==2)
@@ -150,6 +145,8 @@ void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
          }
       });
    }
+   pa_sp_built = single_pa;
+   if (pa_sp_built) { pa_sp.Setup(pa_data, *maps, false); }
 }
 
 template<int T_D1D = 0, int T_Q1D = 0>
@@ -459,10 +456,20 @@ static void PAMassAssembleDiagonal(const int dim, const int D1D,
 
 void MassIntegrator::AssembleDiagonalPA(Vector &diag)
 {
-   if (DeviceCanUseCeed())
+   if (nurbs_maps)
+   {
+      AssembleDiagonalPANURBS(diag);
+   }
+   else if (DeviceCanUseCeed())
    {
       CeedAssembleDiagonal(ceedDataPtr, diag);
    }
+   else if (pa_sp_built)
+   {
+      Vector d;
+      pa_sp.GetData(d);
+      PAMassAssembleDiagonal(dim, dofs1D, quad1D, ne, maps->B, d, diag);
+   }
    else
    {
       PAMassAssembleDiagonal(dim, dofs1D, quad1D, ne, maps->B, pa_data, diag);
@@ -562,11 +569,11 @@ static void OccaPAMassApply3D(const int D1D,
 }
 #endif // MFEM_USE_OCCA
 
-template<int T_D1D = 0, int T_Q1D = 0>
+template<int T_D1D = 0, int T_Q1D = 0, typename TB, typename TD>
 static void PAMassApply2D(const int NE,
-                          const Array<double> &b_,
-                          const Array<double> &bt_,
-                          const Vector &d_,
+                          const TB &b_,
+                          const TB &bt_,
+                          const TD &d_,
                           const Vector &x_,
                           Vector &y_,
                           const int d1d = 0,
@@ -654,11 +661,11 @@ static void PAMassApply2D(const int NE,
    });
 }
 
-template<int T_D1D = 0, int T_Q1D = 0, int T_NBZ = 0>
+template<int T_D1D = 0, int T_Q1D = 0, int T_NBZ = 0, typename TB, typename TD>
 static void SmemPAMassApply2D(const int NE,
-                              const Array<double> &b_,
-                              const Array<double> &bt_,
-                              const Vector &d_,
+                              const TB &b_,
+                              const TB &bt_,
+                              const TD &d_,
                               const Vector &x_,
                               Vector &y_,
                               const int d1d = 0,
@@ -777,11 +784,11 @@ static void SmemPAMassApply2D(const int NE,
    });
 }
 
-template<int T_D1D = 0, int T_Q1D = 0>
+template<int T_D1D = 0, int T_Q1D = 0, typename TB, typename TD>
 static void PAMassApply3D(const int NE,
-                          const Array<double> &b_,
-                          const Array<double> &bt_,
-                          const Vector &d_,
+                          const TB &b_,
+                          const TB &bt_,
+                          const TD &d_,
                           const Vector &x_,
                           Vector &y_,
                           const int d1d = 0,
@@ -918,11 +925,11 @@ static void PAMassApply3D(const int NE,
    });
 }
 
-template<int T_D1D = 0, int T_Q1D = 0>
+template<int T_D1D = 0, int T_Q1D = 0, typename TB, typename TD>
 static void SmemPAMassApply3D(const int NE,
-                              const Array<double> &b_,
-                              const Array<double> &bt_,
-                              const Vector &d_,
+                              const TB &b_,
+                              const TB &bt_,
+                              const TD &d_,
                               const Vector &x_,
                               Vector &y_,
                               const int d1d = 0,
@@ -1145,30 +1152,222 @@ static void SmemPAMassApply3D(const int NE,
    });
 }
 
-static void PAMassApply(const int dim,
-                        const int D1D,
-                        const int Q1D,
-                        const int NE,
-                        const Array<double> &B,
-                        const Array<double> &Bt,
-                        const Vector &D,
-                        const Vector &X,
-                        Vector &Y)
+// Host PA Mass Apply 3D kernel with cross-element vectorization: the elements
+// are processed in batches of VS, the element index within the batch being the
+// SIMD lane, so that the lanes are full for any D1D and Q1D. The batch is
+// gathered into (and scattered from) interleaved local arrays, so the E-vector
+// and quadrature data layouts are unchanged.
+template<int T_D1D, int T_Q1D, int VS>
+static inline MFEM_ALWAYS_INLINE
+void SimdPAMassApply3DKernel(const int NE,
+                             const Array<double> &b_,
+                             const Array<double> &bt_,
+                             const Vector &d_,
+                             const Vector &x_,
+                             Vector &y_)
 {
-#ifdef MFEM_USE_OCCA
-   if (DeviceCanUseOcca())
+   typedef AutoSIMD<double,VS,VS*sizeof(double)> vreal_t;
+   constexpr int D1D = T_D1D;
+   constexpr int Q1D = T_Q1D;
+   const auto B = Reshape(b_.HostRead(), Q1D, D1D);
+   const auto Bt = Reshape(bt_.HostRead(), D1D, Q1D);
+   const auto D = Reshape(d_.HostRead(), Q1D, Q1D, Q1D, NE);
+   const auto X = Reshape(x_.HostRead(), D1D, D1D, D1D, NE);
+   auto Y = Reshape(y_.HostReadWrite(), D1D, D1D, D1D, NE);
+   // The contractions alternate between the buffers W0 and W1, allocated once
+   // on the heap: at the higher orders, the arrays of all the stages would
+   // need a few hundred KB of stack.
+   constexpr int DDD_size = D1D*D1D*D1D, DQQ_size = D1D*Q1D*Q1D;
+   constexpr int DDQ_size = D1D*D1D*Q1D, QQQ_size = Q1D*Q1D*Q1D;
+   constexpr int W0_size = (DDD_size > DQQ_size) ? DDD_size : DQQ_size;
+   constexpr int W1_size = (DDQ_size > QQQ_size) ? DDQ_size : QQQ_size;
+   std::vector<double> buf;
+   vreal_t *W0 = AlignedSimdArray<vreal_t>(buf, W0_size + W1_size);
+   vreal_t *W1 = W0 + W0_size;
+   vreal_t (*DDD)[D1D][D1D] = (vreal_t (*)[D1D][D1D]) W0;
+   vreal_t (*DDQ)[D1D][Q1D] = (vreal_t (*)[D1D][Q1D]) W1;
+   vreal_t (*DQQ)[Q1D][Q1D] = (vreal_t (*)[Q1D][Q1D]) W0;
+   vreal_t (*QQQ)[Q1D][Q1D] = (vreal_t (*)[Q1D][Q1D]) W1;
+   vreal_t (*QQD)[Q1D][D1D] = (vreal_t (*)[Q1D][D1D]) W0;
+   vreal_t (*QDD)[D1D][D1D] = (vreal_t (*)[D1D][D1D]) W1;
+   for (int e0 = 0; e0 < NE; e0 += VS)
    {
-      if (dim == 2)
+      const int nv = (NE - e0 < VS) ? NE - e0 : VS;
+      for (int dz = 0; dz < D1D; ++dz)
       {
-         return OccaPAMassApply2D(D1D,Q1D,NE,B,Bt,D,X,Y);
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               DDD[dz][dy][dx] = 0.0;
+               for (int v = 0; v < nv; ++v)
+               {
+                  DDD[dz][dy][dx][v] = X(dx,dy,dz,e0+v);
+               }
+            }
+         }
       }
-      if (dim == 3)
+      for (int dz = 0; dz < D1D; ++dz)
       {
-         return OccaPAMassApply3D(D1D,Q1D,NE,B,Bt,D,X,Y);
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               vreal_t u; u = 0.0;
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  u.fma(DDD[dz][dy][dx], B(qx,dx));
+               }
+               DDQ[dz][dy][qx] = u;
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               vreal_t u; u = 0.0;
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  u.fma(DDQ[dz][dy][qx], B(qy,dy));
+               }
+               DQQ[dz][qy][qx] = u;
+            }
+         }
+      }
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               vreal_t u; u = 0.0;
+               for (int dz = 0; dz < D1D; ++dz)
+               {
+                  u.fma(DQQ[dz][qy][qx], B(qz,dz));
+               }
+               vreal_t w; w = 0.0;
+               for (int v = 0; v < nv; ++v)
+               {
+                  w[v] = D(qx,qy,qz,e0+v);
+               }
+               QQQ[qz][qy][qx] = u * w;
+            }
+         }
+      }
+      // Apply the transposed basis
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               vreal_t u; u = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  u.fma(QQQ[qz][qy][qx], Bt(dx,qx));
+               }
+               QQD[qz][qy][dx] = u;
+            }
+         }
+      }
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               vreal_t u; u = 0.0;
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  u.fma(QQD[qz][qy][dx], Bt(dy,qy));
+               }
+               QDD[qz][dy][dx] = u;
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               vreal_t u; u = 0.0;
+               for (int qz = 0; qz < Q1D; ++qz)
+               {
+                  u.fma(QDD[qz][dy][dx], Bt(dz,qz));
+               }
+               for (int v = 0; v < nv; ++v)
+               {
+                  Y(dx,dy,dz,e0+v) += u[v];
+               }
+            }
+         }
       }
-      MFEM_ABORT("OCCA PA Mass Apply unknown kernel!");
    }
-#endif // MFEM_USE_OCCA
+}
+
+#ifdef MFEM_SIMD_DISPATCH
+template<int T_D1D, int T_Q1D> MFEM_SIMD_TARGET_AVX2
+static void SimdPAMassApply3DAVX2(const int NE,
+                                  const Array<double> &b_,
+                                  const Array<double> &bt_,
+                                  const Vector &d_,
+                                  const Vector &x_,
+                                  Vector &y_)
+{
+   SimdPAMassApply3DKernel<T_D1D,T_Q1D,4>(NE,b_,bt_,d_,x_,y_);
+}
+
+template<int T_D1D, int T_Q1D> MFEM_SIMD_TARGET_AVX512
+static void SimdPAMassApply3DAVX512(const int NE,
+                                    const Array<double> &b_,
+                                    const Array<double> &bt_,
+                                    const Vector &d_,
+                                    const Vector &x_,
+                                    Vector &y_)
+{
+   SimdPAMassApply3DKernel<T_D1D,T_Q1D,8>(NE,b_,bt_,d_,x_,y_);
+}
+#endif
+
+// Select the variant of SimdPAMassApply3DKernel for the SIMD width detected at
+// startup, see Device::GetSimdBytes().
+template<int T_D1D, int T_Q1D>
+static void SimdPAMassApply3D(const int NE,
+                              const Array<double> &b_,
+                              const Array<double> &bt_,
+                              const Vector &d_,
+                              const Vector &x_,
+                              Vector &y_)
+{
+#ifdef MFEM_SIMD_DISPATCH
+   switch (Device::GetSimdBytes())
+   {
+      case 64: return SimdPAMassApply3DAVX512<T_D1D,T_Q1D>(NE,b_,bt_,d_,x_,y_);
+      case 32: return SimdPAMassApply3DAVX2<T_D1D,T_Q1D>(NE,b_,bt_,d_,x_,y_);
+   }
+#endif
+   constexpr int VS = MFEM_SIMD_BYTES/sizeof(double);
+   SimdPAMassApply3DKernel<T_D1D,T_Q1D,VS>(NE,b_,bt_,d_,x_,y_);
+}
+
+// Dispatch of the shared memory and generic kernels. The basis tables (TB) and
+// the quadrature data (TD) are either double (Array<double> and Vector) or
+// single precision (Array<float>), see SinglePrecisionPAData.
+template<typename TB, typename TD>
+static void PAMassApplyKernels(const int dim,
+                               const int D1D,
+                               const int Q1D,
+                               const int NE,
+                               const TB &B,
+                               const TB &Bt,
+                               const TD &D,
+                               const Vector &X,
+                               Vector &Y)
+{
    const int id = (D1D << 4) | Q1D;
    if (dim == 2)
    {
@@ -1214,12 +1413,68 @@ static void PAMassApply(const int dim,
    MFEM_ABORT("Unknown kernel.");
 }
 
+static void PAMassApply(const int dim,
+                        const int D1D,
+                        const int Q1D,
+                        const int NE,
+                        const Array<double> &B,
+                        const Array<double> &Bt,
+                        const Vector &D,
+                        const Vector &X,
+                        Vector &Y)
+{
+#ifdef MFEM_USE_OCCA
+   if (DeviceCanUseOcca())
+   {
+      if (dim == 2)
+      {
+         return OccaPAMassApply2D(D1D,Q1D,NE,B,Bt,D,X,Y);
+      }
+      if (dim == 3)
+      {
+         return OccaPAMassApply3D(D1D,Q1D,NE,B,Bt,D,X,Y);
+      }
+      MFEM_ABORT("OCCA PA Mass Apply unknown kernel!");
+   }
+#endif // MFEM_USE_OCCA
+   if (dim == 3 && DeviceCanUseSimd())
+   {
+      switch ((D1D << 4) | Q1D)
+      {
+         case 0x23: return SimdPAMassApply3D<2,3>(NE,B,Bt,D,X,Y);
+         case 0x24: return SimdPAMassApply3D<2,4>(NE,B,Bt,D,X,Y);
+         case 0x34: return SimdPAMassApply3D<3,4>(NE,B,Bt,D,X,Y);
+         case 0x36: return SimdPAMassApply3D<3,6>(NE,B,Bt,D,X,Y);
+         case 0x45: return SimdPAMassApply3D<4,5>(NE,B,Bt,D,X,Y);
+         case 0x46: return SimdPAMassApply3D<4,6>(NE,B,Bt,D,X,Y);
+         case 0x48: return SimdPAMassApply3D<4,8>(NE,B,Bt,D,X,Y);
+         case 0x56: return SimdPAMassApply3D<5,6>(NE,B,Bt,D,X,Y);
+         case 0x58: return SimdPAMassApply3D<5,8>(NE,B,Bt,D,X,Y);
+         case 0x67: return SimdPAMassApply3D<6,7>(NE,B,Bt,D,X,Y);
+         case 0x78: return SimdPAMassApply3D<7,8>(NE,B,Bt,D,X,Y);
+         case 0x89: return SimdPAMassApply3D<8,9>(NE,B,Bt,D,X,Y);
+         case 0x9A: return SimdPAMassApply3D<9,10>(NE,B,Bt,D,X,Y);
+         default:   return PAMassApply3D(NE,B,Bt,D,X,Y,D1D,Q1D);
+      }
+   }
+   PAMassApplyKernels(dim,D1D,Q1D,NE,B,Bt,D,X,Y);
+}
+
 void MassIntegrator::AddMultPA(const Vector &x, Vector &y) const
 {
-   if (DeviceCanUseCeed())
+   if (nurbs_maps)
+   {
+      AddMultPANURBS(x, y);
+   }
+   else if (DeviceCanUseCeed())
    {
       CeedAddMult(ceedDataPtr, x, y);
    }
+   else if (pa_sp_built)
+   {
+      PAMassApplyKernels(dim, dofs1D, quad1D, ne, pa_sp.B, pa_sp.Bt, pa_sp.D,
+                         x, y);
+   }
    else
    {
       PAMassApply(dim, dofs1D, quad1D, ne, maps->B, maps->Bt, pa_data, x, y);
@@ -0,0 +1,827 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "bilininteg.hpp"
+#include "../mesh/nurbs.hpp"
+
+#include <map>
+#include <vector>
+
+using namespace std;
+
+namespace mfem
+{
+
+// PA on NURBS spaces. The element dofs are weighted with the NURBS weights w,
+// interpolated with the tensor products of the 1D B-splines of the element
+// knot spans, and the rational factor 1/W of the basis is folded into the
+// quadrature point data:
+//
+//    mass:       y = w B^T D B w x,  D = coeff det(J) / W^2
+//
+//    diffusion:  with P = B w x, g = grad(W)/W, and the reference gradient
+//                of the solution grad(u) = (grad(P) - P g)/W, the flux
+//                v = D (grad(P) - P g), with D = coeff adj(J) adj(J)^T /
+//                (det(J) W^2), is tested with w (G^T v - B^T (g.v)).
+
+NURBSDofToQuad::NURBSDofToQuad(const FiniteElementSpace &fes,
+                               const IntegrationRule &ir)
+{
+   const Mesh *mesh = fes.GetMesh();
+   dim = mesh->Dimension();
+   ne = fes.GetNE();
+   const NURBSFiniteElement *fe0 =
+      dynamic_cast<const NURBSFiniteElement*>(fes.GetFE(0));
+   MFEM_VERIFY(fe0 != NULL, "The space is not a NURBS space!");
+   ndof = fe0->GetOrder() + 1;
+   const int nd = fe0->GetDof();
+   const int nq = ir.GetNPoints();
+   nqpt = (int) floor(pow(nq, 1.0/dim) + 0.5);
+   MFEM_VERIFY(pow(nqpt, dim) == nq && pow(ndof, dim) == nd,
+               "Tensor product integration rule and space required!");
+   MFEM_VERIFY(ndof <= MAX_D1D && nqpt <= MAX_Q1D, "Order too high!");
+
+   // The 1D points are the first nqpt points of the tensor product rule
+   std::map<std::pair<const KnotVector*, int>, int> span_ids;
+   std::vector<double> b, g;
+   Vector shape(ndof), dshape(ndof);
+   spans.SetSize(dim*ne);
+   weights.SetSize(nd*ne);
+   for (int e = 0; e < ne; e++)
+   {
+      const NURBSFiniteElement *fe =
+         static_cast<const NURBSFiniteElement*>(fes.GetFE(e));
+      MFEM_VERIFY(fe->GetDof() == nd, "Variable order is not supported!");
+      const int *ijk = fe->GetIJK();
+      for (int d = 0; d < dim; d++)
+      {
+         const KnotVector *kv = fe->KnotVectors()[d];
+         MFEM_VERIFY(kv->GetOrder() == ndof - 1,
+                     "Anisotropic orders are not supported!");
+         const std::pair<const KnotVector*, int> key(kv, ijk[d]);
+         auto it = span_ids.find(key);
+         if (it == span_ids.end())
+         {
+            it = span_ids.insert(std::make_pair(key, (int) span_ids.size()))
+                 .first;
+            b.resize(b.size() + nqpt*ndof);
+            g.resize(g.size() + nqpt*ndof);
+            double *bs = &b[b.size() - nqpt*ndof];
+            double *gs = &g[g.size() - nqpt*ndof];
+            for (int q = 0; q < nqpt; q++)
+            {
+               const double xi = ir.IntPoint(q).x;
+               kv->CalcShape(shape, ijk[d], xi);
+               kv->CalcDShape(dshape, ijk[d], xi);
+               for (int i = 0; i < ndof; i++)
+               {
+                  bs[q + nqpt*i] = shape(i);
+                  gs[q + nqpt*i] = dshape(i);
+               }
+            }
+         }
+         spans[d + dim*e] = it->second;
+      }
+      for (int i = 0; i < nd; i++)
+      {
+         weights(i + nd*e) = fe->Weights()(i);
+      }
+   }
+   nspans = span_ids.size();
+   B.SetSize(b.size());
+   G.SetSize(g.size());
+   for (int i = 0; i < B.Size(); i++)
+   {
+      B[i] = b[i];
+      G[i] = g[i];
+   }
+}
+
+void NURBSDofToQuad::CalcWeightFunction(int e, Vector &W,
+                                        DenseMatrix &dW) const
+{
+   const int nd = weights.Size()/ne;
+   const int nq = (int) floor(pow(nqpt, dim) + 0.5);
+   const auto b = Reshape(B.HostRead(), nqpt, ndof, nspans);
+   const auto g = Reshape(G.HostRead(), nqpt, ndof, nspans);
+   const auto w = Reshape(weights.HostRead(), nd, ne);
+   const int *s = spans.HostRead() + dim*e;
+   W.SetSize(nq);
+   dW.SetSize(nq, dim);
+   for (int q = 0; q < nq; q++)
+   {
+      int qi[3] = { q % nqpt, (q / nqpt) % nqpt, q / (nqpt*nqpt) };
+      double val = 0.0, grad[3] = { 0.0, 0.0, 0.0 };
+      for (int i = 0; i < nd; i++)
+      {
+         int di[3] = { i % ndof, (i / ndof) % ndof, i / (ndof*ndof) };
+         double bv[3], gv[3];
+         for (int d = 0; d < dim; d++)
+         {
+            bv[d] = b(qi[d], di[d], s[d]);
+            gv[d] = g(qi[d], di[d], s[d]);
+         }
+         double prod = w(i,e);
+         for (int d = 0; d < dim; d++) { prod *= bv[d]; }
+         val += prod;
+         for (int d = 0; d < dim; d++)
+         {
+            double dprod = w(i,e)*gv[d];
+            for (int k = 0; k < dim; k++) { if (k != d) { dprod *= bv[k]; } }
+            grad[d] += dprod;
+         }
+      }
+      W(q) = val;
+      for (int d = 0; d < dim; d++) { dW(q,d) = grad[d]; }
+   }
+}
+
+void MassIntegrator::AssemblePANURBS(const FiniteElementSpace &fes,
+                                     const IntegrationRule &ir)
+{
+   Mesh *mesh = fes.GetMesh();
+   dim = mesh->Dimension();
+   ne = fes.GetNE();
+   nq = ir.GetNPoints();
+   nurbs_maps = new NURBSDofToQuad(fes, ir);
+   dofs1D = nurbs_maps->ndof;
+   quad1D = nurbs_maps->nqpt;
+   pa_data.SetSize(ne*nq, Device::GetDeviceMemoryType());
+   auto d = Reshape(pa_data.HostWrite(), nq, ne);
+   Vector W;
+   DenseMatrix dW;
+   for (int e = 0; e < ne; e++)
+   {
+      ElementTransformation &T = *mesh->GetElementTransformation(e);
+      nurbs_maps->CalcWeightFunction(e, W, dW);
+      for (int q = 0; q < nq; q++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         T.SetIntPoint(&ip);
+         const double coeff = Q ? Q->Eval(T, ip) : 1.0;
+         d(q,e) = ip.weight * coeff * T.Weight() / (W(q)*W(q));
+      }
+   }
+}
+
+// PA Mass Apply 2D kernel for NURBS spaces
+template<int T_D1D = 0, int T_Q1D = 0> static
+void PAMassApplyNURBS2D(const NURBSDofToQuad &maps,
+                        const Vector &d_,
+                        const Vector &x_,
+                        Vector &y_,
+                        const int d1d = 0,
+                        const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const int NE = maps.ne;
+   auto b = Reshape(maps.B.Read(), Q1D, D1D, maps.nspans);
+   auto S = Reshape(maps.spans.Read(), 2, NE);
+   auto W = Reshape(maps.weights.Read(), D1D, D1D, NE);
+   auto D = Reshape(d_.Read(), Q1D, Q1D, NE);
+   auto X = Reshape(x_.Read(), D1D, D1D, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      const int sx = S(0,e), sy = S(1,e);
+      double BX[MD1][MQ1];
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            double u = 0.0;
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               u += b(qx,dx,sx) * W(dx,dy,e) * X(dx,dy,e);
+            }
+            BX[dy][qx] = u;
+         }
+      }
+      double DBBX[MQ1][MQ1];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            double u = 0.0;
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               u += b(qy,dy,sy) * BX[dy][qx];
+            }
+            DBBX[qy][qx] = D(qx,qy,e) * u;
+         }
+      }
+      double BDX[MQ1][MD1];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            double u = 0.0;
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               u += b(qx,dx,sx) * DBBX[qy][qx];
+            }
+            BDX[qy][dx] = u;
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            double u = 0.0;
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               u += b(qy,dy,sy) * BDX[qy][dx];
+            }
+            Y(dx,dy,e) += W(dx,dy,e) * u;
+         }
+      }
+   });
+}
+
+// PA Mass Apply 3D kernel for NURBS spaces
+template<int T_D1D = 0, int T_Q1D = 0> static
+void PAMassApplyNURBS3D(const NURBSDofToQuad &maps,
+                        const Vector &d_,
+                        const Vector &x_,
+                        Vector &y_,
+                        const int d1d = 0,
+                        const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const int NE = maps.ne;
+   auto b = Reshape(maps.B.Read(), Q1D, D1D, maps.nspans);
+   auto S = Reshape(maps.spans.Read(), 3, NE);
+   auto W = Reshape(maps.weights.Read(), D1D, D1D, D1D, NE);
+   auto D = Reshape(d_.Read(), Q1D, Q1D, Q1D, NE);
+   auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      const int sx = S(0,e), sy = S(1,e), sz = S(2,e);
+      double BX[MD1][MD1][MQ1];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               double u = 0.0;
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  u += b(qx,dx,sx) * W(dx,dy,dz,e) * X(dx,dy,dz,e);
+               }
+               BX[dz][dy][qx] = u;
+            }
+         }
+      }
+      double BBX[MD1][MQ1][MQ1];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               double u = 0.0;
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  u += b(qy,dy,sy) * BX[dz][dy][qx];
+               }
+               BBX[dz][qy][qx] = u;
+            }
+         }
+      }
+      double DBBBX[MQ1][MQ1][MQ1];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               double u = 0.0;
+               for (int dz = 0; dz < D1D; ++dz)
+               {
+                  u += b(qz,dz,sz) * BBX[dz][qy][qx];
+               }
+               DBBBX[qz][qy][qx] = D(qx,qy,qz,e) * u;
+            }
+         }
+      }
+      double BDX[MQ1][MQ1][MD1];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double u = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  u += b(qx,dx,sx) * DBBBX[qz][qy][qx];
+               }
+               BDX[qz][qy][dx] = u;
+            }
+         }
+      }
+      double BBDX[MQ1][MD1][MD1];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double u = 0.0;
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  u += b(qy,dy,sy) * BDX[qz][qy][dx];
+               }
+               BBDX[qz][dy][dx] = u;
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double u = 0.0;
+               for (int qz = 0; qz < Q1D; ++qz)
+               {
+                  u += b(qz,dz,sz) * BBDX[qz][dy][dx];
+               }
+               Y(dx,dy,dz,e) += W(dx,dy,dz,e) * u;
+            }
+         }
+      }
+   });
+}
+
+void MassIntegrator::AddMultPANURBS(const Vector &x, Vector &y) const
+{
+   const NURBSDofToQuad &m = *nurbs_maps;
+   const int D1D = dofs1D, Q1D = quad1D;
+   if (dim == 2)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x23: return PAMassApplyNURBS2D<2,3>(m,pa_data,x,y);
+         case 0x34: return PAMassApplyNURBS2D<3,4>(m,pa_data,x,y);
+         case 0x45: return PAMassApplyNURBS2D<4,5>(m,pa_data,x,y);
+         case 0x56: return PAMassApplyNURBS2D<5,6>(m,pa_data,x,y);
+         default: return PAMassApplyNURBS2D(m,pa_data,x,y,D1D,Q1D);
+      }
+   }
+   else if (dim == 3)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x23: return PAMassApplyNURBS3D<2,3>(m,pa_data,x,y);
+         case 0x34: return PAMassApplyNURBS3D<3,4>(m,pa_data,x,y);
+         case 0x45: return PAMassApplyNURBS3D<4,5>(m,pa_data,x,y);
+         case 0x56: return PAMassApplyNURBS3D<5,6>(m,pa_data,x,y);
+         default: return PAMassApplyNURBS3D(m,pa_data,x,y,D1D,Q1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+// The diagonals are computed without sum factorization, with one thread per
+// element dof: entry i of the element diagonal is the sum over the quadrature
+// points of w_i^2 times the quadratic form of the quadrature data applied to
+// the tensor product values of basis function i.
+void MassIntegrator::AssembleDiagonalPANURBS(Vector &diag) const
+{
+   const int DIM = dim, D1D = dofs1D, Q1D = quad1D, NE = ne;
+   const int ND = nurbs_maps->weights.Size()/NE, NQ = nq;
+   auto b = Reshape(nurbs_maps->B.Read(), Q1D, D1D, nurbs_maps->nspans);
+   auto S = Reshape(nurbs_maps->spans.Read(), DIM, NE);
+   auto W = Reshape(nurbs_maps->weights.Read(), ND, NE);
+   auto D = Reshape(pa_data.Read(), NQ, NE);
+   auto Y = Reshape(diag.ReadWrite(), ND, NE);
+   MFEM_FORALL(i, ND*NE,
+   {
+      const int e = i / ND, dof = i % ND;
+      const int di[3] = { dof % D1D, (dof / D1D) % D1D, dof / (D1D*D1D) };
+      double val = 0.0;
+      for (int q = 0; q < NQ; q++)
+      {
+         const int qi[3] = { q % Q1D, (q / Q1D) % Q1D, q / (Q1D*Q1D) };
+         double bq = 1.0;
+         for (int d = 0; d < DIM; d++) { bq *= b(qi[d],di[d],S(d,e)); }
+         val += D(q,e) * bq * bq;
+      }
+      Y(dof,e) += W(dof,e) * W(dof,e) * val;
+   });
+}
+
+void DiffusionIntegrator::AssemblePANURBS(const FiniteElementSpace &fes,
+                                          const IntegrationRule &ir)
+{
+   Mesh *mesh = fes.GetMesh();
+   dim = mesh->Dimension();
+   MFEM_VERIFY(mesh->SpaceDimension() == dim,
+               "Surface NURBS meshes are not supported!");
+   ne = fes.GetNE();
+   const int nq = ir.GetNPoints();
+   nurbs_maps = new NURBSDofToQuad(fes, ir);
+   dofs1D = nurbs_maps->ndof;
+   quad1D = nurbs_maps->nqpt;
+   // Full dim x dim matrix, followed by the reference gradient of log(W)
+   const int nc = dim*dim + dim;
+   pa_data.SetSize(nq*nc*ne, Device::GetDeviceMemoryType());
+   auto d = Reshape(pa_data.HostWrite(), nq, nc, ne);
+   Vector W, vq(dim);
+   DenseMatrix dW, K(dim), adjJ(dim), A(dim), KadjJt(dim);
+   DenseSymmetricMatrix SK;
+   for (int e = 0; e < ne; e++)
+   {
+      ElementTransformation &T = *mesh->GetElementTransformation(e);
+      nurbs_maps->CalcWeightFunction(e, W, dW);
+      for (int q = 0; q < nq; q++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         T.SetIntPoint(&ip);
+         if (MQ) { MQ->Eval(K, T, ip); }
+         else if (SMQ)
+         {
+            SMQ->Eval(SK, T, ip);
+            for (int i = 0; i < dim; i++)
+            {
+               for (int j = 0; j < dim; j++) { K(i,j) = SK(i,j); }
+            }
+         }
+         else if (VQ)
+         {
+            VQ->Eval(vq, T, ip);
+            K.Diag(vq.GetData(), dim);
+         }
+         else
+         {
+            K.Diag(Q ? Q->Eval(T, ip) : 1.0, dim);
+         }
+         CalcAdjugate(T.Jacobian(), adjJ);
+         MultABt(K, adjJ, KadjJt);
+         Mult(adjJ, KadjJt, A);
+         const double s = ip.weight / (T.Weight() * W(q) * W(q));
+         for (int j = 0; j < dim; j++)
+         {
+            for (int i = 0; i < dim; i++)
+            {
+               d(q, i + dim*j, e) = s * A(i,j);
+            }
+            d(q, dim*dim + j, e) = dW(q,j) / W(q);
+         }
+      }
+   }
+}
+
+// PA Diffusion Apply 2D kernel for NURBS spaces
+template<int T_D1D = 0, int T_Q1D = 0> static
+void PADiffusionApplyNURBS2D(const NURBSDofToQuad &maps,
+                             const Vector &d_,
+                             const Vector &x_,
+                             Vector &y_,
+                             const int d1d = 0,
+                             const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const int NE = maps.ne;
+   auto b = Reshape(maps.B.Read(), Q1D, D1D, maps.nspans);
+   auto g = Reshape(maps.G.Read(), Q1D, D1D, maps.nspans);
+   auto S = Reshape(maps.spans.Read(), 2, NE);
+   auto W = Reshape(maps.weights.Read(), D1D, D1D, NE);
+   auto D = Reshape(d_.Read(), Q1D, Q1D, 6, NE);
+   auto X = Reshape(x_.Read(), D1D, D1D, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      const int sx = S(0,e), sy = S(1,e);
+      double BX[MD1][MQ1], GX[MD1][MQ1];
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            double u = 0.0, v = 0.0;
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double wx = W(dx,dy,e) * X(dx,dy,e);
+               u += b(qx,dx,sx) * wx;
+               v += g(qx,dx,sx) * wx;
+            }
+            BX[dy][qx] = u;
+            GX[dy][qx] = v;
+         }
+      }
+      // Values at the points: s (tested with B), v0 (with G_x), v1 (with G_y)
+      double QS[MQ1][MQ1], Q0[MQ1][MQ1], Q1[MQ1][MQ1];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            double p = 0.0, px = 0.0, py = 0.0;
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const double by = b(qy,dy,sy);
+               p  += by * BX[dy][qx];
+               px += by * GX[dy][qx];
+               py += g(qy,dy,sy) * BX[dy][qx];
+            }
+            const double g0 = D(qx,qy,4,e), g1 = D(qx,qy,5,e);
+            const double r0 = px - p*g0, r1 = py - p*g1;
+            const double v0 = D(qx,qy,0,e)*r0 + D(qx,qy,2,e)*r1;
+            const double v1 = D(qx,qy,1,e)*r0 + D(qx,qy,3,e)*r1;
+            QS[qy][qx] = -(g0*v0 + g1*v1);
+            Q0[qy][qx] = v0;
+            Q1[qy][qx] = v1;
+         }
+      }
+      double UB[MQ1][MD1], UG[MQ1][MD1];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            double u = 0.0, v = 0.0;
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double bx = b(qx,dx,sx);
+               u += bx * QS[qy][qx] + g(qx,dx,sx) * Q0[qy][qx];
+               v += bx * Q1[qy][qx];
+            }
+            UB[qy][dx] = u;
+            UG[qy][dx] = v;
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            double u = 0.0;
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               u += b(qy,dy,sy) * UB[qy][dx] + g(qy,dy,sy) * UG[qy][dx];
+            }
+            Y(dx,dy,e) += W(dx,dy,e) * u;
+         }
+      }
+   });
+}
+
+// PA Diffusion Apply 3D kernel for NURBS spaces
+template<int T_D1D = 0, int T_Q1D = 0> static
+void PADiffusionApplyNURBS3D(const NURBSDofToQuad &maps,
+                             const Vector &d_,
+                             const Vector &x_,
+                             Vector &y_,
+                             const int d1d = 0,
+                             const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const int NE = maps.ne;
+   auto b = Reshape(maps.B.Read(), Q1D, D1D, maps.nspans);
+   auto g = Reshape(maps.G.Read(), Q1D, D1D, maps.nspans);
+   auto S = Reshape(maps.spans.Read(), 3, NE);
+   auto W = Reshape(maps.weights.Read(), D1D, D1D, D1D, NE);
+   auto D = Reshape(d_.Read(), Q1D, Q1D, Q1D, 12, NE);
+   auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      const int sx = S(0,e), sy = S(1,e), sz = S(2,e);
+      // Contraction in x: B_x and G_x
+      double BX[MD1][MD1][MQ1], GX[MD1][MD1][MQ1];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               double u = 0.0, v = 0.0;
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const double wx = W(dx,dy,dz,e) * X(dx,dy,dz,e);
+                  u += b(qx,dx,sx) * wx;
+                  v += g(qx,dx,sx) * wx;
+               }
+               BX[dz][dy][qx] = u;
+               GX[dz][dy][qx] = v;
+            }
+         }
+      }
+      // Contraction in y: B_x B_y, G_x B_y and B_x G_y
+      double BB[MD1][MQ1][MQ1], GB[MD1][MQ1][MQ1], BG[MD1][MQ1][MQ1];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               double bb = 0.0, gb = 0.0, bg = 0.0;
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  const double by = b(qy,dy,sy);
+                  bb += by * BX[dz][dy][qx];
+                  gb += by * GX[dz][dy][qx];
+                  bg += g(qy,dy,sy) * BX[dz][dy][qx];
+               }
+               BB[dz][qy][qx] = bb;
+               GB[dz][qy][qx] = gb;
+               BG[dz][qy][qx] = bg;
+            }
+         }
+      }
+      // Contraction in z and transposed contraction in z: the point values
+      // tested with B_x B_y (TBB), G_x B_y (TGB) and B_x G_y (TBG)
+      double TBB[MD1][MQ1][MQ1], TGB[MD1][MQ1][MQ1], TBG[MD1][MQ1][MQ1];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               TBB[dz][qy][qx] = 0.0;
+               TGB[dz][qy][qx] = 0.0;
+               TBG[dz][qy][qx] = 0.0;
+            }
+         }
+      }
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               double p = 0.0, px = 0.0, py = 0.0, pz = 0.0;
+               for (int dz = 0; dz < D1D; ++dz)
+               {
+                  const double bz = b(qz,dz,sz);
+                  p  += bz * BB[dz][qy][qx];
+                  px += bz * GB[dz][qy][qx];
+                  py += bz * BG[dz][qy][qx];
+                  pz += g(qz,dz,sz) * BB[dz][qy][qx];
+               }
+               const double g0 = D(qx,qy,qz,9,e);
+               const double g1 = D(qx,qy,qz,10,e);
+               const double g2 = D(qx,qy,qz,11,e);
+               const double r0 = px - p*g0, r1 = py - p*g1, r2 = pz - p*g2;
+               const double v0 = D(qx,qy,qz,0,e)*r0 + D(qx,qy,qz,3,e)*r1 +
+                                 D(qx,qy,qz,6,e)*r2;
+               const double v1 = D(qx,qy,qz,1,e)*r0 + D(qx,qy,qz,4,e)*r1 +
+                                 D(qx,qy,qz,7,e)*r2;
+               const double v2 = D(qx,qy,qz,2,e)*r0 + D(qx,qy,qz,5,e)*r1 +
+                                 D(qx,qy,qz,8,e)*r2;
+               const double s = -(g0*v0 + g1*v1 + g2*v2);
+               for (int dz = 0; dz < D1D; ++dz)
+               {
+                  const double bz = b(qz,dz,sz);
+                  TBB[dz][qy][qx] += bz * s + g(qz,dz,sz) * v2;
+                  TGB[dz][qy][qx] += bz * v0;
+                  TBG[dz][qy][qx] += bz * v1;
+               }
+            }
+         }
+      }
+      // Transposed contraction in y: tested with B_x (UB) and G_x (UG)
+      double UB[MD1][MD1][MQ1], UG[MD1][MD1][MQ1];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               double u = 0.0, v = 0.0;
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  const double by = b(qy,dy,sy);
+                  u += by * TBB[dz][qy][qx] + g(qy,dy,sy) * TBG[dz][qy][qx];
+                  v += by * TGB[dz][qy][qx];
+               }
+               UB[dz][dy][qx] = u;
+               UG[dz][dy][qx] = v;
+            }
+         }
+      }
+      // Transposed contraction in x
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double u = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  u += b(qx,dx,sx) * UB[dz][dy][qx] +
+                       g(qx,dx,sx) * UG[dz][dy][qx];
+               }
+               Y(dx,dy,dz,e) += W(dx,dy,dz,e) * u;
+            }
+         }
+      }
+   });
+}
+
+void DiffusionIntegrator::AddMultPANURBS(const Vector &x, Vector &y) const
+{
+   const NURBSDofToQuad &m = *nurbs_maps;
+   const int D1D = dofs1D, Q1D = quad1D;
+   if (dim == 2)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x23: return PADiffusionApplyNURBS2D<2,3>(m,pa_data,x,y);
+         case 0x34: return PADiffusionApplyNURBS2D<3,4>(m,pa_data,x,y);
+         case 0x45: return PADiffusionApplyNURBS2D<4,5>(m,pa_data,x,y);
+         case 0x56: return PADiffusionApplyNURBS2D<5,6>(m,pa_data,x,y);
+         default: return PADiffusionApplyNURBS2D(m,pa_data,x,y,D1D,Q1D);
+      }
+   }
+   else if (dim == 3)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x23: return PADiffusionApplyNURBS3D<2,3>(m,pa_data,x,y);
+         case 0x34: return PADiffusionApplyNURBS3D<3,4>(m,pa_data,x,y);
+         case 0x45: return PADiffusionApplyNURBS3D<4,5>(m,pa_data,x,y);
+         case 0x56: return PADiffusionApplyNURBS3D<5,6>(m,pa_data,x,y);
+         default: return PADiffusionApplyNURBS3D(m,pa_data,x,y,D1D,Q1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+void DiffusionIntegrator::AssembleDiagonalPANURBS(Vector &diag) const
+{
+   const int DIM = dim, D1D = dofs1D, Q1D = quad1D, NE = ne;
+   const int ND = nurbs_maps->weights.Size()/NE;
+   const int NQ = (int) floor(pow(Q1D, DIM) + 0.5);
+   auto b = Reshape(nurbs_maps->B.Read(), Q1D, D1D, nurbs_maps->nspans);
+   auto g = Reshape(nurbs_maps->G.Read(), Q1D, D1D, nurbs_maps->nspans);
+   auto S = Reshape(nurbs_maps->spans.Read(), DIM, NE);
+   auto W = Reshape(nurbs_maps->weights.Read(), ND, NE);
+   auto D = Reshape(pa_data.Read(), NQ, DIM*DIM + DIM, NE);
+   auto Y = Reshape(diag.ReadWrite(), ND, NE);
+   MFEM_FORALL(i, ND*NE,
+   {
+      const int e = i / ND, dof = i % ND;
+      const int di[3] = { dof % D1D, (dof / D1D) % D1D, dof / (D1D*D1D) };
+      double val = 0.0;
+      for (int q = 0; q < NQ; q++)
+      {
+         const int qi[3] = { q % Q1D, (q / Q1D) % Q1D, q / (Q1D*Q1D) };
+         double bv[3], gv[3], bq = 1.0;
+         for (int d = 0; d < DIM; d++)
+         {
+            bv[d] = b(qi[d],di[d],S(d,e));
+            gv[d] = g(qi[d],di[d],S(d,e));
+            bq *= bv[d];
+         }
+         // Reference gradient of the basis function, times W/w
+         double r[3];
+         for (int d = 0; d < DIM; d++)
+         {
+            double gq = gv[d];
+            for (int k = 0; k < DIM; k++) { if (k != d) { gq *= bv[k]; } }
+            r[d] = gq - bq * D(q, DIM*DIM + d, e);
+         }
+         for (int j = 0; j < DIM; j++)
+         {
+            for (int k = 0; k < DIM; k++)
+            {
+               val += r[k] * D(q, k + DIM*j, e) * r[j];
+            }
+         }
+      }
+      Y(dof,e) += W(dof,e) * W(dof,e) * val;
+   });
+}
+
+} // namespace mfem
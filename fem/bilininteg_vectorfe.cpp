@@ -782,9 +782,9 @@ void VectorFEMassIntegrator::AssemblePA(const FiniteElementSpace &trial_fes,
 
    Vector coeff(coeffDim * ne * nq);
    coeff = 1.0;
-   auto coeffh = Reshape(coeff.HostWrite(), coeffDim, nq, ne);
-   if (Q || DQ || MQ || SMQ)
+   if (DQ || MQ || SMQ)
    {
+      auto coeffh = Reshape(coeff.HostWrite(), coeffDim, nq, ne);
       Vector D(DQ ? coeffDim : 0);
       DenseMatrix M;
       DenseSymmetricMatrix SM;
@@ -838,13 +838,13 @@ void VectorFEMassIntegrator::AssemblePA(const FiniteElementSpace &trial_fes,
                   coeffh(i, p, e) = D[i];
                }
             }
-            else
-            {
-               coeffh(0, p, e) = Q->Eval(*tr, ir->IntPoint(p));
-            }
          }
       }
    }
+   else if (Q)
+   {
+      Q->EvalBatch(coeff, *mesh, *ir);
+   }
 
    if (trial_curl && test_curl && dim == 3)
    {
@@ -1086,17 +1086,7 @@ void MixedVectorGradientIntegrator::AssemblePA(const FiniteElementSpace
 
    Vector coeff(ne * nq);
    coeff = 1.0;
-   if (Q)
-   {
-      for (int e=0; e<ne; ++e)
-      {
-         ElementTransformation *tr = mesh->GetElementTransformation(e);
-         for (int p=0; p<nq; ++p)
-         {
-            coeff[p + (e * nq)] = Q->Eval(*tr, ir->IntPoint(p));
-         }
-      }
-   }
+   if (Q) { Q->EvalBatch(coeff, *mesh, *ir); }
 
    // Use the same setup functions as VectorFEMassIntegrator.
    if (test_el->GetDerivType() == mfem::FiniteElement::CURL && dim == 3)
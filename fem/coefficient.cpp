@@ -12,6 +12,7 @@
 // Implementation of Coefficient class
 
 #include "fem.hpp"
+#include "../general/forall.hpp"
 
 #include <cmath>
 #include <limits>
@@ -21,6 +22,35 @@ namespace mfem
 
 using namespace std;
 
+void Coefficient::EvalBatch(Vector &qcoeff, Mesh &mesh,
+                            const IntegrationRule &ir)
+{
+   const int NE = mesh.GetNE();
+   const int NQ = ir.GetNPoints();
+   qcoeff.SetSize(NQ*NE);
+   auto C = Reshape(qcoeff.HostWrite(), NQ, NE);
+   for (int e = 0; e < NE; e++)
+   {
+      ElementTransformation &T = *mesh.GetElementTransformation(e);
+      for (int q = 0; q < NQ; q++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         T.SetIntPoint(&ip);
+         C(q,e) = Eval(T, ip);
+      }
+   }
+}
+
+void ConstantCoefficient::EvalBatch(Vector &qcoeff, Mesh &mesh,
+                                    const IntegrationRule &ir)
+{
+   const int N = ir.GetNPoints()*mesh.GetNE();
+   const double c = constant;
+   qcoeff.SetSize(N);
+   auto C = qcoeff.Write();
+   MFEM_FORALL(i, N, C[i] = c;);
+}
+
 double PWConstCoefficient::Eval(ElementTransformation & T,
                                 const IntegrationPoint & ip)
 {
@@ -28,6 +58,24 @@ double PWConstCoefficient::Eval(ElementTransformation & T,
    return (constants(att-1));
 }
 
+void PWConstCoefficient::EvalBatch(Vector &qcoeff, Mesh &mesh,
+                                   const IntegrationRule &ir)
+{
+   const int NE = mesh.GetNE();
+   const int NQ = ir.GetNPoints();
+   Array<int> attr(NE);
+   for (int e = 0; e < NE; e++) { attr[e] = mesh.GetAttribute(e); }
+   qcoeff.SetSize(NQ*NE);
+   const auto A = attr.Read();
+   const auto K = constants.Read();
+   auto C = Reshape(qcoeff.Write(), NQ, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const double c = K[A[e]-1];
+      for (int q = 0; q < NQ; q++) { C(q,e) = c; }
+   });
+}
+
 double FunctionCoefficient::Eval(ElementTransformation & T,
                                  const IntegrationPoint & ip)
 {
@@ -46,12 +94,123 @@ double FunctionCoefficient::Eval(ElementTransformation & T,
    }
 }
 
+// Check if the QuadratureInterpolator kernels can evaluate the physical
+// coordinates of the points of @a ir in all elements of @a mesh.
+static bool BatchedCoordinates(const Mesh &mesh, const IntegrationRule &ir)
+{
+   const GridFunction *nodes = mesh.GetNodes();
+   const int dim = mesh.Dimension();
+   if (mesh.GetNE() == 0 || mesh.NURBSext ||
+       dim != mesh.SpaceDimension() || mesh.GetNumGeometries(dim) != 1)
+   {
+      return false;
+   }
+   // Without nodes, GeometricFactors uses the vertices
+   const int ND = nodes ? nodes->FESpace()->GetFE(0)->GetDof() :
+                  Geometry::NumVerts[mesh.GetElementBaseGeometry(0)];
+   const int NQ = ir.GetNPoints();
+   if (dim == 2)
+   {
+      return ND <= QuadratureInterpolator::MAX_ND2D &&
+             NQ <= QuadratureInterpolator::MAX_NQ2D;
+   }
+   if (dim == 3)
+   {
+      return ND <= QuadratureInterpolator::MAX_ND3D &&
+             NQ <= QuadratureInterpolator::MAX_NQ3D;
+   }
+   return false;
+}
+
+void FunctionCoefficient::EvalBatch(Vector &qcoeff, Mesh &mesh,
+                                    const IntegrationRule &ir)
+{
+   const int NE = mesh.GetNE();
+   if (!BatchedCoordinates(mesh, ir))
+   {
+      Coefficient::EvalBatch(qcoeff, mesh, ir);
+      return;
+   }
+   const int NQ = ir.GetNPoints();
+   const int sdim = mesh.SpaceDimension();
+   // Mesh::GetGeometricFactors() would add nodes to a mesh without them
+   const int flags = GeometricFactors::COORDINATES;
+   GeometricFactors *own_geom =
+      mesh.GetNodes() ? NULL : new GeometricFactors(&mesh, ir, flags);
+   const GeometricFactors *geom =
+      own_geom ? own_geom : mesh.GetGeometricFactors(ir, flags);
+   const auto X = Reshape(geom->X.HostRead(), NQ, sdim, NE);
+   qcoeff.SetSize(NQ*NE);
+   auto C = Reshape(qcoeff.HostWrite(), NQ, NE);
+   Vector transip(sdim);
+   for (int e = 0; e < NE; e++)
+   {
+      for (int q = 0; q < NQ; q++)
+      {
+         for (int d = 0; d < sdim; d++) { transip(d) = X(q,d,e); }
+         C(q,e) = Function ? Function(transip) :
+                  TDFunction(transip, GetTime());
+      }
+   }
+   delete own_geom;
+}
+
 double GridFunctionCoefficient::Eval (ElementTransformation &T,
                                       const IntegrationPoint &ip)
 {
    return GridF -> GetValue (T, ip, Component);
 }
 
+void GridFunctionCoefficient::EvalBatch(Vector &qcoeff, Mesh &mesh,
+                                        const IntegrationRule &ir)
+{
+   const FiniteElementSpace *fes = GridF ? GridF->FESpace() : NULL;
+   const int NE = mesh.GetNE();
+   const int NQ = ir.GetNPoints();
+   const int dim = mesh.Dimension();
+   bool batched = fes && fes->GetMesh() == &mesh && NE > 0 &&
+                  fes->GetVDim() == 1 && !fes->GetNURBSext() &&
+                  fes->GetFE(0)->GetRangeType() == FiniteElement::SCALAR;
+   if (batched)
+   {
+      const int ND = fes->GetFE(0)->GetDof();
+      if (dim == 2)
+      {
+         batched = ND <= QuadratureInterpolator::MAX_ND2D &&
+                   NQ <= QuadratureInterpolator::MAX_NQ2D;
+      }
+      else if (dim == 3)
+      {
+         batched = ND <= QuadratureInterpolator::MAX_ND3D &&
+                   NQ <= QuadratureInterpolator::MAX_NQ3D;
+      }
+      else { batched = false; }
+   }
+   if (!batched)
+   {
+      Coefficient::EvalBatch(qcoeff, mesh, ir);
+      return;
+   }
+
+   const Operator *elem_restr =
+      fes->GetElementRestriction(ElementDofOrdering::NATIVE);
+   const QuadratureInterpolator *qi = fes->GetQuadratureInterpolator(ir);
+   qi->DisableTensorProducts();
+   qi->SetOutputLayout(QVectorLayout::byNODES);
+   qcoeff.SetSize(NQ*NE);
+   if (elem_restr)
+   {
+      Vector e_vec(elem_restr->Height(), Device::GetDeviceMemoryType());
+      e_vec.UseDevice(true);
+      elem_restr->Mult(*GridF, e_vec);
+      qi->Values(e_vec, qcoeff);
+   }
+   else
+   {
+      qi->Values(*GridF, qcoeff);
+   }
+}
+
 double TransformedCoefficient::Eval(ElementTransformation &T,
                                     const IntegrationPoint &ip)
 {
@@ -455,6 +614,47 @@ void MatrixRestrictedCoefficient::Eval(DenseMatrix &K, ElementTransformation &T,
    }
 }
 
+void SumCoefficient::EvalBatch(Vector &qcoeff, Mesh &mesh,
+                               const IntegrationRule &ir)
+{
+   Vector qa;
+   if (a) { a->EvalBatch(qa, mesh, ir); }
+   b->EvalBatch(qcoeff, mesh, ir);
+   const int N = qcoeff.Size();
+   const double al = alpha, be = beta;
+   auto C = qcoeff.ReadWrite();
+   if (a)
+   {
+      const auto A = qa.Read();
+      MFEM_FORALL(i, N, C[i] = al*A[i] + be*C[i];);
+   }
+   else
+   {
+      const double ac = alpha*aConst;
+      MFEM_FORALL(i, N, C[i] = ac + be*C[i];);
+   }
+}
+
+void ProductCoefficient::EvalBatch(Vector &qcoeff, Mesh &mesh,
+                                   const IntegrationRule &ir)
+{
+   Vector qa;
+   if (a) { a->EvalBatch(qa, mesh, ir); }
+   b->EvalBatch(qcoeff, mesh, ir);
+   const int N = qcoeff.Size();
+   auto C = qcoeff.ReadWrite();
+   if (a)
+   {
+      const auto A = qa.Read();
+      MFEM_FORALL(i, N, C[i] *= A[i];);
+   }
+   else
+   {
+      const double ac = aConst;
+      MFEM_FORALL(i, N, C[i] *= ac;);
+   }
+}
+
 InnerProductCoefficient::InnerProductCoefficient(VectorCoefficient &A,
                                                  VectorCoefficient &B)
    : a(&A), b(&B)
@@ -990,4 +1190,22 @@ double QuadratureFunctionCoefficient::Eval(ElementTransformation &T,
    return temp[0];
 }
 
+void QuadratureFunctionCoefficient::EvalBatch(Vector &qcoeff, Mesh &mesh,
+                                              const IntegrationRule &ir)
+{
+   const QuadratureSpace *qspace = QuadF.GetSpace();
+   const int NE = mesh.GetNE();
+   const int N = ir.GetNPoints()*NE;
+   if (qspace->GetMesh() != &mesh || QuadF.Size() != N ||
+       (NE > 0 && &qspace->GetElementIntRule(0) != &ir))
+   {
+      Coefficient::EvalBatch(qcoeff, mesh, ir);
+      return;
+   }
+   qcoeff.SetSize(N);
+   const auto Q = QuadF.Read();
+   auto C = qcoeff.Write();
+   MFEM_FORALL(i, N, C[i] = Q[i];);
+}
+
 }
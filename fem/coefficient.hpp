@@ -70,6 +70,20 @@ public:
       return Eval(T, ip);
    }
 
+   /** @brief Evaluate the coefficient at all points of the IntegrationRule
+       @a ir in all elements of @a mesh. */
+   /** On return, @a qcoeff has size NQ x NE, where NQ is the number of points
+       in @a ir and NE is the number of elements of @a mesh; this is the layout
+       used by the partial assembly setup kernels. All elements of @a mesh are
+       assumed to have the geometry of @a ir.
+
+       The default implementation calls Eval() at every point on the host.
+       Derived classes override it with batched implementations that avoid the
+       per-element ElementTransformation and, where possible, run on the
+       device. */
+   virtual void EvalBatch(Vector &qcoeff, Mesh &mesh,
+                          const IntegrationRule &ir);
+
    virtual ~Coefficient() { }
 };
 
@@ -87,6 +101,10 @@ public:
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip)
    { return (constant); }
+
+   /// Fill @a qcoeff with the constant, see Coefficient::EvalBatch().
+   virtual void EvalBatch(Vector &qcoeff, Mesh &mesh,
+                          const IntegrationRule &ir);
 };
 
 /** @brief A piecewise constant coefficient with the constants keyed
@@ -123,6 +141,11 @@ public:
    /// Evaluate the coefficient.
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
+
+   /** @brief Evaluate the coefficient on the device using the element
+       attributes, see Coefficient::EvalBatch(). */
+   virtual void EvalBatch(Vector &qcoeff, Mesh &mesh,
+                          const IntegrationRule &ir);
 };
 
 /// A general function coefficient
@@ -166,6 +189,13 @@ public:
    /// Evaluate the coefficient at @a ip.
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
+
+   /** @brief Evaluate the function at the physical quadrature points given by
+       the GeometricFactors of @a mesh, see Coefficient::EvalBatch(). */
+   /** The coordinates are computed in batch (on the device, if enabled), while
+       the std::function itself is called on the host. */
+   virtual void EvalBatch(Vector &qcoeff, Mesh &mesh,
+                          const IntegrationRule &ir);
 };
 
 class GridFunction;
@@ -193,6 +223,13 @@ public:
    /// Evaluate the coefficient at @a ip.
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
+
+   /** @brief Interpolate the GridFunction with a QuadratureInterpolator, see
+       Coefficient::EvalBatch(). */
+   /** Falls back to the default implementation if the GridFunction is not a
+       scalar function defined on @a mesh. */
+   virtual void EvalBatch(Vector &qcoeff, Mesh &mesh,
+                          const IntegrationRule &ir);
 };
 
 
@@ -943,6 +980,10 @@ public:
       return alpha * ((a == NULL ) ? aConst : a->Eval(T, ip) )
              + beta * b->Eval(T, ip);
    }
+
+   /// Combine the batched values of the two terms on the device.
+   virtual void EvalBatch(Vector &qcoeff, Mesh &mesh,
+                          const IntegrationRule &ir);
 };
 
 
@@ -1082,6 +1123,10 @@ public:
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip)
    { return ((a == NULL ) ? aConst : a->Eval(T, ip) ) * b->Eval(T, ip); }
+
+   /// Combine the batched values of the two factors on the device.
+   virtual void EvalBatch(Vector &qcoeff, Mesh &mesh,
+                          const IntegrationRule &ir);
 };
 
 /** @brief Scalar coefficient defined as the ratio of two scalars where one or
@@ -1703,6 +1748,11 @@ public:
 
    virtual double Eval(ElementTransformation &T, const IntegrationPoint &ip);
 
+   /** @brief Copy the QuadratureFunction values if they are defined on @a mesh
+       with the rule @a ir, see Coefficient::EvalBatch(). */
+   virtual void EvalBatch(Vector &qcoeff, Mesh &mesh,
+                          const IntegrationRule &ir);
+
    virtual ~QuadratureFunctionCoefficient() { }
 };
 
@@ -109,7 +109,10 @@ DataCollection::DataCollection(const std::string& collection_name, Mesh *mesh_)
    pad_digits_cycle = pad_digits_rank = pad_digits_default;
    format = SERIAL_FORMAT; // use serial mesh format
    compression = false;
+   binary_format = false;
    error = NO_ERROR;
+   saved_mesh = NULL;
+   saved_mesh_sequence = -1;
 }
 
 void DataCollection::SetMesh(Mesh *new_mesh)
@@ -234,10 +237,15 @@ void DataCollection::SaveMesh()
    const ParMesh *pmesh = dynamic_cast<const ParMesh*>(mesh);
    if (pmesh && format == PARALLEL_FORMAT)
    {
-      pmesh->ParPrint(mesh_file);
+      pmesh->ParPrint(mesh_file, binary_format);
    }
    else
 #endif
+   if (binary_format)
+   {
+      mesh->PrintBinary(mesh_file);
+   }
+   else
    {
       mesh->Print(mesh_file);
    }
@@ -248,6 +256,69 @@ void DataCollection::SaveMesh()
    }
 }
 
+// The coordinates and attributes of 'mesh', which are not tracked by its
+// sequence number.
+static void GetMeshState(const Mesh &mesh, Vector &coords,
+                         Array<int> &attributes)
+{
+   if (mesh.GetNodes())
+   {
+      const GridFunction &nodes = *mesh.GetNodes();
+      coords.SetSize(nodes.Size());
+      coords = nodes;
+   }
+   else
+   {
+      mesh.GetVertices(coords);
+   }
+   attributes.SetSize(mesh.GetNE() + mesh.GetNBE());
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      attributes[i] = mesh.GetAttribute(i);
+   }
+   for (int i = 0; i < mesh.GetNBE(); i++)
+   {
+      attributes[mesh.GetNE() + i] = mesh.GetBdrAttribute(i);
+   }
+}
+
+bool DataCollection::MeshChanged() const
+{
+   if (!mesh || mesh != saved_mesh ||
+       mesh->GetSequence() != saved_mesh_sequence)
+   {
+      return true;
+   }
+   Vector coords;
+   Array<int> attributes;
+   GetMeshState(*mesh, coords, attributes);
+   if (coords.Size() != saved_mesh_coords.Size() ||
+       attributes.Size() != saved_mesh_attributes.Size())
+   {
+      return true;
+   }
+   const double *c = coords.HostRead(), *sc = saved_mesh_coords.HostRead();
+   for (int i = 0; i < coords.Size(); i++)
+   {
+      if (c[i] != sc[i]) { return true; }
+   }
+   for (int i = 0; i < attributes.Size(); i++)
+   {
+      if (attributes[i] != saved_mesh_attributes[i]) { return true; }
+   }
+   return false;
+}
+
+void DataCollection::MarkMeshSaved()
+{
+   saved_mesh = mesh;
+   saved_mesh_sequence = mesh ? mesh->GetSequence() : -1;
+   if (mesh)
+   {
+      GetMeshState(*mesh, saved_mesh_coords, saved_mesh_attributes);
+   }
+}
+
 std::string DataCollection::GetMeshShortFileName() const
 {
    return (serial || format == SERIAL_FORMAT) ? "mesh" : "pmesh";
@@ -279,7 +350,14 @@ void DataCollection::SaveOneField(const FieldMapIterator &it)
    mfem::ofgzstream field_file(GetFieldFileName(it->first), compression);
 
    field_file.precision(precision);
-   (it->second)->Save(field_file);
+   if (binary_format)
+   {
+      (it->second)->SaveBinary(field_file);
+   }
+   else
+   {
+      (it->second)->Save(field_file);
+   }
    if (!field_file)
    {
       error = WRITE_ERROR;
@@ -292,7 +370,14 @@ void DataCollection::SaveOneQField(const QFieldMapIterator &it)
    mfem::ofgzstream q_field_file(GetFieldFileName(it->first), compression);
 
    q_field_file.precision(precision);
-   (it->second)->Save(q_field_file);
+   if (binary_format)
+   {
+      (it->second)->SaveBinary(q_field_file);
+   }
+   else
+   {
+      (it->second)->Save(q_field_file);
+   }
    if (!q_field_file)
    {
       error = WRITE_ERROR;
@@ -371,6 +456,8 @@ VisItDataCollection::VisItDataCollection(const std::string& collection_name,
 
    visit_levels_of_detail = 1;
    visit_max_levels_of_detail = 32;
+   reuse_mesh = false;
+   mesh_cycle = -1;
 
    UpdateMeshInfo();
 }
@@ -389,6 +476,8 @@ VisItDataCollection::VisItDataCollection(MPI_Comm comm,
 
    visit_levels_of_detail = 1;
    visit_max_levels_of_detail = 32;
+   reuse_mesh = false;
+   mesh_cycle = -1;
 
    UpdateMeshInfo();
 }
@@ -398,6 +487,7 @@ void VisItDataCollection::SetMesh(Mesh *new_mesh)
 {
    DataCollection::SetMesh(new_mesh);
    appendRankToFileName = true;
+   mesh_cycle = -1;
    UpdateMeshInfo();
 }
 
@@ -470,7 +560,45 @@ void VisItDataCollection::DeleteAll()
 
 void VisItDataCollection::Save()
 {
-   DataCollection::Save();
+   bool write_mesh = !reuse_mesh || mesh_cycle < 0 || MeshChanged();
+#ifdef MFEM_USE_MPI
+   if (!serial)
+   {
+      // The mesh files of all ranks are in the same directory
+      int changed = write_mesh, any_changed;
+      MPI_Allreduce(&changed, &any_changed, 1, MPI_INT, MPI_LOR, m_comm);
+      write_mesh = any_changed;
+   }
+#endif
+   if (write_mesh)
+   {
+      DataCollection::Save();
+      if (reuse_mesh) { MarkMeshSaved(); }
+      mesh_cycle = cycle;
+   }
+   else
+   {
+      std::string dir_name = prefix_path + name;
+      if (cycle != -1)
+      {
+         dir_name += "_" + to_padded_string(cycle, pad_digits_cycle);
+      }
+      if (create_directory(dir_name, mesh, myid))
+      {
+         error = WRITE_ERROR;
+         MFEM_WARNING("Error creating directory: " << dir_name);
+         return;
+      }
+      for (FieldMapIterator it = field_map.begin(); it != field_map.end(); ++it)
+      {
+         SaveOneField(it);
+      }
+      for (QFieldMapIterator it = q_field_map.begin(); it != q_field_map.end();
+           ++it)
+      {
+         SaveOneQField(it);
+      }
+   }
    SaveRootFile();
 }
 
@@ -565,7 +693,11 @@ void VisItDataCollection::LoadMesh()
 {
    // GetMeshFileName() uses 'serial', so we need to set it in advance.
    serial = (format == SERIAL_FORMAT);
+   // The mesh may have been written in an earlier cycle, see SetMeshReuse().
+   const int data_cycle = cycle;
+   if (mesh_cycle >= 0) { cycle = mesh_cycle; }
    std::string mesh_fname = GetMeshFileName();
+   cycle = data_cycle;
    named_ifgzstream file(mesh_fname);
    // TODO: in parallel, check for errors on all processors
    if (!file)
@@ -654,6 +786,13 @@ std::string VisItDataCollection::GetVisItRootString()
    // Get the path string (relative to where the root file is, i.e. no prefix).
    std::string path_str =
       name + "_" + to_padded_string(cycle, pad_digits_cycle) + "/";
+   // The mesh files may be in the directory of an earlier cycle
+   std::string mesh_path_str = path_str;
+   if (reuse_mesh && mesh_cycle >= 0)
+   {
+      mesh_path_str =
+         name + "_" + to_padded_string(mesh_cycle, pad_digits_cycle) + "/";
+   }
 
    // We have to build the json tree inside out to get all the values in there
    picojson::object top, dsets, main, mesh, fields, field, mtags, ftags;
@@ -663,7 +802,7 @@ std::string VisItDataCollection::GetVisItRootString()
    mtags["spatial_dim"] = picojson::value(to_string(spatial_dim));
    mtags["topo_dim"] = picojson::value(to_string(topo_dim));
    mtags["max_lods"] = picojson::value(to_string(visit_max_levels_of_detail));
-   mesh["path"] = picojson::value(path_str + GetMeshShortFileName() +
+   mesh["path"] = picojson::value(mesh_path_str + GetMeshShortFileName() +
                                   file_ext_format);
    mesh["tags"] = picojson::value(mtags);
    mesh["format"] = picojson::value(to_string(format));
@@ -732,6 +871,10 @@ void VisItDataCollection::ParseVisItRootString(const std::string& json)
       return;
    }
    name = path.substr(0, right_sep);
+   // The cycle of the directory with the mesh files, see SetMeshReuse()
+   size_t dir_sep = path.find('/', right_sep);
+   mesh_cycle = (dir_sep == std::string::npos) ? -1 :
+                to_int(path.substr(right_sep + 1, dir_sep - right_sep - 1));
 
    if (mesh.contains("format"))
    {
@@ -764,7 +907,8 @@ ParaViewDataCollection::ParaViewDataCollection(const std::string&
    : DataCollection(collection_name, mesh_),
      levels_of_detail(1),
      pv_data_format(VTKFormat::BINARY),
-     high_order_output(false)
+     high_order_output(false),
+     mesh_vtu_ref(-1)
 {
 #ifdef MFEM_USE_ZLIB
    compression = -1; // default zlib compression level, equivalent to 6
@@ -944,7 +1088,23 @@ void ParaViewDataCollection::SaveDataVTU(std::ostream &out, int ref)
    }
    out << " version=\"0.1\" byte_order=\"" << VTKByteOrder() << "\">\n";
    out << "<UnstructuredGrid>\n";
-   mesh->PrintVTU(out,ref,pv_data_format,high_order_output,compression);
+   if (mesh_vtu_ref != ref || mesh_vtu_format != pv_data_format ||
+       mesh_vtu_high_order != high_order_output ||
+       mesh_vtu_compression != compression ||
+       mesh_vtu_precision != out.precision() || MeshChanged())
+   {
+      std::ostringstream mesh_out;
+      mesh_out.precision(out.precision());
+      mesh->PrintVTU(mesh_out,ref,pv_data_format,high_order_output,compression);
+      mesh_vtu = mesh_out.str();
+      mesh_vtu_ref = ref;
+      mesh_vtu_format = pv_data_format;
+      mesh_vtu_high_order = high_order_output;
+      mesh_vtu_compression = compression;
+      mesh_vtu_precision = out.precision();
+      MarkMeshSaved();
+   }
+   out << mesh_vtu;
 
    // dump out the grid functions as point data
    out << "<PointData >\n";
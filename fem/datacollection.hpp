@@ -207,6 +207,8 @@ protected:
    /// Output mesh format: see the #Format enumeration
    int format;
    int compression;
+   /// Write the mesh and fields in MFEM's binary formats
+   bool binary_format;
 
    /// Should the collection delete its mesh and fields
    bool own_data;
@@ -214,6 +216,18 @@ protected:
    /// Error state
    int error;
 
+   /// State of the mesh when it was last saved, see MeshChanged()
+   const Mesh *saved_mesh;
+   long saved_mesh_sequence;
+   Vector saved_mesh_coords;
+   Array<int> saved_mesh_attributes;
+
+   /** @brief Returns true if the mesh was never saved, or if it was refined,
+       moved or given new attributes since the last call to MarkMeshSaved(). */
+   bool MeshChanged() const;
+   /// Record the current state of the mesh, see MeshChanged().
+   void MarkMeshSaved();
+
    /// Delete data owned by the DataCollection keeping field information
    void DeleteData();
    /// Delete data owned by the DataCollection including field information
@@ -351,6 +365,11 @@ public:
    /// Set the flag for use of gz compressed files
    virtual void SetCompression(bool comp);
 
+   /** @brief Set the flag for writing the mesh and fields in MFEM's binary
+       formats, see Mesh::PrintBinary() and GridFunction::SaveBinary(). */
+   /** Loading detects the binary formats automatically. */
+   void SetBinaryFormat(bool bin) { binary_format = bin; }
+
    /// Set the path where the DataCollection will be saved.
    void SetPrefixPath(const std::string &prefix);
 
@@ -413,6 +432,11 @@ protected:
    std::map<std::string, VisItFieldInfo> field_info_map;
    typedef std::map<std::string, VisItFieldInfo>::iterator FieldInfoMapIterator;
 
+   /// Write the mesh only when it changes, see SetMeshReuse()
+   bool reuse_mesh;
+   /// Cycle whose directory contains the mesh files of the current cycle
+   int mesh_cycle;
+
    /// Prepare the VisIt root file in JSON format for the current collection
    std::string GetVisItRootString();
    /// Read in a VisIt root file in JSON format
@@ -466,6 +490,15 @@ public:
        information. */
    void DeleteAll();
 
+   /** @brief Write the mesh only in the cycles where it changed (default:
+       false). */
+   /** When enabled, Save() writes the mesh files only if the mesh was refined,
+       moved or given new attributes since it was last written, see
+       DataCollection::MeshChanged(). The root files of the other cycles refer
+       to the mesh files in the directory of the last cycle that wrote them,
+       which is understood by VisIt and by Load(). */
+   void SetMeshReuse(bool reuse) { reuse_mesh = reuse; }
+
    /// Save the collection and a VisIt root file
    virtual void Save();
 
@@ -489,6 +522,13 @@ private:
    VTKFormat pv_data_format;
    bool high_order_output;
 
+   // The VTU output of the mesh and the parameters used to generate it, reused
+   // by the cycles where the mesh did not change
+   std::string mesh_vtu;
+   int mesh_vtu_ref, mesh_vtu_compression, mesh_vtu_precision;
+   VTKFormat mesh_vtu_format;
+   bool mesh_vtu_high_order;
+
 protected:
    void SaveDataVTU(std::ostream &out, int ref);
    void SaveGFieldVTU(std::ostream& out, int ref_, const FieldMapIterator& it);
@@ -518,6 +558,9 @@ public:
 
    /// Save the collection - the directory name is constructed based on the
    /// cycle value
+   /** The geometry part of the VTU files is generated only when the mesh or
+       the output parameters changed since the previous Save(); otherwise the
+       previous output is copied. */
    virtual void Save() override;
 
    /// Set the data format for the ParaView output files. Possible options are
@@ -0,0 +1,513 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "dgmassinv.hpp"
+#include "../general/forall.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace mfem
+{
+
+DGMassInverse::DGMassInverse(const FiniteElementSpace &fes_,
+                             const IntegrationRule *ir_)
+   : Solver(fes_.GetVSize()), fes(fes_), ir(NULL), mass(NULL),
+     rel_tol(1e-12), abs_tol(0.0), max_iter(100)
+{
+   Init(NULL, ir_);
+}
+
+DGMassInverse::DGMassInverse(const FiniteElementSpace &fes_, Coefficient &Q,
+                             const IntegrationRule *ir_)
+   : Solver(fes_.GetVSize()), fes(fes_), ir(NULL), mass(NULL),
+     rel_tol(1e-12), abs_tol(0.0), max_iter(100)
+{
+   Init(&Q, ir_);
+}
+
+void DGMassInverse::Init(Coefficient *Q, const IntegrationRule *ir_)
+{
+   Mesh *mesh = fes.GetMesh();
+   const int dim = mesh->Dimension();
+   MFEM_VERIFY(dynamic_cast<const L2_FECollection*>(fes.FEColl()),
+               "DGMassInverse requires an L2 finite element space.");
+   MFEM_VERIFY(fes.GetVDim() == 1, "Vector spaces are not supported.");
+   MFEM_VERIFY(dim == 2 || dim == 3, "Only 2D and 3D meshes are supported.");
+   MFEM_VERIFY(!DeviceCanUseCeed(), "The libCEED backend is not supported.");
+   if (mesh->GetNE() == 0) { return; }
+
+   const FiniteElement &el = *fes.GetFE(0);
+   MFEM_VERIFY(dynamic_cast<const TensorBasisElement*>(&el),
+               "DGMassInverse requires tensor product elements.");
+   ir = ir_ ? ir_ : &MassIntegrator::GetRule(
+           el, el, *mesh->GetElementTransformation(0));
+   // The sum factorized kernels use the same 1D rule in each direction
+   const int nq = ir->GetNPoints();
+   const int nq1d = (int) std::floor(std::pow(nq, 1.0/dim) + 0.5);
+   MFEM_VERIFY(nq == (dim == 2 ? nq1d*nq1d : nq1d*nq1d*nq1d),
+               "The integration rule must be a tensor product rule, it has "
+               << nq << " points.");
+   mass = Q ? new MassIntegrator(*Q, ir) : new MassIntegrator(ir);
+   Update();
+}
+
+void DGMassInverse::Update()
+{
+   if (!mass) { return; }
+   mass->AssemblePA(fes);
+
+   const int dim = fes.GetMesh()->Dimension();
+   const int NE = fes.GetNE();
+   const int D1D = mass->dofs1D;
+   const int Q1D = mass->quad1D;
+   const int NQ = ir->GetNPoints();
+
+   // The tensor product weights are W(qx,qy,qz) = w(qx) w(qy) w(qz)
+   const double *W = ir->GetWeights().HostRead();
+   const double w0 = std::pow(W[0], 1.0/dim);
+   Vector w(Q1D);
+   for (int q = 0; q < Q1D; q++) { w(q) = W[q] / std::pow(w0, dim-1); }
+
+   // Inverse of the 1D mass matrix
+   const double *B = mass->maps->B.HostRead();
+   DenseMatrix M(D1D), Minv;
+   for (int i = 0; i < D1D; i++)
+   {
+      for (int j = 0; j < D1D; j++)
+      {
+         double m_ij = 0.0;
+         for (int q = 0; q < Q1D; q++)
+         {
+            m_ij += w(q) * B[q+Q1D*i] * B[q+Q1D*j];
+         }
+         M(i,j) = m_ij;
+      }
+   }
+   DenseMatrixInverse(M).GetInverseMatrix(Minv);
+   minv.SetSize(D1D*D1D);
+   double *h_minv = minv.HostWrite();
+   for (int k = 0; k < D1D*D1D; k++) { h_minv[k] = Minv.Data()[k]; }
+
+   // In each element, the partially assembled data is W times the product of
+   // the coefficient and the Jacobian determinant. If this product is
+   // constant, the element mass matrix is a scaled tensor product.
+   const double *d = mass->pa_data.HostRead();
+   scale.SetSize(NE);
+   exact.SetSize(NE);
+   double *h_scale = scale.HostWrite();
+   int *h_exact = exact.HostWrite();
+   for (int e = 0; e < NE; e++)
+   {
+      double mean = 0.0;
+      for (int q = 0; q < NQ; q++) { mean += d[q+NQ*e] / W[q]; }
+      mean /= NQ;
+      double dev = 0.0;
+      for (int q = 0; q < NQ; q++)
+      {
+         dev = std::max(dev, std::abs(d[q+NQ*e] / W[q] - mean));
+      }
+      h_scale[e] = 1.0 / mean;
+      h_exact[e] = (dev <= 1e-12 * std::abs(mean));
+   }
+}
+
+// y = D B x, followed by y = B^T y, with the sum-factorized 1D basis B (Q1D x
+// D1D) and the element quadrature data D.
+template<int MD1, int MQ1> MFEM_HOST_DEVICE inline
+void DGMassApply2D(const int D1D, const int Q1D, const double *B,
+                   const double *D, const double *x, double *y)
+{
+   constexpr int MDQ = (MD1 > MQ1) ? MD1 : MQ1;
+   double T1[MDQ*MDQ], T2[MDQ*MDQ];
+   for (int dy = 0; dy < D1D; dy++)
+   {
+      for (int qx = 0; qx < Q1D; qx++)
+      {
+         double u = 0.0;
+         for (int dx = 0; dx < D1D; dx++) { u += B[qx+Q1D*dx] * x[dx+D1D*dy]; }
+         T1[qx+Q1D*dy] = u;
+      }
+   }
+   for (int qy = 0; qy < Q1D; qy++)
+   {
+      for (int qx = 0; qx < Q1D; qx++)
+      {
+         double u = 0.0;
+         for (int dy = 0; dy < D1D; dy++) { u += B[qy+Q1D*dy] * T1[qx+Q1D*dy]; }
+         T2[qx+Q1D*qy] = D[qx+Q1D*qy] * u;
+      }
+   }
+   for (int qy = 0; qy < Q1D; qy++)
+   {
+      for (int dx = 0; dx < D1D; dx++)
+      {
+         double u = 0.0;
+         for (int qx = 0; qx < Q1D; qx++) { u += B[qx+Q1D*dx] * T2[qx+Q1D*qy]; }
+         T1[dx+D1D*qy] = u;
+      }
+   }
+   for (int dy = 0; dy < D1D; dy++)
+   {
+      for (int dx = 0; dx < D1D; dx++)
+      {
+         double u = 0.0;
+         for (int qy = 0; qy < Q1D; qy++) { u += B[qy+Q1D*dy] * T1[dx+D1D*qy]; }
+         y[dx+D1D*dy] = u;
+      }
+   }
+}
+
+template<int MD1, int MQ1> MFEM_HOST_DEVICE inline
+void DGMassApply3D(const int D1D, const int Q1D, const double *B,
+                   const double *D, const double *x, double *y)
+{
+   constexpr int MDQ = (MD1 > MQ1) ? MD1 : MQ1;
+   double T1[MDQ*MDQ*MDQ], T2[MDQ*MDQ*MDQ];
+   for (int dz = 0; dz < D1D; dz++)
+   {
+      for (int dy = 0; dy < D1D; dy++)
+      {
+         for (int qx = 0; qx < Q1D; qx++)
+         {
+            double u = 0.0;
+            for (int dx = 0; dx < D1D; dx++)
+            {
+               u += B[qx+Q1D*dx] * x[dx+D1D*(dy+D1D*dz)];
+            }
+            T1[qx+Q1D*(dy+D1D*dz)] = u;
+         }
+      }
+   }
+   for (int dz = 0; dz < D1D; dz++)
+   {
+      for (int qy = 0; qy < Q1D; qy++)
+      {
+         for (int qx = 0; qx < Q1D; qx++)
+         {
+            double u = 0.0;
+            for (int dy = 0; dy < D1D; dy++)
+            {
+               u += B[qy+Q1D*dy] * T1[qx+Q1D*(dy+D1D*dz)];
+            }
+            T2[qx+Q1D*(qy+Q1D*dz)] = u;
+         }
+      }
+   }
+   for (int qz = 0; qz < Q1D; qz++)
+   {
+      for (int qy = 0; qy < Q1D; qy++)
+      {
+         for (int qx = 0; qx < Q1D; qx++)
+         {
+            double u = 0.0;
+            for (int dz = 0; dz < D1D; dz++)
+            {
+               u += B[qz+Q1D*dz] * T2[qx+Q1D*(qy+Q1D*dz)];
+            }
+            const int q = qx+Q1D*(qy+Q1D*qz);
+            T1[q] = D[q] * u;
+         }
+      }
+   }
+   for (int dz = 0; dz < D1D; dz++)
+   {
+      for (int qy = 0; qy < Q1D; qy++)
+      {
+         for (int qx = 0; qx < Q1D; qx++)
+         {
+            double u = 0.0;
+            for (int qz = 0; qz < Q1D; qz++)
+            {
+               u += B[qz+Q1D*dz] * T1[qx+Q1D*(qy+Q1D*qz)];
+            }
+            T2[qx+Q1D*(qy+Q1D*dz)] = u;
+         }
+      }
+   }
+   for (int dz = 0; dz < D1D; dz++)
+   {
+      for (int dy = 0; dy < D1D; dy++)
+      {
+         for (int qx = 0; qx < Q1D; qx++)
+         {
+            double u = 0.0;
+            for (int qy = 0; qy < Q1D; qy++)
+            {
+               u += B[qy+Q1D*dy] * T2[qx+Q1D*(qy+Q1D*dz)];
+            }
+            T1[qx+Q1D*(dy+D1D*dz)] = u;
+         }
+      }
+   }
+   for (int dz = 0; dz < D1D; dz++)
+   {
+      for (int dy = 0; dy < D1D; dy++)
+      {
+         for (int dx = 0; dx < D1D; dx++)
+         {
+            double u = 0.0;
+            for (int qx = 0; qx < Q1D; qx++)
+            {
+               u += B[qx+Q1D*dx] * T1[qx+Q1D*(dy+D1D*dz)];
+            }
+            y[dx+D1D*(dy+D1D*dz)] = u;
+         }
+      }
+   }
+}
+
+// y = s (Minv x Minv) x, with the inverse 1D mass matrix Minv (D1D x D1D).
+template<int MD1> MFEM_HOST_DEVICE inline
+void DGTensorInverse2D(const int D1D, const double *Minv, const double s,
+                       const double *x, double *y)
+{
+   double T[MD1*MD1];
+   for (int l = 0; l < D1D; l++)
+   {
+      for (int i = 0; i < D1D; i++)
+      {
+         double u = 0.0;
+         for (int k = 0; k < D1D; k++) { u += Minv[i+D1D*k] * x[k+D1D*l]; }
+         T[i+D1D*l] = u;
+      }
+   }
+   for (int j = 0; j < D1D; j++)
+   {
+      for (int i = 0; i < D1D; i++)
+      {
+         double u = 0.0;
+         for (int l = 0; l < D1D; l++) { u += Minv[j+D1D*l] * T[i+D1D*l]; }
+         y[i+D1D*j] = s * u;
+      }
+   }
+}
+
+template<int MD1> MFEM_HOST_DEVICE inline
+void DGTensorInverse3D(const int D1D, const double *Minv, const double s,
+                       const double *x, double *y)
+{
+   double T1[MD1*MD1*MD1], T2[MD1*MD1*MD1];
+   for (int m = 0; m < D1D; m++)
+   {
+      for (int l = 0; l < D1D; l++)
+      {
+         for (int i = 0; i < D1D; i++)
+         {
+            double u = 0.0;
+            for (int k = 0; k < D1D; k++)
+            {
+               u += Minv[i+D1D*k] * x[k+D1D*(l+D1D*m)];
+            }
+            T1[i+D1D*(l+D1D*m)] = u;
+         }
+      }
+   }
+   for (int m = 0; m < D1D; m++)
+   {
+      for (int j = 0; j < D1D; j++)
+      {
+         for (int i = 0; i < D1D; i++)
+         {
+            double u = 0.0;
+            for (int l = 0; l < D1D; l++)
+            {
+               u += Minv[j+D1D*l] * T1[i+D1D*(l+D1D*m)];
+            }
+            T2[i+D1D*(j+D1D*m)] = u;
+         }
+      }
+   }
+   for (int k = 0; k < D1D; k++)
+   {
+      for (int j = 0; j < D1D; j++)
+      {
+         for (int i = 0; i < D1D; i++)
+         {
+            double u = 0.0;
+            for (int m = 0; m < D1D; m++)
+            {
+               u += Minv[k+D1D*m] * T2[i+D1D*(j+D1D*m)];
+            }
+            y[i+D1D*(j+D1D*k)] = s * u;
+         }
+      }
+   }
+}
+
+// Apply the inverse of the element mass matrices: directly with the tensor
+// product inverse in the elements where it is exact, and with CG
+// preconditioned by the tensor product inverse in the other elements.
+template<int DIM, int T_D1D = 0, int T_Q1D = 0>
+static void DGMassInverseApply(const int NE,
+                               const Array<double> &b_,
+                               const Array<double> &minv_,
+                               const Vector &d_,
+                               const Vector &s_,
+                               const Array<int> &exact_,
+                               const double rel_tol,
+                               const double abs_tol,
+                               const int max_iter,
+                               const Vector &x_,
+                               Vector &y_,
+                               const int d1d = 0,
+                               const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   const int ND = (DIM == 2) ? D1D*D1D : D1D*D1D*D1D;
+   const int NQ = (DIM == 2) ? Q1D*Q1D : Q1D*Q1D*Q1D;
+   const double *B = b_.Read();
+   const double *Minv = minv_.Read();
+   const auto D = Reshape(d_.Read(), NQ, NE);
+   const double *S = s_.Read();
+   const int *E = exact_.Read();
+   const auto X = Reshape(x_.Read(), ND, NE);
+   auto Y = Reshape(y_.Write(), ND, NE);
+   const double rel_tol2 = rel_tol*rel_tol, abs_tol2 = abs_tol*abs_tol;
+   MFEM_FORALL(e, NE,
+   {
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      constexpr int max_ND = (DIM == 2) ? max_D1D*max_D1D :
+                             max_D1D*max_D1D*max_D1D;
+      double r[max_ND], z[max_ND], p[max_ND], ap[max_ND];
+      double *y = &Y(0,e);
+      for (int i = 0; i < ND; i++) { r[i] = X(i,e); }
+      if (DIM == 2) { DGTensorInverse2D<max_D1D>(D1D, Minv, S[e], r, z); }
+      else          { DGTensorInverse3D<max_D1D>(D1D, Minv, S[e], r, z); }
+      if (E[e])
+      {
+         for (int i = 0; i < ND; i++) { y[i] = z[i]; }
+         return;
+      }
+
+      double rz = 0.0;
+      for (int i = 0; i < ND; i++)
+      {
+         y[i] = 0.0;
+         p[i] = z[i];
+         rz += r[i] * z[i];
+      }
+      const double rz_stop = fmax(rz*rel_tol2, abs_tol2);
+      for (int it = 0; it < max_iter && rz > rz_stop; it++)
+      {
+         if (DIM == 2)
+         {
+            DGMassApply2D<max_D1D,max_Q1D>(D1D, Q1D, B, &D(0,e), p, ap);
+         }
+         else
+         {
+            DGMassApply3D<max_D1D,max_Q1D>(D1D, Q1D, B, &D(0,e), p, ap);
+         }
+         double pap = 0.0;
+         for (int i = 0; i < ND; i++) { pap += p[i] * ap[i]; }
+         const double alpha = rz / pap;
+         for (int i = 0; i < ND; i++)
+         {
+            y[i] += alpha * p[i];
+            r[i] -= alpha * ap[i];
+         }
+         if (DIM == 2) { DGTensorInverse2D<max_D1D>(D1D, Minv, S[e], r, z); }
+         else          { DGTensorInverse3D<max_D1D>(D1D, Minv, S[e], r, z); }
+         double rz_new = 0.0;
+         for (int i = 0; i < ND; i++) { rz_new += r[i] * z[i]; }
+         const double beta = rz_new / rz;
+         rz = rz_new;
+         for (int i = 0; i < ND; i++) { p[i] = z[i] + beta * p[i]; }
+      }
+   });
+}
+
+void DGMassInverse::Mult(const Vector &b, Vector &x) const
+{
+   if (!mass) { return; }
+   const int dim = fes.GetMesh()->Dimension();
+   const int NE = fes.GetNE();
+   const int D1D = mass->dofs1D;
+   const int Q1D = mass->quad1D;
+   const Array<double> &B = mass->maps->B;
+   const Vector &D = mass->pa_data;
+   const int id = (D1D << 4) | Q1D;
+   if (dim == 2)
+   {
+      switch (id)
+      {
+         case 0x22: return DGMassInverseApply<2,2,2>(NE,B,minv,D,scale,exact,
+                                                        rel_tol,abs_tol,
+                                                        max_iter,b,x);
+         case 0x23: return DGMassInverseApply<2,2,3>(NE,B,minv,D,scale,exact,
+                                                        rel_tol,abs_tol,
+                                                        max_iter,b,x);
+         case 0x33: return DGMassInverseApply<2,3,3>(NE,B,minv,D,scale,exact,
+                                                        rel_tol,abs_tol,
+                                                        max_iter,b,x);
+         case 0x34: return DGMassInverseApply<2,3,4>(NE,B,minv,D,scale,exact,
+                                                        rel_tol,abs_tol,
+                                                        max_iter,b,x);
+         case 0x44: return DGMassInverseApply<2,4,4>(NE,B,minv,D,scale,exact,
+                                                        rel_tol,abs_tol,
+                                                        max_iter,b,x);
+         case 0x45: return DGMassInverseApply<2,4,5>(NE,B,minv,D,scale,exact,
+                                                        rel_tol,abs_tol,
+                                                        max_iter,b,x);
+         case 0x55: return DGMassInverseApply<2,5,5>(NE,B,minv,D,scale,exact,
+                                                        rel_tol,abs_tol,
+                                                        max_iter,b,x);
+         case 0x56: return DGMassInverseApply<2,5,6>(NE,B,minv,D,scale,exact,
+                                                        rel_tol,abs_tol,
+                                                        max_iter,b,x);
+         case 0x66: return DGMassInverseApply<2,6,6>(NE,B,minv,D,scale,exact,
+                                                        rel_tol,abs_tol,
+                                                        max_iter,b,x);
+         case 0x67: return DGMassInverseApply<2,6,7>(NE,B,minv,D,scale,exact,
+                                                        rel_tol,abs_tol,
+                                                        max_iter,b,x);
+         default: return DGMassInverseApply<2>(NE,B,minv,D,scale,exact,
+                                                  rel_tol,abs_tol,max_iter,
+                                                  b,x,D1D,Q1D);
+      }
+   }
+   switch (id)
+   {
+      case 0x22: return DGMassInverseApply<3,2,2>(NE,B,minv,D,scale,exact,
+                                                     rel_tol,abs_tol,max_iter,
+                                                     b,x);
+      case 0x23: return DGMassInverseApply<3,2,3>(NE,B,minv,D,scale,exact,
+                                                     rel_tol,abs_tol,max_iter,
+                                                     b,x);
+      case 0x33: return DGMassInverseApply<3,3,3>(NE,B,minv,D,scale,exact,
+                                                     rel_tol,abs_tol,max_iter,
+                                                     b,x);
+      case 0x34: return DGMassInverseApply<3,3,4>(NE,B,minv,D,scale,exact,
+                                                     rel_tol,abs_tol,max_iter,
+                                                     b,x);
+      case 0x44: return DGMassInverseApply<3,4,4>(NE,B,minv,D,scale,exact,
+                                                     rel_tol,abs_tol,max_iter,
+                                                     b,x);
+      case 0x45: return DGMassInverseApply<3,4,5>(NE,B,minv,D,scale,exact,
+                                                     rel_tol,abs_tol,max_iter,
+                                                     b,x);
+      case 0x55: return DGMassInverseApply<3,5,5>(NE,B,minv,D,scale,exact,
+                                                     rel_tol,abs_tol,max_iter,
+                                                     b,x);
+      case 0x56: return DGMassInverseApply<3,5,6>(NE,B,minv,D,scale,exact,
+                                                     rel_tol,abs_tol,max_iter,
+                                                     b,x);
+      default: return DGMassInverseApply<3>(NE,B,minv,D,scale,exact,
+                                               rel_tol,abs_tol,max_iter,
+                                               b,x,D1D,Q1D);
+   }
+}
+
+} // namespace mfem
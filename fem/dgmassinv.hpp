@@ -0,0 +1,96 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_DGMASSINV
+#define MFEM_DGMASSINV
+
+#include "fespace.hpp"
+#include "bilininteg.hpp"
+
+#include "../linalg/operator.hpp"
+
+namespace mfem
+{
+
+/** @brief Matrix-free inverse of the mass matrix of a discontinuous (L2)
+    finite element space on quadrilateral or hexahedral elements. */
+/** The mass matrix of an L2 space is block diagonal, and each element block is
+    inverted independently, using only the partially assembled mass data, i.e.
+    O(p^d) memory per element. In each element, the mass matrix is compared
+    with the tensor product of the 1D mass matrices scaled by the mean of
+    (coefficient x Jacobian determinant) over the element:
+
+    - if they agree, which is the case for affine elements with a constant
+      coefficient, the block is inverted exactly by applying the inverse 1D
+      mass matrix in each direction;
+
+    - otherwise, e.g. for curved elements, the block is inverted with an
+      element-local CG solver, preconditioned with this tensor product inverse.
+
+    All elements are processed in parallel with MFEM_FORALL. The operator acts
+    on L-vectors of the space, which for L2 spaces (and vdim = 1) are ordered
+    by elements. The element-local CG iterations stop when the preconditioned
+    residual of the element satisfies the relative or absolute tolerances, see
+    SetRelTol() and SetAbsTol(), or after SetMaxIter() iterations. */
+class DGMassInverse : public Solver
+{
+protected:
+   const FiniteElementSpace &fes;
+   const IntegrationRule *ir;
+   MassIntegrator *mass;
+   Array<double> minv;   ///< Inverse of the 1D mass matrix, D1D x D1D
+   Vector scale;         ///< Inverse of the mean scaling of each element
+   Array<int> exact;     ///< Is the tensor product inverse exact, by element?
+   double rel_tol, abs_tol;
+   int max_iter;
+
+   void Init(Coefficient *Q, const IntegrationRule *ir_);
+
+public:
+   /** @brief Construct the inverse of the mass matrix of @a fes_, with unit
+       coefficient. */
+   /** If @a ir_ is NULL, the integration rule of MassIntegrator is used.
+       Otherwise, @a ir_ must be a tensor product rule, with the points of the
+       1D Gauss-Legendre rule of the same order in each direction. */
+   DGMassInverse(const FiniteElementSpace &fes_,
+                 const IntegrationRule *ir_ = NULL);
+
+   /** @brief Construct the inverse of the mass matrix of @a fes_, with
+       coefficient @a Q. */
+   DGMassInverse(const FiniteElementSpace &fes_, Coefficient &Q,
+                 const IntegrationRule *ir_ = NULL);
+
+   /// Set the relative tolerance of the element-local CG solvers.
+   void SetRelTol(double rtol) { rel_tol = rtol; }
+
+   /// Set the absolute tolerance of the element-local CG solvers.
+   void SetAbsTol(double atol) { abs_tol = atol; }
+
+   /// Set the maximum number of iterations of the element-local CG solvers.
+   void SetMaxIter(int max_it) { max_iter = max_it; }
+
+   /** @brief Recompute the partially assembled mass data, e.g. after the mesh
+       nodes or the coefficient changed. */
+   void Update();
+
+   /// Not supported, the operator is defined by the space and the coefficient.
+   virtual void SetOperator(const Operator &op)
+   { MFEM_ABORT("DGMassInverse does not support SetOperator!"); }
+
+   /// Compute @a x = M^{-1} @a b.
+   virtual void Mult(const Vector &b, Vector &x) const;
+
+   virtual ~DGMassInverse() { delete mass; }
+};
+
+} // namespace mfem
+
+#endif
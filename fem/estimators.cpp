@@ -10,6 +10,9 @@
 // CONTRIBUTING.md for details.
 
 #include "estimators.hpp"
+#include "../general/forall.hpp"
+
+#include <map>
 
 namespace mfem
 {
@@ -130,6 +133,9 @@ void KellyErrorEstimator::ResetCoefficientFunctions()
       }
       return diameter/(2.0*order);
    };
+
+   default_element_coefficient = true;
+   default_face_coefficient = true;
 }
 
 void KellyErrorEstimator::ComputeEstimates()
@@ -187,229 +193,565 @@ void KellyErrorEstimator::ComputeEstimates()
       flux.AddElementVector(fdofs, el_f);
    }
 
-   // 2. Add error contribution from local interior faces
-   for (int f = 0; f < pmesh->GetNumFaces(); f++)
-   {
-      auto FT = pmesh->GetFaceElementTransformations(f);
-
-      auto &int_rule = IntRules.Get(FT->FaceGeom, 2 * xfes->GetFaceOrder(f));
-      const auto nip = int_rule.GetNPoints();
+   // Synchronize face data.
+   flux.ExchangeFaceNbrData();
 
-      if (pmesh->FaceIsInterior(f))
+   if (UseBatchedFaceJumps())
+   {
+      // 2. & 3. Add error contribution from all interior faces at once
+      AddFaceJumps(flux);
+   }
+   else
+   {
+      // 2. Add error contribution from local interior faces
+      for (int f = 0; f < pmesh->GetNumFaces(); f++)
       {
-         int Inf1, Inf2, NCFace;
-         pmesh->GetFaceInfos(f, &Inf1, &Inf2, &NCFace);
-
-         // Convention
-         // * Conforming face: Face side with smaller element id handles
-         // the integration
-         // * Non-conforming face: The slave handles the integration.
-         // See FaceInfo documentation for details.
-         bool isNCSlave    = FT->Elem2No >= 0 && NCFace >= 0;
-         bool isConforming = FT->Elem2No >= 0 && NCFace == -1;
-         if ((FT->Elem1No < FT->Elem2No && isConforming) || isNCSlave)
-         {
-            if (attributes.Size() &&
-                (attributes.FindSorted(FT->Elem1->Attribute) == -1
-                 || attributes.FindSorted(FT->Elem2->Attribute) == -1))
-            {
-               continue;
-            }
+         auto FT = pmesh->GetFaceElementTransformations(f);
 
-            IntegrationRule eir;
-            Vector jumps(nip);
+         auto &int_rule = IntRules.Get(FT->FaceGeom, 2 * xfes->GetFaceOrder(f));
+         const auto nip = int_rule.GetNPoints();
 
-            // Integral over local half face on the side of e₁
-            // i.e. the numerical integration of ∫ flux ⋅ n dS₁
-            for (int i = 0; i < nip; i++)
+         if (pmesh->FaceIsInterior(f))
+         {
+            int Inf1, Inf2, NCFace;
+            pmesh->GetFaceInfos(f, &Inf1, &Inf2, &NCFace);
+
+            // Convention
+            // * Conforming face: Face side with smaller element id handles
+            // the integration
+            // * Non-conforming face: The slave handles the integration.
+            // See FaceInfo documentation for details.
+            bool isNCSlave    = FT->Elem2No >= 0 && NCFace >= 0;
+            bool isConforming = FT->Elem2No >= 0 && NCFace == -1;
+            if ((FT->Elem1No < FT->Elem2No && isConforming) || isNCSlave)
             {
-               // Evaluate flux at IP
-               auto &fip = int_rule.IntPoint(i);
-               IntegrationPoint ip;
-               FT->Loc1.Transform(fip, ip);
-
-               Vector val(flux_space->GetVDim());
-               flux.GetVectorValue(FT->Elem1No, ip, val);
-
-               // And build scalar product with normal
-               Vector normal(pmesh->SpaceDimension());
-               FT->Face->SetIntPoint(&fip);
-               if (pmesh->Dimension() == pmesh->SpaceDimension())
+               if (attributes.Size() &&
+                   (attributes.FindSorted(FT->Elem1->Attribute) == -1
+                    || attributes.FindSorted(FT->Elem2->Attribute) == -1))
                {
-                  CalcOrtho(FT->Face->Jacobian(), normal);
+                  continue;
                }
-               else
+
+               IntegrationRule eir;
+               Vector jumps(nip);
+
+               // Integral over local half face on the side of e₁
+               // i.e. the numerical integration of ∫ flux ⋅ n dS₁
+               for (int i = 0; i < nip; i++)
                {
-                  Vector ref_normal(pmesh->Dimension());
-                  FT->Loc1.Transf.SetIntPoint(&fip);
-                  CalcOrtho(FT->Loc1.Transf.Jacobian(), ref_normal);
-                  auto &e1 = FT->GetElement1Transformation();
-                  e1.AdjugateJacobian().MultTranspose(ref_normal, normal);
-                  normal /= e1.Weight();
+                  // Evaluate flux at IP
+                  auto &fip = int_rule.IntPoint(i);
+                  IntegrationPoint ip;
+                  FT->Loc1.Transform(fip, ip);
+
+                  Vector val(flux_space->GetVDim());
+                  flux.GetVectorValue(FT->Elem1No, ip, val);
+
+                  // And build scalar product with normal
+                  Vector normal(pmesh->SpaceDimension());
+                  FT->Face->SetIntPoint(&fip);
+                  if (pmesh->Dimension() == pmesh->SpaceDimension())
+                  {
+                     CalcOrtho(FT->Face->Jacobian(), normal);
+                  }
+                  else
+                  {
+                     Vector ref_normal(pmesh->Dimension());
+                     FT->Loc1.Transf.SetIntPoint(&fip);
+                     CalcOrtho(FT->Loc1.Transf.Jacobian(), ref_normal);
+                     auto &e1 = FT->GetElement1Transformation();
+                     e1.AdjugateJacobian().MultTranspose(ref_normal, normal);
+                     normal /= e1.Weight();
+                  }
+                  jumps(i) = val * normal * fip.weight * FT->Face->Weight();
                }
-               jumps(i) = val * normal * fip.weight * FT->Face->Weight();
-            }
 
-            // Subtract integral over half face of e₂
-            // i.e. the numerical integration of ∫ flux ⋅ n dS₂
-            for (int i = 0; i < nip; i++)
-            {
-               // Evaluate flux vector at IP
-               auto &fip = int_rule.IntPoint(i);
-               IntegrationPoint ip;
-               FT->Loc2.Transform(fip, ip);
-
-               Vector val(flux_space->GetVDim());
-               flux.GetVectorValue(FT->Elem2No, ip, val);
-
-               // And build scalar product with normal
-               Vector normal(pmesh->SpaceDimension());
-               FT->Face->SetIntPoint(&fip);
-               if (pmesh->Dimension() == pmesh->SpaceDimension())
+               // Subtract integral over half face of e₂
+               // i.e. the numerical integration of ∫ flux ⋅ n dS₂
+               for (int i = 0; i < nip; i++)
                {
-                  CalcOrtho(FT->Face->Jacobian(), normal);
+                  // Evaluate flux vector at IP
+                  auto &fip = int_rule.IntPoint(i);
+                  IntegrationPoint ip;
+                  FT->Loc2.Transform(fip, ip);
+
+                  Vector val(flux_space->GetVDim());
+                  flux.GetVectorValue(FT->Elem2No, ip, val);
+
+                  // And build scalar product with normal
+                  Vector normal(pmesh->SpaceDimension());
+                  FT->Face->SetIntPoint(&fip);
+                  if (pmesh->Dimension() == pmesh->SpaceDimension())
+                  {
+                     CalcOrtho(FT->Face->Jacobian(), normal);
+                  }
+                  else
+                  {
+                     Vector ref_normal(pmesh->Dimension());
+                     FT->Loc1.Transf.SetIntPoint(&fip);
+                     CalcOrtho(FT->Loc1.Transf.Jacobian(), ref_normal);
+                     auto &e1 = FT->GetElement1Transformation();
+                     e1.AdjugateJacobian().MultTranspose(ref_normal, normal);
+                     normal /= e1.Weight();
+                  }
+
+                  jumps(i) -= val * normal * fip.weight * FT->Face->Weight();
                }
-               else
+
+               // Finalize "local" L₂ contribution
+               for (int i = 0; i < nip; i++)
                {
-                  Vector ref_normal(pmesh->Dimension());
-                  FT->Loc1.Transf.SetIntPoint(&fip);
-                  CalcOrtho(FT->Loc1.Transf.Jacobian(), ref_normal);
-                  auto &e1 = FT->GetElement1Transformation();
-                  e1.AdjugateJacobian().MultTranspose(ref_normal, normal);
-                  normal /= e1.Weight();
+                  jumps(i) *= jumps(i);
                }
+               auto h_k_face = compute_face_coefficient(pmesh, f, false);
+               double jump_integral = h_k_face*jumps.Sum();
+
+               // A local face is shared between two local elements, so we
+               // can get away with integrating the jump only once and add
+               // it to both elements. To minimize communication, the jump
+               // of shared faces is computed locally by each process.
+               error_estimates(FT->Elem1No) += jump_integral;
+               error_estimates(FT->Elem2No) += jump_integral;
+            }
+         }
+      }
 
-               jumps(i) -= val * normal * fip.weight * FT->Face->Weight();
+      // 3. Add error contribution from shared interior faces
+      for (int sf = 0; sf < pmesh->GetNSharedFaces(); sf++)
+      {
+         auto FT = pmesh->GetSharedFaceTransformations(sf, true);
+         if (attributes.Size() &&
+             (attributes.FindSorted(FT->Elem1->Attribute) == -1
+              || attributes.FindSorted(FT->Elem2->Attribute) == -1))
+         {
+            continue;
+         }
+
+         auto &int_rule = IntRules.Get(FT->FaceGeom, 2 * xfes->GetFaceOrder(0));
+         const auto nip = int_rule.GetNPoints();
+
+         IntegrationRule eir;
+         Vector jumps(nip);
+
+         // Integral over local half face on the side of e₁
+         // i.e. the numerical integration of ∫ flux ⋅ n dS₁
+         for (int i = 0; i < nip; i++)
+         {
+            // Evaluate flux vector at integration point
+            auto &fip = int_rule.IntPoint(i);
+            IntegrationPoint ip;
+            FT->Loc1.Transform(fip, ip);
+
+            Vector val(flux_space->GetVDim());
+            flux.GetVectorValue(FT->Elem1No, ip, val);
+
+            Vector normal(pmesh->SpaceDimension());
+            FT->Face->SetIntPoint(&fip);
+            if (pmesh->Dimension() == pmesh->SpaceDimension())
+            {
+               CalcOrtho(FT->Face->Jacobian(), normal);
             }
+            else
+            {
+               Vector ref_normal(pmesh->Dimension());
+               FT->Loc1.Transf.SetIntPoint(&fip);
+               CalcOrtho(FT->Loc1.Transf.Jacobian(), ref_normal);
+               auto &e1 = FT->GetElement1Transformation();
+               e1.AdjugateJacobian().MultTranspose(ref_normal, normal);
+               normal /= e1.Weight();
+            }
+
+            jumps(i) = val * normal * fip.weight * FT->Face->Weight();
+         }
 
-            // Finalize "local" L₂ contribution
-            for (int i = 0; i < nip; i++)
+         // Subtract integral over non-local half face of e₂
+         // i.e. the numerical integration of ∫ flux ⋅ n dS₂
+         for (int i = 0; i < nip; i++)
+         {
+            // Evaluate flux vector at integration point
+            auto &fip = int_rule.IntPoint(i);
+            IntegrationPoint ip;
+            FT->Loc2.Transform(fip, ip);
+
+            Vector val(flux_space->GetVDim());
+            flux.GetVectorValue(FT->Elem2No, ip, val);
+
+            // Evaluate gauss point
+            Vector normal(pmesh->SpaceDimension());
+            FT->Face->SetIntPoint(&fip);
+            if (pmesh->Dimension() == pmesh->SpaceDimension())
             {
-               jumps(i) *= jumps(i);
+               CalcOrtho(FT->Face->Jacobian(), normal);
             }
-            auto h_k_face = compute_face_coefficient(pmesh, f, false);
-            double jump_integral = h_k_face*jumps.Sum();
-
-            // A local face is shared between two local elements, so we
-            // can get away with integrating the jump only once and add
-            // it to both elements. To minimize communication, the jump
-            // of shared faces is computed locally by each process.
-            error_estimates(FT->Elem1No) += jump_integral;
-            error_estimates(FT->Elem2No) += jump_integral;
+            else
+            {
+               Vector ref_normal(pmesh->Dimension());
+               CalcOrtho(FT->Loc1.Transf.Jacobian(), ref_normal);
+               auto &e1 = FT->GetElement1Transformation();
+               e1.AdjugateJacobian().MultTranspose(ref_normal, normal);
+               normal /= e1.Weight();
+            }
+
+            jumps(i) -= val * normal * fip.weight * FT->Face->Weight();
          }
+
+         // Finalize "local" L₂ contribution
+         for (int i = 0; i < nip; i++)
+         {
+            jumps(i) *= jumps(i);
+         }
+         auto h_k_face = compute_face_coefficient(pmesh, sf, true);
+         double jump_integral = h_k_face*jumps.Sum();
+
+         error_estimates(FT->Elem1No) += jump_integral;
+         // We skip "error_estimates(FT->Elem2No) += jump_integral"
+         // because the error is stored on the remote process and
+         // recomputed there.
       }
    }
 
-   // 3. Add error contribution from shared interior faces
-   // Synchronize face data.
-   flux.ExchangeFaceNbrData();
-
-   for (int sf = 0; sf < pmesh->GetNSharedFaces(); sf++)
+   // Finalize element errors
+   if (default_element_coefficient)
    {
-      auto FT = pmesh->GetSharedFaceTransformations(sf, true);
-      if (attributes.Size() &&
-          (attributes.FindSorted(FT->Elem1->Attribute) == -1
-           || attributes.FindSorted(FT->Elem2->Attribute) == -1))
+      // The sqrt belongs to the norm and hₑ = 1 to the indicator.
+      auto d_err = error_estimates.ReadWrite();
+      MFEM_FORALL(e, xfes->GetNE(), d_err[e] = sqrt(d_err[e]););
+   }
+   else
+   {
+      error_estimates.HostReadWrite();
+      for (int e = 0; e < xfes->GetNE(); e++)
       {
-         continue;
+         auto factor = compute_element_coefficient(pmesh, e);
+         // The sqrt belongs to the norm and hₑ to the indicator.
+         error_estimates(e) = sqrt(factor * error_estimates(e));
       }
+   }
 
-      auto &int_rule = IntRules.Get(FT->FaceGeom, 2 * xfes->GetFaceOrder(0));
-      const auto nip = int_rule.GetNPoints();
+   current_sequence = solution->FESpace()->GetMesh()->GetSequence();
+
+   // Finish by computing the global error.
+   double process_local_error = error_estimates.Sum();
+   MPI_Allreduce(&process_local_error, &total_error, 1, MPI_DOUBLE,
+                 MPI_SUM, xfes->GetComm());
+}
 
-      IntegrationRule eir;
-      Vector jumps(nip);
+bool KellyErrorEstimator::UseBatchedFaceJumps() const
+{
+   ParMesh *pmesh = solution->ParFESpace()->GetParMesh();
+   const int dim = pmesh->Dimension();
 
-      // Integral over local half face on the side of e₁
-      // i.e. the numerical integration of ∫ flux ⋅ n dS₁
-      for (int i = 0; i < nip; i++)
+   if (!pmesh->Conforming() || pmesh->NURBSext || pmesh->GetNE() == 0 ||
+       dim < 2 || dim != pmesh->SpaceDimension() ||
+       pmesh->GetNumGeometries(dim) != 1)
+   {
+      return false;
+   }
+   // The faces are integrated with a single face geometry, so elements with
+   // faces of different geometries, i.e. prisms, are not supported
+   const Geometry::Type geom = pmesh->GetElementBaseGeometry(0);
+   if (geom == Geometry::PRISM) { return false; }
+   for (int i = 0; i < pmesh->GetNFaceNeighborElements(); i++)
+   {
+      if (pmesh->face_nbr_elements[i]->GetGeometryType() != geom)
       {
-         // Evaluate flux vector at integration point
-         auto &fip = int_rule.IntPoint(i);
-         IntegrationPoint ip;
-         FT->Loc1.Transform(fip, ip);
+         return false;
+      }
+   }
+   return (flux_space->IsDGSpace() &&
+           flux_space->GetVDim() == dim &&
+           flux_space->GetFE(0)->GetRangeType() == FiniteElement::SCALAR);
+}
 
-         Vector val(flux_space->GetVDim());
-         flux.GetVectorValue(FT->Elem1No, ip, val);
+void KellyErrorEstimator::AddFaceJumps(const ParGridFunction &flux)
+{
+   ParFiniteElementSpace *xfes = solution->ParFESpace();
+   ParMesh *pmesh = xfes->GetParMesh();
+   const int dim = pmesh->Dimension();
+   const int NE = pmesh->GetNE();
+   const int NG = pmesh->GetNFaceNeighborElements();
+
+   // The normals and face weights are computed from the element nodes. For a
+   // mesh without nodes, a temporary linear nodal function is built from the
+   // vertices, so that the mesh is not modified.
+   const GridFunction *nodes = pmesh->GetNodes();
+   GridFunction lin_nodes;
+   if (nodes == NULL)
+   {
+      const int NV = pmesh->GetNV();
+      FiniteElementCollection *lin_fec = new H1_FECollection(1, dim);
+      lin_nodes.SetSpace(new FiniteElementSpace(pmesh, lin_fec, dim));
+      lin_nodes.MakeOwner(lin_fec);
+      for (int i = 0; i < NV; i++)
+      {
+         const double *v = pmesh->GetVertex(i);
+         for (int d = 0; d < dim; d++) { lin_nodes(d*NV + i) = v[d]; }
+      }
+      nodes = &lin_nodes;
+   }
+   const FiniteElementSpace *nfes = nodes->FESpace();
+   const FiniteElement *nfe = nfes->GetFE(0);
+   const FiniteElement *ffe = flux_space->GetFE(0);
+
+   // List the faces handled by this processor with the same convention as the
+   // non-batched version: a local interior face is integrated once and added
+   // to both elements, a shared face is added to the local element only. The
+   // second element of a shared face is a face neighbor, shifted by NE. Each
+   // side refers to a table for its element geometry and face info.
+   std::map<int, int> key_table;
+   Array<int> key_face; // a face (shared faces encoded as -1-sf) for each table
+   Array<int> key_side; // the side of that face (1 or 2)
+   auto table = [&](Geometry::Type geom, int inf, int face, int side)
+   {
+      const int key = inf*Geometry::NumGeom + geom;
+      auto it = key_table.find(key);
+      if (it != key_table.end()) { return it->second; }
+      key_table[key] = key_face.Size();
+      key_face.Append(face);
+      key_side.Append(side);
+      return key_face.Size() - 1;
+   };
+
+   if (attributes.Size()) { attributes.Sort(); }
+   auto skip = [&](int attr1, int attr2)
+   {
+      return attributes.Size() && (attributes.FindSorted(attr1) == -1 ||
+                                   attributes.FindSorted(attr2) == -1);
+   };
 
-         Vector normal(pmesh->SpaceDimension());
-         FT->Face->SetIntPoint(&fip);
-         if (pmesh->Dimension() == pmesh->SpaceDimension())
+   Array<int> face_list; // (elem1, table1, elem2, table2) for each face
+   Array<double> face_coeff;
+   for (int f = 0; f < pmesh->GetNumFaces(); f++)
+   {
+      int e1, e2, inf1, inf2;
+      pmesh->GetFaceElements(f, &e1, &e2);
+      if (e2 < 0 || e1 > e2) { continue; }
+      if (skip(pmesh->GetAttribute(e1), pmesh->GetAttribute(e2))) { continue; }
+
+      pmesh->GetFaceInfos(f, &inf1, &inf2);
+      face_list.Append(e1);
+      face_list.Append(table(pmesh->GetElementBaseGeometry(e1), inf1, f, 1));
+      face_list.Append(e2);
+      face_list.Append(table(pmesh->GetElementBaseGeometry(e2), inf2, f, 2));
+      face_coeff.Append(default_face_coefficient ? 0.0 :
+                        compute_face_coefficient(pmesh, f, false));
+   }
+   const int NLF = face_coeff.Size(); // number of local faces
+   for (int sf = 0; sf < pmesh->GetNSharedFaces(); sf++)
+   {
+      const int f = pmesh->GetSharedFace(sf);
+      int e1, e2, inf1, inf2;
+      pmesh->GetFaceElements(f, &e1, &e2);
+      const Element *nbr = pmesh->face_nbr_elements[-1 - e2];
+      if (skip(pmesh->GetAttribute(e1), nbr->GetAttribute())) { continue; }
+
+      pmesh->GetFaceInfos(f, &inf1, &inf2);
+      face_list.Append(e1);
+      face_list.Append(table(pmesh->GetElementBaseGeometry(e1), inf1,
+                             -1 - sf, 1));
+      face_list.Append(NE - 1 - e2);
+      face_list.Append(table(nbr->GetGeometryType(), inf2, -1 - sf, 2));
+      face_coeff.Append(default_face_coefficient ? 0.0 :
+                        compute_face_coefficient(pmesh, sf, true));
+   }
+   const int NF = face_coeff.Size();
+   if (NF == 0) { return; }
+
+   // Tables of the flux basis, the tangential derivatives of the node basis
+   // and the node basis at the face vertices, for each face info.
+   const Geometry::Type face_geom = pmesh->GetFaceBaseGeometry(0);
+   const IntegrationRule &ir = IntRules.Get(face_geom,
+                                            2 * xfes->GetFaceOrder(0));
+   const IntegrationRule *vertices = Geometries.GetVertices(face_geom);
+   const int NQ = ir.GetNPoints(), NV = vertices->GetNPoints();
+   const int NDF = ffe->GetDof(), NDN = nfe->GetDof();
+   const int NT = key_face.Size();
+
+   Vector ftab(NQ*NDF*NT), ntab(NQ*NDN*(dim-1)*NT), vtab(NV*NDN*NT);
+   {
+      auto B = Reshape(ftab.HostWrite(), NQ, NDF, NT);
+      auto G = Reshape(ntab.HostWrite(), NQ, NDN, dim-1, NT);
+      auto V = Reshape(vtab.HostWrite(), NV, NDN, NT);
+      Vector shape(NDF), nshape(NDN);
+      DenseMatrix dshape(NDN, dim), tshape(NDN, dim-1);
+      IntegrationPoint eip;
+      for (int t = 0; t < NT; t++)
+      {
+         const int face = key_face[t];
+         FaceElementTransformations *FT = (face >= 0) ?
+            pmesh->GetFaceElementTransformations(face) :
+            pmesh->GetSharedFaceTransformations(-1 - face, true);
+         IntegrationPointTransformation &loc =
+            (key_side[t] == 1) ? FT->Loc1 : FT->Loc2;
+
+         for (int q = 0; q < NQ; q++)
          {
-            CalcOrtho(FT->Face->Jacobian(), normal);
+            const IntegrationPoint &fip = ir.IntPoint(q);
+            loc.Transform(fip, eip);
+            loc.Transf.SetIntPoint(&fip);
+
+            ffe->CalcShape(eip, shape);
+            nfe->CalcDShape(eip, dshape);
+            Mult(dshape, loc.Transf.Jacobian(), tshape);
+            for (int d = 0; d < NDF; d++) { B(q,d,t) = shape(d); }
+            for (int j = 0; j < dim-1; j++)
+            {
+               for (int d = 0; d < NDN; d++) { G(q,d,j,t) = tshape(d,j); }
+            }
          }
-         else
+         for (int v = 0; v < NV; v++)
          {
-            Vector ref_normal(pmesh->Dimension());
-            FT->Loc1.Transf.SetIntPoint(&fip);
-            CalcOrtho(FT->Loc1.Transf.Jacobian(), ref_normal);
-            auto &e1 = FT->GetElement1Transformation();
-            e1.AdjugateJacobian().MultTranspose(ref_normal, normal);
-            normal /= e1.Weight();
+            loc.Transform(vertices->IntPoint(v), eip);
+            nfe->CalcShape(eip, nshape);
+            for (int d = 0; d < NDN; d++) { V(v,d,t) = nshape(d); }
          }
-
-         jumps(i) = val * normal * fip.weight * FT->Face->Weight();
       }
+   }
 
-      // Subtract integral over non-local half face of e₂
-      // i.e. the numerical integration of ∫ flux ⋅ n dS₂
-      for (int i = 0; i < nip; i++)
+   // Element values of the nodes and of the flux, including face neighbors
+   const ElementDofOrdering ordering = ElementDofOrdering::NATIVE;
+   const Operator *nodes_restr = nfes->GetElementRestriction(ordering);
+   Vector enodes(nodes_restr->Height());
+   nodes_restr->Mult(*nodes, enodes);
+
+   Vector eflux((NE + NG)*NDF*dim), eflux_loc;
+   eflux_loc.MakeRef(eflux, 0, NE*NDF*dim);
+   flux_space->GetElementRestriction(ordering)->Mult(flux, eflux_loc);
+   if (NG)
+   {
+      // gather the face neighbor data in the same layout
+      Array<int> nbr_map(NG*NDF*dim), vdofs;
+      for (int i = 0; i < NG; i++)
       {
-         // Evaluate flux vector at integration point
-         auto &fip = int_rule.IntPoint(i);
-         IntegrationPoint ip;
-         FT->Loc2.Transform(fip, ip);
+         flux_space->GetFaceNbrElementVDofs(i, vdofs);
+         for (int j = 0; j < NDF*dim; j++)
+         {
+            nbr_map[i*NDF*dim + j] = vdofs[j];
+         }
+      }
+      auto map = nbr_map.Read();
+      auto src = flux.FaceNbrData().Read();
+      auto dst = eflux.ReadWrite() + NE*NDF*dim;
+      MFEM_FORALL(i, NG*NDF*dim, dst[i] = src[map[i]];);
+   }
 
-         Vector val(flux_space->GetVDim());
-         flux.GetVectorValue(FT->Elem2No, ip, val);
+   // Integrate the squared jumps of the normal flux on each face
+   const bool default_coeff = default_face_coefficient;
+   const double order = nfe->GetOrder();
+   auto X = Reshape(enodes.Read(), NDN, dim, NE);
+   auto F = Reshape(eflux.Read(), NDF, dim, NE + NG);
+   auto B = Reshape(ftab.Read(), NQ, NDF, NT);
+   auto G = Reshape(ntab.Read(), NQ, NDN, dim-1, NT);
+   auto V = Reshape(vtab.Read(), NV, NDN, NT);
+   auto W = ir.GetWeights().Read();
+   auto faces = Reshape(face_list.Read(), 4, NF);
+   auto coeff = face_coeff.Read();
+   Vector face_err(NF);
+   auto d_face_err = face_err.Write();
+   MFEM_FORALL(f, NF,
+   {
+      const int e1 = faces(0,f), t1 = faces(1,f);
+      const int e2 = faces(2,f), t2 = faces(3,f);
 
-         // Evaluate gauss point
-         Vector normal(pmesh->SpaceDimension());
-         FT->Face->SetIntPoint(&fip);
-         if (pmesh->Dimension() == pmesh->SpaceDimension())
+      double sum = 0.0;
+      for (int q = 0; q < NQ; q++)
+      {
+         // The normal scaled by the face weight, see CalcOrtho()
+         double J[3][2], n[3];
+         for (int c = 0; c < dim; c++)
          {
-            CalcOrtho(FT->Face->Jacobian(), normal);
+            for (int j = 0; j < dim-1; j++)
+            {
+               double s = 0.0;
+               for (int d = 0; d < NDN; d++) { s += G(q,d,j,t1)*X(d,c,e1); }
+               J[c][j] = s;
+            }
+         }
+         if (dim == 2)
+         {
+            n[0] = J[1][0];
+            n[1] = -J[0][0];
          }
          else
          {
-            Vector ref_normal(pmesh->Dimension());
-            CalcOrtho(FT->Loc1.Transf.Jacobian(), ref_normal);
-            auto &e1 = FT->GetElement1Transformation();
-            e1.AdjugateJacobian().MultTranspose(ref_normal, normal);
-            normal /= e1.Weight();
+            n[0] = J[1][0]*J[2][1] - J[2][0]*J[1][1];
+            n[1] = J[2][0]*J[0][1] - J[0][0]*J[2][1];
+            n[2] = J[0][0]*J[1][1] - J[1][0]*J[0][1];
          }
+         double weight = 0.0;
+         for (int c = 0; c < dim; c++) { weight += n[c]*n[c]; }
+         weight = sqrt(weight);
 
-         jumps(i) -= val * normal * fip.weight * FT->Face->Weight();
+         double jump = 0.0;
+         for (int c = 0; c < dim; c++)
+         {
+            double val = 0.0;
+            for (int d = 0; d < NDF; d++) { val += B(q,d,t1)*F(d,c,e1); }
+            for (int d = 0; d < NDF; d++) { val -= B(q,d,t2)*F(d,c,e2); }
+            jump += val*n[c];
+         }
+         jump *= W[q]*weight;
+         sum += jump*jump;
       }
 
-      // Finalize "local" L₂ contribution
-      for (int i = 0; i < nip; i++)
+      double h_k = coeff[f];
+      if (default_coeff)
       {
-         jumps(i) *= jumps(i);
+         // Poor man's face diameter, see ResetCoefficientFunctions()
+         double p[4][3], diameter = 0.0;
+         for (int v = 0; v < NV; v++)
+         {
+            for (int c = 0; c < dim; c++)
+            {
+               double s = 0.0;
+               for (int d = 0; d < NDN; d++) { s += V(v,d,t1)*X(d,c,e1); }
+               p[v][c] = s;
+            }
+            for (int w = 0; w < v; w++)
+            {
+               double dist = 0.0;
+               for (int c = 0; c < dim; c++)
+               {
+                  dist += (p[v][c] - p[w][c])*(p[v][c] - p[w][c]);
+               }
+               diameter = fmax(diameter, sqrt(dist));
+            }
+         }
+         h_k = diameter/(2.0*order);
       }
-      auto h_k_face = compute_face_coefficient(pmesh, sf, true);
-      double jump_integral = h_k_face*jumps.Sum();
-
-      error_estimates(FT->Elem1No) += jump_integral;
-      // We skip "error_estimates(FT->Elem2No) += jump_integral"
-      // because the error is stored on the remote process and
-      // recomputed there.
+      d_face_err[f] = h_k*sum;
+   });
+
+   // Add the face contributions to the elements: the faces of each element
+   // are listed in CSR format, local faces contribute to both elements.
+   Array<int> elem_offsets(NE+1), elem_faces;
+   elem_offsets = 0;
+   for (int f = 0; f < NF; f++)
+   {
+      elem_offsets[face_list[4*f] + 1]++;
+      if (f < NLF) { elem_offsets[face_list[4*f + 2] + 1]++; }
    }
-
-   // Finalize element errors
-   for (int e = 0; e < xfes->GetNE(); e++)
+   elem_offsets.PartialSum();
+   elem_faces.SetSize(elem_offsets[NE]);
+   for (int f = 0; f < NF; f++)
    {
-      auto factor = compute_element_coefficient(pmesh, e);
-      // The sqrt belongs to the norm and hₑ to the indicator.
-      error_estimates(e) = sqrt(factor * error_estimates(e));
+      elem_faces[elem_offsets[face_list[4*f]]++] = f;
+      if (f < NLF) { elem_faces[elem_offsets[face_list[4*f + 2]]++] = f; }
    }
-
-   current_sequence = solution->FESpace()->GetMesh()->GetSequence();
-
-   // Finish by computing the global error.
-   double process_local_error = error_estimates.Sum();
-   MPI_Allreduce(&process_local_error, &total_error, 1, MPI_DOUBLE,
-                 MPI_SUM, xfes->GetComm());
+   for (int e = NE; e > 0; e--) { elem_offsets[e] = elem_offsets[e-1]; }
+   elem_offsets[0] = 0;
+
+   auto offsets = elem_offsets.Read();
+   auto efaces = elem_faces.Read();
+   auto d_face_err_r = face_err.Read();
+   auto d_err = error_estimates.ReadWrite();
+   MFEM_FORALL(e, NE,
+   {
+      for (int k = offsets[e]; k < offsets[e+1]; k++)
+      {
+         d_err[e] += d_face_err_r[efaces[k]];
+      }
+   });
 }
 
 #endif // MFEM_USE_MPI
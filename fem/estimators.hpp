@@ -477,6 +477,11 @@ private:
    */
    FaceCoefficientFunction compute_face_coefficient;
 
+   /// True if the default hₑ is used, i.e. no custom function was set.
+   bool default_element_coefficient = true;
+   /// True if the default hₖ is used, i.e. no custom function was set.
+   bool default_face_coefficient = true;
+
    BilinearFormIntegrator* flux_integrator; ///< Not owned.
    ParGridFunction* solution;               ///< Not owned.
 
@@ -503,6 +508,22 @@ private:
    */
    void ComputeEstimates();
 
+   /** @brief Check if the face contributions can be computed by
+       AddFaceJumps(), i.e. if the mesh is conforming with a single element
+       geometry, with a single face geometry (not prisms), and the flux space
+       is a discontinuous space of scalar elements. */
+   bool UseBatchedFaceJumps() const;
+
+   /** @brief Add the contributions of all interior faces, including the shared
+       faces, to the (squared) error estimates using batched kernels.
+
+       The flux on both sides of the faces and the face normals are evaluated
+       from element E-vectors with tables of basis functions for each local
+       face and orientation, so no face transformations are needed, except for
+       building the tables. The face neighbor data of @a flux must be
+       exchanged before calling this method. */
+   void AddFaceJumps(const ParGridFunction &flux);
+
 public:
    /** @brief Construct a new KellyErrorEstimator object for a scalar field.
        @param di_         The bilinearform to compute the interface flux.
@@ -554,6 +575,7 @@ public:
                                       compute_element_coefficient_)
    {
       compute_element_coefficient = compute_element_coefficient_;
+      default_element_coefficient = false;
    }
 
    /** @brief Change the method to compute hₖ on a per-element basis.
@@ -566,6 +588,7 @@ public:
       compute_face_coefficient_)
    {
       compute_face_coefficient = compute_face_coefficient_;
+      default_face_coefficient = false;
    }
 
    /// Change the coefficients back to default as described above.
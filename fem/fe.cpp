@@ -6916,6 +6916,27 @@ void RotTriLinearHexFiniteElement::CalcDShape(const IntegrationPoint &ip,
 }
 
 
+// Scratch space for the 1D basis values used by the tensor product elements.
+// Vectors of up to MaxSize entries live on the stack, so that CalcShape() and
+// CalcDShape() of these elements do not allocate and can be called
+// concurrently from multiple threads; larger sizes fall back to the heap.
+class BasisScratch : public Vector
+{
+   static const int MaxSize = 32;
+   double buffer[MaxSize];
+
+public:
+   explicit BasisScratch(int size)
+   {
+      if (size <= MaxSize) { SetDataAndSize(buffer, size); }
+      else { SetSize(size); }
+   }
+
+private:
+   BasisScratch(const BasisScratch &);
+   BasisScratch &operator=(const BasisScratch &);
+};
+
 Poly_1D::Basis::Basis(const int p, const double *nodes, EvalType etype)
    : etype(etype)
 {
@@ -6923,8 +6944,6 @@ Poly_1D::Basis::Basis(const int p, const double *nodes, EvalType etype)
    {
       case ChangeOfBasis:
       {
-         x.SetSize(p + 1);
-         w.SetSize(p + 1);
          DenseMatrix A(p + 1);
          for (int i = 0; i <= p; i++)
          {
@@ -6980,8 +6999,9 @@ void Poly_1D::Basis::Eval(const double y, Vector &u) const
    {
       case ChangeOfBasis:
       {
-         CalcBasis(Ai.Width() - 1, y, x);
-         Ai.Mult(x, u);
+         BasisScratch b(Ai.Width());
+         CalcBasis(Ai.Width() - 1, y, b);
+         Ai.Mult(b, u);
          break;
       }
       case Barycentric:
@@ -7038,9 +7058,10 @@ void Poly_1D::Basis::Eval(const double y, Vector &u, Vector &d) const
    {
       case ChangeOfBasis:
       {
-         CalcBasis(Ai.Width() - 1, y, x, w);
-         Ai.Mult(x, u);
-         Ai.Mult(w, d);
+         BasisScratch b(Ai.Width()), db(Ai.Width());
+         CalcBasis(Ai.Width() - 1, y, b, db);
+         Ai.Mult(b, u);
+         Ai.Mult(db, d);
          break;
       }
       case Barycentric:
@@ -7118,9 +7139,10 @@ void Poly_1D::Basis::Eval(const double y, Vector &u, Vector &d,
    {
       case ChangeOfBasis:
       {
-         CalcBasis(Ai.Width() - 1, y, x, w);
-         Ai.Mult(x, u);
-         Ai.Mult(w, d);
+         BasisScratch b(Ai.Width()), db(Ai.Width());
+         CalcBasis(Ai.Width() - 1, y, b, db);
+         Ai.Mult(b, u);
+         Ai.Mult(db, d);
          // set d2 (not implemented yet)
          break;
       }
@@ -7749,12 +7771,6 @@ H1_SegmentElement::H1_SegmentElement(const int p, const int btype)
 {
    const double *cp = poly1d.ClosedPoints(p, b_type);
 
-#ifndef MFEM_THREAD_SAFE
-   shape_x.SetSize(p+1);
-   dshape_x.SetSize(p+1);
-   d2shape_x.SetSize(p+1);
-#endif
-
    Nodes.IntPoint(0).x = cp[0];
    Nodes.IntPoint(1).x = cp[p];
    for (int i = 1; i < p; i++)
@@ -7768,9 +7784,7 @@ void H1_SegmentElement::CalcShape(const IntegrationPoint &ip,
 {
    const int p = order;
 
-#ifdef MFEM_THREAD_SAFE
-   Vector shape_x(p+1);
-#endif
+   BasisScratch shape_x(p+1);
 
    basis1d.Eval(ip.x, shape_x);
 
@@ -7787,9 +7801,7 @@ void H1_SegmentElement::CalcDShape(const IntegrationPoint &ip,
 {
    const int p = order;
 
-#ifdef MFEM_THREAD_SAFE
-   Vector shape_x(p+1), dshape_x(p+1);
-#endif
+   BasisScratch shape_x(p+1), dshape_x(p+1);
 
    basis1d.Eval(ip.x, shape_x, dshape_x);
 
@@ -7806,9 +7818,7 @@ void H1_SegmentElement::CalcHessian(const IntegrationPoint &ip,
 {
    const int p = order;
 
-#ifdef MFEM_THREAD_SAFE
-   Vector shape_x(p+1), dshape_x(p+1), d2shape_x(p+1);
-#endif
+   BasisScratch shape_x(p+1), dshape_x(p+1), d2shape_x(p+1);
 
    basis1d.Eval(ip.x, shape_x, dshape_x, d2shape_x);
 
@@ -7853,17 +7863,6 @@ H1_QuadrilateralElement::H1_QuadrilateralElement(const int p, const int btype)
 {
    const double *cp = poly1d.ClosedPoints(p, b_type);
 
-#ifndef MFEM_THREAD_SAFE
-   const int p1 = p + 1;
-
-   shape_x.SetSize(p1);
-   shape_y.SetSize(p1);
-   dshape_x.SetSize(p1);
-   dshape_y.SetSize(p1);
-   d2shape_x.SetSize(p1);
-   d2shape_y.SetSize(p1);
-#endif
-
    int o = 0;
    for (int j = 0; j <= p; j++)
    {
@@ -7879,9 +7878,7 @@ void H1_QuadrilateralElement::CalcShape(const IntegrationPoint &ip,
 {
    const int p = order;
 
-#ifdef MFEM_THREAD_SAFE
-   Vector shape_x(p+1), shape_y(p+1);
-#endif
+   BasisScratch shape_x(p+1), shape_y(p+1);
 
    basis1d.Eval(ip.x, shape_x);
    basis1d.Eval(ip.y, shape_y);
@@ -7898,9 +7895,7 @@ void H1_QuadrilateralElement::CalcDShape(const IntegrationPoint &ip,
 {
    const int p = order;
 
-#ifdef MFEM_THREAD_SAFE
-   Vector shape_x(p+1), shape_y(p+1), dshape_x(p+1), dshape_y(p+1);
-#endif
+   BasisScratch shape_x(p+1), shape_y(p+1), dshape_x(p+1), dshape_y(p+1);
 
    basis1d.Eval(ip.x, shape_x, dshape_x);
    basis1d.Eval(ip.y, shape_y, dshape_y);
@@ -7920,10 +7915,8 @@ void H1_QuadrilateralElement::CalcHessian(const IntegrationPoint &ip,
 {
    const int p = order;
 
-#ifdef MFEM_THREAD_SAFE
-   Vector shape_x(p+1), shape_y(p+1), dshape_x(p+1), dshape_y(p+1),
-          d2shape_x(p+1), d2shape_y(p+1);
-#endif
+   BasisScratch shape_x(p+1), shape_y(p+1), dshape_x(p+1), dshape_y(p+1),
+                d2shape_x(p+1), d2shape_y(p+1);
 
    basis1d.Eval(ip.x, shape_x, dshape_x, d2shape_x);
    basis1d.Eval(ip.y, shape_y, dshape_y, d2shape_y);
@@ -7944,9 +7937,7 @@ void H1_QuadrilateralElement::ProjectDelta(int vertex, Vector &dofs) const
    const int p = order;
    const double *cp = poly1d.ClosedPoints(p, b_type);
 
-#ifdef MFEM_THREAD_SAFE
-   Vector shape_x(p+1), shape_y(p+1);
-#endif
+   BasisScratch shape_x(p+1), shape_y(p+1);
 
    for (int i = 0; i <= p; i++)
    {
@@ -7993,20 +7984,6 @@ H1_HexahedronElement::H1_HexahedronElement(const int p, const int btype)
 {
    const double *cp = poly1d.ClosedPoints(p, b_type);
 
-#ifndef MFEM_THREAD_SAFE
-   const int p1 = p + 1;
-
-   shape_x.SetSize(p1);
-   shape_y.SetSize(p1);
-   shape_z.SetSize(p1);
-   dshape_x.SetSize(p1);
-   dshape_y.SetSize(p1);
-   dshape_z.SetSize(p1);
-   d2shape_x.SetSize(p1);
-   d2shape_y.SetSize(p1);
-   d2shape_z.SetSize(p1);
-#endif
-
    int o = 0;
    for (int k = 0; k <= p; k++)
       for (int j = 0; j <= p; j++)
@@ -8021,9 +7998,7 @@ void H1_HexahedronElement::CalcShape(const IntegrationPoint &ip,
 {
    const int p = order;
 
-#ifdef MFEM_THREAD_SAFE
-   Vector shape_x(p+1), shape_y(p+1), shape_z(p+1);
-#endif
+   BasisScratch shape_x(p+1), shape_y(p+1), shape_z(p+1);
 
    basis1d.Eval(ip.x, shape_x);
    basis1d.Eval(ip.y, shape_y);
@@ -8042,10 +8017,8 @@ void H1_HexahedronElement::CalcDShape(const IntegrationPoint &ip,
 {
    const int p = order;
 
-#ifdef MFEM_THREAD_SAFE
-   Vector shape_x(p+1),  shape_y(p+1),  shape_z(p+1);
-   Vector dshape_x(p+1), dshape_y(p+1), dshape_z(p+1);
-#endif
+   BasisScratch shape_x(p+1),  shape_y(p+1),  shape_z(p+1);
+   BasisScratch dshape_x(p+1), dshape_y(p+1), dshape_z(p+1);
 
    basis1d.Eval(ip.x, shape_x, dshape_x);
    basis1d.Eval(ip.y, shape_y, dshape_y);
@@ -8066,11 +8039,9 @@ void H1_HexahedronElement::CalcHessian(const IntegrationPoint &ip,
 {
    const int p = order;
 
-#ifdef MFEM_THREAD_SAFE
-   Vector shape_x(p+1),  shape_y(p+1),  shape_z(p+1);
-   Vector dshape_x(p+1), dshape_y(p+1), dshape_z(p+1);
-   Vector d2shape_x(p+1), d2shape_y(p+1), d2shape_z(p+1);
-#endif
+   BasisScratch shape_x(p+1),  shape_y(p+1),  shape_z(p+1);
+   BasisScratch dshape_x(p+1), dshape_y(p+1), dshape_z(p+1);
+   BasisScratch d2shape_x(p+1), d2shape_y(p+1), d2shape_z(p+1);
 
    basis1d.Eval(ip.x, shape_x, dshape_x, d2shape_x);
    basis1d.Eval(ip.y, shape_y, dshape_y, d2shape_y);
@@ -8095,9 +8066,7 @@ void H1_HexahedronElement::ProjectDelta(int vertex, Vector &dofs) const
    const int p = order;
    const double *cp = poly1d.ClosedPoints(p,b_type);
 
-#ifdef MFEM_THREAD_SAFE
-   Vector shape_x(p+1), shape_y(p+1);
-#endif
+   BasisScratch shape_x(p+1), shape_y(p+1);
 
    for (int i = 0; i <= p; i++)
    {
@@ -8178,12 +8147,6 @@ void H1_HexahedronElement::ProjectDelta(int vertex, Vector &dofs) const
 H1Pos_SegmentElement::H1Pos_SegmentElement(const int p)
    : PositiveTensorFiniteElement(1, p, H1_DOF_MAP)
 {
-#ifndef MFEM_THREAD_SAFE
-   // thread private versions; see class header.
-   shape_x.SetSize(p+1);
-   dshape_x.SetSize(p+1);
-#endif
-
    // Endpoints need to be first in the list, so reorder them.
    Nodes.IntPoint(0).x = 0.0;
    Nodes.IntPoint(1).x = 1.0;
@@ -8198,9 +8161,7 @@ void H1Pos_SegmentElement::CalcShape(const IntegrationPoint &ip,
 {
    const int p = order;
 
-#ifdef MFEM_THREAD_SAFE
-   Vector shape_x(p+1);
-#endif
+   BasisScratch shape_x(p+1);
 
    Poly_1D::CalcBernstein(p, ip.x, shape_x.GetData() );
 
@@ -8218,9 +8179,7 @@ void H1Pos_SegmentElement::CalcDShape(const IntegrationPoint &ip,
 {
    const int p = order;
 
-#ifdef MFEM_THREAD_SAFE
-   Vector shape_x(p+1), dshape_x(p+1);
-#endif
+   BasisScratch shape_x(p+1), dshape_x(p+1);
 
    Poly_1D::CalcBernstein(p, ip.x, shape_x.GetData(), dshape_x.GetData() );
 
@@ -8243,15 +8202,6 @@ void H1Pos_SegmentElement::ProjectDelta(int vertex, Vector &dofs) const
 H1Pos_QuadrilateralElement::H1Pos_QuadrilateralElement(const int p)
    : PositiveTensorFiniteElement(2, p, H1_DOF_MAP)
 {
-#ifndef MFEM_THREAD_SAFE
-   const int p1 = p + 1;
-
-   shape_x.SetSize(p1);
-   shape_y.SetSize(p1);
-   dshape_x.SetSize(p1);
-   dshape_y.SetSize(p1);
-#endif
-
    int o = 0;
    for (int j = 0; j <= p; j++)
       for (int i = 0; i <= p; i++)
@@ -8265,9 +8215,7 @@ void H1Pos_QuadrilateralElement::CalcShape(const IntegrationPoint &ip,
 {
    const int p = order;
 
-#ifdef MFEM_THREAD_SAFE
-   Vector shape_x(p+1), shape_y(p+1);
-#endif
+   BasisScratch shape_x(p+1), shape_y(p+1);
 
    Poly_1D::CalcBernstein(p, ip.x, shape_x.GetData() );
    Poly_1D::CalcBernstein(p, ip.y, shape_y.GetData() );
@@ -8285,9 +8233,7 @@ void H1Pos_QuadrilateralElement::CalcDShape(const IntegrationPoint &ip,
 {
    const int p = order;
 
-#ifdef MFEM_THREAD_SAFE
-   Vector shape_x(p+1), shape_y(p+1), dshape_x(p+1), dshape_y(p+1);
-#endif
+   BasisScratch shape_x(p+1), shape_y(p+1), dshape_x(p+1), dshape_y(p+1);
 
    Poly_1D::CalcBernstein(p, ip.x, shape_x.GetData(), dshape_x.GetData() );
    Poly_1D::CalcBernstein(p, ip.y, shape_y.GetData(), dshape_y.GetData() );
@@ -8311,17 +8257,6 @@ void H1Pos_QuadrilateralElement::ProjectDelta(int vertex, Vector &dofs) const
 H1Pos_HexahedronElement::H1Pos_HexahedronElement(const int p)
    : PositiveTensorFiniteElement(3, p, H1_DOF_MAP)
 {
-#ifndef MFEM_THREAD_SAFE
-   const int p1 = p + 1;
-
-   shape_x.SetSize(p1);
-   shape_y.SetSize(p1);
-   shape_z.SetSize(p1);
-   dshape_x.SetSize(p1);
-   dshape_y.SetSize(p1);
-   dshape_z.SetSize(p1);
-#endif
-
    int o = 0;
    for (int k = 0; k <= p; k++)
       for (int j = 0; j <= p; j++)
@@ -8335,9 +8270,7 @@ void H1Pos_HexahedronElement::CalcShape(const IntegrationPoint &ip,
 {
    const int p = order;
 
-#ifdef MFEM_THREAD_SAFE
-   Vector shape_x(p+1), shape_y(p+1), shape_z(p+1);
-#endif
+   BasisScratch shape_x(p+1), shape_y(p+1), shape_z(p+1);
 
    Poly_1D::CalcBernstein(p, ip.x, shape_x.GetData() );
    Poly_1D::CalcBernstein(p, ip.y, shape_y.GetData() );
@@ -8356,10 +8289,8 @@ void H1Pos_HexahedronElement::CalcDShape(const IntegrationPoint &ip,
 {
    const int p = order;
 
-#ifdef MFEM_THREAD_SAFE
-   Vector shape_x(p+1),  shape_y(p+1),  shape_z(p+1);
-   Vector dshape_x(p+1), dshape_y(p+1), dshape_z(p+1);
-#endif
+   BasisScratch shape_x(p+1),  shape_y(p+1),  shape_z(p+1);
+   BasisScratch dshape_x(p+1), dshape_y(p+1), dshape_z(p+1);
 
    Poly_1D::CalcBernstein(p, ip.x, shape_x.GetData(), dshape_x.GetData() );
    Poly_1D::CalcBernstein(p, ip.y, shape_y.GetData(), dshape_y.GetData() );
@@ -9447,11 +9378,6 @@ L2_SegmentElement::L2_SegmentElement(const int p, const int btype)
 {
    const double *op = poly1d.OpenPoints(p, btype);
 
-#ifndef MFEM_THREAD_SAFE
-   shape_x.SetSize(p + 1);
-   dshape_x.SetDataAndSize(NULL, p + 1);
-#endif
-
    for (int i = 0; i <= p; i++)
    {
       Nodes.IntPoint(i).x = op[i];
@@ -9467,11 +9393,8 @@ void L2_SegmentElement::CalcShape(const IntegrationPoint &ip,
 void L2_SegmentElement::CalcDShape(const IntegrationPoint &ip,
                                    DenseMatrix &dshape) const
 {
-#ifdef MFEM_THREAD_SAFE
-   Vector shape_x(dof), dshape_x(dshape.Data(), dof);
-#else
-   dshape_x.SetData(dshape.Data());
-#endif
+   BasisScratch shape_x(dof);
+   Vector dshape_x(dshape.Data(), dof);
    basis1d.Eval(ip.x, shape_x, dshape_x);
 }
 
@@ -9502,11 +9425,6 @@ void L2_SegmentElement::ProjectDelta(int vertex, Vector &dofs) const
 L2Pos_SegmentElement::L2Pos_SegmentElement(const int p)
    : PositiveTensorFiniteElement(1, p, L2_DOF_MAP)
 {
-#ifndef MFEM_THREAD_SAFE
-   shape_x.SetSize(p + 1);
-   dshape_x.SetDataAndSize(NULL, p + 1);
-#endif
-
    if (p == 0)
    {
       Nodes.IntPoint(0).x = 0.5;
@@ -9529,11 +9447,8 @@ void L2Pos_SegmentElement::CalcShape(const IntegrationPoint &ip,
 void L2Pos_SegmentElement::CalcDShape(const IntegrationPoint &ip,
                                       DenseMatrix &dshape) const
 {
-#ifdef MFEM_THREAD_SAFE
-   Vector shape_x(dof), dshape_x(dshape.Data(), dof);
-#else
-   dshape_x.SetData(dshape.Data());
-#endif
+   BasisScratch shape_x(dof);
+   Vector dshape_x(dshape.Data(), dof);
    Poly_1D::CalcBernstein(order, ip.x, shape_x, dshape_x);
 }
 
@@ -9549,13 +9464,6 @@ L2_QuadrilateralElement::L2_QuadrilateralElement(const int p, const int btype)
 {
    const double *op = poly1d.OpenPoints(p, b_type);
 
-#ifndef MFEM_THREAD_SAFE
-   shape_x.SetSize(p + 1);
-   shape_y.SetSize(p + 1);
-   dshape_x.SetSize(p + 1);
-   dshape_y.SetSize(p + 1);
-#endif
-
    for (int o = 0, j = 0; j <= p; j++)
       for (int i = 0; i <= p; i++)
       {
@@ -9568,9 +9476,7 @@ void L2_QuadrilateralElement::CalcShape(const IntegrationPoint &ip,
 {
    const int p = order;
 
-#ifdef MFEM_THREAD_SAFE
-   Vector shape_x(p+1), shape_y(p+1);
-#endif
+   BasisScratch shape_x(p+1), shape_y(p+1);
 
    basis1d.Eval(ip.x, shape_x);
    basis1d.Eval(ip.y, shape_y);
@@ -9587,9 +9493,7 @@ void L2_QuadrilateralElement::CalcDShape(const IntegrationPoint &ip,
 {
    const int p = order;
 
-#ifdef MFEM_THREAD_SAFE
-   Vector shape_x(p+1), shape_y(p+1), dshape_x(p+1), dshape_y(p+1);
-#endif
+   BasisScratch shape_x(p+1), shape_y(p+1), dshape_x(p+1), dshape_y(p+1);
 
    basis1d.Eval(ip.x, shape_x, dshape_x);
    basis1d.Eval(ip.y, shape_y, dshape_y);
@@ -9607,9 +9511,7 @@ void L2_QuadrilateralElement::ProjectDelta(int vertex, Vector &dofs) const
    const int p = order;
    const double *op = poly1d.OpenPoints(p, b_type);
 
-#ifdef MFEM_THREAD_SAFE
-   Vector shape_x(p+1), shape_y(p+1);
-#endif
+   BasisScratch shape_x(p+1), shape_y(p+1);
 
    for (int i = 0; i <= p; i++)
    {
@@ -9654,13 +9556,6 @@ void L2_QuadrilateralElement::ProjectDelta(int vertex, Vector &dofs) const
 L2Pos_QuadrilateralElement::L2Pos_QuadrilateralElement(const int p)
    : PositiveTensorFiniteElement(2, p, L2_DOF_MAP)
 {
-#ifndef MFEM_THREAD_SAFE
-   shape_x.SetSize(p + 1);
-   shape_y.SetSize(p + 1);
-   dshape_x.SetSize(p + 1);
-   dshape_y.SetSize(p + 1);
-#endif
-
    if (p == 0)
    {
       Nodes.IntPoint(0).Set2(0.5, 0.5);
@@ -9680,9 +9575,7 @@ void L2Pos_QuadrilateralElement::CalcShape(const IntegrationPoint &ip,
 {
    const int p = order;
 
-#ifdef MFEM_THREAD_SAFE
-   Vector shape_x(p+1), shape_y(p+1);
-#endif
+   BasisScratch shape_x(p+1), shape_y(p+1);
 
    Poly_1D::CalcBernstein(p, ip.x, shape_x);
    Poly_1D::CalcBernstein(p, ip.y, shape_y);
@@ -9699,9 +9592,7 @@ void L2Pos_QuadrilateralElement::CalcDShape(const IntegrationPoint &ip,
 {
    const int p = order;
 
-#ifdef MFEM_THREAD_SAFE
-   Vector shape_x(p+1), shape_y(p+1), dshape_x(p+1), dshape_y(p+1);
-#endif
+   BasisScratch shape_x(p+1), shape_y(p+1), dshape_x(p+1), dshape_y(p+1);
 
    Poly_1D::CalcBernstein(p, ip.x, shape_x, dshape_x);
    Poly_1D::CalcBernstein(p, ip.y, shape_y, dshape_y);
@@ -9734,15 +9625,6 @@ L2_HexahedronElement::L2_HexahedronElement(const int p, const int btype)
 {
    const double *op = poly1d.OpenPoints(p, btype);
 
-#ifndef MFEM_THREAD_SAFE
-   shape_x.SetSize(p + 1);
-   shape_y.SetSize(p + 1);
-   shape_z.SetSize(p + 1);
-   dshape_x.SetSize(p + 1);
-   dshape_y.SetSize(p + 1);
-   dshape_z.SetSize(p + 1);
-#endif
-
    for (int o = 0, k = 0; k <= p; k++)
       for (int j = 0; j <= p; j++)
          for (int i = 0; i <= p; i++)
@@ -9756,9 +9638,7 @@ void L2_HexahedronElement::CalcShape(const IntegrationPoint &ip,
 {
    const int p = order;
 
-#ifdef MFEM_THREAD_SAFE
-   Vector shape_x(p+1), shape_y(p+1), shape_z(p+1);
-#endif
+   BasisScratch shape_x(p+1), shape_y(p+1), shape_z(p+1);
 
    basis1d.Eval(ip.x, shape_x);
    basis1d.Eval(ip.y, shape_y);
@@ -9777,10 +9657,8 @@ void L2_HexahedronElement::CalcDShape(const IntegrationPoint &ip,
 {
    const int p = order;
 
-#ifdef MFEM_THREAD_SAFE
-   Vector shape_x(p+1),  shape_y(p+1),  shape_z(p+1);
-   Vector dshape_x(p+1), dshape_y(p+1), dshape_z(p+1);
-#endif
+   BasisScratch shape_x(p+1),  shape_y(p+1),  shape_z(p+1);
+   BasisScratch dshape_x(p+1), dshape_y(p+1), dshape_z(p+1);
 
    basis1d.Eval(ip.x, shape_x, dshape_x);
    basis1d.Eval(ip.y, shape_y, dshape_y);
@@ -9801,9 +9679,7 @@ void L2_HexahedronElement::ProjectDelta(int vertex, Vector &dofs) const
    const int p = order;
    const double *op = poly1d.OpenPoints(p, b_type);
 
-#ifdef MFEM_THREAD_SAFE
-   Vector shape_x(p+1), shape_y(p+1);
-#endif
+   BasisScratch shape_x(p+1), shape_y(p+1);
 
    for (int i = 0; i <= p; i++)
    {
@@ -9884,15 +9760,6 @@ void L2_HexahedronElement::ProjectDelta(int vertex, Vector &dofs) const
 L2Pos_HexahedronElement::L2Pos_HexahedronElement(const int p)
    : PositiveTensorFiniteElement(3, p, L2_DOF_MAP)
 {
-#ifndef MFEM_THREAD_SAFE
-   shape_x.SetSize(p + 1);
-   shape_y.SetSize(p + 1);
-   shape_z.SetSize(p + 1);
-   dshape_x.SetSize(p + 1);
-   dshape_y.SetSize(p + 1);
-   dshape_z.SetSize(p + 1);
-#endif
-
    if (p == 0)
    {
       Nodes.IntPoint(0).Set3(0.5, 0.5, 0.5);
@@ -9913,9 +9780,7 @@ void L2Pos_HexahedronElement::CalcShape(const IntegrationPoint &ip,
 {
    const int p = order;
 
-#ifdef MFEM_THREAD_SAFE
-   Vector shape_x(p+1), shape_y(p+1), shape_z(p+1);
-#endif
+   BasisScratch shape_x(p+1), shape_y(p+1), shape_z(p+1);
 
    Poly_1D::CalcBernstein(p, ip.x, shape_x);
    Poly_1D::CalcBernstein(p, ip.y, shape_y);
@@ -9934,10 +9799,8 @@ void L2Pos_HexahedronElement::CalcDShape(const IntegrationPoint &ip,
 {
    const int p = order;
 
-#ifdef MFEM_THREAD_SAFE
-   Vector shape_x(p+1),  shape_y(p+1),  shape_z(p+1);
-   Vector dshape_x(p+1), dshape_y(p+1), dshape_z(p+1);
-#endif
+   BasisScratch shape_x(p+1),  shape_y(p+1),  shape_z(p+1);
+   BasisScratch dshape_x(p+1), dshape_y(p+1), dshape_z(p+1);
 
    Poly_1D::CalcBernstein(p, ip.x, shape_x, dshape_x);
    Poly_1D::CalcBernstein(p, ip.y, shape_y, dshape_y);
@@ -1873,7 +1873,7 @@ public:
    private:
       int etype;
       DenseMatrixInverse Ai;
-      mutable Vector x, w;
+      Vector x, w;
 
    public:
       /// Create a nodal or positive (Bernstein) basis
@@ -2129,11 +2129,6 @@ public:
 /// Arbitrary H1 elements in 1D
 class H1_SegmentElement : public NodalTensorFiniteElement
 {
-private:
-#ifndef MFEM_THREAD_SAFE
-   mutable Vector shape_x, dshape_x, d2shape_x;
-#endif
-
 public:
    /// Construct the H1_SegmentElement of order @a p and BasisType @a btype
    H1_SegmentElement(const int p, const int btype = BasisType::GaussLobatto);
@@ -2149,11 +2144,6 @@ public:
 /// Arbitrary H1 elements in 2D on a square
 class H1_QuadrilateralElement : public NodalTensorFiniteElement
 {
-private:
-#ifndef MFEM_THREAD_SAFE
-   mutable Vector shape_x, shape_y, dshape_x, dshape_y, d2shape_x, d2shape_y;
-#endif
-
 public:
    /// Construct the H1_QuadrilateralElement of order @a p and BasisType @a btype
    H1_QuadrilateralElement(const int p,
@@ -2170,12 +2160,6 @@ public:
 /// Arbitrary H1 elements in 3D on a cube
 class H1_HexahedronElement : public NodalTensorFiniteElement
 {
-private:
-#ifndef MFEM_THREAD_SAFE
-   mutable Vector shape_x, shape_y, shape_z, dshape_x, dshape_y, dshape_z,
-           d2shape_x, d2shape_y, d2shape_z;
-#endif
-
 public:
    /// Construct the H1_HexahedronElement of order @a p and BasisType @a btype
    H1_HexahedronElement(const int p, const int btype = BasisType::GaussLobatto);
@@ -2190,16 +2174,6 @@ public:
 /// Arbitrary order H1 elements in 1D utilizing the Bernstein basis
 class H1Pos_SegmentElement : public PositiveTensorFiniteElement
 {
-private:
-#ifndef MFEM_THREAD_SAFE
-   // This is to share scratch space between invocations, which helps speed
-   // things up, but with OpenMP, we need one copy per thread. Right now, we
-   // solve this by allocating this space within each function call every time
-   // we call it. Alternatively, we should do some sort thread private thing.
-   // Brunner, Jan 2014
-   mutable Vector shape_x, dshape_x;
-#endif
-
 public:
    /// Construct the H1Pos_SegmentElement of order @a p
    H1Pos_SegmentElement(const int p);
@@ -2213,12 +2187,6 @@ public:
 /// Arbitrary order H1 elements in 2D utilizing the Bernstein basis on a square
 class H1Pos_QuadrilateralElement : public PositiveTensorFiniteElement
 {
-private:
-#ifndef MFEM_THREAD_SAFE
-   // See comment in H1Pos_SegmentElement
-   mutable Vector shape_x, shape_y, dshape_x, dshape_y;
-#endif
-
 public:
    /// Construct the H1Pos_QuadrilateralElement of order @a p
    H1Pos_QuadrilateralElement(const int p);
@@ -2246,12 +2214,6 @@ public:
 /// Arbitrary order H1 elements in 3D utilizing the Bernstein basis on a cube
 class H1Pos_HexahedronElement : public PositiveTensorFiniteElement
 {
-private:
-#ifndef MFEM_THREAD_SAFE
-   // See comment in H1Pos_SegementElement.
-   mutable Vector shape_x, shape_y, shape_z, dshape_x, dshape_y, dshape_z;
-#endif
-
 public:
    /// Construct the H1Pos_HexahedronElement of order @a p
    H1Pos_HexahedronElement(const int p);
@@ -2437,11 +2399,6 @@ public:
 /// Arbitrary L2 elements in 1D on a segment
 class L2_SegmentElement : public NodalTensorFiniteElement
 {
-private:
-#ifndef MFEM_THREAD_SAFE
-   mutable Vector shape_x, dshape_x;
-#endif
-
 public:
    /// Construct the L2_SegmentElement of order @a p and BasisType @a btype
    L2_SegmentElement(const int p, const int btype = BasisType::GaussLegendre);
@@ -2454,11 +2411,6 @@ public:
 /// Arbitrary order L2 elements in 1D utilizing the Bernstein basis on a segment
 class L2Pos_SegmentElement : public PositiveTensorFiniteElement
 {
-private:
-#ifndef MFEM_THREAD_SAFE
-   mutable Vector shape_x, dshape_x;
-#endif
-
 public:
    /// Construct the L2Pos_SegmentElement of order @a p
    L2Pos_SegmentElement(const int p);
@@ -2472,11 +2424,6 @@ public:
 /// Arbitrary order L2 elements in 2D on a square
 class L2_QuadrilateralElement : public NodalTensorFiniteElement
 {
-private:
-#ifndef MFEM_THREAD_SAFE
-   mutable Vector shape_x, shape_y, dshape_x, dshape_y;
-#endif
-
 public:
    /// Construct the L2_QuadrilateralElement of order @a p and BasisType @a btype
    L2_QuadrilateralElement(const int p,
@@ -2494,11 +2441,6 @@ public:
 /// Arbitrary order L2 elements in 2D utilizing the Bernstein basis on a square
 class L2Pos_QuadrilateralElement : public PositiveTensorFiniteElement
 {
-private:
-#ifndef MFEM_THREAD_SAFE
-   mutable Vector shape_x, shape_y, dshape_x, dshape_y;
-#endif
-
 public:
    /// Construct the L2Pos_QuadrilateralElement of order @a p
    L2Pos_QuadrilateralElement(const int p);
@@ -2511,11 +2453,6 @@ public:
 /// Arbitrary order L2 elements in 3D on a cube
 class L2_HexahedronElement : public NodalTensorFiniteElement
 {
-private:
-#ifndef MFEM_THREAD_SAFE
-   mutable Vector shape_x, shape_y, shape_z, dshape_x, dshape_y, dshape_z;
-#endif
-
 public:
    /// Construct the L2_HexahedronElement of order @a p and BasisType @a btype
    L2_HexahedronElement(const int p,
@@ -2530,11 +2467,6 @@ public:
 /// Arbitrary order L2 elements in 3D utilizing the Bernstein basis on a cube
 class L2Pos_HexahedronElement : public PositiveTensorFiniteElement
 {
-private:
-#ifndef MFEM_THREAD_SAFE
-   mutable Vector shape_x, shape_y, shape_z, dshape_x, dshape_y, dshape_z;
-#endif
-
 public:
    /// Construct the L2Pos_HexahedronElement of order @a p
    L2Pos_HexahedronElement(const int p);
@@ -3227,6 +3159,8 @@ public:
 
    void                 Reset      ()         const { patch = elem = -1; }
    void                 SetIJK     (const int *IJK) const { ijk = IJK; }
+   /// Return the knot span indices of the element in each direction
+   const int           *GetIJK     ()         const { return ijk; }
    int                  GetPatch   ()         const { return patch; }
    void                 SetPatch   (int p)    const { patch = p; }
    int                  GetElement ()         const { return elem; }
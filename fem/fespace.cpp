@@ -1112,7 +1112,6 @@ SparseMatrix* FiniteElementSpace::RefinementMatrix(int old_ndofs,
 FiniteElementSpace::RefinementOperator::RefinementOperator
 (const FiniteElementSpace* fespace, Table* old_elem_dof, int old_ndofs)
    : fespace(fespace)
-   , old_elem_dof(old_elem_dof)
 {
    MFEM_VERIFY(fespace->GetNE() >= old_elem_dof->Size(),
                "Previous mesh is not coarser.");
@@ -1126,12 +1125,15 @@ FiniteElementSpace::RefinementOperator::RefinementOperator
    {
       fespace->GetLocalRefinementMatrices(elem_geoms[i], localP[elem_geoms[i]]);
    }
+
+   MakeDofMaps(*old_elem_dof);
+   delete old_elem_dof;
 }
 
 FiniteElementSpace::RefinementOperator::RefinementOperator(
    const FiniteElementSpace *fespace, const FiniteElementSpace *coarse_fes)
    : Operator(fespace->GetVSize(), coarse_fes->GetVSize()),
-     fespace(fespace), old_elem_dof(NULL)
+     fespace(fespace)
 {
    Mesh::GeometryList elem_geoms(*fespace->GetMesh());
 
@@ -1141,106 +1143,182 @@ FiniteElementSpace::RefinementOperator::RefinementOperator(
                                           localP[elem_geoms[i]]);
    }
 
-   // Make a copy of the coarse elem_dof Table.
-   old_elem_dof = new Table(coarse_fes->GetElementToDofTable());
+   MakeDofMaps(coarse_fes->GetElementToDofTable());
 }
 
-FiniteElementSpace::RefinementOperator::~RefinementOperator()
-{
-   delete old_elem_dof;
-}
-
-void FiniteElementSpace::RefinementOperator
-::Mult(const Vector &x, Vector &y) const
+void FiniteElementSpace::RefinementOperator::MakeDofMaps(
+   const Table &old_elem_dof)
 {
    Mesh* mesh = fespace->GetMesh();
    const CoarseFineTransformations &rtrans = mesh->GetRefinementTransforms();
+   const int old_ndofs = width / fespace->GetVDim();
 
-   Array<int> dofs, vdofs, old_dofs, old_vdofs;
-
-   int vdim = fespace->GetVDim();
-   int old_ndofs = width / vdim;
-
-   Vector subY, subX;
+   // Each fine DOF is interpolated by the first fine element containing it
+   Array<int> dofs, old_dofs, dof_elem(fespace->GetNDofs());
+   dof_elem = -1;
+   for (int k = 0; k < mesh->GetNE(); k++)
+   {
+      fespace->GetElementDofs(k, dofs);
+      for (int i = 0; i < dofs.Size(); i++)
+      {
+         const int d = DecodeDof(dofs[i]);
+         if (dof_elem[d] < 0) { dof_elem[d] = k; }
+      }
+   }
 
+   // Group the fine elements by geometry and sort them by embedding matrix
+   Array<Pair<int, int> > elems[Geometry::NumGeom];
    for (int k = 0; k < mesh->GetNE(); k++)
    {
-      const Embedding &emb = rtrans.embeddings[k];
       const Geometry::Type geom = mesh->GetElementBaseGeometry(k);
-      const DenseMatrix &lP = localP[geom](emb.matrix);
-
-      subY.SetSize(lP.Height());
+      elems[geom].Append(Pair<int, int>(rtrans.embeddings[k].matrix, k));
+   }
 
-      fespace->GetElementDofs(k, dofs);
-      old_elem_dof->GetRow(emb.parent, old_dofs);
+   for (int g = 0; g < Geometry::NumGeom; g++)
+   {
+      const int ne = elems[g].Size();
+      if (ne == 0) { continue; }
+      SortPairs<int, int>(elems[g], ne);
+
+      const int nf = localP[g].SizeI(), nc = localP[g].SizeJ();
+      coarse_map[g].SetSize(nc*ne);
+      elem_mat[g].SetSize(ne);
+      row_dof[g].SetSize(0);
+      row_loc[g].SetSize(0);
+      for (int e = 0; e < ne; e++)
+      {
+         const int k = elems[g][e].two;
+         elem_mat[g][e] = elems[g][e].one;
+         old_elem_dof.GetRow(rtrans.embeddings[k].parent, old_dofs);
+         MFEM_ASSERT(old_dofs.Size() == nc, "");
+         old_dofs.CopyTo(coarse_map[g].GetData() + nc*e);
+
+         fespace->GetElementDofs(k, dofs);
+         MFEM_ASSERT(dofs.Size() == nf, "");
+         for (int i = 0; i < nf; i++)
+         {
+            if (dof_elem[DecodeDof(dofs[i])] == k)
+            {
+               row_dof[g].Append(dofs[i]);
+               row_loc[g].Append(nf*e + i);
+            }
+         }
+      }
 
-      for (int vd = 0; vd < vdim; vd++)
+      // Transposed map, see ElementRestriction
+      Array<int> &off = offsets[g], &ind = indices[g];
+      off.SetSize(old_ndofs + 1);
+      off = 0;
+      const int nrows = row_dof[g].Size();
+      for (int q = 0; q < nrows; q++)
       {
-         dofs.Copy(vdofs);
-         fespace->DofsToVDofs(vd, vdofs);
-         old_dofs.Copy(old_vdofs);
-         fespace->DofsToVDofs(vd, old_vdofs, old_ndofs);
-         x.GetSubVector(old_vdofs, subX);
-         lP.Mult(subX, subY);
-         y.SetSubVector(vdofs, subY);
+         const int e = row_loc[g][q] / nf;
+         for (int j = 0; j < nc; j++)
+         {
+            off[DecodeDof(coarse_map[g][nc*e + j]) + 1]++;
+         }
+      }
+      off.PartialSum();
+      ind.SetSize(nc*nrows);
+      for (int q = 0; q < nrows; q++)
+      {
+         const int e = row_loc[g][q] / nf;
+         for (int j = 0; j < nc; j++)
+         {
+            ind[off[DecodeDof(coarse_map[g][nc*e + j])]++] = nc*q + j;
+         }
       }
+      for (int i = old_ndofs; i > 0; i--)
+      {
+         off[i] = off[i - 1];
+      }
+      off[0] = 0;
    }
 }
 
 void FiniteElementSpace::RefinementOperator
-::MultTranspose(const Vector &x, Vector &y) const
+::Mult(const Vector &x, Vector &y) const
 {
-   y = 0.0;
-
-   Mesh* mesh = fespace->GetMesh();
-   const CoarseFineTransformations &rtrans = mesh->GetRefinementTransforms();
-
-   Array<char> processed(fespace->GetVSize());
-   processed = 0;
-
-   Array<int> f_dofs, c_dofs, f_vdofs, c_vdofs;
-
-   int vdim = fespace->GetVDim();
-   int old_ndofs = width / vdim;
+   const int vd = fespace->GetVDim();
+   const bool t = fespace->GetOrdering() == Ordering::byVDIM;
+   const int fine_ndofs = height / vd;
+   const int old_ndofs = width / vd;
+   auto d_x = Reshape(x.Read(), t?vd:old_ndofs, t?old_ndofs:vd);
+   auto d_y = Reshape(y.Write(), t?vd:fine_ndofs, t?fine_ndofs:vd);
 
-   Vector subY, subX;
-
-   for (int k = 0; k < mesh->GetNE(); k++)
+   for (int g = 0; g < Geometry::NumGeom; g++)
    {
-      const Embedding &emb = rtrans.embeddings[k];
-      const Geometry::Type geom = mesh->GetElementBaseGeometry(k);
-      const DenseMatrix &lP = localP[geom](emb.matrix);
-
-      fespace->GetElementDofs(k, f_dofs);
-      old_elem_dof->GetRow(emb.parent, c_dofs);
-
-      subY.SetSize(lP.Width());
+      const int nrows = row_dof[g].Size();
+      if (nrows == 0) { continue; }
+      const int nf = localP[g].SizeI(), nc = localP[g].SizeJ();
+      auto d_P = Reshape(localP[g].Read(), nf, nc, localP[g].SizeK());
+      auto d_cmap = Reshape(coarse_map[g].Read(), nc, elem_mat[g].Size());
+      auto d_mat = elem_mat[g].Read();
+      auto d_rdof = row_dof[g].Read();
+      auto d_rloc = row_loc[g].Read();
+      MFEM_FORALL(q, nrows,
+      {
+         const int sf = d_rdof[q];
+         const int f = sf >= 0 ? sf : -1-sf;
+         const int e = d_rloc[q] / nf, i = d_rloc[q] % nf;
+         const int m = d_mat[e];
+         for (int c = 0; c < vd; c++)
+         {
+            double val = 0.0;
+            for (int j = 0; j < nc; j++)
+            {
+               const int sk = d_cmap(j, e);
+               const int k = sk >= 0 ? sk : -1-sk;
+               const double xk = d_x(t?c:k, t?k:c);
+               val += d_P(i, j, m) * (sk >= 0 ? xk : -xk);
+            }
+            d_y(t?c:f, t?f:c) = sf >= 0 ? val : -val;
+         }
+      });
+   }
+}
 
-      for (int vd = 0; vd < vdim; vd++)
-      {
-         f_dofs.Copy(f_vdofs);
-         fespace->DofsToVDofs(vd, f_vdofs);
-         c_dofs.Copy(c_vdofs);
-         fespace->DofsToVDofs(vd, c_vdofs, old_ndofs);
+void FiniteElementSpace::RefinementOperator
+::MultTranspose(const Vector &x, Vector &y) const
+{
+   const int vd = fespace->GetVDim();
+   const bool t = fespace->GetOrdering() == Ordering::byVDIM;
+   const int fine_ndofs = height / vd;
+   const int old_ndofs = width / vd;
 
-         x.GetSubVector(f_vdofs, subX);
+   y = 0.0;
+   auto d_x = Reshape(x.Read(), t?vd:fine_ndofs, t?fine_ndofs:vd);
+   auto d_y = Reshape(y.ReadWrite(), t?vd:old_ndofs, t?old_ndofs:vd);
 
-         for (int p = 0; p < f_dofs.Size(); ++p)
+   for (int g = 0; g < Geometry::NumGeom; g++)
+   {
+      if (row_dof[g].Size() == 0) { continue; }
+      const int nf = localP[g].SizeI(), nc = localP[g].SizeJ();
+      auto d_P = Reshape(localP[g].Read(), nf, nc, localP[g].SizeK());
+      auto d_cmap = Reshape(coarse_map[g].Read(), nc, elem_mat[g].Size());
+      auto d_mat = elem_mat[g].Read();
+      auto d_rdof = row_dof[g].Read();
+      auto d_rloc = row_loc[g].Read();
+      auto d_off = offsets[g].Read();
+      auto d_ind = indices[g].Read();
+      MFEM_FORALL(k, old_ndofs,
+      {
+         for (int c = 0; c < vd; c++)
          {
-            if (processed[DecodeDof(f_dofs[p])])
+            double val = 0.0;
+            for (int l = d_off[k]; l < d_off[k + 1]; l++)
             {
-               subX[p] = 0.0;
+               const int q = d_ind[l] / nc, j = d_ind[l] % nc;
+               const int sf = d_rdof[q];
+               const int f = sf >= 0 ? sf : -1-sf;
+               const int e = d_rloc[q] / nf, i = d_rloc[q] % nf;
+               const bool plus = (sf >= 0) == (d_cmap(j, e) >= 0);
+               const double px = d_P(i, j, d_mat[e]) * d_x(t?c:f, t?f:c);
+               val += plus ? px : -px;
             }
+            d_y(t?c:k, t?k:c) += val;
          }
-
-         lP.MultTranspose(subX, subY);
-         y.AddElementVector(c_vdofs, subY);
-      }
-
-      for (int p = 0; p < f_dofs.Size(); ++p)
-      {
-         processed[DecodeDof(f_dofs[p])] = 1;
-      }
+      });
    }
 }
 
@@ -1283,7 +1361,9 @@ FiniteElementSpace::DerefinementOperator::DerefinementOperator(
       }
    }
 
-   Table ref_type_to_matrix;
+   Table ref_type_to_matrix, coarse_to_fine;
+   Array<int> coarse_to_ref_type;
+   Array<Geometry::Type> ref_type_to_geom;
    rtrans.GetCoarseToFineMap(*f_mesh, coarse_to_fine, coarse_to_ref_type,
                              ref_type_to_matrix, ref_type_to_geom);
    MFEM_ASSERT(coarse_to_fine.Size() == c_fes->GetNE(), "");
@@ -1291,7 +1371,7 @@ FiniteElementSpace::DerefinementOperator::DerefinementOperator(
    const int total_ref_types = ref_type_to_geom.Size();
    int num_ref_types[Geometry::NumGeom], num_fine_elems[Geometry::NumGeom];
    Array<int> ref_type_to_coarse_elem_offset(total_ref_types);
-   ref_type_to_fine_elem_offset.SetSize(total_ref_types);
+   Array<int> ref_type_to_fine_elem_offset(total_ref_types);
    std::fill(num_ref_types, num_ref_types+Geometry::NumGeom, 0);
    std::fill(num_fine_elems, num_fine_elems+Geometry::NumGeom, 0);
    for (int i = 0; i < total_ref_types; i++)
@@ -1335,44 +1415,95 @@ FiniteElementSpace::DerefinementOperator::DerefinementOperator(
       }
    }
 
-   // Make a copy of the coarse element-to-dof Table.
-   coarse_elem_dof = new Table(c_fes->GetElementToDofTable());
-}
+   // Flat index maps for Mult(): each coarse DOF is computed by the last
+   // coarse element containing it.
+   const Table &coarse_elem_dof = c_fes->GetElementToDofTable();
+   Array<int> dof_elem(c_fes->GetNDofs()), c_dofs, f_dofs;
+   for (int coarse_el = 0; coarse_el < coarse_to_fine.Size(); coarse_el++)
+   {
+      coarse_elem_dof.GetRow(coarse_el, c_dofs);
+      for (int i = 0; i < c_dofs.Size(); i++)
+      {
+         dof_elem[DecodeDof(c_dofs[i])] = coarse_el;
+      }
+   }
+   for (int g = 0; g < Geometry::NumGeom; g++)
+   {
+      fine_offsets[g].SetSize(1);
+      fine_offsets[g][0] = 0;
+   }
+   for (int coarse_el = 0; coarse_el < coarse_to_fine.Size(); coarse_el++)
+   {
+      const int ref_type = coarse_to_ref_type[coarse_el];
+      const Geometry::Type g = ref_type_to_geom[ref_type];
+      const int e = fine_offsets[g].Size() - 1;
+      const int *fine_elems = coarse_to_fine.GetRow(coarse_el);
+      const int nfe = coarse_to_fine.RowSize(coarse_el);
+      for (int s = 0; s < nfe; s++)
+      {
+         fine_fes->GetElementDofs(fine_elems[s], f_dofs);
+         MFEM_ASSERT(f_dofs.Size() == localR[g].SizeJ(), "");
+         fine_map[g].Append(f_dofs);
+         fine_mat[g].Append(ref_type_to_fine_elem_offset[ref_type] + s);
+      }
+      fine_offsets[g].Append(fine_mat[g].Size());
 
-FiniteElementSpace::DerefinementOperator::~DerefinementOperator()
-{
-   delete coarse_elem_dof;
+      coarse_elem_dof.GetRow(coarse_el, c_dofs);
+      MFEM_ASSERT(c_dofs.Size() == localR[g].SizeI(), "");
+      for (int i = 0; i < c_dofs.Size(); i++)
+      {
+         if (dof_elem[DecodeDof(c_dofs[i])] == coarse_el)
+         {
+            row_dof[g].Append(c_dofs[i]);
+            row_loc[g].Append(c_dofs.Size()*e + i);
+         }
+      }
+   }
 }
 
 void FiniteElementSpace::DerefinementOperator
 ::Mult(const Vector &x, Vector &y) const
 {
-   Array<int> c_vdofs, f_vdofs;
-   Vector loc_x, loc_y;
-   DenseMatrix loc_x_mat, loc_y_mat;
-   const int vdim = fine_fes->GetVDim();
-   const int coarse_ndofs = height/vdim;
-   for (int coarse_el = 0; coarse_el < coarse_to_fine.Size(); coarse_el++)
+   const int vd = fine_fes->GetVDim();
+   const bool t = fine_fes->GetOrdering() == Ordering::byVDIM;
+   const int coarse_ndofs = height / vd;
+   const int fine_ndofs = width / vd;
+   auto d_x = Reshape(x.Read(), t?vd:fine_ndofs, t?fine_ndofs:vd);
+   auto d_y = Reshape(y.Write(), t?vd:coarse_ndofs, t?coarse_ndofs:vd);
+
+   for (int g = 0; g < Geometry::NumGeom; g++)
    {
-      coarse_elem_dof->GetRow(coarse_el, c_vdofs);
-      fine_fes->DofsToVDofs(c_vdofs, coarse_ndofs);
-      loc_y.SetSize(c_vdofs.Size());
-      loc_y = 0.0;
-      loc_y_mat.UseExternalData(loc_y.GetData(), c_vdofs.Size()/vdim, vdim);
-      const int ref_type = coarse_to_ref_type[coarse_el];
-      const Geometry::Type geom = ref_type_to_geom[ref_type];
-      const int *fine_elems = coarse_to_fine.GetRow(coarse_el);
-      const int num_fine_elems = coarse_to_fine.RowSize(coarse_el);
-      const int lR_offset = ref_type_to_fine_elem_offset[ref_type];
-      for (int s = 0; s < num_fine_elems; s++)
-      {
-         const DenseMatrix &lR = localR[geom](lR_offset+s);
-         fine_fes->GetElementVDofs(fine_elems[s], f_vdofs);
-         x.GetSubVector(f_vdofs, loc_x);
-         loc_x_mat.UseExternalData(loc_x.GetData(), f_vdofs.Size()/vdim, vdim);
-         AddMult(lR, loc_x_mat, loc_y_mat);
-      }
-      y.SetSubVector(c_vdofs, loc_y);
+      const int nrows = row_dof[g].Size();
+      if (nrows == 0) { continue; }
+      const int nc = localR[g].SizeI(), nf = localR[g].SizeJ();
+      auto d_R = Reshape(localR[g].Read(), nc, nf, localR[g].SizeK());
+      auto d_fmap = Reshape(fine_map[g].Read(), nf, fine_mat[g].Size());
+      auto d_fmat = fine_mat[g].Read();
+      auto d_foff = fine_offsets[g].Read();
+      auto d_rdof = row_dof[g].Read();
+      auto d_rloc = row_loc[g].Read();
+      MFEM_FORALL(q, nrows,
+      {
+         const int sk = d_rdof[q];
+         const int k = sk >= 0 ? sk : -1-sk;
+         const int e = d_rloc[q] / nc, i = d_rloc[q] % nc;
+         for (int c = 0; c < vd; c++)
+         {
+            double val = 0.0;
+            for (int s = d_foff[e]; s < d_foff[e + 1]; s++)
+            {
+               const int m = d_fmat[s];
+               for (int j = 0; j < nf; j++)
+               {
+                  const int sf = d_fmap(j, s);
+                  const int f = sf >= 0 ? sf : -1-sf;
+                  const double xf = d_x(t?c:f, t?f:c);
+                  val += d_R(i, j, m) * (sf >= 0 ? xf : -xf);
+               }
+            }
+            d_y(t?c:k, t?k:c) = sk >= 0 ? val : -val;
+         }
+      });
    }
 }
 
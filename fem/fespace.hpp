@@ -198,11 +198,26 @@ protected:
    void MakeVDimMatrix(SparseMatrix &mat) const;
 
    /// GridFunction interpolation operator applicable after mesh refinement.
+   /** The fine elements of each geometry are sorted by their embedding matrix
+       and the operator is applied in batched kernels, using flat index maps
+       computed in the constructor. Each fine DOF is interpolated from the
+       parent of the first fine element containing it. */
    class RefinementOperator : public Operator
    {
       const FiniteElementSpace* fespace;
       DenseTensor localP[Geometry::NumGeom];
-      Table* old_elem_dof; // Owned.
+      /// Signed coarse DOFs of the parents of the sorted fine elements.
+      Array<int> coarse_map[Geometry::NumGeom];
+      /// Index of the local matrix in localP for each sorted fine element.
+      Array<int> elem_mat[Geometry::NumGeom];
+      /// Signed fine DOFs interpolated from each geometry and their local
+      /// index, ldof*e + i, where e is the position of the sorted element.
+      Array<int> row_dof[Geometry::NumGeom], row_loc[Geometry::NumGeom];
+      /// CSR map from coarse DOFs to the pairs (row, coarse ldof), packed as
+      /// row*coarse_ldof + ldof, used by MultTranspose().
+      Array<int> offsets[Geometry::NumGeom], indices[Geometry::NumGeom];
+
+      void MakeDofMaps(const Table &old_elem_dof);
 
    public:
       /** Construct the operator based on the elem_dof table of the original
@@ -213,26 +228,27 @@ protected:
                          const FiniteElementSpace *coarse_fes);
       virtual void Mult(const Vector &x, Vector &y) const;
       virtual void MultTranspose(const Vector &x, Vector &y) const;
-      virtual ~RefinementOperator();
    };
 
    /// Derefinement operator, used by the friend class InterpolationGridTransfer.
+   /** As the RefinementOperator, it is applied in batched kernels, one for each
+       geometry of the coarse elements. */
    class DerefinementOperator : public Operator
    {
       const FiniteElementSpace *fine_fes; // Not owned.
       DenseTensor localR[Geometry::NumGeom];
-      Table *coarse_elem_dof; // Owned.
-      Table coarse_to_fine;
-      Array<int> coarse_to_ref_type;
-      Array<Geometry::Type> ref_type_to_geom;
-      Array<int> ref_type_to_fine_elem_offset;
+      /// Offsets of the fine elements of each coarse element in fine_map.
+      Array<int> fine_offsets[Geometry::NumGeom];
+      /// Signed fine DOFs and index in localR of the fine elements.
+      Array<int> fine_map[Geometry::NumGeom], fine_mat[Geometry::NumGeom];
+      /// Signed coarse DOFs computed from each geometry and their local index.
+      Array<int> row_dof[Geometry::NumGeom], row_loc[Geometry::NumGeom];
 
    public:
       DerefinementOperator(const FiniteElementSpace *f_fes,
                            const FiniteElementSpace *c_fes,
                            BilinearFormIntegrator *mass_integ);
       virtual void Mult(const Vector &x, Vector &y) const;
-      virtual ~DerefinementOperator();
    };
 
    /** This method makes the same assumptions as the method:
@@ -462,7 +478,8 @@ public:
 
    /** @brief Returns the transformation defining the @a i-th element in the
        user-defined variable @a ElTr. */
-   void GetElementTransformation(int i, IsoparametricTransformation *ElTr)
+   void GetElementTransformation(int i,
+                                 IsoparametricTransformation *ElTr) const
    { mesh->GetElementTransformation(i, ElTr); }
 
    /// Returns ElementTransformation for the @a i-th boundary element.
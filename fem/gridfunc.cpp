@@ -14,6 +14,9 @@
 #include "gridfunc.hpp"
 #include "../mesh/nurbs.hpp"
 #include "../general/text.hpp"
+#include "../general/forall.hpp"
+#include "quadinterpolator.hpp"
+#include "restriction.hpp"
 
 #ifdef MFEM_USE_MPI
 #include "pfespace.hpp"
@@ -22,6 +25,7 @@
 #include <limits>
 #include <cstring>
 #include <string>
+#include <sstream>
 #include <cmath>
 #include <iostream>
 #include <algorithm>
@@ -59,6 +63,13 @@ GridFunction::GridFunction(Mesh *m, std::istream &input)
          MFEM_ABORT("unknown section: " << buff);
       }
    }
+   else if (next_char == 'b') // First letter of "binary_values"
+   {
+      string buff;
+      getline(input, buff);
+      MFEM_VERIFY(buff == "binary_values", "unknown section: " << buff);
+      Vector::LoadBinary(input, fes->GetVSize());
+   }
    else
    {
       Vector::Load(input, fes->GetVSize());
@@ -2254,12 +2265,75 @@ void GridFunction::ProjectDeltaCoefficient(DeltaCoefficient &delta_coeff,
    }
 }
 
+// Check if the QuadratureInterpolator kernels can evaluate scalar functions in
+// @a fes at the points of @a ir in all elements.
+static bool BatchedScalarValues(const FiniteElementSpace &fes,
+                                const IntegrationRule &ir)
+{
+   const Mesh *mesh = fes.GetMesh();
+   const int dim = mesh->Dimension();
+   if (fes.GetNE() == 0 || fes.GetVDim() != 1 || mesh->NURBSext ||
+       dim != mesh->SpaceDimension() || mesh->GetNumGeometries(dim) != 1 ||
+       fes.GetFE(0)->GetRangeType() != FiniteElement::SCALAR)
+   {
+      return false;
+   }
+   const int ND = fes.GetFE(0)->GetDof();
+   const int NQ = ir.GetNPoints();
+   if (dim == 2)
+   {
+      return ND <= QuadratureInterpolator::MAX_ND2D &&
+             NQ <= QuadratureInterpolator::MAX_NQ2D;
+   }
+   if (dim == 3)
+   {
+      return ND <= QuadratureInterpolator::MAX_ND3D &&
+             NQ <= QuadratureInterpolator::MAX_NQ3D;
+   }
+   return false;
+}
+
+// Batched version of the element loop in GridFunction::ProjectCoefficient()
+// for nodal elements: the coefficient is evaluated at the element nodes and
+// the values are scattered with ElementRestriction::MultLeftInverse(), i.e.
+// the last element containing a dof sets its value. Returns false if the space
+// is not supported.
+static bool ProjectNodalBatched(GridFunction &gf, Coefficient &coeff)
+{
+   FiniteElementSpace *fes = gf.FESpace();
+   Mesh *mesh = fes->GetMesh();
+   if (fes->GetNE() == 0 || fes->GetVDim() != 1 || mesh->NURBSext ||
+       mesh->GetNumGeometries(mesh->Dimension()) != 1)
+   {
+      return false;
+   }
+   const NodalFiniteElement *fe =
+      dynamic_cast<const NodalFiniteElement*>(fes->GetFE(0));
+   if (fe == NULL || fe->GetMapType() != FiniteElement::VALUE)
+   {
+      return false;
+   }
+   const Operator *R = fes->GetElementRestriction(ElementDofOrdering::NATIVE);
+   const ElementRestriction *er = dynamic_cast<const ElementRestriction*>(R);
+   const L2ElementRestriction *l2r =
+      dynamic_cast<const L2ElementRestriction*>(R);
+   if (!er && !l2r) { return false; }
+
+   Vector e_vals;
+   coeff.EvalBatch(e_vals, *mesh, fe->GetNodes());
+   if (er) { er->MultLeftInverse(e_vals, gf); }
+   else { l2r->MultLeftInverse(e_vals, gf); }
+   return true;
+}
+
 void GridFunction::ProjectCoefficient(Coefficient &coeff)
 {
    DeltaCoefficient *delta_c = dynamic_cast<DeltaCoefficient *>(&coeff);
 
    if (delta_c == NULL)
    {
+      if (ProjectNodalBatched(*this, coeff)) { return; }
+
       Array<int> vdofs;
       Vector vals;
 
@@ -3110,6 +3184,83 @@ double GridFunction::ComputeW11Error(
    return error;
 }
 
+// Batched version of the element loops in GridFunction::ComputeLpError() and
+// GridFunction::ComputeElementLpErrors(). For finite p, @a elem_err is set to
+// the integrals of weight*|gf-exsol|^p in the elements, or to their p-th roots
+// if @a root is true; otherwise it is set to the maximum of weight*|gf-exsol|.
+// Returns false if the space of @a gf is not supported.
+static bool ElementLpErrorsBatched(const GridFunction &gf, const double p,
+                                   Coefficient &exsol, Coefficient *weight,
+                                   const IntegrationRule *irs[], bool root,
+                                   Vector &elem_err)
+{
+   const FiniteElementSpace *fes = gf.FESpace();
+   if (fes->GetNE() == 0) { return false; }
+   Mesh *mesh = fes->GetMesh();
+   const FiniteElement *fe = fes->GetFE(0);
+   const IntegrationRule &ir = irs ? *irs[fe->GetGeomType()] :
+                               IntRules.Get(fe->GetGeomType(),
+                                            2*fe->GetOrder() + 3);
+   if (!BatchedScalarValues(*fes, ir)) { return false; }
+   const Operator *R = fes->GetElementRestriction(ElementDofOrdering::NATIVE);
+   if (R == NULL) { return false; }
+
+   const int NE = fes->GetNE();
+   const int NQ = ir.GetNPoints();
+   const QuadratureInterpolator *qi = fes->GetQuadratureInterpolator(ir);
+   qi->DisableTensorProducts();
+   qi->SetOutputLayout(QVectorLayout::byNODES);
+   Vector e_vec(R->Height()), u_q(NQ*NE), ex_q, w_q;
+   R->Mult(gf, e_vec);
+   qi->Values(e_vec, u_q);
+   exsol.EvalBatch(ex_q, *mesh, ir);
+   if (weight) { weight->EvalBatch(w_q, *mesh, ir); }
+
+   // Mesh::GetGeometricFactors() would add nodes to a mesh without them
+   const int flags = GeometricFactors::DETERMINANTS;
+   GeometricFactors *own_geom =
+      mesh->GetNodes() ? NULL : new GeometricFactors(mesh, ir, flags);
+   const GeometricFactors *geom =
+      own_geom ? own_geom : mesh->GetGeometricFactors(ir, flags);
+
+   const bool finite_p = (p < infinity());
+   const bool use_weight = (weight != NULL);
+   auto U = Reshape(u_q.Read(), NQ, NE);
+   auto EX = Reshape(ex_q.Read(), NQ, NE);
+   auto WQ = Reshape(use_weight ? w_q.Read() : ex_q.Read(), NQ, NE);
+   auto W = ir.GetWeights().Read();
+   auto detJ = Reshape(geom->detJ.Read(), NQ, NE);
+   elem_err.SetSize(NE);
+   auto E = elem_err.Write();
+   MFEM_FORALL(e, NE,
+   {
+      double err_e = 0.0;
+      for (int q = 0; q < NQ; q++)
+      {
+         double err = fabs(U(q,e) - EX(q,e));
+         if (finite_p)
+         {
+            err = pow(err, p);
+            if (use_weight) { err *= WQ(q,e); }
+            err_e += W[q]*detJ(q,e)*err;
+         }
+         else
+         {
+            if (use_weight) { err *= WQ(q,e); }
+            err_e = fmax(err_e, err);
+         }
+      }
+      if (finite_p && root)
+      {
+         // Negative quadrature weights may cause the error to be negative
+         err_e = (err_e < 0.0) ? -pow(-err_e, 1.0/p) : pow(err_e, 1.0/p);
+      }
+      E[e] = err_e;
+   });
+   delete own_geom;
+   return true;
+}
+
 double GridFunction::ComputeLpError(const double p, Coefficient &exsol,
                                     Coefficient *weight,
                                     const IntegrationRule *irs[]) const
@@ -3119,42 +3270,51 @@ double GridFunction::ComputeLpError(const double p, Coefficient &exsol,
    ElementTransformation *T;
    Vector vals;
 
-   for (int i = 0; i < fes->GetNE(); i++)
+   Vector elem_err;
+   if (ElementLpErrorsBatched(*this, p, exsol, weight, irs, false, elem_err))
    {
-      fe = fes->GetFE(i);
-      const IntegrationRule *ir;
-      if (irs)
-      {
-         ir = irs[fe->GetGeomType()];
-      }
-      else
-      {
-         int intorder = 2*fe->GetOrder() + 3; // <----------
-         ir = &(IntRules.Get(fe->GetGeomType(), intorder));
-      }
-      GetValues(i, *ir, vals);
-      T = fes->GetElementTransformation(i);
-      for (int j = 0; j < ir->GetNPoints(); j++)
+      elem_err.HostRead();
+      error = (p < infinity()) ? elem_err.Sum() : elem_err.Max();
+   }
+   else
+   {
+      for (int i = 0; i < fes->GetNE(); i++)
       {
-         const IntegrationPoint &ip = ir->IntPoint(j);
-         T->SetIntPoint(&ip);
-         double err = fabs(vals(j) - exsol.Eval(*T, ip));
-         if (p < infinity())
+         fe = fes->GetFE(i);
+         const IntegrationRule *ir;
+         if (irs)
          {
-            err = pow(err, p);
-            if (weight)
-            {
-               err *= weight->Eval(*T, ip);
-            }
-            error += ip.weight * T->Weight() * err;
+            ir = irs[fe->GetGeomType()];
          }
          else
          {
-            if (weight)
+            int intorder = 2*fe->GetOrder() + 3; // <----------
+            ir = &(IntRules.Get(fe->GetGeomType(), intorder));
+         }
+         GetValues(i, *ir, vals);
+         T = fes->GetElementTransformation(i);
+         for (int j = 0; j < ir->GetNPoints(); j++)
+         {
+            const IntegrationPoint &ip = ir->IntPoint(j);
+            T->SetIntPoint(&ip);
+            double err = fabs(vals(j) - exsol.Eval(*T, ip));
+            if (p < infinity())
             {
-               err *= weight->Eval(*T, ip);
+               err = pow(err, p);
+               if (weight)
+               {
+                  err *= weight->Eval(*T, ip);
+               }
+               error += ip.weight * T->Weight() * err;
+            }
+            else
+            {
+               if (weight)
+               {
+                  err *= weight->Eval(*T, ip);
+               }
+               error = std::max(error, err);
             }
-            error = std::max(error, err);
          }
       }
    }
@@ -3183,6 +3343,11 @@ void GridFunction::ComputeElementLpErrors(const double p, Coefficient &exsol,
    MFEM_ASSERT(error.Size() == fes->GetNE(),
                "Incorrect size for result vector");
 
+   if (ElementLpErrorsBatched(*this, p, exsol, weight, irs, true, error))
+   {
+      return;
+   }
+
    error = 0.0;
    const FiniteElement *fe;
    ElementTransformation *T;
@@ -3463,6 +3628,25 @@ void GridFunction::Save(std::ostream &out) const
    out.flush();
 }
 
+// Write the text header followed by the "binary_values" line, padded so that
+// the binary data after it starts at an offset that is a multiple of 8.
+static void WriteBinaryValuesHeader(std::ostream &out, std::string header)
+{
+   const std::string tag = "binary_values\n";
+   header += '\n';
+   header.append((8 - (header.size() + tag.size()) % 8) % 8, ' ');
+   out << header << tag;
+}
+
+void GridFunction::SaveBinary(std::ostream &out) const
+{
+   std::ostringstream header;
+   fes->Save(header);
+   WriteBinaryValuesHeader(out, header.str());
+   Vector::PrintBinary(out);
+   out.flush();
+}
+
 #ifdef MFEM_USE_ADIOS2
 void GridFunction::Save(adios2stream &out,
                         const std::string& variable_name,
@@ -3683,7 +3867,17 @@ QuadratureFunction::QuadratureFunction(Mesh *mesh, std::istream &in)
    in >> ident; MFEM_VERIFY(ident == "VDim:", msg);
    in >> vdim;
 
-   Load(in, vdim*qspace->GetSize());
+   skip_comment_lines(in, '#');
+   if (in.peek() == 'b') // First letter of "binary_values"
+   {
+      getline(in, ident);
+      MFEM_VERIFY(ident == "binary_values", msg);
+      LoadBinary(in, vdim*qspace->GetSize());
+   }
+   else
+   {
+      Load(in, vdim*qspace->GetSize());
+   }
 }
 
 QuadratureFunction & QuadratureFunction::operator=(double value)
@@ -3713,6 +3907,16 @@ void QuadratureFunction::Save(std::ostream &out) const
    out.flush();
 }
 
+void QuadratureFunction::SaveBinary(std::ostream &out) const
+{
+   std::ostringstream header;
+   qspace->Save(header);
+   header << "VDim: " << vdim << '\n';
+   WriteBinaryValuesHeader(out, header.str());
+   Vector::PrintBinary(out);
+   out.flush();
+}
+
 std::ostream &operator<<(std::ostream &out, const QuadratureFunction &qf)
 {
    qf.Save(out);
@@ -3867,6 +4071,96 @@ double ComputeElementLpDistance(double p, int i,
    return norm;
 }
 
+void ComputeElementLpDistances(double p, GridFunction &gf1, GridFunction &gf2,
+                               Vector &distances)
+{
+   FiniteElementSpace *fes1 = gf1.FESpace();
+   FiniteElementSpace *fes2 = gf2.FESpace();
+   Mesh *mesh = fes1->GetMesh();
+   const int NE = mesh->GetNE();
+
+   distances.SetSize(NE);
+   if (NE == 0) { return; }
+
+   const int dim = mesh->Dimension();
+   const FiniteElement *fe1 = fes1->GetFE(0);
+   const FiniteElement *fe2 = fes2->GetFE(0);
+
+   const bool batched =
+      mesh->GetNumGeometries(dim) == 1 &&
+      dim == mesh->SpaceDimension() &&
+      mesh->NURBSext == NULL &&
+      fe1->GetRangeType() == FiniteElement::SCALAR &&
+      fe2->GetRangeType() == FiniteElement::SCALAR &&
+      fes1->GetVDim() == fes2->GetVDim();
+
+   if (!batched)
+   {
+      for (int i = 0; i < NE; i++)
+      {
+         distances(i) = ComputeElementLpDistance(p, i, gf1, gf2);
+      }
+      return;
+   }
+
+   int intorder = 2*std::max(fe1->GetOrder(), fe2->GetOrder()) + 1;
+   const IntegrationRule &ir = IntRules.Get(fe1->GetGeomType(), intorder);
+   // Mesh::GetGeometricFactors() would add nodes to a mesh without them
+   const int flags = GeometricFactors::DETERMINANTS;
+   GeometricFactors *own_geom =
+      mesh->GetNodes() ? NULL : new GeometricFactors(mesh, ir, flags);
+   const GeometricFactors *geom =
+      own_geom ? own_geom : mesh->GetGeometricFactors(ir, flags);
+   const DofToQuad &maps1 = fe1->GetDofToQuad(ir, DofToQuad::FULL);
+   const DofToQuad &maps2 = fe2->GetDofToQuad(ir, DofToQuad::FULL);
+
+   const ElementDofOrdering ordering = ElementDofOrdering::NATIVE;
+   const Operator *R1 = fes1->GetElementRestriction(ordering);
+   const Operator *R2 = fes2->GetElementRestriction(ordering);
+   Vector x1(R1->Height()), x2(R2->Height());
+   R1->Mult(gf1, x1);
+   R2->Mult(gf2, x2);
+
+   const int NQ = ir.GetNPoints();
+   const int ND1 = maps1.ndof, ND2 = maps2.ndof;
+   const int VDIM = fes1->GetVDim();
+   const bool finite_p = (p < infinity());
+
+   auto B1 = Reshape(maps1.B.Read(), NQ, ND1);
+   auto B2 = Reshape(maps2.B.Read(), NQ, ND2);
+   auto X1 = Reshape(x1.Read(), ND1, VDIM, NE);
+   auto X2 = Reshape(x2.Read(), ND2, VDIM, NE);
+   auto W = ir.GetWeights().Read();
+   auto detJ = Reshape(geom->detJ.Read(), NQ, NE);
+   auto D = distances.Write();
+
+   MFEM_FORALL(e, NE,
+   {
+      double norm = 0.0;
+      for (int q = 0; q < NQ; q++)
+      {
+         double err2 = 0.0;
+         for (int c = 0; c < VDIM; c++)
+         {
+            double diff = 0.0;
+            for (int d = 0; d < ND1; d++) { diff += B1(q,d)*X1(d,c,e); }
+            for (int d = 0; d < ND2; d++) { diff -= B2(q,d)*X2(d,c,e); }
+            err2 += diff*diff;
+         }
+         const double err = sqrt(err2);
+         if (finite_p) { norm += W[q]*detJ(q,e)*pow(err, p); }
+         else { norm = fmax(norm, err); }
+      }
+      if (finite_p)
+      {
+         // Negative quadrature weights may cause the norm to be negative
+         norm = (norm < 0.0) ? -pow(-norm, 1.0/p) : pow(norm, 1.0/p);
+      }
+      D[e] = norm;
+   });
+   delete own_geom;
+}
+
 
 double ExtrudeCoefficient::Eval(ElementTransformation &T,
                                 const IntegrationPoint &ip)
@@ -93,9 +93,9 @@ public:
    { fes = f; fec = NULL; sequence = f->GetSequence(); UseDevice(true); }
 
    /// Construct a GridFunction on the given Mesh, using the data from @a input.
-   /** The content of @a input should be in the format created by the method
-       Save(). The reconstructed FiniteElementSpace and FiniteElementCollection
-       are owned by the GridFunction. */
+   /** The content of @a input should be in the format created by the methods
+       Save() or SaveBinary(). The reconstructed FiniteElementSpace and
+       FiniteElementCollection are owned by the GridFunction. */
    GridFunction(Mesh *m, std::istream &input);
 
    GridFunction(Mesh *m, GridFunction *gf_array[], int num_pieces);
@@ -648,6 +648,15 @@ public:
    /// Save the GridFunction to an output stream.
    virtual void Save(std::ostream &out) const;
 
+   /** @brief Save the GridFunction to an output stream, writing the values in
+       binary format. */
+   /** The FiniteElementSpace header is written as text, as in Save(), and it
+       is followed by a "binary_values" section, see Vector::PrintBinary().
+       Relative to the beginning of the GridFunction, the values are aligned
+       to 8 bytes, so that when the output begins at an aligned file offset,
+       loading it from a mfem::mapped_ifstream does not copy the values. */
+   virtual void SaveBinary(std::ostream &out) const;
+
 #ifdef MFEM_USE_ADIOS2
    /// Save the GridFunction to a binary output stream using adios2 bp format.
    virtual void Save(adios2stream &out, const std::string& variable_name,
@@ -851,6 +860,10 @@ public:
 
    /// Write the QuadratureFunction to the stream @a out.
    void Save(std::ostream &out) const;
+
+   /** @brief Write the QuadratureFunction to the stream @a out, with the
+       values in binary format, see GridFunction::SaveBinary(). */
+   void SaveBinary(std::ostream &out) const;
 };
 
 /// Overload operator<< for std::ostream and QuadratureFunction.
@@ -869,6 +882,15 @@ double ZZErrorEstimator(BilinearFormIntegrator &blfi,
 double ComputeElementLpDistance(double p, int i,
                                 GridFunction& gf1, GridFunction& gf2);
 
+/** @brief Compute the Lp distances between two grid functions on all elements
+    of the mesh, see ComputeElementLpDistance(). */
+/** The distances are computed with a batched kernel (on the device, if one is
+    enabled) when the mesh has a single element geometry and both spaces have
+    scalar basis functions with the same vector dimension. Otherwise, this
+    function falls back to ComputeElementLpDistance(). */
+void ComputeElementLpDistances(double p, GridFunction &gf1, GridFunction &gf2,
+                               Vector &distances);
+
 
 /// Class used for extruding scalar GridFunctions
 class ExtrudeCoefficient : public Coefficient
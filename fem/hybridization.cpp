@@ -581,23 +581,40 @@ void Hybridization::ComputeH()
    SparseMatrix *V = pC ? new SparseMatrix(Ct->Height(), Ct->Width()) : NULL;
 #endif
 
+   // Factor the A_ii blocks, then compute the Schur complements S_bb and
+   // factor them. The factorizations are batched over the elements with the
+   // same block sizes.
+   Array<int> i_sizes(NE), b_sizes(NE);
+   Array<double*> ii_data(NE), bb_data(NE);
+   Array<int*> ii_ipiv(NE), bb_ipiv(NE);
+   for (int el = 0; el < NE; el++)
+   {
+      GetBDofs(el, i_sizes[el], b_dofs);
+      b_sizes[el] = b_dofs.Size();
+      const int i_size = i_sizes[el], b_size = b_sizes[el];
+      ii_data[el] = Af_data + Af_offsets[el];
+      ii_ipiv[el] = Af_ipiv + Af_f_offsets[el];
+      bb_data[el] = ii_data[el] + i_size*i_size + 2*i_size*b_size;
+      bb_ipiv[el] = ii_ipiv[el] + i_size;
+   }
+   BatchLUFactor(i_sizes, ii_data, ii_ipiv);
+   for (int el = 0; el < NE; el++)
+   {
+      const int i_size = i_sizes[el], b_size = b_sizes[el];
+      double *A_ib_data = ii_data[el] + i_size*i_size;
+      double *A_bi_data = A_ib_data + i_size*b_size;
+      LUFactors LU_ii(ii_data[el], ii_ipiv[el]);
+      LU_ii.BlockFactor(i_size, b_size, A_ib_data, A_bi_data, bb_data[el]);
+   }
+   BatchLUFactor(b_sizes, bb_data, bb_ipiv);
+
    c_dof_marker = -1;
    int c_mark_start = 0;
    for (int el = 0; el < NE; el++)
    {
       int i_dofs_size;
       GetBDofs(el, i_dofs_size, b_dofs);
-
-      LUFactors LU_ii(Af_data + Af_offsets[el], Af_ipiv + Af_f_offsets[el]);
-      double *A_ib_data = LU_ii.data + i_dofs_size*i_dofs_size;
-      double *A_bi_data = A_ib_data + i_dofs_size*b_dofs.Size();
-      LUFactors LU_bb(A_bi_data + i_dofs_size*b_dofs.Size(),
-                      LU_ii.ipiv + i_dofs_size);
-
-      LU_ii.Factor(i_dofs_size);
-      LU_ii.BlockFactor(i_dofs_size, b_dofs.Size(),
-                        A_ib_data, A_bi_data, LU_bb.data);
-      LU_bb.Factor(b_dofs.Size());
+      LUFactors LU_bb(bb_data[el], bb_ipiv[el]);
 
       // Extract Cb_t from Ct, define c_dofs
       c_dofs.SetSize(0);
@@ -10,6 +10,9 @@
 // CONTRIBUTING.md for details.
 
 #include "multigrid.hpp"
+#ifdef MFEM_USE_MPI
+#include "pbilinearform.hpp"
+#endif
 
 namespace mfem
 {
@@ -210,4 +213,200 @@ void Multigrid::RecoverFineFEMSolution(const Vector& X, const Vector& b,
    bfs.Last()->RecoverFEMSolution(X, b, x);
 }
 
+BilinearFormMultigrid::BilinearFormMultigrid(
+   FiniteElementSpaceHierarchy& fespaces_, BilinearForm& a,
+   const Array<int>& ess_bdr, int smoother_order, int coarse_min_dofs_)
+   : Multigrid(fespaces_), coarse_prec(NULL), coarse_min_dofs(coarse_min_dofs_),
+     own_fine_form(false)
+{
+   const int numLevels = fespaces_.GetNumLevels();
+   MFEM_VERIFY(a.FESpace() == &fespaces_.GetFinestFESpace(),
+               "The prototype form must be defined on the finest space.");
+#ifdef MFEM_USE_MPI
+   ParBilinearForm* pa = dynamic_cast<ParBilinearForm*>(&a);
+#endif
+
+   for (int level = 0; level < numLevels; ++level)
+   {
+      FiniteElementSpace& fespace = fespaces_.GetFESpaceAtLevel(level);
+      BilinearForm* form = &a;
+      if (level < numLevels - 1)
+      {
+#ifdef MFEM_USE_MPI
+         if (pa)
+         {
+            ParFiniteElementSpace* pfespace =
+               dynamic_cast<ParFiniteElementSpace*>(&fespace);
+            MFEM_VERIFY(pfespace, "A ParBilinearForm requires a "
+                        "ParFiniteElementSpaceHierarchy.");
+            form = new ParBilinearForm(pfespace, pa);
+         }
+         else
+#endif
+         {
+            form = new BilinearForm(&fespace, &a);
+         }
+      }
+      AddFormLevel(form, ess_bdr, smoother_order);
+   }
+}
+
+BilinearFormMultigrid::BilinearFormMultigrid(
+   FiniteElementSpaceHierarchy& fespaces_,
+   const IntegratorFactory& add_integrators, AssemblyLevel assembly,
+   const Array<int>& ess_bdr, int smoother_order, int coarse_min_dofs_)
+   : Multigrid(fespaces_), coarse_prec(NULL), coarse_min_dofs(coarse_min_dofs_),
+     own_fine_form(true)
+{
+   const int numLevels = fespaces_.GetNumLevels();
+   for (int level = 0; level < numLevels; ++level)
+   {
+      FiniteElementSpace& fespace = fespaces_.GetFESpaceAtLevel(level);
+      BilinearForm* form;
+#ifdef MFEM_USE_MPI
+      if (ParFiniteElementSpace* pfespace =
+             dynamic_cast<ParFiniteElementSpace*>(&fespace))
+      {
+         form = new ParBilinearForm(pfespace);
+      }
+      else
+#endif
+      {
+         form = new BilinearForm(&fespace);
+      }
+      // The coarsest level is fully assembled for the coarse solver
+      form->SetAssemblyLevel(level == 0 ? AssemblyLevel::LEGACYFULL : assembly);
+      add_integrators(*form);
+      AddFormLevel(form, ess_bdr, smoother_order);
+   }
+}
+
+void BilinearFormMultigrid::AddFormLevel(BilinearForm* form,
+                                         const Array<int>& ess_bdr,
+                                         int smoother_order)
+{
+   const int level = bfs.Size();
+   FiniteElementSpace& fespace = *form->FESpace();
+   form->SetDiagonalPolicy(Operator::DIAG_ONE);
+   form->Assemble();
+   bfs.Append(form);
+
+   essentialTrueDofs.Append(new Array<int>());
+   fespace.GetEssentialTrueDofs(ess_bdr, *essentialTrueDofs.Last());
+
+   OperatorPtr opr(Operator::ANY_TYPE);
+   form->FormSystemMatrix(*essentialTrueDofs.Last(), opr);
+   const bool ownOperator = opr.OwnsOperator();
+   opr.SetOperatorOwner(false);
+
+   Vector* diag = new Vector(fespace.GetTrueVSize());
+   if (SparseMatrix* mat = opr.Is<SparseMatrix>())
+   {
+      mat->GetDiag(*diag);
+   }
+#ifdef MFEM_USE_MPI
+   else if (HypreParMatrix* mat = opr.Is<HypreParMatrix>())
+   {
+      mat->GetDiag(*diag);
+   }
+#endif
+   else
+   {
+      form->AssembleDiagonal(*diag);
+   }
+   diagonals.Append(diag);
+
+   Solver* smoother = ConstructSmoother(level, opr.Ptr(), *diag,
+                                        smoother_order);
+   AddLevel(opr.Ptr(), smoother, ownOperator, true);
+}
+
+BilinearFormMultigrid::~BilinearFormMultigrid()
+{
+   // The prototype form is owned by the caller
+   if (!own_fine_form) { bfs.DeleteLast(); }
+   delete coarse_prec;
+   for (int i = 0; i < diagonals.Size(); ++i)
+   {
+      delete diagonals[i];
+   }
+}
+
+Solver* BilinearFormMultigrid::ConstructSmoother(int level, Operator* opr,
+                                                 const Vector& diag,
+                                                 int smoother_order)
+{
+   const Array<int>& ess_tdofs = *essentialTrueDofs[level];
+#ifdef MFEM_USE_MPI
+   const ParFiniteElementSpace* pfespace =
+      dynamic_cast<const ParFiniteElementSpace*>(bfs[level]->FESpace());
+   MPI_Comm comm = pfespace ? pfespace->GetComm() : MPI_COMM_NULL;
+   CGSolver* cg = (level == 0 && pfespace) ? new CGSolver(comm) : NULL;
+   if (HypreParMatrix* mat = dynamic_cast<HypreParMatrix*>(opr))
+   {
+      if (level == 0 && coarse_min_dofs > 0)
+      {
+         // Agglomerate the coarsest operator onto fewer ranks and solve it
+         // there with CG and AMG.
+         delete cg;
+         HypreAgglomeratedSolver* agg =
+            new HypreAgglomeratedSolver(*mat, coarse_min_dofs);
+         if (agg->IsActive())
+         {
+            HypreBoomerAMG* amg =
+               new HypreBoomerAMG(*agg->GetAgglomeratedMatrix());
+            amg->SetPrintLevel(-1);
+            coarse_prec = amg;
+            cg = new CGSolver(agg->GetSubComm());
+            SetCoarseSolverOptions(*cg, *agg->GetAgglomeratedMatrix());
+            agg->SetSolver(*cg, true);
+         }
+         return agg;
+      }
+      if (level == 0)
+      {
+         HypreBoomerAMG* amg = new HypreBoomerAMG(*mat);
+         amg->SetPrintLevel(-1);
+         coarse_prec = amg;
+      }
+   }
+#else
+   CGSolver* cg = NULL;
+#endif
+   if (SparseMatrix* mat = dynamic_cast<SparseMatrix*>(opr))
+   {
+      if (level == 0) { coarse_prec = new GSSmoother(*mat); }
+   }
+
+   Solver* smoother = NULL;
+   if (level > 0 || !coarse_prec)
+   {
+      smoother = new OperatorChebyshevSmoother(opr, diag, ess_tdofs,
+                                               smoother_order
+#ifdef MFEM_USE_MPI
+                                               , comm
+#endif
+                                              );
+   }
+   if (level > 0) { return smoother; }
+
+   // Coarsest level: CG preconditioned with AMG, Gauss-Seidel or, if the
+   // operator is not assembled, with the Chebyshev smoother.
+   if (!coarse_prec) { coarse_prec = smoother; }
+   if (!cg) { cg = new CGSolver; }
+   SetCoarseSolverOptions(*cg, *opr);
+   return cg;
+}
+
+void BilinearFormMultigrid::SetCoarseSolverOptions(CGSolver& cg,
+                                                   const Operator& opr)
+{
+   cg.SetPrintLevel(-1);
+   cg.SetMaxIter(200);
+   cg.SetRelTol(1e-2);
+   cg.SetAbsTol(0.0);
+   cg.SetOperator(opr);
+   cg.SetPreconditioner(*coarse_prec);
+}
+
 } // namespace mfem
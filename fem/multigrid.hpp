@@ -18,6 +18,8 @@
 #include "../linalg/operator.hpp"
 #include "../linalg/handle.hpp"
 
+#include <functional>
+
 namespace mfem
 {
 
@@ -114,6 +116,84 @@ private:
    void Cycle(int level) const;
 };
 
+/** @brief Multigrid preconditioner constructed from a BilinearForm, or from a
+    function adding its integrators, and a FiniteElementSpaceHierarchy, e.g.
+    one built with AddUniformlyRefinedLevel() and AddOrderRefinedLevel(). */
+/** The prototype form @a a must be defined on the finest space of the
+    hierarchy, with all its integrators added. It is assembled by the
+    constructor, with its own assembly level (e.g. AssemblyLevel::PARTIAL),
+    and it defines the operator on the finest level.
+
+    The coarser levels use forms that share the integrators of @a a, see
+    BilinearForm(FiniteElementSpace*, BilinearForm*); they are ParBilinearForm%s
+    if @a a is a ParBilinearForm. These forms are fully assembled, because the
+    partially assembled data is stored in the integrators and can not be shared
+    by several levels. To use partial assembly on all levels but the coarsest,
+    construct the multigrid with an IntegratorFactory instead, which creates
+    new integrators for each level.
+
+    All levels, except the coarsest, are smoothed with an
+    OperatorChebyshevSmoother of order @a smoother_order. It uses the diagonal
+    of the level operator, and its largest eigenvalue is estimated with the
+    power method. The coarsest level is solved approximately with CG,
+    preconditioned with BoomerAMG in parallel and with Gauss-Seidel in serial.
+    The intergrid transfer uses the prolongation operators of the hierarchy.
+
+    In parallel, if @a coarse_min_dofs_ is positive, the coarsest operator is
+    agglomerated onto fewer ranks, each owning at least @a coarse_min_dofs_
+    rows, and solved there, see HypreAgglomeratedSolver.
+
+    Essential boundary conditions are imposed on the boundary attributes
+    marked in @a ess_bdr. All forms, including @a a, use the DIAG_ONE policy.
+    Use FormFineLinearSystem() and RecoverFineFEMSolution() to form and solve
+    the linear system on the finest level. */
+class BilinearFormMultigrid : public Multigrid
+{
+public:
+   /// Function adding new integrators to the (Par)BilinearForm of a level
+   typedef std::function<void(BilinearForm&)> IntegratorFactory;
+
+protected:
+   Array<Vector*> diagonals;
+   Solver *coarse_prec;
+   int coarse_min_dofs;
+   bool own_fine_form;
+
+public:
+   BilinearFormMultigrid(FiniteElementSpaceHierarchy& fespaces_,
+                         BilinearForm& a, const Array<int>& ess_bdr,
+                         int smoother_order = 2, int coarse_min_dofs_ = 0);
+
+   /** @brief Construct the forms of all levels, with the integrators added by
+       @a add_integrators. */
+   /** The forms of all levels but the coarsest use the given @a assembly
+       level, e.g. AssemblyLevel::PARTIAL, so that each level has its own
+       partially assembled data. The coarsest form is fully assembled, for the
+       AMG or Gauss-Seidel preconditioner of its CG solver. The forms are
+       ParBilinearForm%s if the spaces are ParFiniteElementSpace%s, and they
+       are owned by the multigrid. */
+   BilinearFormMultigrid(FiniteElementSpaceHierarchy& fespaces_,
+                         const IntegratorFactory& add_integrators,
+                         AssemblyLevel assembly, const Array<int>& ess_bdr,
+                         int smoother_order = 2, int coarse_min_dofs_ = 0);
+
+   /// Destructor. A prototype form given to the constructor is not deleted.
+   virtual ~BilinearFormMultigrid();
+
+protected:
+   /** @brief Assemble the given form of the next level and add the level with
+       its operator and smoother. */
+   void AddFormLevel(BilinearForm* form, const Array<int>& ess_bdr,
+                     int smoother_order);
+
+   /// Construct the smoother, or the coarse solver, of the given level
+   Solver* ConstructSmoother(int level, Operator* opr, const Vector& diag,
+                             int smoother_order);
+
+   /// Set the options of the CG solver of the coarsest level
+   void SetCoarseSolverOptions(CGSolver& cg, const Operator& opr);
+};
+
 } // namespace mfem
 
 #endif
@@ -27,6 +27,9 @@
 namespace mfem
 {
 
+GroupCommunicator::Mode ParFiniteElementSpace::gcomm_mode =
+   GroupCommunicator::byNeighbor;
+
 ParFiniteElementSpace::ParFiniteElementSpace(
    const ParFiniteElementSpace &orig, ParMesh *pmesh,
    const FiniteElementCollection *fec)
@@ -734,7 +737,7 @@ void ParFiniteElementSpace::DivideByGroupSize(double *vec)
 
 GroupCommunicator *ParFiniteElementSpace::ScalarGroupComm()
 {
-   GroupCommunicator *gc = new GroupCommunicator(GetGroupTopo());
+   GroupCommunicator *gc = new GroupCommunicator(GetGroupTopo(), gcomm_mode);
    if (NURBSext)
    {
       gc->Create(pNURBSext()->ldof_group);
@@ -1236,7 +1239,7 @@ void ParFiniteElementSpace::ConstructTrueDofs()
 {
    int i, gr, n = GetVSize();
    GroupTopology &gt = pmesh->gtopo;
-   gcomm = new GroupCommunicator(gt);
+   gcomm = new GroupCommunicator(gt, gcomm_mode);
    Table &group_ldof = gcomm->GroupLDofTable();
 
    GetGroupComm(*gcomm, 1, &ldof_sign);
@@ -1286,7 +1289,7 @@ void ParFiniteElementSpace::ConstructTrueNURBSDofs()
 {
    int n = GetVSize();
    GroupTopology &gt = pNURBSext()->gtopo;
-   gcomm = new GroupCommunicator(gt);
+   gcomm = new GroupCommunicator(gt, gcomm_mode);
 
    // pNURBSext()->ldof_group is for scalar space!
    if (vdim == 1)
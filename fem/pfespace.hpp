@@ -41,6 +41,9 @@ private:
    /// GroupCommunicator on the local VDofs. Owned.
    GroupCommunicator *gcomm;
 
+   /// Mode of the GroupCommunicator%s created next, see SetGroupCommMode().
+   static GroupCommunicator::Mode gcomm_mode;
+
    /// Number of true dofs in this processor (local true dofs).
    mutable int ltdof_size;
 
@@ -294,6 +297,21 @@ public:
    /// Scale a vector of true dofs
    void DivideByGroupSize(double *vec);
 
+   /** @brief Set the communication mode of the GroupCommunicator%s created
+       by the ParFiniteElementSpace%s constructed or updated afterwards. */
+   /** The default is GroupCommunicator::byNeighbor, and the mode must be the
+       same on all ranks. With GroupCommunicator::byNeighborCollective, the
+       operations of GroupComm(), e.g. in the prolongation and restriction of
+       the space, are collective over the communicator of the space. With
+       GroupCommunicator::byNeighborShared, the destruction of the space is
+       collective over the ranks of each node, unless
+       GroupCommunicator::FreeSharedWindow() was called on GroupComm(). */
+   static void SetGroupCommMode(GroupCommunicator::Mode mode)
+   { gcomm_mode = mode; }
+
+   /// Return the mode set with SetGroupCommMode().
+   static GroupCommunicator::Mode GetGroupCommMode() { return gcomm_mode; }
+
    /// Return a reference to the internal GroupCommunicator (on VDofs)
    GroupCommunicator &GroupComm() { return *gcomm; }
 
@@ -835,6 +835,22 @@ void ParGridFunction::Save(std::ostream &out) const
    }
 }
 
+void ParGridFunction::SaveBinary(std::ostream &out) const
+{
+   double *data_  = const_cast<double*>(HostRead());
+   for (int i = 0; i < size; i++)
+   {
+      if (pfes->GetDofSign(i) < 0) { data_[i] = -data_[i]; }
+   }
+
+   GridFunction::SaveBinary(out);
+
+   for (int i = 0; i < size; i++)
+   {
+      if (pfes->GetDofSign(i) < 0) { data_[i] = -data_[i]; }
+   }
+}
+
 #ifdef MFEM_USE_ADIOS2
 void ParGridFunction::Save(adios2stream &out,
                            const std::string& variable_name,
@@ -1153,10 +1169,10 @@ double L2ZZErrorEstimator(BilinearFormIntegrator &flux_integrator,
    // between the flux as computed per element and the flux projected onto the
    // smooth_flux_fes space.
    double total_error = 0.0;
-   errors.SetSize(xfes->GetNE());
+   ComputeElementLpDistances(norm_p, smooth_flux, flux, errors);
+   errors.HostRead();
    for (int i = 0; i < xfes->GetNE(); i++)
    {
-      errors(i) = ComputeElementLpDistance(norm_p, i, smooth_flux, flux);
       total_error += pow(errors(i), norm_p);
    }
 
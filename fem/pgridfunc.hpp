@@ -403,6 +403,10 @@ public:
        the local dofs. */
    virtual void Save(std::ostream &out) const;
 
+   /** Save the local portion of the ParGridFunction in binary format, taking
+       into account the signs of the local dofs, as Save(). */
+   virtual void SaveBinary(std::ostream &out) const;
+
 #ifdef MFEM_USE_ADIOS2
    /** Save the local portion of the ParGridFunction. This differs from the
        serial GridFunction::Save in that it takes into account the signs of
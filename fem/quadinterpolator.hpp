@@ -45,6 +45,8 @@ protected:
 
    mutable bool use_tensor_products;
 
+public:
+   /// Maximum sizes supported by the non-tensor compute kernels.
    static const int MAX_NQ2D = 100;
    static const int MAX_ND2D = 100;
    static const int MAX_VDIM2D = 3;
@@ -53,7 +55,6 @@ protected:
    static const int MAX_ND3D = 1000;
    static const int MAX_VDIM3D = 3;
 
-public:
    enum EvalFlags
    {
       VALUES       = 1 << 0,  ///< Evaluate the values at quadrature points
@@ -168,6 +168,31 @@ void ElementRestriction::MultTranspose(const Vector& x, Vector& y) const
    });
 }
 
+void ElementRestriction::MultLeftInverse(const Vector& x, Vector& y) const
+{
+   // Assumes all elements have the same number of dofs
+   const int nd = dof;
+   const int vd = vdim;
+   const bool t = byvdim;
+   auto d_offsets = offsets.Read();
+   auto d_indices = indices.Read();
+   auto d_x = Reshape(x.Read(), nd, vd, ne);
+   auto d_y = Reshape(y.ReadWrite(), t?vd:ndofs, t?ndofs:vd);
+   MFEM_FORALL(i, ndofs,
+   {
+      const int j = d_offsets[i + 1] - 1;
+      if (j >= d_offsets[i])
+      {
+         const int idx_j = (d_indices[j] >= 0) ? d_indices[j] : -1 - d_indices[j];
+         for (int c = 0; c < vd; ++c)
+         {
+            const double dofValue = d_x(idx_j % nd, c, idx_j / nd);
+            d_y(t?c:i,t?i:c) = (d_indices[j] >= 0) ? dofValue : -dofValue;
+         }
+      }
+   });
+}
+
 void ElementRestriction::MultTransposeUnsigned(const Vector& x, Vector& y) const
 {
    // Assumes all elements have the same number of dofs
@@ -57,6 +57,13 @@ public:
    /// Compute MultTranspose without applying signs based on DOF orientations.
    void MultTransposeUnsigned(const Vector &x, Vector &y) const;
 
+   /** @brief Set each entry of the L-vector @a y to the corresponding entry of
+       the E-vector @a x in the last element containing it. */
+   /** This is a left inverse of Mult() that emulates element-by-element
+       SetSubVector() loops. Entries of @a y that do not belong to any element
+       are not modified. */
+   void MultLeftInverse(const Vector &x, Vector &y) const;
+
    /// @brief Fills the E-vector y with `boolean` values 0.0 and 1.0 such that each
    /// each entry of the L-vector is uniquely represented in `y`.
    /** This means, the sum of the E-vector `y` is equal to the sum of the
@@ -92,6 +99,9 @@ public:
    L2ElementRestriction(const FiniteElementSpace&);
    void Mult(const Vector &x, Vector &y) const;
    void MultTranspose(const Vector &x, Vector &y) const;
+   /// Same as MultTranspose(), the L2 dofs are not shared between elements.
+   void MultLeftInverse(const Vector &x, Vector &y) const
+   { MultTranspose(x, y); }
    /** Fill the I array of SparseMatrix corresponding to the sparsity pattern
        given by this ElementRestriction. */
    void FillI(SparseMatrix &mat) const;
@@ -166,6 +176,13 @@ public:
    /// This methods adds the DG face matrices to the element matrices.
    void AddFaceMatricesToElementMatrices(Vector &fea_data,
                                          Vector &ea_data) const;
+   /** @brief Return the L-vector indices of the face dofs of the first
+       (@a side = 0) or second (@a side = 1) element of each face. */
+   /** The indices are ordered as the face E-vectors returned by Mult(), i.e.
+       lexicographically on each face. Missing neighbors of boundary faces are
+       marked with -1. */
+   const Array<int> &GetScatterIndices(int side) const
+   { return side == 0 ? scatter_indices1 : scatter_indices2; }
 };
 
 // Return the face degrees of freedom returned in Lexicographic order.
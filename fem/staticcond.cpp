@@ -147,6 +147,10 @@ void StaticCondensation::Init(bool symmetric, bool block_diagonal)
       A_offsets[i+1] = A_offsets[i] + npd*(npd + (symm ? 1 : 2)*ned);
       A_ipiv_offsets[i+1] = A_ipiv_offsets[i] + npd;
    }
+   pending_elems.SetSize(0);
+   A_ee_offsets.SetSize(1);
+   A_ee_offsets[0] = 0;
+   A_ee_data.DeleteAll();
    A_data = Memory<double>(A_offsets[NE]);
    A_ipiv = Memory<int>(A_ipiv_offsets[NE]);
    const int nedofs = tr_fes->GetVSize();
@@ -195,10 +199,14 @@ void StaticCondensation::AssembleMatrix(int el, const DenseMatrix &elmat)
    const int nved = rvdofs.Size();
    DenseMatrix A_pp(A_data + A_offsets[el], nvpd, nvpd);
    DenseMatrix A_pe(A_pp.Data() + nvpd*nvpd, nvpd, nved);
-   DenseMatrix A_ep;
-   if (symm) { A_ep.SetSize(nved, nvpd); }
-   else      { A_ep.UseExternalData(A_pe.Data() + nvpd*nved, nved, nvpd); }
-   DenseMatrix A_ee(nved, nved);
+   if (pending_elems.Size() == max_pending_elems) { FactorPendingElements(); }
+   const int k = pending_elems.Size();
+   A_ee_offsets.Append(A_ee_offsets[k] + nved*(nved + (symm ? nvpd : 0)));
+   A_ee_data.SetSize(A_ee_offsets.Last());
+   DenseMatrix A_ee(A_ee_data + A_ee_offsets[k], nved, nved);
+   // If symm, A_ep is kept after A_ee until the Schur complement is computed
+   DenseMatrix A_ep(symm ? A_ee.Data() + nved*nved : A_pe.Data() + nvpd*nved,
+                    nved, nvpd);
 
    const int npd = nvpd/vdim;
    const int ned = nved/vdim;
@@ -214,14 +222,46 @@ void StaticCondensation::AssembleMatrix(int el, const DenseMatrix &elmat)
          A_ee.CopyMN(elmat, ned, ned, i*nd,     j*nd,     i*ned, j*ned);
       }
    }
-   // Compute the Schur complement
-   LUFactors lu(A_pp.Data(), A_ipiv + A_ipiv_offsets[el]);
-   lu.Factor(nvpd);
-   lu.BlockFactor(nvpd, nved, A_pe.Data(), A_ep.Data(), A_ee.Data());
+   pending_elems.Append(el);
+}
+
+void StaticCondensation::FactorPendingElements()
+{
+   const int num_pending = pending_elems.Size();
+   if (num_pending == 0) { return; }
 
-   // Assemble the Schur complement
+   // Factor the A_pp blocks, in batches of blocks of the same size
+   Array<int> sizes(num_pending);
+   Array<double*> data(num_pending);
+   Array<int*> ipiv(num_pending);
+   for (int k = 0; k < num_pending; k++)
+   {
+      const int el = pending_elems[k];
+      sizes[k] = elem_pdof.RowSize(el);
+      data[k] = A_data + A_offsets[el];
+      ipiv[k] = A_ipiv + A_ipiv_offsets[el];
+   }
+   BatchLUFactor(sizes, data, ipiv);
+
+   // Compute and assemble the Schur complements
+   Array<int> rvdofs;
    const int skip_zeros = 0;
-   S->AddSubMatrix(rvdofs, rvdofs, A_ee, skip_zeros);
+   for (int k = 0; k < num_pending; k++)
+   {
+      const int el = pending_elems[k];
+      tr_fes->GetElementVDofs(el, rvdofs);
+      const int nvpd = sizes[k];
+      const int nved = rvdofs.Size();
+      double *A_pe = data[k] + nvpd*nvpd;
+      DenseMatrix A_ee(A_ee_data + A_ee_offsets[k], nved, nved);
+      double *A_ep = symm ? A_ee.Data() + nved*nved : A_pe + nvpd*nved;
+      LUFactors lu(data[k], ipiv[k]);
+      lu.BlockFactor(nvpd, nved, A_pe, A_ep, A_ee.Data());
+      S->AddSubMatrix(rvdofs, rvdofs, A_ee, skip_zeros);
+   }
+   pending_elems.SetSize(0);
+   A_ee_offsets.SetSize(1);
+   A_ee_data.SetSize(0);
 }
 
 void StaticCondensation::AssembleBdrMatrix(int el, const DenseMatrix &elmat)
@@ -234,6 +274,8 @@ void StaticCondensation::AssembleBdrMatrix(int el, const DenseMatrix &elmat)
 
 void StaticCondensation::Finalize()
 {
+   FactorPendingElements();
+   A_ee_data.DeleteAll();
    const int skip_zeros = 0;
    if (!Parallel())
    {
@@ -85,6 +85,18 @@ class StaticCondensation
    Memory<double> A_data;
    Memory<int> A_ipiv;
 
+   // The A_pp blocks are factored in batches of up to max_pending_elems
+   // elements, the last one in Finalize(). Until then, the A_ee blocks of the
+   // pending elements, followed by their A_ep blocks if symm, are kept in
+   // A_ee_data, so its size does not grow with the number of elements.
+   static const int max_pending_elems = 1024;
+   Array<int> A_ee_offsets, pending_elems;
+   Array<double> A_ee_data;
+
+   /** Factor the A_pp blocks of the pending elements, grouped by size, and
+       add their Schur complements to S. */
+   void FactorPendingElements();
+
    Array<int> ess_rtdof_list;
 
 public:
@@ -114,7 +126,8 @@ public:
 #endif
    /** Assemble the contribution to the Schur complement from the given
        element matrix 'elmat'; save the other blocks internally: A_pp_inv, A_pe,
-       and A_ep. */
+       and A_ep. The A_pp blocks are factored and the contributions are added
+       to the Schur complement in Finalize(). */
    void AssembleMatrix(int el, const DenseMatrix &elmat);
 
    /** Assemble the contribution to the Schur complement from the given boundary
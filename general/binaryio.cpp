@@ -12,6 +12,14 @@
 #include "binaryio.hpp"
 #include "error.hpp"
 
+#include <fstream>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 namespace mfem
 {
 namespace bin_io
@@ -51,5 +59,100 @@ void WriteBase64(std::ostream &out, const void *bytes, size_t nbytes)
    }
 }
 
+void WritePaddedLine(std::ostream &os, const std::string &line)
+{
+   const size_t len = line.size() + 1;
+   os << line << std::string((8 - len % 8) % 8, ' ') << '\n';
+}
+
 } // namespace mfem::bin_io
+
+char *mapped_ifstream::mapped_buf::Map(size_t nbytes)
+{
+   if (nbytes > size_t(egptr() - gptr())) { return NULL; }
+   char *ptr = gptr();
+   setg(eback(), ptr + nbytes, egptr());
+   return ptr;
+}
+
+mapped_ifstream::mapped_buf::pos_type
+mapped_ifstream::mapped_buf::seekoff(off_type off, std::ios_base::seekdir dir,
+                                     std::ios_base::openmode which)
+{
+   if (!(which & std::ios_base::in)) { return pos_type(off_type(-1)); }
+   char *base = (dir == std::ios_base::beg) ? eback() :
+                (dir == std::ios_base::cur) ? gptr() : egptr();
+   if (off < eback() - base || off > egptr() - base)
+   {
+      return pos_type(off_type(-1));
+   }
+   setg(eback(), base + off, egptr());
+   return pos_type(gptr() - eback());
+}
+
+mapped_ifstream::mapped_buf::pos_type
+mapped_ifstream::mapped_buf::seekpos(pos_type pos,
+                                     std::ios_base::openmode which)
+{
+   return seekoff(off_type(pos), std::ios_base::beg, which);
+}
+
+mapped_ifstream::mapped_ifstream(const char *filename)
+   : std::istream(NULL), map_data(NULL), map_size(0)
+{
+   rdbuf(&buf);
+   bool ok = false;
+#ifndef _WIN32
+   const int fd = open(filename, O_RDONLY);
+   struct stat st;
+   if (fd >= 0 && fstat(fd, &st) == 0)
+   {
+      map_size = st.st_size;
+      ok = true;
+      if (map_size > 0)
+      {
+         void *ptr = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                          fd, 0);
+         if (ptr != MAP_FAILED)
+         {
+            map_data = static_cast<char*>(ptr);
+         }
+         else
+         {
+            map_size = 0;
+            ok = false;
+         }
+      }
+   }
+   if (fd >= 0) { close(fd); }
+#else
+   std::ifstream file(filename, std::ios::binary | std::ios::ate);
+   if (file)
+   {
+      map_size = file.tellg();
+      map_data = new char[map_size];
+      file.seekg(0);
+      ok = bool(file.read(map_data, map_size));
+   }
+#endif
+   buf.Set(map_data, map_size);
+   if (!ok) { setstate(std::ios::failbit); }
+}
+
+mapped_ifstream::~mapped_ifstream()
+{
+#ifndef _WIN32
+   if (map_data) { munmap(map_data, map_size); }
+#else
+   delete [] map_data;
+#endif
+}
+
+char *mapped_ifstream::Map(size_t nbytes)
+{
+   char *ptr = buf.Map(nbytes);
+   if (!ptr) { setstate(std::ios::failbit); }
+   return ptr;
+}
+
 } // namespace mfem
@@ -16,6 +16,7 @@
 
 #include <iostream>
 #include <vector>
+#include <string>
 
 namespace mfem
 {
@@ -50,8 +51,77 @@ void AppendBytes(std::vector<char> &vec, const T &val)
 
 void WriteBase64(std::ostream &out, const void *bytes, size_t length);
 
+/// Write @a n values of type T followed by zero bytes padding the written
+/// data to a multiple of 8 bytes.
+template <typename T>
+inline void WritePadded(std::ostream &os, const T *data, size_t n)
+{
+   static const char zeros[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+   const size_t nbytes = n*sizeof(T);
+   os.write((const char*) data, nbytes);
+   os.write(zeros, (8 - nbytes % 8) % 8);
+}
+
+/// Read @a n values of type T written with WritePadded(), skipping the
+/// padding bytes.
+template <typename T>
+inline void ReadPadded(std::istream &is, T *data, size_t n)
+{
+   const size_t nbytes = n*sizeof(T);
+   is.read((char*) data, nbytes);
+   is.ignore((8 - nbytes % 8) % 8);
+}
+
+/** @brief Write a text line padded with spaces so that, including the
+    terminating newline, its length is a multiple of 8 bytes. */
+void WritePaddedLine(std::ostream &os, const std::string &line);
+
 } // namespace mfem::bin_io
 
+/** @brief Input stream reading from a memory map of a whole file.
+
+    Objects loaded from a mapped_ifstream in binary format, e.g. the values of a
+    GridFunction saved with GridFunction::SaveBinary(), reference the mapped
+    data directly instead of copying it, see Map(). Such objects must not
+    outlive the stream. The map is private (copy-on-write), so the referencing
+    objects can be modified without changing the file. On platforms without
+    POSIX mmap() the file is read into memory instead. */
+class mapped_ifstream : public std::istream
+{
+protected:
+   class mapped_buf : public std::streambuf
+   {
+   public:
+      void Set(char *data, size_t size) { setg(data, data, data + size); }
+      char *Map(size_t nbytes);
+
+   protected:
+      virtual pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                               std::ios_base::openmode which);
+      virtual pos_type seekpos(pos_type pos, std::ios_base::openmode which);
+   };
+
+   mapped_buf buf;
+   char *map_data;
+   size_t map_size;
+
+public:
+   /// Map the file @a filename; on failure the failbit of the stream is set.
+   explicit mapped_ifstream(const char *filename);
+
+   /// Unmap the file.
+   virtual ~mapped_ifstream();
+
+   /// Return the size of the mapped file in bytes.
+   size_t Size() const { return map_size; }
+
+   /** @brief Return a pointer to the next @a nbytes bytes of the file and
+       advance the read position past them. */
+   /** If fewer than @a nbytes bytes remain, the failbit is set and NULL is
+       returned. The pointer remains valid until the stream is destroyed. */
+   char *Map(size_t nbytes);
+};
+
 } // namespace mfem
 
 #endif
@@ -265,6 +265,24 @@ void GroupTopology::Create(ListOfIntegerSets &groups, int mpitag)
    // debug barrier: MPI_Barrier(MyComm);
 }
 
+void GroupTopology::GetNeighborNodeRanks(MPI_Comm node_comm,
+                                         Array<int> &nbr_node_rank) const
+{
+   MPI_Group group, node_group;
+   MPI_Comm_group(MyComm, &group);
+   MPI_Comm_group(node_comm, &node_group);
+   nbr_node_rank.SetSize(GetNumNeighbors());
+   MPI_Group_translate_ranks(group, GetNumNeighbors(),
+                             const_cast<int*>(lproc_proc.GetData()),
+                             node_group, nbr_node_rank.GetData());
+   for (int i = 0; i < nbr_node_rank.Size(); i++)
+   {
+      if (nbr_node_rank[i] == MPI_UNDEFINED) { nbr_node_rank[i] = -1; }
+   }
+   MPI_Group_free(&node_group);
+   MPI_Group_free(&group);
+}
+
 void GroupTopology::Save(ostream &out) const
 {
    out << "\ncommunication_groups\n";
@@ -348,6 +366,19 @@ GroupCommunicator::GroupCommunicator(GroupTopology &gt, Mode m)
    num_requests = 0;
    request_marker = NULL;
    buf_offsets = NULL;
+   nbr_comm = MPI_COMM_NULL;
+   node_comm = MPI_COMM_NULL;
+   shm_win = MPI_WIN_NULL;
+   shm_base = NULL;
+   shm_requests = NULL;
+   num_shm_requests = 0;
+#if MPI_VERSION < 3
+   // Neighborhood collectives and shared memory windows require MPI-3
+   if (mode == byNeighborCollective || mode == byNeighborShared)
+   {
+      mode = byNeighbor;
+   }
+#endif
 }
 
 void GroupCommunicator::Create(const Array<int> &ldof_group)
@@ -402,6 +433,10 @@ void GroupCommunicator::Finalize()
       }
    }
 
+   // The neighborhood collective uses one request, also on ranks without
+   // shared groups, since it must be called by all ranks.
+   if (mode == byNeighborCollective) { request_counter = 1; }
+
    requests = new MPI_Request[request_counter];
    // statuses = new MPI_Status[request_counter];
    request_marker = new int[request_counter];
@@ -483,6 +518,153 @@ void GroupCommunicator::Finalize()
          }
       }
    }
+
+   if (mode == byNeighborCollective)
+   {
+      CreateNeighborComm();
+   }
+   else if (mode == byNeighborShared)
+   {
+      CreateSharedWindow();
+   }
+}
+
+void GroupCommunicator::CreateNeighborComm()
+{
+#if MPI_VERSION >= 3
+   const int num_nbrs = gtopo.GetNumNeighbors()-1; // excluding me
+   nbr_send_count.SetSize(num_nbrs);
+   nbr_send_offset.SetSize(num_nbrs+1);
+   nbr_recv_count.SetSize(num_nbrs);
+   nbr_recv_offset.SetSize(num_nbrs+1);
+   nbr_send_offset[0] = nbr_recv_offset[0] = 0;
+   for (int nbr = 1; nbr <= num_nbrs; nbr++)
+   {
+      int send_size = 0, recv_size = 0;
+      const int *send_list = nbr_send_groups.GetRow(nbr);
+      for (int i = 0; i < nbr_send_groups.RowSize(nbr); i++)
+      {
+         send_size += group_ldof.RowSize(send_list[i]);
+      }
+      const int *recv_list = nbr_recv_groups.GetRow(nbr);
+      for (int i = 0; i < nbr_recv_groups.RowSize(nbr); i++)
+      {
+         recv_size += group_ldof.RowSize(recv_list[i]);
+      }
+      nbr_send_count[nbr-1] = send_size;
+      nbr_recv_count[nbr-1] = recv_size;
+      nbr_send_offset[nbr] = nbr_send_offset[nbr-1] + send_size;
+      nbr_recv_offset[nbr] = nbr_recv_offset[nbr-1] + recv_size;
+   }
+   MFEM_ASSERT(nbr_send_offset[num_nbrs] + nbr_recv_offset[num_nbrs] ==
+               group_buf_size, "");
+
+   // The neighbor relation is symmetric, so the same list of ranks is used for
+   // both the sources and the destinations of the graph. Ranks are not
+   // reordered, so rank numbers in nbr_comm are the same as in the group
+   // topology communicator.
+   Array<int> nbr_ranks(num_nbrs);
+   for (int nbr = 1; nbr <= num_nbrs; nbr++)
+   {
+      nbr_ranks[nbr-1] = gtopo.GetNeighborRank(nbr);
+   }
+   MPI_Dist_graph_create_adjacent(gtopo.GetComm(),
+                                  num_nbrs, nbr_ranks.GetData(), MPI_UNWEIGHTED,
+                                  num_nbrs, nbr_ranks.GetData(), MPI_UNWEIGHTED,
+                                  MPI_INFO_NULL, 0, &nbr_comm);
+#else
+   MFEM_ABORT("MPI-3 is required for GroupCommunicator::byNeighborCollective");
+#endif
+}
+
+void GroupCommunicator::CreateSharedWindow()
+{
+#if MPI_VERSION >= 3
+   MPI_Comm_split_type(gtopo.GetComm(), MPI_COMM_TYPE_SHARED, 0,
+                       MPI_INFO_NULL, &node_comm);
+   gtopo.GetNeighborNodeRanks(node_comm, nbr_node_rank);
+
+   // Each rank writes the data for all of its on-node neighbors in its own
+   // segment of the window: the Bcast and the Reduce data both start at
+   // offset 0, since the two operations cannot be active at the same time.
+   const int num_nbrs = gtopo.GetNumNeighbors();
+   shm_send_offset.SetSize(2*num_nbrs);
+   shm_recv_offset.SetSize(2*num_nbrs);
+   shm_send_offset = -1;
+   shm_recv_offset = -1;
+   int bcast_size = 0, reduce_size = 0, num_node_nbrs = 0;
+   for (int nbr = 1; nbr < num_nbrs; nbr++)
+   {
+      if (nbr_node_rank[nbr] < 0) { continue; }
+      num_node_nbrs++;
+      shm_send_offset[2*nbr] = bcast_size;
+      shm_send_offset[2*nbr+1] = reduce_size;
+      const int *send_list = nbr_send_groups.GetRow(nbr);
+      for (int i = 0; i < nbr_send_groups.RowSize(nbr); i++)
+      {
+         bcast_size += group_ldof.RowSize(send_list[i]);
+      }
+      const int *recv_list = nbr_recv_groups.GetRow(nbr);
+      for (int i = 0; i < nbr_recv_groups.RowSize(nbr); i++)
+      {
+         reduce_size += group_ldof.RowSize(recv_list[i]);
+      }
+   }
+
+   // The window is used with entries of type int or double.
+   const MPI_Aint win_size = max(bcast_size, reduce_size)*sizeof(double);
+   MPI_Win_allocate_shared(win_size, sizeof(double), MPI_INFO_NULL, node_comm,
+                           &shm_base, &shm_win);
+   MPI_Win_lock_all(MPI_MODE_NOCHECK, shm_win);
+
+   // Get the addresses of the neighbor segments and exchange the offsets of
+   // the data in them.
+   shm_nbr_base.SetSize(num_nbrs);
+   shm_nbr_base = (char *) NULL;
+   MPI_Request *offset_requests = new MPI_Request[2*num_node_nbrs];
+   int request_counter = 0;
+   for (int nbr = 1; nbr < num_nbrs; nbr++)
+   {
+      if (nbr_node_rank[nbr] < 0) { continue; }
+      MPI_Aint size;
+      int disp_unit;
+      MPI_Win_shared_query(shm_win, nbr_node_rank[nbr], &size, &disp_unit,
+                           &shm_nbr_base[nbr]);
+      MPI_Isend(&shm_send_offset[2*nbr], 2, MPI_INT,
+                gtopo.GetNeighborRank(nbr), 47822, gtopo.GetComm(),
+                &offset_requests[request_counter++]);
+      MPI_Irecv(&shm_recv_offset[2*nbr], 2, MPI_INT,
+                gtopo.GetNeighborRank(nbr), 47822, gtopo.GetComm(),
+                &offset_requests[request_counter++]);
+   }
+   MPI_Waitall(request_counter, offset_requests, MPI_STATUSES_IGNORE);
+   delete [] offset_requests;
+
+   // At most one "done" send and one "done" receive per on-node neighbor.
+   shm_requests = new MPI_Request[2*num_node_nbrs];
+   num_shm_requests = 0;
+#else
+   MFEM_ABORT("MPI-3 is required for GroupCommunicator::byNeighborShared");
+#endif
+}
+
+void GroupCommunicator::WaitSharedDone() const
+{
+   if (num_shm_requests == 0) { return; }
+   MPI_Waitall(num_shm_requests, shm_requests, MPI_STATUSES_IGNORE);
+   num_shm_requests = 0;
+}
+
+void GroupCommunicator::PostSharedDone(const Table &nbr_readers) const
+{
+   for (int nbr = 1; nbr < nbr_readers.Size(); nbr++)
+   {
+      if (nbr_readers.RowSize(nbr) > 0 && OnNode(nbr))
+      {
+         MPI_Irecv(NULL, 0, MPI_BYTE, gtopo.GetNeighborRank(nbr), 45822,
+                   gtopo.GetComm(), &shm_requests[num_shm_requests++]);
+      }
+   }
 }
 
 void GroupCommunicator::SetLTDofTable(const Array<int> &ldof_ltdof)
@@ -698,7 +880,8 @@ void GroupCommunicator::BcastBegin(T *ldata, int layout) const
 {
    MFEM_VERIFY(comm_lock == 0, "object is already in use");
 
-   if (group_buf_size == 0) { return; }
+   // The neighborhood collective is called by all ranks of nbr_comm.
+   if (group_buf_size == 0 && mode != byNeighborCollective) { return; }
 
    int request_counter = 0;
    switch (mode)
@@ -767,7 +950,11 @@ void GroupCommunicator::BcastBegin(T *ldata, int layout) const
       }
 
       case byNeighbor: // ***** Communication by neighbors *****
+      case byNeighborShared:
       {
+         // Wait until the on-node neighbors are done reading the window data
+         // from the previous operation.
+         WaitSharedDone();
          group_buf.SetSize(group_buf_size*sizeof(T));
          T *buf = (T *)group_buf.GetData();
          for (int nbr = 1; nbr < nbr_send_groups.Size(); nbr++)
@@ -778,21 +965,29 @@ void GroupCommunicator::BcastBegin(T *ldata, int layout) const
                // Possible optimization:
                //    if (num_send_groups == 1) and (layout == 1) then we do not
                //    need to copy the data in order to send it.
-               T *buf_start = buf;
+               // On-node data is copied directly into the shared window.
+               T *buf_start = OnNode(nbr) ?
+                              (T *)shm_base + shm_send_offset[2*nbr] : buf;
+               T *buf_end = buf_start;
                const int *grp_list = nbr_send_groups.GetRow(nbr);
                for (int i = 0; i < num_send_groups; i++)
                {
-                  buf = CopyGroupToBuffer(ldata, buf, grp_list[i], layout);
+                  buf_end = CopyGroupToBuffer(ldata, buf_end, grp_list[i],
+                                              layout);
+               }
+               buf += buf_end - buf_start;
+               if (!OnNode(nbr))
+               {
+                  MPI_Isend(buf_start,
+                            buf_end - buf_start,
+                            MPITypeMap<T>::mpi_type,
+                            gtopo.GetNeighborRank(nbr),
+                            40822,
+                            gtopo.GetComm(),
+                            &requests[request_counter]);
+                  request_marker[request_counter] = -1; // mark as send req.
+                  request_counter++;
                }
-               MPI_Isend(buf_start,
-                         buf - buf_start,
-                         MPITypeMap<T>::mpi_type,
-                         gtopo.GetNeighborRank(nbr),
-                         40822,
-                         gtopo.GetComm(),
-                         &requests[request_counter]);
-               request_marker[request_counter] = -1; // mark as send request
-               request_counter++;
             }
 
             const int num_recv_groups = nbr_recv_groups.RowSize(nbr);
@@ -808,13 +1003,21 @@ void GroupCommunicator::BcastBegin(T *ldata, int layout) const
                {
                   recv_size += group_ldof.RowSize(grp_list[i]);
                }
-               MPI_Irecv(buf,
-                         recv_size,
-                         MPITypeMap<T>::mpi_type,
-                         gtopo.GetNeighborRank(nbr),
-                         40822,
-                         gtopo.GetComm(),
-                         &requests[request_counter]);
+               if (!OnNode(nbr))
+               {
+                  MPI_Irecv(buf,
+                            recv_size,
+                            MPITypeMap<T>::mpi_type,
+                            gtopo.GetNeighborRank(nbr),
+                            40822,
+                            gtopo.GetComm(),
+                            &requests[request_counter]);
+               }
+               else // the data will be ready in the window after this recv
+               {
+                  MPI_Irecv(NULL, 0, MPI_BYTE, gtopo.GetNeighborRank(nbr),
+                            44822, gtopo.GetComm(), &requests[request_counter]);
+               }
                request_marker[request_counter] = nbr;
                request_counter++;
                buf_offsets[nbr] = buf - (T*)group_buf.GetData();
@@ -822,6 +1025,50 @@ void GroupCommunicator::BcastBegin(T *ldata, int layout) const
             }
          }
          MFEM_ASSERT(buf - (T*)group_buf.GetData() == group_buf_size, "");
+         if (mode == byNeighborShared)
+         {
+            // Make the window data visible, then notify the on-node readers.
+            MPI_Win_sync(shm_win);
+            for (int nbr = 1; nbr < nbr_send_groups.Size(); nbr++)
+            {
+               if (nbr_send_groups.RowSize(nbr) > 0 && OnNode(nbr))
+               {
+                  MPI_Isend(NULL, 0, MPI_BYTE, gtopo.GetNeighborRank(nbr),
+                            44822, gtopo.GetComm(), &requests[request_counter]);
+                  request_marker[request_counter] = -1; // mark as send req.
+                  request_counter++;
+               }
+            }
+         }
+         break;
+      }
+
+      case byNeighborCollective: // ***** Neighborhood collective *****
+      {
+#if MPI_VERSION >= 3
+         group_buf.SetSize(group_buf_size*sizeof(T));
+         T *send_buf = (T *)group_buf.GetData();
+         T *recv_buf = send_buf + nbr_send_offset.Last();
+         T *buf = send_buf;
+         for (int nbr = 1; nbr < nbr_send_groups.Size(); nbr++)
+         {
+            const int num_send_groups = nbr_send_groups.RowSize(nbr);
+            const int *grp_list = nbr_send_groups.GetRow(nbr);
+            for (int i = 0; i < num_send_groups; i++)
+            {
+               buf = CopyGroupToBuffer(ldata, buf, grp_list[i], layout);
+            }
+         }
+         MFEM_ASSERT(buf == recv_buf, "");
+         MPI_Ineighbor_alltoallv(send_buf, nbr_send_count.GetData(),
+                                 nbr_send_offset.GetData(),
+                                 MPITypeMap<T>::mpi_type,
+                                 recv_buf, nbr_recv_count.GetData(),
+                                 nbr_recv_offset.GetData(),
+                                 MPITypeMap<T>::mpi_type,
+                                 nbr_comm, &requests[0]);
+         request_counter = 1;
+#endif
          break;
       }
    }
@@ -864,6 +1111,7 @@ void GroupCommunicator::BcastEnd(T *ldata, int layout) const
       }
 
       case byNeighbor: // ***** Communication by neighbors *****
+      case byNeighborShared:
       {
          // copy the received data from the buffer to ldata, as it arrives
          int idx;
@@ -878,10 +1126,39 @@ void GroupCommunicator::BcastEnd(T *ldata, int layout) const
             {
                const int *grp_list = nbr_recv_groups.GetRow(nbr);
                const T *buf = (T*)group_buf.GetData() + buf_offsets[nbr];
+               if (OnNode(nbr)) // read directly from the neighbor's segment
+               {
+                  MPI_Win_sync(shm_win);
+                  buf = (T*)shm_nbr_base[nbr] + shm_recv_offset[2*nbr];
+               }
                for (int i = 0; i < num_recv_groups; i++)
                {
                   buf = CopyGroupFromBuffer(buf, ldata, grp_list[i], layout);
                }
+               if (OnNode(nbr))
+               {
+                  MPI_Isend(NULL, 0, MPI_BYTE, gtopo.GetNeighborRank(nbr),
+                            45822, gtopo.GetComm(),
+                            &shm_requests[num_shm_requests++]);
+               }
+            }
+         }
+         if (mode == byNeighborShared) { PostSharedDone(nbr_send_groups); }
+         break;
+      }
+
+      case byNeighborCollective: // ***** Neighborhood collective *****
+      {
+         MPI_Wait(&requests[0], MPI_STATUS_IGNORE);
+
+         const T *buf = (T*)group_buf.GetData() + nbr_send_offset.Last();
+         for (int nbr = 1; nbr < nbr_recv_groups.Size(); nbr++)
+         {
+            const int num_recv_groups = nbr_recv_groups.RowSize(nbr);
+            const int *grp_list = nbr_recv_groups.GetRow(nbr);
+            for (int i = 0; i < num_recv_groups; i++)
+            {
+               buf = CopyGroupFromBuffer(buf, ldata, grp_list[i], layout);
             }
          }
          break;
@@ -897,7 +1174,8 @@ void GroupCommunicator::ReduceBegin(const T *ldata) const
 {
    MFEM_VERIFY(comm_lock == 0, "object is already in use");
 
-   if (group_buf_size == 0) { return; }
+   // The neighborhood collective is called by all ranks of nbr_comm.
+   if (group_buf_size == 0 && mode != byNeighborCollective) { return; }
 
    int request_counter = 0;
    group_buf.SetSize(group_buf_size*sizeof(T));
@@ -954,29 +1232,41 @@ void GroupCommunicator::ReduceBegin(const T *ldata) const
       }
 
       case byNeighbor: // ***** Communication by neighbors *****
+      case byNeighborShared:
       {
+         // Wait until the on-node neighbors are done reading the window data
+         // from the previous operation.
+         WaitSharedDone();
          for (int nbr = 1; nbr < nbr_send_groups.Size(); nbr++)
          {
             // In Reduce operation: send_groups <--> recv_groups
             const int num_send_groups = nbr_recv_groups.RowSize(nbr);
             if (num_send_groups > 0)
             {
-               T *buf_start = buf;
+               // On-node data is copied directly into the shared window.
+               T *buf_start = OnNode(nbr) ?
+                              (T *)shm_base + shm_send_offset[2*nbr+1] : buf;
+               T *buf_end = buf_start;
                const int *grp_list = nbr_recv_groups.GetRow(nbr);
                for (int i = 0; i < num_send_groups; i++)
                {
                   const int layout = 0; // ldata is an array on all ldofs
-                  buf = CopyGroupToBuffer(ldata, buf, grp_list[i], layout);
+                  buf_end = CopyGroupToBuffer(ldata, buf_end, grp_list[i],
+                                              layout);
+               }
+               buf += buf_end - buf_start;
+               if (!OnNode(nbr))
+               {
+                  MPI_Isend(buf_start,
+                            buf_end - buf_start,
+                            MPITypeMap<T>::mpi_type,
+                            gtopo.GetNeighborRank(nbr),
+                            43822,
+                            gtopo.GetComm(),
+                            &requests[request_counter]);
+                  request_marker[request_counter] = -1; // mark as send req.
+                  request_counter++;
                }
-               MPI_Isend(buf_start,
-                         buf - buf_start,
-                         MPITypeMap<T>::mpi_type,
-                         gtopo.GetNeighborRank(nbr),
-                         43822,
-                         gtopo.GetComm(),
-                         &requests[request_counter]);
-               request_marker[request_counter] = -1; // mark as send request
-               request_counter++;
             }
 
             // In Reduce operation: send_groups <--> recv_groups
@@ -989,13 +1279,21 @@ void GroupCommunicator::ReduceBegin(const T *ldata) const
                {
                   recv_size += group_ldof.RowSize(grp_list[i]);
                }
-               MPI_Irecv(buf,
-                         recv_size,
-                         MPITypeMap<T>::mpi_type,
-                         gtopo.GetNeighborRank(nbr),
-                         43822,
-                         gtopo.GetComm(),
-                         &requests[request_counter]);
+               if (!OnNode(nbr))
+               {
+                  MPI_Irecv(buf,
+                            recv_size,
+                            MPITypeMap<T>::mpi_type,
+                            gtopo.GetNeighborRank(nbr),
+                            43822,
+                            gtopo.GetComm(),
+                            &requests[request_counter]);
+               }
+               else // the data will be ready in the window after this recv
+               {
+                  MPI_Irecv(NULL, 0, MPI_BYTE, gtopo.GetNeighborRank(nbr),
+                            44822, gtopo.GetComm(), &requests[request_counter]);
+               }
                request_marker[request_counter] = nbr;
                request_counter++;
                buf_offsets[nbr] = buf - (T*)group_buf.GetData();
@@ -1003,6 +1301,50 @@ void GroupCommunicator::ReduceBegin(const T *ldata) const
             }
          }
          MFEM_ASSERT(buf - (T*)group_buf.GetData() == group_buf_size, "");
+         if (mode == byNeighborShared)
+         {
+            // Make the window data visible, then notify the on-node readers.
+            MPI_Win_sync(shm_win);
+            for (int nbr = 1; nbr < nbr_recv_groups.Size(); nbr++)
+            {
+               if (nbr_recv_groups.RowSize(nbr) > 0 && OnNode(nbr))
+               {
+                  MPI_Isend(NULL, 0, MPI_BYTE, gtopo.GetNeighborRank(nbr),
+                            44822, gtopo.GetComm(), &requests[request_counter]);
+                  request_marker[request_counter] = -1; // mark as send req.
+                  request_counter++;
+               }
+            }
+         }
+         break;
+      }
+
+      case byNeighborCollective: // ***** Neighborhood collective *****
+      {
+#if MPI_VERSION >= 3
+         // In Reduce operation: send_groups <--> recv_groups
+         T *send_buf = buf;
+         T *recv_buf = send_buf + nbr_recv_offset.Last();
+         for (int nbr = 1; nbr < nbr_recv_groups.Size(); nbr++)
+         {
+            const int num_send_groups = nbr_recv_groups.RowSize(nbr);
+            const int *grp_list = nbr_recv_groups.GetRow(nbr);
+            for (int i = 0; i < num_send_groups; i++)
+            {
+               const int layout = 0; // ldata is an array on all ldofs
+               buf = CopyGroupToBuffer(ldata, buf, grp_list[i], layout);
+            }
+         }
+         MFEM_ASSERT(buf == recv_buf, "");
+         MPI_Ineighbor_alltoallv(send_buf, nbr_recv_count.GetData(),
+                                 nbr_recv_offset.GetData(),
+                                 MPITypeMap<T>::mpi_type,
+                                 recv_buf, nbr_send_count.GetData(),
+                                 nbr_send_offset.GetData(),
+                                 MPITypeMap<T>::mpi_type,
+                                 nbr_comm, &requests[0]);
+         request_counter = 1;
+#endif
          break;
       }
    }
@@ -1055,8 +1397,10 @@ void GroupCommunicator::ReduceEnd(T *ldata, int layout,
       }
 
       case byNeighbor: // ***** Communication by neighbors *****
+      case byNeighborShared:
       {
          MPI_Waitall(num_requests, requests, MPI_STATUSES_IGNORE);
+         if (mode == byNeighborShared) { MPI_Win_sync(shm_win); }
 
          for (int nbr = 1; nbr < nbr_send_groups.Size(); nbr++)
          {
@@ -1065,12 +1409,40 @@ void GroupCommunicator::ReduceEnd(T *ldata, int layout,
             if (num_recv_groups > 0)
             {
                const int *grp_list = nbr_send_groups.GetRow(nbr);
-               const T *buf = (T*)group_buf.GetData() + buf_offsets[nbr];
+               const T *buf = OnNode(nbr) ?
+                              (T*)shm_nbr_base[nbr] + shm_recv_offset[2*nbr+1] :
+                              (T*)group_buf.GetData() + buf_offsets[nbr];
                for (int i = 0; i < num_recv_groups; i++)
                {
                   buf = ReduceGroupFromBuffer(buf, ldata, grp_list[i],
                                               layout, Op);
                }
+               if (OnNode(nbr))
+               {
+                  MPI_Isend(NULL, 0, MPI_BYTE, gtopo.GetNeighborRank(nbr),
+                            45822, gtopo.GetComm(),
+                            &shm_requests[num_shm_requests++]);
+               }
+            }
+         }
+         if (mode == byNeighborShared) { PostSharedDone(nbr_recv_groups); }
+         break;
+      }
+
+      case byNeighborCollective: // ***** Neighborhood collective *****
+      {
+         MPI_Wait(&requests[0], MPI_STATUS_IGNORE);
+
+         // In Reduce operation: send_groups <--> recv_groups
+         const T *buf = (T*)group_buf.GetData() + nbr_recv_offset.Last();
+         for (int nbr = 1; nbr < nbr_send_groups.Size(); nbr++)
+         {
+            const int num_recv_groups = nbr_send_groups.RowSize(nbr);
+            const int *grp_list = nbr_send_groups.GetRow(nbr);
+            for (int i = 0; i < num_recv_groups; i++)
+            {
+               buf = ReduceGroupFromBuffer(buf, ldata, grp_list[i],
+                                           layout, Op);
             }
          }
          break;
@@ -1191,6 +1563,8 @@ void GroupCommunicator::PrintInfo(std::ostream &out) const
          break;
 
       case byNeighbor:
+      case byNeighborCollective:
+      case byNeighborShared:
          for (int gr = 1; gr < group_ldof.Size(); gr++)
          {
             const int nldofs = group_ldof.RowSize(gr);
@@ -1245,7 +1619,10 @@ void GroupCommunicator::PrintInfo(std::ostream &out) const
    }
    out << "Rank " << myid << ":\n"
        "   mode             = " <<
-       (mode == byGroup ? "byGroup" : "byNeighbor") << "\n"
+       (mode == byGroup ? "byGroup" :
+        (mode == byNeighbor ? "byNeighbor" :
+         (mode == byNeighborCollective ? "byNeighborCollective" :
+          "byNeighborShared"))) << "\n"
        "   number of sends  = " << num_sends <<
        " (" << mem_sends << " bytes)\n"
        "   number of recvs  = " << num_recvs <<
@@ -1255,7 +1632,7 @@ void GroupCommunicator::PrintInfo(std::ostream &out) const
        num_master_groups << " + " <<
        group_ldof.Size()-num_master_groups-num_empty_groups << " + " <<
        num_empty_groups << " (master + slave + empty)\n";
-   if (mode == byNeighbor)
+   if (mode != byGroup)
    {
       out <<
           "   num neighbors    = " << nbr_send_groups.Size() << " = " <<
@@ -1275,8 +1652,30 @@ void GroupCommunicator::PrintInfo(std::ostream &out) const
    MPI_Barrier(gtopo.GetComm());
 }
 
+void GroupCommunicator::FreeSharedWindow()
+{
+#if MPI_VERSION >= 3
+   if (shm_win != MPI_WIN_NULL)
+   {
+      MFEM_VERIFY(comm_lock == 0, "a Bcast or Reduce is in progress");
+      WaitSharedDone();
+      MPI_Win_unlock_all(shm_win);
+      MPI_Win_free(&shm_win);
+   }
+#endif
+   if (node_comm != MPI_COMM_NULL) { MPI_Comm_free(&node_comm); }
+   delete [] shm_requests;
+   shm_requests = NULL;
+   shm_base = NULL;
+   shm_nbr_base.DeleteAll();
+   // the buffers and requests of byNeighborShared are those of byNeighbor
+   if (mode == byNeighborShared) { mode = byNeighbor; }
+}
+
 GroupCommunicator::~GroupCommunicator()
 {
+   if (nbr_comm != MPI_COMM_NULL) { MPI_Comm_free(&nbr_comm); }
+   FreeSharedWindow();
    delete [] buf_offsets;
    delete [] request_marker;
    // delete [] statuses;
@@ -101,6 +101,14 @@ public:
    /// Return the number of neighbors including the local processor.
    int GetNumNeighbors() const { return lproc_proc.Size(); }
 
+   /** @brief Compute the rank in the communicator @a node_comm of every
+       neighbor, or -1 for neighbors that are not part of @a node_comm. */
+   /** Typically, @a node_comm is a subcommunicator of GetComm() created with
+       MPI_Comm_split_type(MPI_COMM_TYPE_SHARED), in which case the result
+       identifies the neighbors that are on the same shared-memory node. */
+   void GetNeighborNodeRanks(MPI_Comm node_comm,
+                             Array<int> &nbr_node_rank) const;
+
    /// Return the MPI rank of neighbor 'i'.
    int GetNeighborRank(int i) const { return lproc_proc[i]; }
 
@@ -146,8 +154,24 @@ public:
    enum Mode
    {
       byGroup,    ///< Communications are performed one group at a time.
-      byNeighbor  /**< Communications are performed one neighbor at a time,
+      byNeighbor, /**< Communications are performed one neighbor at a time,
                        aggregating over groups. */
+      byNeighborCollective, /**< Communications are aggregated over groups
+                                like in byNeighbor, but all neighbors are
+                                handled with a single non-blocking MPI-3
+                                neighborhood collective on a distributed graph
+                                communicator created once in Finalize().
+                                Bcast and Reduce are then collective over the
+                                communicator of the GroupTopology. If MPI-3 is
+                                not available, this mode falls back to
+                                byNeighbor. */
+      byNeighborShared /**< Like byNeighbor, but the data for neighbors on
+                            the same shared-memory node is exchanged through
+                            an MPI-3 shared memory window; only zero-size
+                            synchronization messages are sent to these
+                            neighbors. Off-node neighbors use regular messages.
+                            If MPI-3 is not available, this mode falls back to
+                            byNeighbor. */
    };
 
 protected:
@@ -165,6 +189,46 @@ protected:
    int *request_marker;
    int *buf_offsets; // size = max(number of groups, number of neighbors)
    Table nbr_send_groups, nbr_recv_groups; // nbr 0 = me
+   // Data used only in mode byNeighborCollective: the graph communicator with
+   // all neighbors (except me) as sources and destinations, and the counts and
+   // offsets (in number of entries) of the data sent to/received from each
+   // neighbor in a Bcast; a Reduce uses the same arrays with send <--> recv.
+   MPI_Comm nbr_comm;
+   Array<int> nbr_send_count, nbr_send_offset; // size = number of nbrs - 1
+   Array<int> nbr_recv_count, nbr_recv_offset; // offsets have one extra entry
+
+   // Data used only in mode byNeighborShared: the shared memory node
+   // communicator and window, the node rank of each neighbor (-1 if off-node),
+   // and the offsets (in number of entries) of the Bcast/Reduce data for each
+   // on-node neighbor: in my window segment (shm_send_offset) and in the
+   // neighbor's segment (shm_recv_offset); [2*nbr] is for Bcast, [2*nbr+1] is
+   // for Reduce. The requests for the "done" synchronization messages of the
+   // last operation are completed at the beginning of the next one.
+   MPI_Comm node_comm;
+   MPI_Win shm_win;
+   char *shm_base;
+   Array<int> nbr_node_rank;
+   Array<int> shm_send_offset, shm_recv_offset;
+   Array<char *> shm_nbr_base;
+   MPI_Request *shm_requests;
+   mutable int num_shm_requests;
+
+   /// Create the graph communicator and counts used by byNeighborCollective.
+   void CreateNeighborComm();
+
+   /// Create the shared memory window used by byNeighborShared.
+   void CreateSharedWindow();
+
+   /// Return true if neighbor @a nbr uses the shared memory window.
+   bool OnNode(int nbr) const
+   { return mode == byNeighborShared && nbr_node_rank[nbr] >= 0; }
+
+   /// Wait for the on-node readers to finish with the data in the window.
+   void WaitSharedDone() const;
+
+   /** @brief Post the "done" receives from the on-node neighbors that read the
+       data written by this rank in the last operation. */
+   void PostSharedDone(const Table &nbr_readers) const;
 
 public:
    /// Construct a GroupCommunicator object.
@@ -188,8 +252,20 @@ public:
    const Table &GroupLDofTable() const { return group_ldof; }
 
    /// Allocate internal buffers after the GroupLDofTable is defined
+   /** In modes byNeighborCollective and byNeighborShared, this method is
+       collective over the communicator of the GroupTopology. */
    void Finalize();
 
+   /// Return the communication mode.
+   Mode GetMode() const { return mode; }
+
+   /** @brief In mode byNeighborShared, free the shared memory window and
+       switch to mode byNeighbor. */
+   /** This method is collective over the ranks on the same node. After it,
+       the destructor is no longer collective, so the object can be destroyed
+       independently on each rank. No Bcast or Reduce can be in progress. */
+   void FreeSharedWindow();
+
    /// Initialize the internal group_ltdof Table.
    /** This method must be called before performing operations that use local
        data layout 2, see CopyGroupToBuffer() for layout descriptions. */
@@ -332,6 +408,9 @@ public:
 
    /** @brief Destroy a GroupCommunicator object, deallocating internal data
        structures and buffers. */
+   /** In mode byNeighborShared, the destructor is collective over the ranks
+       on the same node, since it frees the shared memory window. Call
+       FreeSharedWindow() before to make it local. */
    ~GroupCommunicator();
 };
 
@@ -11,10 +11,12 @@
 
 #include "forall.hpp"
 #include "occa.hpp"
+#include "../linalg/simd.hpp"
 #ifdef MFEM_USE_CEED
 #include "../fem/libceed/ceed.hpp"
 #endif
 
+#include <algorithm>
 #include <unordered_map>
 #include <string>
 #include <map>
@@ -57,6 +59,39 @@ static const char *backend_name[Backend::NUM_BACKENDS] =
    "ceed-cpu", "occa-cpu", "raja-cpu", "cpu"
 };
 
+// Return the largest SIMD width, in bytes, supported by the CPU for which the
+// kernels with runtime dispatch have a variant, optionally limited by the
+// environment variable MFEM_SIMD.
+static int DetectSimdBytes()
+{
+   int bytes = MFEM_SIMD_BYTES;
+#ifdef MFEM_SIMD_DISPATCH
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("avx512f"))
+   {
+      bytes = std::max(bytes, 64);
+   }
+   else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+   {
+      bytes = std::max(bytes, 32);
+   }
+#endif
+   if (getenv("MFEM_SIMD"))
+   {
+      const std::string isa(getenv("MFEM_SIMD"));
+      int max_bytes = 0;
+      if (isa == "avx512") { max_bytes = 64; }
+      else if (isa == "avx2") { max_bytes = 32; }
+      else if (isa == "generic") { max_bytes = MFEM_SIMD_BYTES; }
+      else { MFEM_ABORT("Unknown SIMD instruction set: " << isa); }
+      bytes = std::max(std::min(bytes, max_bytes), MFEM_SIMD_BYTES);
+   }
+   return bytes;
+}
+
+// The SIMD width returned by Device::GetSimdBytes(), 0 until it is detected
+static int simd_bytes = 0;
+
 } // namespace mfem::internal
 
 
@@ -286,7 +321,33 @@ void Device::Print(std::ostream &out)
    {
       out << ',' << MemoryTypeName[static_cast<int>(device_mem_type)];
    }
-   out << std::endl;
+   out << '\n';
+   out << "Host SIMD kernels: " << GetSimdName()
+       << " (" << GetSimdBytes() << " bytes)" << std::endl;
+}
+
+int Device::GetSimdBytes()
+{
+   if (internal::simd_bytes == 0) { DetectSimd(); }
+   return internal::simd_bytes;
+}
+
+const char *Device::GetSimdName()
+{
+#ifdef MFEM_SIMD_DISPATCH
+   // Same selection as the kernels with runtime dispatch
+   switch (GetSimdBytes())
+   {
+      case 64: return "avx512";
+      case 32: return "avx2";
+   }
+#endif
+   return "generic";
+}
+
+void Device::DetectSimd()
+{
+   internal::simd_bytes = internal::DetectSimdBytes();
 }
 
 void Device::UpdateMemoryTypeAndClass()
@@ -230,6 +230,26 @@ public:
    /// Print the configuration of the MFEM virtual device object.
    void Print(std::ostream &out = mfem::out);
 
+   /** @brief Get the SIMD width, in bytes, of the host kernels that are
+       compiled for several instruction sets, see MFEM_SIMD_DISPATCH in
+       linalg/simd.hpp. */
+   /** The width is detected on the first call, see DetectSimd(), from the
+       features of the CPU, and it is never less than MFEM_SIMD_BYTES. The
+       environment variable MFEM_SIMD can be set to 'avx512', 'avx2' or
+       'generic' to limit the width, e.g. when the clock speed penalty of the
+       wider instructions is not acceptable. */
+   static int GetSimdBytes();
+
+   /** @brief Get the instruction set of the host kernels selected with
+       GetSimdBytes(): "avx512", "avx2" or "generic". */
+   /** The "generic" kernels are compiled for the instruction set of the MFEM
+       build, with the width MFEM_SIMD_BYTES. */
+   static const char *GetSimdName();
+
+   /** @brief Detect again the width returned by GetSimdBytes(), e.g. after
+       changing the environment variable MFEM_SIMD. */
+   static void DetectSimd();
+
    /// Return true if Configure() has been called previously.
    static inline bool IsConfigured() { return Get().ngpu >= 0; }
 
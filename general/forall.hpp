@@ -383,6 +383,14 @@ void HipWrap3D(const int N, DBODY &&d_body,
 #endif // MFEM_USE_HIP
 
 
+/** @brief Function that determines if the host kernels with cross-element
+    SIMD vectorization (batches of MFEM_SIMD_BYTES/sizeof(double) elements)
+    should be used, based on the current mfem::Device configuration. */
+inline bool DeviceCanUseSimd()
+{
+   return !Device::Allows(Backend::DEVICE_MASK | Backend::OMP_MASK);
+}
+
 /// The forall kernel body wrapper
 template <const int DIM, typename DBODY, typename HBODY>
 inline void ForallWrap(const bool use_dev, const int N,
@@ -120,6 +120,19 @@ public:
    void Reparent(int id, int new_p1, int new_p2);
    void Reparent(int id, int new_p1, int new_p2, int new_p3, int new_p4 = -1);
 
+   /** @brief Move item 'id' to the new position 'new_ids[id]', for all used
+       ids. The resulting container has 'new_num_ids' ids, those not assigned
+       to any item become unused.
+
+       The parent IDs (p1, p2, ...) of the items are not changed by this
+       method, but the hash table is rebuilt (and resized) from their current
+       values. If the parent IDs refer to renumbered items, the caller should
+       update them (sorted, see GetId()) before calling this method. */
+   void Renumber(const Array<int> &new_ids, int new_num_ids);
+
+   /// Resize the hash table so that 'num_ids' items fit without rehashing.
+   void Reserve(int num_ids);
+
    /// Return total size of allocated memory (tables plus items), in bytes.
    long MemoryUsage() const;
 
@@ -197,9 +210,12 @@ protected:
    inline void Insert(int idx, int id, T &item);
    void Unlink(int idx, int id);
 
+   /// Maximum average length of the linked lists, see CheckRehash()
+   static const int fill_factor = 2;
+
    /// Check table load factor and resize if necessary
    inline void CheckRehash();
-   void DoRehash();
+   void DoRehash(int new_table_size);
 };
 
 
@@ -408,22 +424,18 @@ int HashTable<T>::SearchList(int id, int p1, int p2, int p3) const
 template<typename T>
 inline void HashTable<T>::CheckRehash()
 {
-   const int fill_factor = 2;
-
    // is the table overfull?
    if (Base::Size() > (mask+1) * fill_factor)
    {
-      DoRehash();
+      DoRehash(2*(mask+1)); // double the table size
    }
 }
 
 template<typename T>
-void HashTable<T>::DoRehash()
+void HashTable<T>::DoRehash(int new_table_size)
 {
    delete [] table;
 
-   // double the table size
-   int new_table_size = 2*(mask+1);
    table = new int[new_table_size];
    for (int i = 0; i < new_table_size; i++) { table[i] = -1; }
    mask = new_table_size-1;
@@ -515,6 +527,59 @@ void HashTable<T>::Reparent(int id,
    Insert(new_idx, id, item);
 }
 
+template<typename T>
+void HashTable<T>::Renumber(const Array<int> &new_ids, int new_num_ids)
+{
+   MFEM_VERIFY(new_ids.Size() == Base::Size(), "invalid size of 'new_ids'.");
+
+   // move the items to a new BlockArray, in the new order
+   Base old_items(Base::mask+1);
+   Base::Swap(old_items);
+   for (int i = 0; i < new_num_ids; i++) { Base::Append(); }
+
+   Array<bool> assigned(new_num_ids);
+   assigned = false;
+
+   for (int id = 0; id < old_items.Size(); id++)
+   {
+      T &item = old_items[id];
+      if (item.next == -2) { continue; }
+
+      int new_id = new_ids[id];
+      MFEM_ASSERT(new_id >= 0 && new_id < new_num_ids && !assigned[new_id],
+                  "invalid new id " << new_id << " of item " << id);
+
+      Base::At(new_id) = item;
+      assigned[new_id] = true;
+
+      item = T(); // leave a default (unreferenced) item behind
+   }
+
+   // list the ids not assigned to any item as unused, lowest id last
+   unused.SetSize(0);
+   for (int i = new_num_ids-1; i >= 0; i--)
+   {
+      if (!assigned[i])
+      {
+         Base::At(i).next = -2;
+         unused.Append(i);
+      }
+   }
+
+   // shrink (or grow) the table to fit the new number of items
+   int new_table_size = 16;
+   while (new_num_ids > new_table_size * fill_factor) { new_table_size *= 2; }
+   DoRehash(new_table_size);
+}
+
+template<typename T>
+void HashTable<T>::Reserve(int num_ids)
+{
+   int new_table_size = mask+1;
+   while (num_ids > new_table_size * fill_factor) { new_table_size *= 2; }
+   if (new_table_size > mask+1) { DoRehash(new_table_size); }
+}
+
 template<typename T>
 long HashTable<T>::MemoryUsage() const
 {
@@ -21,12 +21,15 @@
 #include "../general/forall.hpp"
 #include "../general/table.hpp"
 #include "../general/globals.hpp"
+#include "simd.hpp"
 
 #include <iostream>
 #include <iomanip>
 #include <limits>
 #include <algorithm>
 #include <cstdlib>
+#include <cstdint>
+#include <vector>
 #if defined(_MSC_VER) && (_MSC_VER < 1800)
 #include <float.h>
 #define copysign _copysign
@@ -3511,71 +3514,225 @@ DenseTensor &DenseTensor::operator=(double c)
    return *this;
 }
 
-void BatchLUFactor(DenseTensor &Mlu, Array<int> &P, const double TOL)
+// Host kernels for the batched factorizations, using SIMD across the batch: VS
+// matrices are factored at a time, interleaved in the work array W such that
+// the lanes of W[i+j*m] hold the entry (i,j) of the VS matrices. Unused lanes
+// of the last batch are set to the identity.
+template <typename vreal_t>
+static inline MFEM_ALWAYS_INLINE
+vreal_t *SimdBatchGather(const int m, const int nv, const double *A,
+                         std::vector<double> &buf)
 {
-   const int m = Mlu.SizeI();
-   const int NE = Mlu.SizeK();
-   P.SetSize(m*NE);
+   const int VS = sizeof(vreal_t)/sizeof(double);
+   vreal_t *W = AlignedSimdArray<vreal_t>(buf, m*m);
+   for (int k = 0; k < m*m; k++)
+   {
+      for (int v = 0; v < VS; v++)
+      {
+         W[k][v] = (v < nv) ? A[k+v*m*m] : ((k % (m+1) == 0) ? 1.0 : 0.0);
+      }
+   }
+   return W;
+}
 
-   auto data_all = mfem::Reshape(Mlu.ReadWrite(), m, m, NE);
-   auto ipiv_all = mfem::Reshape(P.Write(), m, NE);
-   Array<bool> pivot_flag(1);
-   pivot_flag[0] = true;
-   bool *d_pivot_flag = pivot_flag.ReadWrite();
+template <typename vreal_t>
+static inline MFEM_ALWAYS_INLINE
+void SimdBatchScatter(const int m, const int nv, const vreal_t *W, double *A)
+{
+   for (int k = 0; k < m*m; k++)
+   {
+      for (int v = 0; v < nv; v++)
+      {
+         A[k+v*m*m] = W[k][v];
+      }
+   }
+}
 
-   MFEM_FORALL(e, NE,
+template <int VS>
+static inline MFEM_ALWAYS_INLINE
+bool SimdBatchLUFactorKernel(const int m, const int NE, double *A, int *P,
+                             const double TOL)
+{
+   typedef AutoSIMD<double,VS,VS*sizeof(double)> vreal_t;
+   std::vector<double> buf;
+   bool pivot_flag = true;
+   for (int e0 = 0; e0 < NE; e0 += VS)
    {
+      const int nv = (NE - e0 < VS) ? NE - e0 : VS;
+      vreal_t *W = SimdBatchGather<vreal_t>(m, nv, A + e0*m*m, buf);
       for (int i = 0; i < m; i++)
       {
-         // pivoting
+         // The pivoting is done independently in each lane
+         for (int v = 0; v < nv; v++)
          {
             int piv = i;
-            double a = fabs(data_all(piv,i,e));
+            double a = fabs(W[i+i*m][v]);
             for (int j = i+1; j < m; j++)
             {
-               const double b = fabs(data_all(j,i,e));
+               const double b = fabs(W[j+i*m][v]);
                if (b > a)
                {
                   a = b;
                   piv = j;
                }
             }
-            ipiv_all(i,e) = piv;
+            P[i+(e0+v)*m] = piv;
             if (piv != i)
             {
-               // swap rows i and piv in both L and U parts
                for (int j = 0; j < m; j++)
                {
-                  mfem::kernels::internal::Swap<double>(data_all(i,j,e), data_all(piv,j,e));
+                  kernels::internal::Swap<double>(W[i+j*m][v], W[piv+j*m][v]);
                }
             }
-         } // pivot end
-
-         if (abs(data_all(i,i,e)) <= TOL)
-         {
-            d_pivot_flag[0] = false;
+            if (fabs(W[i+i*m][v]) <= TOL) { pivot_flag = false; }
          }
 
-         const double a_ii_inv = 1.0 / data_all(i,i,e);
+         vreal_t a_ii_inv;
+         a_ii_inv = 1.0;
+         a_ii_inv /= W[i+i*m];
          for (int j = i+1; j < m; j++)
          {
-            data_all(j,i,e) *= a_ii_inv;
+            W[j+i*m] *= a_ii_inv;
          }
-
          for (int k = i+1; k < m; k++)
          {
-            const double a_ik = data_all(i,k,e);
+            const vreal_t a_ik = W[i+k*m];
             for (int j = i+1; j < m; j++)
             {
-               data_all(j,k,e) -= a_ik * data_all(j,i,e);
+               W[j+k*m] -= a_ik * W[j+i*m];
+            }
+         }
+      }
+      SimdBatchScatter<vreal_t>(m, nv, W, A + e0*m*m);
+   }
+   return pivot_flag;
+}
+
+template <int VS>
+static inline MFEM_ALWAYS_INLINE
+bool SimdBatchCholeskyFactorKernel(const int m, const int NE, double *A)
+{
+   typedef AutoSIMD<double,VS,VS*sizeof(double)> vreal_t;
+   std::vector<double> buf;
+   bool spd_flag = true;
+   for (int e0 = 0; e0 < NE; e0 += VS)
+   {
+      const int nv = (NE - e0 < VS) ? NE - e0 : VS;
+      vreal_t *W = SimdBatchGather<vreal_t>(m, nv, A + e0*m*m, buf);
+      for (int j = 0; j < m; j++)
+      {
+         vreal_t l_jj_inv;
+         for (int v = 0; v < VS; v++)
+         {
+            const double a_jj = W[j+j*m][v];
+            if (!(a_jj > 0.0)) { spd_flag = false; }
+            W[j+j*m][v] = sqrt(a_jj);
+            l_jj_inv[v] = 1.0 / W[j+j*m][v];
+         }
+         for (int i = j+1; i < m; i++)
+         {
+            W[i+j*m] *= l_jj_inv;
+         }
+         for (int k = j+1; k < m; k++)
+         {
+            const vreal_t l_kj = W[k+j*m];
+            for (int i = k; i < m; i++)
+            {
+               W[i+k*m] -= W[i+j*m] * l_kj;
             }
          }
+      }
+      SimdBatchScatter<vreal_t>(m, nv, W, A + e0*m*m);
+   }
+   return spd_flag;
+}
+
+#ifdef MFEM_SIMD_DISPATCH
+MFEM_SIMD_TARGET_AVX2
+static bool SimdBatchLUFactorAVX2(const int m, const int NE, double *A,
+                                  int *P, const double TOL)
+{
+   return SimdBatchLUFactorKernel<4>(m, NE, A, P, TOL);
+}
 
-      } // m loop
+MFEM_SIMD_TARGET_AVX512
+static bool SimdBatchLUFactorAVX512(const int m, const int NE, double *A,
+                                    int *P, const double TOL)
+{
+   return SimdBatchLUFactorKernel<8>(m, NE, A, P, TOL);
+}
 
+MFEM_SIMD_TARGET_AVX2
+static bool SimdBatchCholeskyFactorAVX2(const int m, const int NE, double *A)
+{
+   return SimdBatchCholeskyFactorKernel<4>(m, NE, A);
+}
+
+MFEM_SIMD_TARGET_AVX512
+static bool SimdBatchCholeskyFactorAVX512(const int m, const int NE, double *A)
+{
+   return SimdBatchCholeskyFactorKernel<8>(m, NE, A);
+}
+#endif
+
+// Select the variant of the SIMD kernels for the SIMD width detected at
+// startup, see Device::GetSimdBytes().
+static bool SimdBatchLUFactor(const int m, const int NE, double *A, int *P,
+                              const double TOL)
+{
+#ifdef MFEM_SIMD_DISPATCH
+   switch (Device::GetSimdBytes())
+   {
+      case 64: return SimdBatchLUFactorAVX512(m, NE, A, P, TOL);
+      case 32: return SimdBatchLUFactorAVX2(m, NE, A, P, TOL);
+   }
+#endif
+   constexpr int VS = MFEM_SIMD_BYTES/sizeof(double);
+   return SimdBatchLUFactorKernel<VS>(m, NE, A, P, TOL);
+}
+
+static bool SimdBatchCholeskyFactor(const int m, const int NE, double *A)
+{
+#ifdef MFEM_SIMD_DISPATCH
+   switch (Device::GetSimdBytes())
+   {
+      case 64: return SimdBatchCholeskyFactorAVX512(m, NE, A);
+      case 32: return SimdBatchCholeskyFactorAVX2(m, NE, A);
+   }
+#endif
+   constexpr int VS = MFEM_SIMD_BYTES/sizeof(double);
+   return SimdBatchCholeskyFactorKernel<VS>(m, NE, A);
+}
+
+void BatchLUFactor(DenseTensor &Mlu, Array<int> &P, const double TOL)
+{
+   const int m = Mlu.SizeI();
+   const int NE = Mlu.SizeK();
+   P.SetSize(m*NE);
+
+   if (DeviceCanUseSimd())
+   {
+      const bool pivot_flag =
+         SimdBatchLUFactor(m, NE, Mlu.HostReadWrite(), P.HostWrite(), TOL);
+      MFEM_VERIFY(pivot_flag, "Batch LU factorization failed");
+      return;
+   }
+
+   auto data_all = mfem::Reshape(Mlu.ReadWrite(), m, m, NE);
+   auto ipiv_all = mfem::Reshape(P.Write(), m, NE);
+   Array<bool> pivot_flag(1);
+   pivot_flag[0] = true;
+   bool *d_pivot_flag = pivot_flag.ReadWrite();
+
+   MFEM_FORALL(e, NE,
+   {
+      if (!kernels::LUFactor(&data_all(0,0,e), m, &ipiv_all(0,e), TOL))
+      {
+         d_pivot_flag[0] = false;
+      }
    });
 
-   MFEM_ASSERT(pivot_flag.HostRead()[0], "Batch LU factorization failed \n");
+   MFEM_VERIFY(pivot_flag.HostRead()[0], "Batch LU factorization failed");
 }
 
 void BatchLUSolve(const DenseTensor &Mlu, const Array<int> &P, Vector &X)
@@ -3595,4 +3752,100 @@ void BatchLUSolve(const DenseTensor &Mlu, const Array<int> &P, Vector &X)
 
 }
 
+void BatchCholeskyFactor(DenseTensor &Mchol)
+{
+   const int m = Mchol.SizeI();
+   const int NE = Mchol.SizeK();
+
+   if (DeviceCanUseSimd())
+   {
+      const bool spd_flag = SimdBatchCholeskyFactor(m, NE,
+                                                    Mchol.HostReadWrite());
+      MFEM_VERIFY(spd_flag, "Batch Cholesky factorization failed");
+      return;
+   }
+
+   auto data_all = mfem::Reshape(Mchol.ReadWrite(), m, m, NE);
+   Array<bool> spd_flag(1);
+   spd_flag[0] = true;
+   bool *d_spd_flag = spd_flag.ReadWrite();
+
+   MFEM_FORALL(e, NE,
+   {
+      if (!kernels::CholeskyFactor(&data_all(0,0,e), m))
+      {
+         d_spd_flag[0] = false;
+      }
+   });
+
+   MFEM_VERIFY(spd_flag.HostRead()[0], "Batch Cholesky factorization failed");
+}
+
+void BatchCholeskySolve(const DenseTensor &Mchol, Vector &X)
+{
+   const int m = Mchol.SizeI();
+   const int NE = Mchol.SizeK();
+
+   auto data_all = mfem::Reshape(Mchol.Read(), m, m, NE);
+   auto x_all = mfem::Reshape(X.ReadWrite(), m, NE);
+
+   MFEM_FORALL(e, NE,
+   {
+      kernels::CholeskySolve(&data_all(0,0,e), m, &x_all(0,e));
+   });
+}
+
+void BatchLUFactor(const Array<int> &sizes, const Array<double*> &data,
+                   const Array<int*> &ipiv)
+{
+   const int n = sizes.Size();
+   MFEM_ASSERT(data.Size() == n && ipiv.Size() == n, "invalid sizes");
+
+   // Group the matrices by size
+   Array<int> order(n);
+   for (int k = 0; k < n; k++) { order[k] = k; }
+   std::stable_sort(order.begin(), order.end(),
+                    [&](int a, int b) { return sizes[a] < sizes[b]; });
+
+   DenseTensor A;
+   Array<int> P;
+   int g_end;
+   for (int g_begin = 0; g_begin < n; g_begin = g_end)
+   {
+      const int m = sizes[order[g_begin]];
+      g_end = g_begin + 1;
+      while (g_end < n && sizes[order[g_end]] == m) { g_end++; }
+      const int nb = g_end - g_begin;
+      if (m == 0) { continue; }
+      if (nb == 1)
+      {
+         const int k = order[g_begin];
+         LUFactors lu(data[k], ipiv[k]);
+         lu.Factor(m);
+         continue;
+      }
+
+      // Copy the group to a DenseTensor, factor it and copy the factors back
+      A.SetSize(m, m, nb);
+      double *h_A = A.HostWrite();
+      for (int j = 0; j < nb; j++)
+      {
+         const double *d = data[order[g_begin + j]];
+         std::copy(d, d + m*m, h_A + j*m*m);
+      }
+      BatchLUFactor(A, P);
+      h_A = A.HostReadWrite();
+      const int *h_P = P.HostRead();
+      for (int j = 0; j < nb; j++)
+      {
+         const int k = order[g_begin + j];
+         std::copy(h_A + j*m*m, h_A + (j+1)*m*m, data[k]);
+         for (int i = 0; i < m; i++)
+         {
+            ipiv[k][i] = h_P[j*m + i] + LUFactors::ipiv_base;
+         }
+      }
+   }
+}
+
 } // namespace mfem
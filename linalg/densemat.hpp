@@ -866,17 +866,20 @@ public:
 
     Factorize n matrices of size (m x m) stored in a dense tensor overwriting it
     with the LU factors. The factorization is such that L.U = Piv.A, where A is
-    the original matrix and Piv is a permutation matrix represented by P.
+    the original matrix and Piv is a permutation matrix represented by P. On
+    the host, the matrices are factored in groups of SIMD width, see
+    Device::GetSimdBytes().
 
     @param [in, out] Mlu batch of square matrices - dimension m x m x n.
     @param [out] P array storing pivot information - dimension m x n.
-    @param [in] TOL optional fuzzy comparison tolerance. Defaults to 0.0. */
+    @param [in] TOL optional fuzzy comparison tolerance. Defaults to 0.0.
+    A pivot with absolute value <= TOL is an error. */
 void BatchLUFactor(DenseTensor &Mlu, Array<int> &P, const double TOL = 0.0);
 
 /** @brief Solve batch linear systems
 
-    Assuming L.U = P.A for n factored matrices (m x m), compute x <- A x, for n
-    companion vectors.
+    Assuming L.U = P.A for n factored matrices (m x m), compute x <- A^{-1} x,
+    for n companion vectors.
 
     @param [in] Mlu batch of LU factors for matrix M - dimension m x m x n.
     @param [in] P array storing pivot information - dimension m x n.
@@ -884,6 +887,42 @@ void BatchLUFactor(DenseTensor &Mlu, Array<int> &P, const double TOL = 0.0);
     dimension m x n. */
 void BatchLUSolve(const DenseTensor &Mlu, const Array<int> &P, Vector &X);
 
+/** @brief Compute the Cholesky factorization of a batch of symmetric positive
+    definite matrices
+
+    Factorize n matrices of size (m x m) stored in a dense tensor overwriting
+    their lower triangles with the factors L, such that L.L^t = A. On the host,
+    the matrices are factored in groups of SIMD width, see
+    Device::GetSimdBytes().
+
+    @param [in, out] Mchol batch of square matrices - dimension m x m x n. */
+void BatchCholeskyFactor(DenseTensor &Mchol);
+
+/** @brief Solve batch linear systems
+
+    Assuming L.L^t = A for n factored matrices (m x m), compute x <- A^{-1} x,
+    for n companion vectors.
+
+    @param [in] Mchol batch of Cholesky factors - dimension m x m x n.
+    @param [in, out] X vector storing right-hand side and then solution -
+    dimension m x n. */
+void BatchCholeskySolve(const DenseTensor &Mchol, Vector &X);
+
+/** @brief Compute the LU factorization of matrices of possibly different
+    sizes, stored at arbitrary host locations
+
+    Matrix k, of size (@a sizes[k] x @a sizes[k]), is stored at @a data[k] and
+    is overwritten with its LU factors; its pivots are stored at @a ipiv[k],
+    with the convention of LUFactors. The matrices are grouped by size and the
+    groups with more than one matrix are factored with BatchLUFactor(). A
+    matrix with a unique size is factored with LUFactors::Factor().
+
+    @param [in] sizes the size of each matrix.
+    @param [in] data the location of each matrix (column-major).
+    @param [in] ipiv the location of the pivots of each matrix. */
+void BatchLUFactor(const Array<int> &sizes, const Array<double*> &data,
+                   const Array<int*> &ipiv);
+
 
 // Inline methods
 
@@ -4129,6 +4129,198 @@ void HypreADS::SetPrintLevel(int print_lvl)
    HYPRE_ADSSetPrintLevel(ads, print_lvl);
 }
 
+HypreAgglomeratedSolver::HypreAgglomeratedSolver(const HypreParMatrix &A,
+                                                 int min_dofs)
+   : Solver(A.Height(), A.Width()),
+     sub_comm(MPI_COMM_NULL),
+     A_agg(NULL),
+     solver(NULL),
+     own_solver(false)
+{
+   MFEM_VERIFY(A.GetGlobalNumRows() == A.GetGlobalNumCols(),
+               "The matrix must be square.");
+   // The point-to-point messages below use a private communicator, so they
+   // can not match messages of the caller on the communicator of A.
+   MPI_Comm_dup(A.GetComm(), &comm);
+   int myid, num_procs;
+   MPI_Comm_rank(comm, &myid);
+   MPI_Comm_size(comm, &num_procs);
+
+   // The ranks are split into num_active contiguous groups, and all the rows
+   // of a group are sent to its first rank. Since the rows of A are numbered
+   // consecutively by rank, the agglomerated rows remain contiguous.
+   const HYPRE_Int glob_size = A.GetGlobalNumRows();
+   long long num_active = num_procs;
+   if (min_dofs > 0)
+   {
+      num_active = std::min(num_active, (long long) glob_size / min_dofs);
+      num_active = std::max(num_active, 1LL);
+   }
+   const long long group = (long long) myid * num_active / num_procs;
+   target = (int) ((group * num_procs + num_active - 1) / num_active);
+   const int next_target =
+      (int) (((group + 1) * num_procs + num_active - 1) / num_active);
+   const bool active = (target == myid);
+   MPI_Comm_split(comm, active ? 0 : MPI_UNDEFINED, myid, &sub_comm);
+
+   // Local rows of A with global column indices
+   SparseMatrix diag, offd;
+   HYPRE_Int *cmap;
+   A.GetDiag(diag);
+   A.GetOffd(offd, cmap);
+   const HYPRE_Int col_start =
+      hypre_ParCSRMatrixFirstColDiag((hypre_ParCSRMatrix *) A);
+   const int nrows = A.GetNumRows();
+   Array<int> I(nrows + 1);
+   Array<HYPRE_Int> J(diag.NumNonZeroElems() + offd.NumNonZeroElems());
+   Array<double> data(J.Size());
+   I[0] = 0;
+   for (int i = 0, k = 0; i < nrows; i++)
+   {
+      for (int j = diag.GetI()[i]; j < diag.GetI()[i+1]; j++, k++)
+      {
+         J[k] = col_start + diag.GetJ()[j];
+         data[k] = diag.GetData()[j];
+      }
+      if (offd.Height() > 0)
+      {
+         for (int j = offd.GetI()[i]; j < offd.GetI()[i+1]; j++, k++)
+         {
+            J[k] = cmap[offd.GetJ()[j]];
+            data[k] = offd.GetData()[j];
+         }
+      }
+      I[i+1] = k;
+   }
+
+   if (!active)
+   {
+      int sizes[2] = { nrows, J.Size() };
+      MPI_Send(sizes, 2, MPI_INT, target, 0, comm);
+      MPI_Send(I.GetData(), nrows + 1, MPI_INT, target, 0, comm);
+      MPI_Send(J.GetData(), J.Size(), HYPRE_MPI_INT, target, 0, comm);
+      MPI_Send(data.GetData(), data.Size(), MPI_DOUBLE, target, 0, comm);
+      return;
+   }
+
+   // Append the rows of the other ranks in the group
+   source_offsets.SetSize(next_target - myid + 1);
+   source_offsets[0] = 0;
+   source_offsets[1] = nrows;
+   for (int s = 1; s < next_target - myid; s++)
+   {
+      const int src = myid + s;
+      int sizes[2];
+      MPI_Recv(sizes, 2, MPI_INT, src, 0, comm, MPI_STATUS_IGNORE);
+      const int agg_nrows = I.Size() - 1, agg_nnz = J.Size();
+      source_offsets[s+1] = agg_nrows + sizes[0];
+      I.SetSize(agg_nrows + sizes[0] + 1);
+      J.SetSize(agg_nnz + sizes[1]);
+      data.SetSize(agg_nnz + sizes[1]);
+      MPI_Recv(I.GetData() + agg_nrows, sizes[0] + 1, MPI_INT, src, 0, comm,
+               MPI_STATUS_IGNORE);
+      MPI_Recv(J.GetData() + agg_nnz, sizes[1], HYPRE_MPI_INT, src, 0, comm,
+               MPI_STATUS_IGNORE);
+      MPI_Recv(data.GetData() + agg_nnz, sizes[1], MPI_DOUBLE, src, 0, comm,
+               MPI_STATUS_IGNORE);
+      // The received row offsets start at 0; the first one overwrote the
+      // last offset of the rows already present.
+      for (int i = 0; i <= sizes[0]; i++) { I[agg_nrows + i] += agg_nnz; }
+   }
+
+   // Row partitioning of the agglomerated matrix
+   const int agg_nrows = I.Size() - 1;
+   HYPRE_Int row_start =
+      hypre_ParCSRMatrixFirstRowIndex((hypre_ParCSRMatrix *) A);
+   Array<HYPRE_Int> rows;
+   if (HYPRE_AssumedPartitionCheck())
+   {
+      rows.SetSize(2);
+      rows[0] = row_start;
+      rows[1] = row_start + agg_nrows;
+   }
+   else
+   {
+      int sub_size;
+      MPI_Comm_size(sub_comm, &sub_size);
+      rows.SetSize(sub_size + 1);
+      MPI_Allgather(&row_start, 1, HYPRE_MPI_INT, rows.GetData(), 1,
+                    HYPRE_MPI_INT, sub_comm);
+      rows[sub_size] = glob_size;
+   }
+   A_agg = new HypreParMatrix(sub_comm, agg_nrows, glob_size, glob_size,
+                              I.GetData(), J.GetData(), data.GetData(),
+                              rows.GetData(), rows.GetData());
+}
+
+void HypreAgglomeratedSolver::SetSolver(Solver &s, bool own)
+{
+   if (own_solver) { delete solver; }
+   solver = &s;
+   own_solver = own;
+}
+
+void HypreAgglomeratedSolver::Mult(const Vector &b, Vector &x) const
+{
+   if (!IsActive())
+   {
+      MPI_Send(b.HostRead(), b.Size(), MPI_DOUBLE, target, 0, comm);
+      if (iterative_mode)
+      {
+         MPI_Send(x.HostRead(), x.Size(), MPI_DOUBLE, target, 0, comm);
+      }
+      MPI_Recv(x.HostWrite(), x.Size(), MPI_DOUBLE, target, 0, comm,
+               MPI_STATUS_IGNORE);
+      return;
+   }
+   MFEM_VERIFY(solver, "The solver is not set, see SetSolver().");
+
+   const int num_sources = source_offsets.Size() - 1;
+   b_agg.SetSize(source_offsets[num_sources]);
+   x_agg.SetSize(source_offsets[num_sources]);
+   double *b_data = b_agg.HostWrite();
+   double *x_data = iterative_mode ? x_agg.HostWrite() : NULL;
+   b.HostRead();
+   std::copy(b.GetData(), b.GetData() + b.Size(), b_data);
+   if (iterative_mode)
+   {
+      x.HostRead();
+      std::copy(x.GetData(), x.GetData() + x.Size(), x_data);
+   }
+   for (int s = 1; s < num_sources; s++)
+   {
+      const int size = source_offsets[s+1] - source_offsets[s];
+      MPI_Recv(b_data + source_offsets[s], size, MPI_DOUBLE, target + s, 0,
+               comm, MPI_STATUS_IGNORE);
+      if (iterative_mode)
+      {
+         MPI_Recv(x_data + source_offsets[s], size, MPI_DOUBLE, target + s, 0,
+                  comm, MPI_STATUS_IGNORE);
+      }
+   }
+
+   solver->iterative_mode = iterative_mode;
+   solver->Mult(b_agg, x_agg);
+
+   x_data = x_agg.HostReadWrite();
+   for (int s = 1; s < num_sources; s++)
+   {
+      const int size = source_offsets[s+1] - source_offsets[s];
+      MPI_Send(x_data + source_offsets[s], size, MPI_DOUBLE, target + s, 0,
+               comm);
+   }
+   double *x_own = x.HostWrite();
+   std::copy(x_data, x_data + x.Size(), x_own);
+}
+
+HypreAgglomeratedSolver::~HypreAgglomeratedSolver()
+{
+   delete A_agg;
+   if (own_solver) { delete solver; }
+   if (sub_comm != MPI_COMM_NULL) { MPI_Comm_free(&sub_comm); }
+   MPI_Comm_free(&comm);
+}
+
 HypreLOBPCG::HypreMultiVector::HypreMultiVector(int n, HypreParVector & v,
                                                 mv_InterfaceInterpreter & interpreter)
    : hpv(NULL),
@@ -1216,6 +1216,59 @@ public:
    virtual ~HypreADS();
 };
 
+/** @brief Solver for a square HypreParMatrix agglomerated onto a subset of the
+    ranks of its communicator. */
+/** The rows of the matrix are gathered, in contiguous blocks of ranks, onto
+    min(P, max(1, N/min_dofs)) ranks, where N is the global size and P is the
+    number of ranks, so that each active rank owns (about) @a min_dofs rows or
+    more. The agglomerated matrix lives on the subcommunicator formed by the
+    active ranks and is solved there with the solver given to SetSolver().
+    Mult() gathers the input onto the active ranks and scatters the result
+    back, so that the cost of the solve does not grow with the total number of
+    ranks. This is intended for the coarsest level of a multigrid hierarchy.
+
+    If #iterative_mode is set, the initial guess is gathered as well and the
+    solver is applied in iterative mode. */
+class HypreAgglomeratedSolver : public Solver
+{
+private:
+   MPI_Comm comm;              ///< Duplicate of the communicator of A
+   MPI_Comm sub_comm;
+   int target;                 ///< Rank in comm that receives our rows
+   Array<int> source_offsets;  ///< On active ranks: row offsets of the sources
+   HypreParMatrix *A_agg;
+   Solver *solver;
+   bool own_solver;
+   mutable Vector b_agg, x_agg;
+
+public:
+   /** @brief Agglomerate @a A such that each active rank owns at least
+       @a min_dofs rows. If @a min_dofs <= 0, all ranks remain active. */
+   HypreAgglomeratedSolver(const HypreParMatrix &A, int min_dofs);
+
+   /// Is the calling rank one of the ranks holding the agglomerated matrix?
+   bool IsActive() const { return A_agg != NULL; }
+
+   /// Subcommunicator of the active ranks, MPI_COMM_NULL on inactive ranks.
+   MPI_Comm GetSubComm() const { return sub_comm; }
+
+   /// The agglomerated matrix on the active ranks, NULL on inactive ranks.
+   HypreParMatrix *GetAgglomeratedMatrix() const { return A_agg; }
+
+   /** @brief Set the solver applied on the active ranks, typically constructed
+       from GetAgglomeratedMatrix() and GetSubComm(). */
+   /** This must be called on all active ranks; inactive ranks never use the
+       solver. */
+   void SetSolver(Solver &s, bool own = false);
+
+   virtual void SetOperator(const Operator &op)
+   { mfem_error("HypreAgglomeratedSolver does not support SetOperator!"); }
+
+   virtual void Mult(const Vector &b, Vector &x) const;
+
+   virtual ~HypreAgglomeratedSolver();
+};
+
 /** LOBPCG eigenvalue solver in hypre
 
     The Locally Optimal Block Preconditioned Conjugate Gradient (LOBPCG)
@@ -1372,6 +1372,68 @@ have_aa:
 }
 
 
+/// Compute the LU factorization of the matrix (m x m) stored in @a data, with
+/// partial pivoting, overwriting it with the factors such that L.U = P.A.
+//
+// @param [in, out] data matrix A, and then its LU factorization
+// @param [in] m square matrix height
+// @param [out] ipiv array storing pivot information (0-based)
+// @param [in] TOL pivots not larger than TOL in absolute value are an error
+// @return false if the factorization failed, true otherwise
+MFEM_HOST_DEVICE
+inline bool LUFactor(double *data, const int m, int *ipiv,
+                     const double TOL = 0.0)
+{
+   bool pivot_flag = true;
+   for (int i = 0; i < m; i++)
+   {
+      // pivoting
+      {
+         int piv = i;
+         double a = fabs(data[piv+i*m]);
+         for (int j = i+1; j < m; j++)
+         {
+            const double b = fabs(data[j+i*m]);
+            if (b > a)
+            {
+               a = b;
+               piv = j;
+            }
+         }
+         ipiv[i] = piv;
+         if (piv != i)
+         {
+            // swap rows i and piv in both L and U parts
+            for (int j = 0; j < m; j++)
+            {
+               internal::Swap<double>(data[i+j*m], data[piv+j*m]);
+            }
+         }
+      } // pivot end
+
+      if (fabs(data[i+i*m]) <= TOL)
+      {
+         pivot_flag = false;
+      }
+
+      const double a_ii_inv = 1.0 / data[i+i*m];
+      for (int j = i+1; j < m; j++)
+      {
+         data[j+i*m] *= a_ii_inv;
+      }
+
+      for (int k = i+1; k < m; k++)
+      {
+         const double a_ik = data[i+k*m];
+         for (int j = i+1; j < m; j++)
+         {
+            data[j+k*m] -= a_ik * data[j+i*m];
+         }
+      }
+   } // m loop
+   return pivot_flag;
+}
+
 /// Assuming L.U = P.A for a factored matrix (m x m),
 //  compute x <- A x
 //
@@ -1410,6 +1472,69 @@ inline void LUSolve(const double *data, const int m, const int *ipiv,
    }
 }
 
+/// Compute the Cholesky factorization A = L.L^t of the symmetric positive
+/// definite matrix (m x m) stored in @a data, overwriting its lower triangle
+/// with L. The strictly upper triangle is not referenced.
+//
+// @param [in, out] data matrix A, and then its Cholesky factor
+// @param [in] m square matrix height
+// @return false if A is not numerically positive definite, true otherwise
+MFEM_HOST_DEVICE
+inline bool CholeskyFactor(double *data, const int m)
+{
+   for (int j = 0; j < m; j++)
+   {
+      const double a_jj = data[j+j*m];
+      if (!(a_jj > 0.0)) { return false; }
+      const double l_jj = sqrt(a_jj);
+      data[j+j*m] = l_jj;
+      const double l_jj_inv = 1.0 / l_jj;
+      for (int i = j+1; i < m; i++)
+      {
+         data[i+j*m] *= l_jj_inv;
+      }
+      for (int k = j+1; k < m; k++)
+      {
+         const double l_kj = data[k+j*m];
+         for (int i = k; i < m; i++)
+         {
+            data[i+k*m] -= data[i+j*m] * l_kj;
+         }
+      }
+   }
+   return true;
+}
+
+/// Assuming L.L^t = A for a factored matrix (m x m), compute x <- A^{-1} x
+//
+// @param [in] data Cholesky factorization of A, see CholeskyFactor()
+// @param [in] m square matrix height
+// @param [in, out] x vector storing right-hand side and then solution
+MFEM_HOST_DEVICE
+inline void CholeskySolve(const double *data, const int m, double *x)
+{
+   // X <- L^{-1} X
+   for (int j = 0; j < m; j++)
+   {
+      const double x_j = (x[j] /= data[j+j*m]);
+      for (int i = j+1; i < m; i++)
+      {
+         x[i] -= data[i+j*m] * x_j;
+      }
+   }
+
+   // X <- L^{-t} X
+   for (int j = m-1; j >= 0; j--)
+   {
+      double x_j = x[j];
+      for (int i = j+1; i < m; i++)
+      {
+         x_j -= data[i+j*m] * x[i];
+      }
+      x[j] = x_j / data[j+j*m];
+   }
+}
+
 } // namespace kernels
 
 } // namespace mfem
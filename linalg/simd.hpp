@@ -13,6 +13,8 @@
 #define MFEM_SIMD_HPP
 
 #include "../config/tconfig.hpp"
+#include <cstdint>
+#include <vector>
 
 // --- AutoSIMD + specializations with intrinsics
 #include "simd/auto.hpp"
@@ -53,6 +55,20 @@
 #define MFEM_ALIGN_BYTES 32
 #endif
 
+// MFEM_SIMD_DISPATCH is defined when host kernels can be compiled for several
+// x86 instruction sets in the same translation unit, using the GCC/Clang
+// 'target' function attribute. Such kernels provide a variant for each of the
+// MFEM_SIMD_TARGET_* macros below, and select one at runtime based on
+// Device::GetSimdBytes(), see e.g. SimdPAMassApply3D in
+// fem/bilininteg_mass_pa.cpp. The kernel body has to be inlined in the
+// variant, so that it is compiled with the target instruction set.
+#if defined(__x86_64__) && defined(__GNUC__) && \
+    !defined(__CUDACC__) && !defined(__HIPCC__)
+#define MFEM_SIMD_DISPATCH
+#define MFEM_SIMD_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define MFEM_SIMD_TARGET_AVX512 __attribute__((target("avx512f,fma")))
+#endif
+
 // derived macros
 #define MFEM_ROUNDUP(val,base) ((((val)+(base)-1)/(base))*(base))
 #define MFEM_ALIGN_SIZE(size,type) \
@@ -61,6 +77,21 @@
 namespace mfem
 {
 
+/** @brief Return a pointer to @a n entries of type @a vreal_t, an AutoSIMD
+    type, stored in @a buf and aligned to the size of @a vreal_t. */
+/** The size of @a buf is increased as needed, so that one buffer can be reused
+    by the SIMD host kernels across batches of elements. */
+template <typename vreal_t>
+inline vreal_t *AlignedSimdArray(std::vector<double> &buf, const int n)
+{
+   const int VS = sizeof(vreal_t)/sizeof(double);
+   if (buf.size() < (size_t) ((n + 1)*VS)) { buf.resize((n + 1)*VS); }
+   const std::uintptr_t align = sizeof(vreal_t);
+   return reinterpret_cast<vreal_t*>(
+             MFEM_ROUNDUP(reinterpret_cast<std::uintptr_t>(buf.data()),
+                          align));
+}
+
 template<typename complex_t, typename real_t>
 struct AutoSIMDTraits
 {
@@ -39,12 +39,7 @@ struct MFEM_AUTOSIMD_ALIGN__ AutoSIMD
       return vec[i];
    }
 
-   inline MFEM_ALWAYS_INLINE AutoSIMD &operator=(const AutoSIMD &v)
-   {
-      MFEM_VECTORIZE_LOOP
-      for (int i = 0; i < size; i++) { vec[i] = v[i]; }
-      return *this;
-   }
+   AutoSIMD &operator=(const AutoSIMD &) = default;
 
    inline MFEM_ALWAYS_INLINE AutoSIMD &operator=(const scalar_t &e)
    {
@@ -48,11 +48,7 @@ template <> struct AutoSIMD<double,4,32>
       return vec[i];
    }
 
-   inline MFEM_ALWAYS_INLINE AutoSIMD &operator=(const AutoSIMD &v)
-   {
-      m256d = v.m256d;
-      return *this;
-   }
+   AutoSIMD &operator=(const AutoSIMD &) = default;
 
    inline MFEM_ALWAYS_INLINE AutoSIMD &operator=(const double &e)
    {
@@ -49,11 +49,7 @@ template <> struct AutoSIMD<double,8,64>
       return vec[i];
    }
 
-   inline MFEM_ALWAYS_INLINE AutoSIMD &operator=(const AutoSIMD &v)
-   {
-      m512d = v.m512d;
-      return *this;
-   }
+   AutoSIMD &operator=(const AutoSIMD &) = default;
 
    inline MFEM_ALWAYS_INLINE AutoSIMD &operator=(const double &e)
    {
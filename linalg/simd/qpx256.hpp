@@ -38,11 +38,7 @@ template <> struct AutoSIMD<double,4,32>
 
    inline __ATTRS_ai const double &operator[](int i) const { return vec[i]; }
 
-   inline __ATTRS_ai AutoSIMD &operator=(const AutoSIMD &v)
-   {
-      vd = v.vd;
-      return *this;
-   }
+   AutoSIMD &operator=(const AutoSIMD &) = default;
 
    inline __ATTRS_ai AutoSIMD &operator=(const double &e)
    {
@@ -44,11 +44,7 @@ template <> struct AutoSIMD<double,2,16>
       return vec[i];
    }
 
-   inline MFEM_ALWAYS_INLINE AutoSIMD &operator=(const AutoSIMD &v)
-   {
-      vd = v.vd;
-      return *this;
-   }
+   AutoSIMD &operator=(const AutoSIMD &) = default;
 
    inline MFEM_ALWAYS_INLINE AutoSIMD &operator=(const double &e)
    {
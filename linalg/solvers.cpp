@@ -525,6 +525,77 @@ void SLI(const Operator &A, Solver &B, const Vector &b, Vector &x,
 }
 
 
+void IterativeRefinementSolver::UpdateVectors()
+{
+   r.SetSize(width);
+   z.SetSize(width);
+}
+
+void IterativeRefinementSolver::Mult(const Vector &b, Vector &x) const
+{
+   MFEM_VERIFY(inner != NULL, "the inner solver is not set");
+   double nom, nom0, r0;
+
+   if (iterative_mode)
+   {
+      oper->Mult(x, r);
+      subtract(b, r, r); // r = b - A x
+   }
+   else
+   {
+      r = b;
+      x = 0.0;
+   }
+   nom0 = nom = Norm(r);
+   MFEM_ASSERT(IsFinite(nom), "nom = " << nom);
+   if (print_level == 1)
+   {
+      mfem::out << "   Iteration : " << setw(3) << 0 << "  ||r|| = "
+                << nom << '\n';
+   }
+   Monitor(0, nom, r, x);
+
+   r0 = std::max(nom*rel_tol, abs_tol);
+   converged = 0;
+   final_iter = 0;
+   for (int i = 1; nom > r0 && i <= max_iter; i++)
+   {
+      inner->Mult(r, z); // z ~ A^{-1} r
+      x += z;
+      oper->Mult(x, r);
+      subtract(b, r, r); // r = b - A x
+      const double nomold = nom;
+      nom = Norm(r);
+      MFEM_ASSERT(IsFinite(nom), "nom = " << nom);
+      final_iter = i;
+      if (print_level == 1)
+      {
+         mfem::out << "   Iteration : " << setw(3) << i << "  ||r|| = "
+                   << nom << "\tConv. rate: " << nom/nomold << '\n';
+      }
+      Monitor(i, nom, r, x);
+   }
+   converged = (nom <= r0);
+   final_norm = nom;
+   Monitor(final_iter, nom, r, x, true);
+
+   if (print_level == 2)
+   {
+      mfem::out << "Number of IR iterations: " << final_iter << '\n';
+   }
+   else if (print_level == 3)
+   {
+      mfem::out << "||r_0|| = " << nom0 << '\n'
+                << "||r_N|| = " << nom << '\n'
+                << "Number of IR iterations: " << final_iter << '\n';
+   }
+   if (print_level >= 0 && !converged)
+   {
+      mfem::err << "IR: No convergence!" << '\n';
+   }
+}
+
+
 void CGSolver::UpdateVectors()
 {
    r.SetSize(width);
@@ -2558,12 +2629,12 @@ void BlockILU::Factorize()
 {
    int nblockrows = Height()/block_size;
 
-   // Precompute LU factorization of diagonal blocks
-   for (int i=0; i<nblockrows; ++i)
-   {
-      LUFactors factorization(DB.GetData(i), &ipiv[i*block_size]);
-      factorization.Factor(block_size);
-   }
+   // Precompute LU factorization of diagonal blocks, as a batch. The pivots
+   // are then converted to the convention of LUFactors, used below.
+   BatchLUFactor(DB, ipiv);
+   DB.HostReadWrite();
+   int *h_ipiv = ipiv.HostReadWrite();
+   for (int i=0; i<ipiv.Size(); ++i) { h_ipiv[i] += LUFactors::ipiv_base; }
 
    // Note: we use UseExternalData to extract submatrices from the tensor AB
    // instead of the DenseTensor call operator, because the call operator does
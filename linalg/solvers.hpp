@@ -254,6 +254,46 @@ void SLI(const Operator &A, Solver &B, const Vector &b, Vector &x,
          double RTOLERANCE = 1e-12, double ATOLERANCE = 1e-24);
 
 
+/// Iterative refinement: x <- x + S (b - A x), with an inexact inner solver S
+/** The residual b - A x is computed with the operator A given to
+    SetOperator(), e.g. a double precision operator, while the inner solver S,
+    given to SetInnerSolver(), only needs to reduce the residual by a moderate
+    factor. Typically S is a CGSolver with a loose relative tolerance (e.g.
+    1e-3), applied to a cheaper, lower precision version of A, such as a
+    partially assembled form whose integrators use single precision storage,
+    see MassIntegrator::SetSinglePrecisionPA(). The final accuracy is then
+    limited only by the precision of A.
+
+    The iteration stops when the norm of the true residual, ||b - A x||, is
+    below max(rel_tol ||b - A x_0||, abs_tol). The inner solver keeps its own
+    operator; it is not reset by SetOperator(), unlike preconditioners. */
+class IterativeRefinementSolver : public IterativeSolver
+{
+protected:
+   Solver *inner;
+   mutable Vector r, z;
+
+   void UpdateVectors();
+
+public:
+   IterativeRefinementSolver() : inner(NULL) { }
+
+#ifdef MFEM_USE_MPI
+   IterativeRefinementSolver(MPI_Comm _comm)
+      : IterativeSolver(_comm), inner(NULL) { }
+#endif
+
+   /// Set the inner solver, applied to the residual in each iteration.
+   /** The inner solver is used with a zero initial guess. */
+   void SetInnerSolver(Solver &s) { inner = &s; inner->iterative_mode = false; }
+
+   virtual void SetOperator(const Operator &op)
+   { IterativeSolver::SetOperator(op); UpdateVectors(); }
+
+   virtual void Mult(const Vector &b, Vector &x) const;
+};
+
+
 /// Conjugate gradient method
 class CGSolver : public IterativeSolver
 {
@@ -14,6 +14,7 @@
 #include "kernels.hpp"
 #include "vector.hpp"
 #include "../general/forall.hpp"
+#include "../general/binaryio.hpp"
 
 #if defined(MFEM_USE_SUNDIALS)
 #include "sundials.hpp"
@@ -32,6 +33,8 @@
 #include <cstdlib>
 #include <ctime>
 #include <limits>
+#include <cstring>
+#include <cstdint>
 
 namespace mfem
 {
@@ -98,6 +101,35 @@ void Vector::Load(std::istream &in, int Size)
    }
 }
 
+void Vector::LoadBinary(std::istream &in, int Size)
+{
+   const int64_t s = bin_io::read<int64_t>(in);
+   MFEM_VERIFY(in && s == Size, "invalid binary vector data");
+
+   const size_t nbytes = sizeof(double)*Size;
+   mapped_ifstream *min = dynamic_cast<mapped_ifstream*>(&in);
+   if (min && Size > 0)
+   {
+      char *ptr = min->Map(nbytes);
+      MFEM_VERIFY(ptr, "unexpected end of binary vector data");
+      if (reinterpret_cast<uintptr_t>(ptr) % alignof(double) == 0)
+      {
+         const bool use_dev = UseDevice();
+         NewDataAndSize(reinterpret_cast<double*>(ptr), Size);
+         UseDevice(use_dev);
+      }
+      else
+      {
+         SetSize(Size);
+         std::memcpy(HostWrite(), ptr, nbytes);
+      }
+      return;
+   }
+   SetSize(Size);
+   in.read(reinterpret_cast<char*>(HostWrite()), nbytes);
+   MFEM_VERIFY(in, "unexpected end of binary vector data");
+}
+
 double &Vector::Elem(int i)
 {
    return operator()(i);
@@ -726,6 +758,12 @@ void Vector::Print_HYPRE(std::ostream &out) const
    out.flags(old_fmt);
 }
 
+void Vector::PrintBinary(std::ostream &out) const
+{
+   bin_io::write<int64_t>(out, size);
+   out.write(reinterpret_cast<const char*>(HostRead()), sizeof(double)*size);
+}
+
 void Vector::Randomize(int seed)
 {
    // static unsigned int seed = time(0);
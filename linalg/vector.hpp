@@ -109,6 +109,12 @@ public:
    /// Load a vector from an input stream, reading the size from the stream.
    void Load(std::istream &in) { int s; in >> s; Load(in, s); }
 
+   /** @brief Load a vector of size @a Size written with PrintBinary() from an
+       input stream. */
+   /** If @a in is a mfem::mapped_ifstream and the data is suitably aligned,
+       the Vector references the mapped data without copying it. */
+   void LoadBinary(std::istream &in, int Size);
+
    /// @brief Resize the vector to size @a s.
    /** If the new size is less than or equal to Capacity() then the internal
        data array remains the same. Otherwise, the old array is deleted, if
@@ -349,6 +355,10 @@ public:
    /// Prints vector to stream out in HYPRE_Vector format.
    void Print_HYPRE(std::ostream &out) const;
 
+   /** @brief Write the vector to stream out in binary format: the size as a
+       64-bit integer followed by the raw (native endian) values. */
+   void PrintBinary(std::ostream &out) const;
+
    /// Set random values in the vector.
    void Randomize(int seed = 0);
    /// Returns the l2 norm of the vector.
@@ -342,7 +342,8 @@ FiniteElement *Mesh::GetTransformationFEforElementType(Element::Type ElemType)
 }
 
 
-void Mesh::GetElementTransformation(int i, IsoparametricTransformation *ElTr)
+void Mesh::GetElementTransformation(int i,
+                                    IsoparametricTransformation *ElTr) const
 {
    ElTr->Attribute = GetAttribute(i);
    ElTr->ElementNo = i;
@@ -356,7 +357,10 @@ void Mesh::GetElementTransformation(int i, IsoparametricTransformation *ElTr)
    else
    {
       DenseMatrix &pm = ElTr->GetPointMat();
-      Array<int> vdofs;
+      // The vdofs of low order elements are kept on the stack
+      const int max_vdofs = 3*64;
+      int vdofs_data[max_vdofs];
+      Array<int> vdofs(vdofs_data, max_vdofs);
       Nodes->FESpace()->GetElementVDofs(i, vdofs);
       Nodes->HostRead();
       const GridFunction &nodes = *Nodes;
@@ -374,7 +378,7 @@ void Mesh::GetElementTransformation(int i, IsoparametricTransformation *ElTr)
 }
 
 void Mesh::GetElementTransformation(int i, const Vector &nodes,
-                                    IsoparametricTransformation *ElTr)
+                                    IsoparametricTransformation *ElTr) const
 {
    ElTr->Attribute = GetAttribute(i);
    ElTr->ElementNo = i;
@@ -3457,6 +3461,8 @@ void Mesh::Loader(std::istream &input, int generate_edges,
    bool mfem_v10 = (mesh_type == "MFEM mesh v1.0");
    bool mfem_v11 = (mesh_type == "MFEM mesh v1.1");
    bool mfem_v12 = (mesh_type == "MFEM mesh v1.2");
+   // The binary format header line is padded with spaces
+   bool mfem_bin = (mesh_type.compare(0, 21, "MFEM binary mesh v1.0") == 0);
    if (mfem_v10 || mfem_v11 || mfem_v12) // MFEM's own mesh formats
    {
       // Formats mfem_v12 and newer have a tag indicating the end of the mesh
@@ -3469,6 +3475,11 @@ void Mesh::Loader(std::istream &input, int generate_edges,
       }
       ReadMFEMMesh(input, mfem_v11, curved);
    }
+   else if (mfem_bin) // MFEM's binary mesh format, always ends with a tag
+   {
+      if (parse_tag.empty()) { parse_tag = "mfem_mesh_end"; }
+      ReadMFEMBinaryMesh(input, curved);
+   }
    else if (mesh_type == "linemesh") // 1D mesh
    {
       ReadLineMesh(input);
@@ -3581,7 +3592,7 @@ void Mesh::Loader(std::istream &input, int generate_edges,
 
    // If a parse tag was supplied, keep reading the stream until the tag is
    // encountered.
-   if (mfem_v12)
+   if (mfem_v12 || mfem_bin)
    {
       string line;
       do
@@ -8824,6 +8835,75 @@ void Mesh::Printer(std::ostream &out, std::string section_delimiter) const
    }
 }
 
+static void PrintBinaryElements(std::ostream &out, const Array<Element*> &elem,
+                                int num_elem)
+{
+   Array<int> geom(num_elem), attr(num_elem), verts;
+   for (int i = 0; i < num_elem; i++)
+   {
+      geom[i] = elem[i]->GetGeometryType();
+      attr[i] = elem[i]->GetAttribute();
+      verts.Append(elem[i]->GetVertices(), elem[i]->GetNVertices());
+   }
+   bin_io::WritePadded(out, geom.GetData(), geom.Size());
+   bin_io::WritePadded(out, attr.GetData(), attr.Size());
+   bin_io::WritePadded(out, verts.GetData(), verts.Size());
+}
+
+void Mesh::BinaryPrinter(std::ostream &out, std::string section_delimiter) const
+{
+   if (NURBSext)
+   {
+      Printer(out, section_delimiter);
+      return;
+   }
+
+   std::string nc_text;
+   if (ncmesh)
+   {
+      std::ostringstream nc_out;
+      nc_out << "vertex_parents\n";
+      ncmesh->PrintVertexParents(nc_out);
+      nc_out << "\ncoarse_elements\n";
+      ncmesh->PrintCoarseElements(nc_out);
+      nc_text = nc_out.str();
+   }
+
+   bin_io::WritePaddedLine(out, "MFEM binary mesh v1.0");
+   // The first entry is used to detect files written with a different byte
+   // order.
+   const int64_t header[8] =
+   {
+      0x0102030405060708LL, Dim, spaceDim, NumOfVertices, NumOfElements,
+      NumOfBdrElements, Nodes ? 1 : 0, int64_t(nc_text.size())
+   };
+   bin_io::WritePadded(out, header, 8);
+
+   PrintBinaryElements(out, elements, NumOfElements);
+   PrintBinaryElements(out, boundary, NumOfBdrElements);
+   bin_io::WritePadded(out, nc_text.data(), nc_text.size());
+
+   if (Nodes == NULL)
+   {
+      Array<double> coords(NumOfVertices*spaceDim);
+      for (int i = 0; i < NumOfVertices; i++)
+      {
+         for (int j = 0; j < spaceDim; j++)
+         {
+            coords[i*spaceDim + j] = vertices[i](j);
+         }
+      }
+      bin_io::WritePadded(out, coords.GetData(), coords.Size());
+   }
+   else
+   {
+      Nodes->SaveBinary(out);
+   }
+
+   out << '\n' << (section_delimiter.empty() ? "mfem_mesh_end" :
+                   section_delimiter) << endl;
+}
+
 void Mesh::PrintTopo(std::ostream &out,const Array<int> &e_to_k) const
 {
    int i;
@@ -10707,6 +10787,24 @@ GeometricFactors::GeometricFactors(const Mesh *mesh, const IntegrationRule &ir,
    computed_factors = flags;
 
    const GridFunction *nodes = mesh->GetNodes();
+   H1_FECollection *lin_fec = NULL;
+   FiniteElementSpace *lin_fes = NULL;
+   GridFunction lin_nodes;
+   if (nodes == NULL)
+   {
+      // The vertices are the dofs of the lowest order H1 space
+      const int NV = mesh->GetNV();
+      const int sdim = mesh->SpaceDimension();
+      lin_fec = new H1_FECollection(1, mesh->Dimension());
+      lin_fes = new FiniteElementSpace(const_cast<Mesh*>(mesh), lin_fec, sdim);
+      lin_nodes.SetSpace(lin_fes);
+      for (int i = 0; i < NV; i++)
+      {
+         const double *v = mesh->GetVertex(i);
+         for (int d = 0; d < sdim; d++) { lin_nodes(d*NV + i) = v[d]; }
+      }
+      nodes = &lin_nodes;
+   }
    const FiniteElementSpace *fespace = nodes->FESpace();
    const FiniteElement *fe = fespace->GetFE(0);
    const int dim  = fe->GetDim();
@@ -10750,6 +10848,8 @@ GeometricFactors::GeometricFactors(const Mesh *mesh, const IntegrationRule &ir,
    {
       qi->Mult(*nodes, eval_flags, X, J, detJ);
    }
+   delete lin_fes;
+   delete lin_fec;
 }
 
 FaceGeometricFactors::FaceGeometricFactors(const Mesh *mesh,
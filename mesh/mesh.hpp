@@ -235,6 +235,7 @@ protected:
    // Readers for different mesh formats, used in the Load() method.
    // The implementations of these methods are in mesh_readers.cpp.
    void ReadMFEMMesh(std::istream &input, bool mfem_v11, int &curved);
+   void ReadMFEMBinaryMesh(std::istream &input, int &curved);
    void ReadLineMesh(std::istream &input);
    void ReadNetgen2DMesh(std::istream &input, int &curved);
    void ReadNetgen3DMesh(std::istream &input);
@@ -437,6 +438,12 @@ protected:
    void Printer(std::ostream &out = mfem::out,
                 std::string section_delimiter = "") const;
 
+   // Write the "MFEM binary mesh v1.0" format, ended by the given
+   // section_delimiter, or by "mfem_mesh_end" if it is empty. NURBS meshes are
+   // written in the text NURBS format.
+   void BinaryPrinter(std::ostream &out,
+                      std::string section_delimiter = "") const;
+
    /** Creates mesh for the parallelepiped [0,sx]x[0,sy]x[0,sz], divided into
        nx*ny*nz hexahedra if type=HEXAHEDRON or into 6*nx*ny*nz tetrahedrons if
        type=TETRAHEDRON. The parameter @a sfc_ordering controls how the elements
@@ -949,9 +956,16 @@ public:
 
    static FiniteElement *GetTransformationFEforElementType(Element::Type);
 
-   /** Builds the transformation defining the i-th element in the user-defined
-       variable. */
-   void GetElementTransformation(int i, IsoparametricTransformation *ElTr);
+   /** @brief Builds the transformation defining the i-th element in the
+       user-defined variable @a ElTr.
+
+       Unlike GetElementTransformation(int), this method does not modify the
+       mesh, so it can be called concurrently (e.g. from OpenMP threads) as long
+       as each thread uses its own @a ElTr and the mesh nodes, if any, are
+       valid on the host. With the tensor product H1 nodes of order up to 3,
+       repeated calls with the same @a ElTr do not allocate memory. */
+   void GetElementTransformation(int i,
+                                 IsoparametricTransformation *ElTr) const;
 
    /// Returns the transformation defining the i-th element
    ElementTransformation *GetElementTransformation(int i);
@@ -959,7 +973,7 @@ public:
    /** Return the transformation defining the i-th element assuming
        the position of the vertices/nodes are given by 'nodes'. */
    void GetElementTransformation(int i, const Vector &nodes,
-                                 IsoparametricTransformation *ElTr);
+                                 IsoparametricTransformation *ElTr) const;
 
    /// Returns the transformation defining the i-th boundary element
    ElementTransformation * GetBdrElementTransformation(int i);
@@ -1238,6 +1252,15 @@ public:
    /// \see mfem::ofgzstream() for on-the-fly compression of ascii outputs
    virtual void Print(std::ostream &out = mfem::out) const { Printer(out); }
 
+   /** @brief Print the mesh to the given stream using the binary MFEM mesh
+       format. */
+   /** The binary format stores the same data as the text format, including
+       the NCMesh refinement hierarchy and the Nodes (saved with
+       GridFunction::SaveBinary()), in native byte order. It is read by the
+       same constructors and methods as the text formats. When read from a
+       mfem::mapped_ifstream, the values of the Nodes are not copied. */
+   void PrintBinary(std::ostream &out) const { BinaryPrinter(out); }
+
    /// Print the mesh to the given stream using the adios2 bp format
 #ifdef MFEM_USE_ADIOS2
    virtual void Print(adios2stream &out) const;
@@ -1410,6 +1433,10 @@ public:
       DETERMINANTS = 1 << 2,
    };
 
+   /** @brief Compute the factors given by @a flags at the points of @a ir in
+       all elements of @a mesh. */
+   /** If @a mesh does not have nodes, a temporary linear nodal GridFunction is
+       built from its vertices, i.e. the mesh is not modified. */
    GeometricFactors(const Mesh *mesh, const IntegrationRule &ir, int flags);
 
    /// Mapped (physical) coordinates of all quadrature points.
@@ -67,6 +67,9 @@ ThresholdRefiner::ThresholdRefiner(ErrorEstimator &est)
 
    non_conforming = -1;
    nc_limit = 0;
+
+   marking = THRESHOLD_MARKING;
+   marking_fraction = 0.5;
 }
 
 double ThresholdRefiner::GetNorm(const Vector &local_err, Mesh &mesh) const
@@ -81,6 +84,106 @@ double ThresholdRefiner::GetNorm(const Vector &local_err, Mesh &mesh) const
    return local_err.Normlp(total_norm_p);
 }
 
+// Sum (or maximize, if 'max' is true) the 'n' values in 'data' over all
+// processors of a parallel mesh. Nothing to do for a serial mesh.
+static void ReduceValues(Mesh &mesh, double *data, int n, bool max)
+{
+#ifdef MFEM_USE_MPI
+   ParMesh *pmesh = dynamic_cast<ParMesh*>(&mesh);
+   if (pmesh)
+   {
+      MPI_Allreduce(MPI_IN_PLACE, data, n, MPI_DOUBLE, max ? MPI_MAX : MPI_SUM,
+                    pmesh->GetComm());
+   }
+#else
+   MFEM_CONTRACT_VAR(mesh);
+   MFEM_CONTRACT_VAR(data);
+   MFEM_CONTRACT_VAR(n);
+   MFEM_CONTRACT_VAR(max);
+#endif
+}
+
+// Histogram bin of the value 'e' for bins of width 'h' starting at 'lo'.
+static inline int HistogramBin(double e, double lo, double h, int nbins)
+{
+   int b = int((e - lo) / h);
+   return std::min(std::max(b, 0), nbins-1);
+}
+
+double ThresholdRefiner::SelectThreshold(const Vector &local_err,
+                                         Mesh &mesh) const
+{
+   const bool dorfler = (marking == DORFLER_MARKING);
+   const int nbins = 64, max_rounds = 16;
+   const int NE = local_err.Size();
+
+   // global range of the errors and the total weight to be marked; the
+   // weight of an element is its squared error (Dorfler) or one (fraction)
+   double range[2] = { -infinity(), -infinity() };
+   double total = 0.0;
+   for (int i = 0; i < NE; i++)
+   {
+      const double e = local_err(i);
+      range[0] = std::max(range[0], e);
+      range[1] = std::max(range[1], -e);
+      total += dorfler ? e*e : 1.0;
+   }
+   ReduceValues(mesh, range, 2, true);
+   ReduceValues(mesh, &total, 1, false);
+
+   double lo = -range[1], hi = range[0];
+   const double target = marking_fraction * total;
+
+   // The elements are split into three groups: 'above' (marked), candidates
+   // in [lo, hi], and 'below' (not marked). In each round, the histogram of
+   // the candidates is summed over all processors, and only the candidates
+   // in the bin where the marked weight reaches the target are kept.
+   Array<double> cand(NE);
+   for (int i = 0; i < NE; i++) { cand[i] = local_err(i); }
+
+   double above = 0.0, below_max = -infinity();
+   Vector hist(2*nbins); // weights and counts of the bins
+
+   for (int round = 0; round < max_rounds && lo < hi; round++)
+   {
+      const double h = (hi - lo) / nbins;
+
+      hist = 0.0;
+      for (int i = 0; i < cand.Size(); i++)
+      {
+         const int b = HistogramBin(cand[i], lo, h, nbins);
+         hist(b) += dorfler ? cand[i]*cand[i] : 1.0;
+         hist(nbins + b) += 1.0;
+      }
+      ReduceValues(mesh, hist.GetData(), 2*nbins, false);
+
+      int bin = nbins-1;
+      while (bin > 0 && above + hist(bin) < target)
+      {
+         above += hist(bin--);
+      }
+
+      int j = 0;
+      for (int i = 0; i < cand.Size(); i++)
+      {
+         const int b = HistogramBin(cand[i], lo, h, nbins);
+         if (b == bin) { cand[j++] = cand[i]; }
+         else if (b < bin) { below_max = std::max(below_max, cand[i]); }
+      }
+      cand.SetSize(j);
+
+      if (bin < nbins-1) { hi = lo + (bin+1)*h; }
+      lo += bin*h;
+
+      if (hist(nbins + bin) <= 1.0) { break; }
+   }
+
+   // the remaining candidates are marked, the threshold is the largest error
+   // of the elements that are not marked
+   ReduceValues(mesh, &below_max, 1, true);
+   return below_max;
+}
+
 int ThresholdRefiner::ApplyImpl(Mesh &mesh)
 {
    threshold = 0.0;
@@ -98,7 +201,11 @@ int ThresholdRefiner::ApplyImpl(Mesh &mesh)
    const double total_err = GetNorm(local_err, mesh);
    if (total_err <= total_err_goal) { return STOP; }
 
-   if (total_norm_p < infinity())
+   if (marking != THRESHOLD_MARKING)
+   {
+      threshold = std::max(SelectThreshold(local_err, mesh), local_err_goal);
+   }
+   else if (total_norm_p < infinity())
    {
       threshold = std::max(total_err * total_fraction *
                            std::pow(num_elements, -1.0/total_norm_p),
@@ -163,7 +270,9 @@ int Rebalancer::ApplyImpl(Mesh &mesh)
    ParMesh *pmesh = dynamic_cast<ParMesh*>(&mesh);
    if (pmesh && pmesh->Nonconforming())
    {
-      pmesh->Rebalance();
+      if (elem_weights) { pmesh->Rebalance(*elem_weights); }
+      else { pmesh->Rebalance(); }
+      imbalance = pmesh->GetRebalanceImbalance();
       return CONTINUE + REBALANCED;
    }
 #endif
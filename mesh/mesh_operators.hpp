@@ -190,14 +190,32 @@ protected:
    int non_conforming;
    int nc_limit;
 
+   int marking;           ///< one of the MarkingStrategy values
+   double marking_fraction;
+
    double GetNorm(const Vector &local_err, Mesh &mesh) const;
 
+   /** @brief Find the threshold for the Dorfler or fixed fraction marking,
+       see SetDorflerMarking() and SetFixedFractionMarking().
+
+       The threshold is found by a distributed bisection using histograms of
+       the local errors, without sorting or gathering the errors. */
+   double SelectThreshold(const Vector &local_err, Mesh &mesh) const;
+
    /** @brief Apply the operator to the mesh.
        @return STOP if a stopping criterion is satisfied or no elements were
        marked for refinement; REFINED + CONTINUE otherwise. */
    virtual int ApplyImpl(Mesh &mesh);
 
 public:
+   /// Strategies for selecting the elements to be refined.
+   enum MarkingStrategy
+   {
+      THRESHOLD_MARKING, ///< threshold based on the total error (default)
+      DORFLER_MARKING,   ///< bulk marking of a fraction of the total error
+      FRACTION_MARKING   ///< marking of a fraction of the elements
+   };
+
    /// Construct a ThresholdRefiner using the given ErrorEstimator.
    ThresholdRefiner(ErrorEstimator &est);
 
@@ -224,6 +242,33 @@ public:
        computation. */
    void SetLocalErrorGoal(double err_goal) { local_err_goal = err_goal; }
 
+   /** @brief Use Dorfler (bulk) marking: mark the smallest set of elements
+       with the largest errors whose sum of squared errors is at least
+       @a theta times the total sum of squared errors.
+       @note The total error fraction and the norm p do not affect the marking
+       in this case, the local error goal still applies. */
+   void SetDorflerMarking(double theta)
+   {
+      MFEM_VERIFY(theta > 0.0 && theta <= 1.0, "invalid theta = " << theta);
+      marking = DORFLER_MARKING;
+      marking_fraction = theta;
+   }
+
+   /** @brief Mark the given fraction of all elements, the ones with the
+       largest errors.
+       @note The total error fraction and the norm p do not affect the marking
+       in this case, the local error goal still applies. */
+   void SetFixedFractionMarking(double fraction)
+   {
+      MFEM_VERIFY(fraction > 0.0 && fraction <= 1.0,
+                  "invalid fraction = " << fraction);
+      marking = FRACTION_MARKING;
+      marking_fraction = fraction;
+   }
+
+   /// Use the default marking, see SetTotalErrorFraction().
+   void SetThresholdMarking() { marking = THRESHOLD_MARKING; }
+
    /** @brief Set the maximum number of elements stopping criterion: stop when
        the input mesh has num_elements >= max_elem. The default value is
        LONG_MAX. */
@@ -254,8 +299,6 @@ public:
    virtual void Reset();
 };
 
-// TODO: BulkRefiner to refine a portion of the global error
-
 
 /** @brief De-refinement operator using an error threshold.
 
@@ -315,12 +358,28 @@ public:
 class Rebalancer : public MeshOperator
 {
 protected:
+   const Vector *elem_weights;
+   double imbalance;
+
    /** @brief Rebalance a parallel mesh (only non-conforming parallel meshes are
        supported).
        @return CONTINUE + REBALANCE on success, NONE otherwise. */
    virtual int ApplyImpl(Mesh &mesh);
 
 public:
+   Rebalancer() : elem_weights(NULL), imbalance(1.0) { }
+
+   /** @brief Balance the total weight of the elements instead of their
+       number, see ParMesh::Rebalance(const Vector &).
+
+       The Vector is referenced, not copied. When the operator is applied it
+       must contain one weight for each local element of the mesh. Pass NULL
+       to balance the number of elements again. */
+   void SetElementWeights(const Vector *weights) { elem_weights = weights; }
+
+   /// Return the load imbalance (maximum/average) after the last rebalancing.
+   double GetImbalance() const { return imbalance; }
+
    /// Empty.
    virtual void Reset() { }
 };
@@ -12,10 +12,12 @@
 #include "mesh_headers.hpp"
 #include "../fem/fem.hpp"
 #include "../general/text.hpp"
+#include "../general/binaryio.hpp"
 #include "gmsh.hpp"
 
 #include <iostream>
 #include <cstdio>
+#include <sstream>
 
 #ifdef MFEM_USE_NETCDF
 #include "netcdf.h"
@@ -114,6 +116,91 @@ void Mesh::ReadMFEMMesh(std::istream &input, bool mfem_v11, int &curved)
    if (remove_unused_vertices) { RemoveUnusedVertices(); }
 }
 
+static void ReadBinaryElements(std::istream &input, Mesh *mesh, int num_elem,
+                               Array<Element*> &elem)
+{
+   Array<int> geom(num_elem), attr(num_elem), verts;
+   bin_io::ReadPadded(input, geom.GetData(), num_elem);
+   bin_io::ReadPadded(input, attr.GetData(), num_elem);
+   int num_verts = 0;
+   for (int i = 0; i < num_elem; i++)
+   {
+      MFEM_VERIFY(geom[i] >= 0 && geom[i] < Geometry::NumGeom,
+                  "invalid binary mesh file");
+      num_verts += Geometry::NumVerts[geom[i]];
+   }
+   verts.SetSize(num_verts);
+   bin_io::ReadPadded(input, verts.GetData(), num_verts);
+   MFEM_VERIFY(input, "invalid binary mesh file");
+
+   elem.SetSize(num_elem);
+   for (int i = 0, j = 0; i < num_elem; i++)
+   {
+      elem[i] = mesh->NewElement(geom[i]);
+      elem[i]->SetAttribute(attr[i]);
+      elem[i]->SetVertices(verts.GetData() + j);
+      j += Geometry::NumVerts[geom[i]];
+   }
+}
+
+void Mesh::ReadMFEMBinaryMesh(std::istream &input, int &curved)
+{
+   // Read MFEM binary mesh v1.0 format, see Mesh::BinaryPrinter()
+   int64_t header[8];
+   bin_io::ReadPadded(input, header, 8);
+   MFEM_VERIFY(input && header[0] == 0x0102030405060708LL,
+               "invalid binary mesh file or incompatible byte order");
+
+   Dim = header[1];
+   spaceDim = header[2];
+   NumOfVertices = header[3];
+   NumOfElements = header[4];
+   NumOfBdrElements = header[5];
+   const bool has_nodes = header[6];
+
+   ReadBinaryElements(input, this, NumOfElements, elements);
+   ReadBinaryElements(input, this, NumOfBdrElements, boundary);
+
+   if (header[7] > 0)
+   {
+      std::string nc_text(header[7], ' ');
+      bin_io::ReadPadded(input, &nc_text[0], nc_text.size());
+
+      std::istringstream nc_input(nc_text);
+      string ident;
+      nc_input >> ident;
+      MFEM_VERIFY(ident == "vertex_parents", "invalid binary mesh file");
+      ncmesh = new NCMesh(this, &nc_input);
+      skip_comment_lines(nc_input, '#');
+      nc_input >> ident;
+      MFEM_VERIFY(ident == "coarse_elements", "invalid binary mesh file");
+      ncmesh->LoadCoarseElements(nc_input);
+   }
+
+   vertices.SetSize(NumOfVertices);
+   if (!has_nodes)
+   {
+      Array<double> coords(NumOfVertices*spaceDim);
+      bin_io::ReadPadded(input, coords.GetData(), coords.Size());
+      MFEM_VERIFY(input, "invalid binary mesh file");
+      for (int j = 0; j < NumOfVertices; j++)
+      {
+         for (int i = 0; i < spaceDim; i++)
+         {
+            vertices[j](i) = coords[j*spaceDim + i];
+         }
+      }
+
+      // initialize vertex positions in NCMesh
+      if (ncmesh) { ncmesh->SetVertexPositions(vertices); }
+   }
+   else
+   {
+      // the nodes follow in binary GridFunction format
+      curved = 1;
+   }
+}
+
 void Mesh::ReadLineMesh(std::istream &input)
 {
    int j,p1,p2,a;
@@ -71,6 +71,7 @@ void NCMesh::GeomInfo::Initialize(const mfem::Element* elem)
 
 NCMesh::NCMesh(const Mesh *mesh, std::istream *vertex_parents)
    : shadow(1024, 2048)
+   , compact_threshold(0.25)
 {
    Dim = mesh->Dimension();
    spaceDim = mesh->SpaceDimension();
@@ -203,6 +204,7 @@ NCMesh::NCMesh(const NCMesh &other)
    , faces(other.faces)
    , elements(other.elements)
    , shadow(1024, 2048)
+   , compact_threshold(other.compact_threshold)
 {
    other.free_element_ids.Copy(free_element_ids);
    other.root_state.Copy(root_state);
@@ -1500,6 +1502,9 @@ void NCMesh::RefineElement(int elem, char ref_type)
 
 void NCMesh::Refine(const Array<Refinement>& refinements)
 {
+   // make room for the new nodes and faces of the whole batch
+   ReserveRefinements(refinements);
+
    // push all refinements on the stack in reverse order
    ref_stack.Reserve(refinements.Size());
    for (int i = refinements.Size()-1; i >= 0; i--)
@@ -1538,6 +1543,8 @@ void NCMesh::Refine(const Array<Refinement>& refinements)
    ref_stack.DeleteAll();
    shadow.DeleteAll();
 
+   if (NeedsCompaction()) { Compact(); }
+
    Update();
 }
 
@@ -1809,6 +1816,8 @@ void NCMesh::Derefine(const Array<int> &derefs)
       DerefineElement(parent);
    }
 
+   if (NeedsCompaction()) { Compact(&fine_coarse); }
+
    // update leaf_elements, Element::index etc.
    Update();
 
@@ -1851,6 +1860,197 @@ void NCMesh::SetDerefMatrixCodes(int parent, Array<int> &fine_coarse)
 }
 
 
+//// Compaction ////////////////////////////////////////////////////////////////
+
+void NCMesh::ReserveRefinements(const Array<Refinement> &refinements)
+{
+   int nleaves = leaf_elements.Size();
+   if (!nleaves) { return; }
+
+   // estimate the number of new leaves (forced refinements not included)
+   long nnew = 0;
+   for (int i = 0; i < refinements.Size(); i++)
+   {
+      nnew += ref_type_num_children[(int) refinements[i].ref_type] - 1;
+   }
+
+   // assume the number of nodes and faces grows with the number of leaves
+   double growth = 1.0 + double(nnew) / nleaves;
+   nodes.Reserve(int(growth * nodes.Size()));
+   faces.Reserve(int(growth * faces.Size()));
+}
+
+bool NCMesh::NeedsCompaction() const
+{
+   if (compact_threshold >= 1.0) { return false; }
+
+   return (free_element_ids.Size() > compact_threshold * elements.Size() ||
+           nodes.NumFreeIds() > compact_threshold * nodes.NumIds() ||
+           faces.NumFreeIds() > compact_threshold * faces.NumIds());
+}
+
+void NCMesh::Compact(Array<int> *elem_ids)
+{
+   // *** elements: roots first, then the trees in depth-first order ***
+
+   BlockArray<Element> tmp_elements;
+   elements.Swap(tmp_elements);
+   free_element_ids.DeleteAll();
+
+   Array<int> index_map(tmp_elements.Size());
+   index_map = -1;
+
+   int root_count = root_state.Size();
+   for (int i = 0; i < root_count; i++)
+   {
+      elements.Append(tmp_elements[i]);
+      index_map[i] = i;
+   }
+   for (int i = 0; i < root_count; i++)
+   {
+      CopyElements(i, tmp_elements, index_map);
+   }
+   tmp_elements.DeleteAll();
+
+   for (face_iterator face = faces.begin(); face != faces.end(); ++face)
+   {
+      for (int i = 0; i < 2; i++)
+      {
+         if (face->elem[i] >= 0) { face->elem[i] = index_map[face->elem[i]]; }
+      }
+   }
+   for (int i = 0; i < coarse_elements.Size(); i++)
+   {
+      coarse_elements[i] = index_map[coarse_elements[i]];
+   }
+   if (elem_ids)
+   {
+      for (int i = 0; i < elem_ids->Size(); i++)
+      {
+         int &id = (*elem_ids)[i];
+         if (id >= 0) { id = index_map[id]; }
+      }
+   }
+
+   // *** nodes and faces: in order of first use by the leaf elements ***
+
+   // top-level nodes keep their IDs (id == p1 == p2, see NCMesh::NCMesh)
+   int num_node_ids = nodes.Size();
+   Array<int> node_map(nodes.NumIds());
+   node_map = -1;
+   for (node_iterator node = nodes.begin(); node != nodes.end(); ++node)
+   {
+      if (node->p1 == node->p2)
+      {
+         node_map[node.index()] = node.index();
+         num_node_ids = std::max(num_node_ids, node.index() + 1);
+      }
+   }
+
+   Array<bool> node_taken(num_node_ids);
+   node_taken = false;
+   for (int i = 0; i < node_map.Size(); i++)
+   {
+      if (node_map[i] >= 0) { node_taken[node_map[i]] = true; }
+   }
+
+   int next_node = 0;
+   Array<int> face_map(faces.NumIds());
+   Array<int> face_keys(4*faces.NumIds());
+   face_map = -1;
+   int next_face = 0;
+
+   for (elem_iterator el = elements.begin(); el != elements.end(); ++el)
+   {
+      if (el->ref_type) { continue; }
+
+      const int* node = el->node;
+      GeomInfo &gi = GI[el->Geom()];
+
+      for (int i = 0; i < gi.nv + gi.ne; i++)
+      {
+         int id = (i < gi.nv)
+                  ? node[i]
+                  : nodes.FindId(node[gi.edges[i - gi.nv][0]],
+                                 node[gi.edges[i - gi.nv][1]]);
+         MFEM_ASSERT(id >= 0, "node not found.");
+         if (node_map[id] < 0)
+         {
+            while (node_taken[next_node]) { next_node++; }
+            node_map[id] = next_node;
+            node_taken[next_node] = true;
+         }
+      }
+
+      for (int i = 0; i < gi.nf; i++)
+      {
+         const int* fv = gi.faces[i];
+         int id = faces.FindId(node[fv[0]], node[fv[1]],
+                               node[fv[2]], node[fv[3]]);
+         MFEM_ASSERT(id >= 0, "face not found.");
+         if (face_map[id] < 0)
+         {
+            face_map[id] = next_face++;
+            for (int j = 0; j < 4; j++) { face_keys[4*id + j] = node[fv[j]]; }
+         }
+      }
+   }
+
+   // nodes and faces not used by any leaf (e.g., unused top-level vertices)
+   for (node_iterator node = nodes.begin(); node != nodes.end(); ++node)
+   {
+      if (node_map[node.index()] < 0)
+      {
+         while (node_taken[next_node]) { next_node++; }
+         node_map[node.index()] = next_node;
+         node_taken[next_node] = true;
+      }
+   }
+   for (face_iterator face = faces.begin(); face != faces.end(); ++face)
+   {
+      int id = face.index();
+      if (face_map[id] < 0)
+      {
+         face_map[id] = next_face++;
+         FindFaceNodes(id, &face_keys[4*id]);
+      }
+   }
+
+   // renumber the parents of nodes and faces, then move the items
+   for (node_iterator node = nodes.begin(); node != nodes.end(); ++node)
+   {
+      int p1 = node_map[node->p1], p2 = node_map[node->p2];
+      node->p1 = std::min(p1, p2);
+      node->p2 = std::max(p1, p2);
+   }
+   nodes.Renumber(node_map, num_node_ids);
+
+   for (face_iterator face = faces.begin(); face != faces.end(); ++face)
+   {
+      int fn[4];
+      for (int j = 0; j < 4; j++)
+      {
+         int n = face_keys[4*face.index() + j];
+         fn[j] = (n >= 0) ? node_map[n] : -1;
+      }
+      internal::sort4_ext(fn[0], fn[1], fn[2], fn[3]);
+      face->p1 = fn[0];
+      face->p2 = fn[1];
+      face->p3 = fn[2];
+   }
+   faces.Renumber(face_map, next_face);
+
+   for (elem_iterator el = elements.begin(); el != elements.end(); ++el)
+   {
+      if (el->ref_type) { continue; }
+      for (int i = 0; i < 8; i++)
+      {
+         if (el->node[i] >= 0) { el->node[i] = node_map[el->node[i]]; }
+      }
+   }
+}
+
+
 //// Mesh Interface ////////////////////////////////////////////////////////////
 
 void NCMesh::UpdateVertices()
@@ -5198,7 +5398,7 @@ long NCMesh::NCList::MemoryUsage() const
    int pm_size = 0;
    for (int i = 0; i < Geometry::NumGeom; i++)
    {
-      for (int j = 0; j < point_matrices[i].Size(); i++)
+      for (int j = 0; j < point_matrices[i].Size(); j++)
       {
          pm_size += point_matrices[i][j]->MemoryUsage();
       }
@@ -5235,8 +5435,11 @@ long NCMesh::MemoryUsage() const
           edge_list.MemoryUsage() +
           vertex_list.MemoryUsage() +
           boundary_faces.MemoryUsage() +
+          face_geom.MemoryUsage() +
           element_vertex.MemoryUsage() +
           ref_stack.MemoryUsage() +
+          shadow.MemoryUsage() +
+          reparents.MemoryUsage() +
           derefinements.MemoryUsage() +
           transforms.MemoryUsage() +
           coarse_elements.MemoryUsage() +
@@ -5258,8 +5461,11 @@ int NCMesh::PrintMemoryDetail() const
              << edge_list.MemoryUsage() << " edge_list\n"
              << vertex_list.MemoryUsage() << " vertex_list\n"
              << boundary_faces.MemoryUsage() << " boundary_faces\n"
+             << face_geom.MemoryUsage() << " face_geom\n"
              << element_vertex.MemoryUsage() << " element_vertex\n"
              << ref_stack.MemoryUsage() << " ref_stack\n"
+             << shadow.MemoryUsage() << " shadow\n"
+             << reparents.MemoryUsage() << " reparents\n"
              << derefinements.MemoryUsage() << " derefinements\n"
              << transforms.MemoryUsage() << " transforms\n"
              << coarse_elements.MemoryUsage() << " coarse_elements\n"
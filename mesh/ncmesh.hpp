@@ -146,6 +146,13 @@ public:
        derefinements may have to be skipped to preserve mesh consistency. */
    virtual void Derefine(const Array<int> &derefs);
 
+   /** Set the fraction of unused node, face or element IDs above which Refine
+       and Derefine renumber the internal data structures to be contiguous,
+       releasing the unused memory. The default is 0.25. Zero compacts whenever
+       unused IDs are present, values >= 1 turn the compaction off. */
+   void SetCompactionThreshold(double threshold)
+   { compact_threshold = threshold; }
+
 
    // master/slave lists
 
@@ -539,9 +546,25 @@ protected: // implementation
 
    Table derefinements; ///< possible derefinements, see GetDerefinementTable
 
+   double compact_threshold; ///< see SetCompactionThreshold
+
    void RefineElement(int elem, char ref_type);
    void DerefineElement(int elem);
 
+   /** Resize the node and face hash tables ahead of a batch of refinements so
+       they do not need to be rehashed repeatedly while refining. */
+   void ReserveRefinements(const Array<Refinement> &refinements);
+
+   /// Return true if the fraction of unused IDs exceeds 'compact_threshold'.
+   bool NeedsCompaction() const;
+
+   /** Renumber elements, nodes and faces to remove unused IDs. Elements are
+       stored in depth-first order of the refinement trees, nodes and faces in
+       the order they are first used by the leaf elements. Top-level nodes keep
+       their IDs. Element IDs in 'coarse_elements' and in the optional array
+       'elem_ids' are updated. Update() needs to be called afterwards. */
+   void Compact(Array<int> *elem_ids = NULL);
+
    int AddElement(const Element &el)
    {
       if (free_element_ids.Size())
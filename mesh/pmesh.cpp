@@ -22,6 +22,8 @@
 
 #include <iostream>
 #include <fstream>
+#include <climits>
+#include <cctype>
 
 using namespace std;
 
@@ -1077,6 +1079,1400 @@ ParMesh::ParMesh(MPI_Comm comm, istream &input, bool refine)
    // TODO: AMR meshes, NURBS meshes?
 }
 
+// Send the entries [send_off[r],send_off[r+1]) of 'send' to rank 'r' of
+// 'comm'. On return, the entries [recv_off[r],recv_off[r+1]) of 'recv' are the
+// ones received from rank 'r'. This is a collective operation.
+template <typename T>
+static void ExchangeAll(MPI_Comm comm, MPI_Datatype type, const Array<T> &send,
+                        const Array<int> &send_off, Array<T> &recv,
+                        Array<int> &recv_off)
+{
+   int nranks;
+   MPI_Comm_size(comm, &nranks);
+
+   Array<int> send_cnt(nranks), recv_cnt(nranks);
+   for (int r = 0; r < nranks; r++)
+   {
+      send_cnt[r] = send_off[r+1] - send_off[r];
+   }
+   MPI_Alltoall(send_cnt.GetData(), 1, MPI_INT,
+                recv_cnt.GetData(), 1, MPI_INT, comm);
+   recv_off.SetSize(nranks+1);
+   recv_off[0] = 0;
+   for (int r = 0; r < nranks; r++)
+   {
+      recv_off[r+1] = recv_off[r] + recv_cnt[r];
+   }
+   recv.SetSize(recv_off[nranks]);
+   MPI_Alltoallv(const_cast<T*>(send.GetData()), send_cnt.GetData(),
+                 const_cast<int*>(send_off.GetData()), type,
+                 recv.GetData(), recv_cnt.GetData(), recv_off.GetData(),
+                 type, comm);
+}
+
+// Return the rank of the distributed directory responsible for the given key,
+// a tuple of 'kl' entries.
+static int KeyDirectory(const long *key, int kl, int nranks)
+{
+   unsigned long h = 0;
+   for (int j = 0; j < kl; j++)
+   {
+      h = 1000003ul*h + (unsigned long) key[j];
+   }
+   return h % nranks;
+}
+
+// For each key, given as a tuple of 'kl' consecutive entries of 'keys', find
+// the (sorted) list of ranks in 'comm' that have the same key. The search uses
+// a distributed directory: each key is sent to a rank determined by its hash,
+// which matches the keys it received and replies with the list of ranks. Row
+// 'k' of 'key_ranks' corresponds to key 'k' and always includes the calling
+// rank. This is a collective operation.
+static void FindKeyRanks(MPI_Comm comm, const Array<long> &keys, int kl,
+                         Table &key_ranks)
+{
+   int nranks;
+   MPI_Comm_size(comm, &nranks);
+
+   const int nkeys = keys.Size()/kl;
+
+   // send each key to its directory rank
+   Array<int> dir(nkeys), send_off(nranks+1);
+   send_off = 0;
+   for (int k = 0; k < nkeys; k++)
+   {
+      dir[k] = KeyDirectory(&keys[k*kl], kl, nranks);
+      send_off[dir[k]+1] += kl;
+   }
+   send_off.PartialSum();
+   // 'sent[i]' is the key sent in position 'i', the keys sent to rank 'r'
+   // occupy positions send_off[r]/kl to send_off[r+1]/kl-1
+   Array<long> send_buf(keys.Size()), recv_buf;
+   Array<int> sent(nkeys), pos(nranks), recv_off;
+   for (int r = 0; r < nranks; r++) { pos[r] = send_off[r]/kl; }
+   for (int k = 0; k < nkeys; k++)
+   {
+      const int i = pos[dir[k]]++;
+      sent[i] = k;
+      for (int j = 0; j < kl; j++) { send_buf[i*kl+j] = keys[k*kl+j]; }
+   }
+   ExchangeAll(comm, MPI_LONG, send_buf, send_off, recv_buf, recv_off);
+
+   // directory: sort the received keys by value and then by source rank
+   const int nrecv = recv_off[nranks]/kl;
+   Array<int> src(nrecv), perm(nrecv), run_size(nrecv);
+   for (int r = 0; r < nranks; r++)
+   {
+      for (int i = recv_off[r]/kl; i < recv_off[r+1]/kl; i++) { src[i] = r; }
+   }
+   for (int i = 0; i < nrecv; i++) { perm[i] = i; }
+   const long *rkeys = recv_buf.GetData();
+   auto key_less = [&](int a, int b)
+   {
+      for (int j = 0; j < kl; j++)
+      {
+         if (rkeys[a*kl+j] != rkeys[b*kl+j])
+         {
+            return rkeys[a*kl+j] < rkeys[b*kl+j];
+         }
+      }
+      return src[a] < src[b];
+   };
+   auto key_equal = [&](int a, int b)
+   {
+      for (int j = 0; j < kl; j++)
+      {
+         if (rkeys[a*kl+j] != rkeys[b*kl+j]) { return false; }
+      }
+      return true;
+   };
+   std::sort(perm.begin(), perm.end(), key_less);
+   for (int i = 0, j; i < nrecv; i = j)
+   {
+      for (j = i+1; j < nrecv && key_equal(perm[i], perm[j]); j++) { }
+      for (int l = i; l < j; l++) { run_size[perm[l]] = j-i; }
+   }
+
+   // reply to each received key with [m, r_1, ..., r_m], in the same order
+   // in which the keys were received
+   Array<int> rsend_off(nranks+1), key_pos(nrecv+1);
+   key_pos[0] = 0;
+   for (int i = 0; i < nrecv; i++)
+   {
+      key_pos[i+1] = key_pos[i] + 1 + run_size[i];
+   }
+   for (int r = 0; r <= nranks; r++)
+   {
+      rsend_off[r] = key_pos[recv_off[r]/kl];
+   }
+   Array<int> rsend_buf(key_pos[nrecv]), rrecv_buf, rrecv_off;
+   for (int i = 0, j; i < nrecv; i = j)
+   {
+      j = i + run_size[perm[i]];
+      for (int l = i; l < j; l++)
+      {
+         int p = key_pos[perm[l]];
+         rsend_buf[p++] = j-i;
+         for (int l2 = i; l2 < j; l2++) { rsend_buf[p++] = src[perm[l2]]; }
+      }
+   }
+   ExchangeAll(comm, MPI_INT, rsend_buf, rsend_off, rrecv_buf, rrecv_off);
+
+   // the replies arrive in the order in which the keys were sent
+   key_ranks.MakeI(nkeys);
+   for (int i = 0, p = 0; i < nkeys; i++)
+   {
+      key_ranks.AddColumnsInRow(sent[i], rrecv_buf[p]);
+      p += 1 + rrecv_buf[p];
+   }
+   key_ranks.MakeJ();
+   for (int i = 0, p = 0; i < nkeys; i++)
+   {
+      key_ranks.AddConnections(sent[i], &rrecv_buf[p+1], rrecv_buf[p]);
+      p += 1 + rrecv_buf[p];
+   }
+   key_ranks.ShiftUpI();
+}
+
+// Sort the shared entities 'ent' by their group and then by their global keys,
+// given as tuples of 'kl' consecutive entries of 'keys'.
+static void SortSharedEntities(const Array<int> &ent_group,
+                               const Array<long> &keys, int kl,
+                               Array<int> &ent)
+{
+   const long *k = keys.GetData();
+   std::sort(ent.begin(), ent.end(), [&](int a, int b)
+   {
+      if (ent_group[a] != ent_group[b]) { return ent_group[a] < ent_group[b]; }
+      return std::lexicographical_compare(k + a*kl, k + (a+1)*kl,
+                                          k + b*kl, k + (b+1)*kl);
+   });
+}
+
+// Define the group-to-entity table 'group_ent' (with ngroups-1 rows) of the
+// shared entities sorted by group, where 'sent_group' lists their groups.
+static void MakeSharedGroupTable(int ngroups, const Array<int> &sent_group,
+                                 Table &group_ent)
+{
+   group_ent.MakeI(ngroups-1);
+   for (int i = 0; i < sent_group.Size(); i++)
+   {
+      group_ent.AddAColumnInRow(sent_group[i]-1);
+   }
+   group_ent.MakeJ();
+   for (int i = 0; i < sent_group.Size(); i++)
+   {
+      group_ent.AddConnection(sent_group[i]-1, i);
+   }
+   group_ent.ShiftUpI();
+}
+
+void ParMesh::InitFromLocalParts(const Array<long> &vert_global, bool refine)
+{
+   MFEM_VERIFY(vert_global.Size() == NumOfVertices,
+               "invalid size of the global vertex numbers");
+
+   ListOfIntegerSets groups;
+   IntegerSet group;
+   group.Recreate(1, &MyRank);
+   groups.Insert(group);
+
+   // Find the shared vertices and their groups: the vertex groups are simply
+   // the ranks with the same global vertex number.
+   Table key_ranks;
+   FindKeyRanks(MyComm, vert_global, 1, key_ranks);
+   Array<int> vert_group(NumOfVertices), sverts;
+   for (int v = 0; v < NumOfVertices; v++)
+   {
+      vert_group[v] = 0;
+      if (key_ranks.RowSize(v) > 1)
+      {
+         group.Recreate(key_ranks.RowSize(v), key_ranks.GetRow(v));
+         vert_group[v] = groups.Insert(group);
+         sverts.Append(v);
+      }
+   }
+
+   // Find the shared edges: the candidates are the edges with two shared
+   // vertices, identified by their sorted global vertex numbers.
+   Array<int> edge_cand, edge_group, sedges;
+   Array<long> edge_keys;
+   if (Dim >= 2)
+   {
+      Table *edge_vert = GetEdgeVertexTable();
+      for (int e = 0; e < NumOfEdges; e++)
+      {
+         const int *v = edge_vert->GetRow(e);
+         if (vert_group[v[0]] && vert_group[v[1]])
+         {
+            const long g0 = vert_global[v[0]], g1 = vert_global[v[1]];
+            edge_cand.Append(e);
+            edge_keys.Append(std::min(g0, g1));
+            edge_keys.Append(std::max(g0, g1));
+         }
+      }
+      FindKeyRanks(MyComm, edge_keys, 2, key_ranks);
+      edge_group.SetSize(edge_cand.Size());
+      for (int i = 0; i < edge_cand.Size(); i++)
+      {
+         edge_group[i] = 0;
+         if (key_ranks.RowSize(i) > 1)
+         {
+            group.Recreate(key_ranks.RowSize(i), key_ranks.GetRow(i));
+            edge_group[i] = groups.Insert(group);
+            sedges.Append(i);
+         }
+      }
+   }
+
+   // Find the shared faces: the candidates are the local boundary faces with
+   // all vertices shared, identified by their sorted global vertex numbers
+   // (padded with -1 for triangles).
+   Array<int> face_cand, face_group, sfaces;
+   Array<long> face_keys;
+   if (Dim == 3)
+   {
+      Array<int> fv;
+      for (int f = 0; f < NumOfFaces; f++)
+      {
+         if (faces_info[f].Elem2No >= 0) { continue; }
+         GetFaceVertices(f, fv);
+         bool shared = true;
+         for (int j = 0; j < fv.Size(); j++)
+         {
+            shared = shared && vert_group[fv[j]];
+         }
+         if (!shared) { continue; }
+         MFEM_VERIFY(fv.Size() == 3 || fv.Size() == 4,
+                     "unsupported shared face geometry");
+         long key[4] = { -1, -1, -1, -1 };
+         for (int j = 0; j < fv.Size(); j++) { key[j] = vert_global[fv[j]]; }
+         std::sort(key, key + 4);
+         face_cand.Append(f);
+         face_keys.Append(key, 4);
+      }
+      FindKeyRanks(MyComm, face_keys, 4, key_ranks);
+      face_group.SetSize(face_cand.Size());
+      for (int i = 0; i < face_cand.Size(); i++)
+      {
+         face_group[i] = 0;
+         if (key_ranks.RowSize(i) > 1)
+         {
+            MFEM_VERIFY(key_ranks.RowSize(i) == 2,
+                        "a face is shared by more than two ranks");
+            group.Recreate(key_ranks.RowSize(i), key_ranks.GetRow(i));
+            face_group[i] = groups.Insert(group);
+            sfaces.Append(i);
+         }
+      }
+   }
+
+   const int ngroups = groups.Size();
+   gtopo.Create(groups, 822);
+
+   // Define the shared entities, sorted within each group by their global
+   // keys, so that their order is the same on all ranks in the group.
+   Array<int> sent_group;
+   SortSharedEntities(vert_group, vert_global, 1, sverts);
+   svert_lvert = sverts;
+   sent_group.SetSize(sverts.Size());
+   for (int i = 0; i < sverts.Size(); i++)
+   {
+      sent_group[i] = vert_group[sverts[i]];
+   }
+   MakeSharedGroupTable(ngroups, sent_group, group_svert);
+
+   if (Dim >= 2)
+   {
+      SortSharedEntities(edge_group, edge_keys, 2, sedges);
+      Table *edge_vert = GetEdgeVertexTable();
+      shared_edges.SetSize(sedges.Size());
+      sent_group.SetSize(sedges.Size());
+      for (int i = 0; i < sedges.Size(); i++)
+      {
+         // orient the shared edges by their global vertex numbers
+         const int *v = edge_vert->GetRow(edge_cand[sedges[i]]);
+         const int flip = (vert_global[v[0]] > vert_global[v[1]]);
+         shared_edges[i] = new Segment(v[flip], v[1-flip], 1);
+         sent_group[i] = edge_group[sedges[i]];
+      }
+      MakeSharedGroupTable(ngroups, sent_group, group_sedge);
+   }
+   else
+   {
+      group_sedge.SetSize(ngroups-1, 0);   // create empty group_sedge
+   }
+
+   if (Dim == 3)
+   {
+      SortSharedEntities(face_group, face_keys, 4, sfaces);
+      Array<int> fv, tri_group, quad_group;
+      for (int i = 0; i < sfaces.Size(); i++)
+      {
+         const int sf = sfaces[i];
+         GetFaceVertices(face_cand[sf], fv);
+         if (fv.Size() == 3)
+         {
+            // triangles: sort the vertices by their global numbers
+            std::sort(fv.begin(), fv.end(), [&](int a, int b)
+            { return vert_global[a] < vert_global[b]; });
+            shared_trias.SetSize(shared_trias.Size()+1);
+            for (int j = 0; j < 3; j++) { shared_trias.Last().v[j] = fv[j]; }
+            tri_group.Append(face_group[sf]);
+         }
+         else
+         {
+            // quadrilaterals: start from the smallest global vertex number and
+            // proceed towards its neighbor with the smaller global number
+            int j0 = 0;
+            for (int j = 1; j < 4; j++)
+            {
+               if (vert_global[fv[j]] < vert_global[fv[j0]]) { j0 = j; }
+            }
+            const int s = (vert_global[fv[(j0+1)%4]] <
+                           vert_global[fv[(j0+3)%4]]) ? 1 : 3;
+            shared_quads.SetSize(shared_quads.Size()+1);
+            for (int j = 0; j < 4; j++)
+            {
+               shared_quads.Last().v[j] = fv[(j0+s*j)%4];
+            }
+            quad_group.Append(face_group[sf]);
+         }
+      }
+      MakeSharedGroupTable(ngroups, tri_group, group_stria);
+      MakeSharedGroupTable(ngroups, quad_group, group_squad);
+   }
+   else
+   {
+      group_stria.SetSize(ngroups-1, 0);   // create empty group_stria
+      group_squad.SetSize(ngroups-1, 0);   // create empty group_squad
+   }
+
+   ReduceMeshGen(); // determine the global 'meshgen'
+
+   // Same as Finalize(refine, false), except that boundary elements are never
+   // generated: a rank may legitimately have no global boundary elements.
+   if (refine && Dim > 1 && (meshgen & 1))
+   {
+      const int meshgen_save = meshgen;
+      MarkForRefinement(); // may rotate the shared_trias
+      FinalizeTopology(false);
+      meshgen = meshgen_save;
+   }
+   CheckBdrElementOrientation();
+   FinalizeParTopo();
+
+   SetAttributes();
+}
+
+ParMesh::ParMesh(MPI_Comm comm, const Mesh &local_mesh,
+                 const Array<long> &vert_global, bool refine)
+   : Mesh(local_mesh)
+   , glob_elem_offset(-1)
+   , glob_offset_sequence(-1)
+   , gtopo(comm)
+{
+   MyComm = comm;
+   MPI_Comm_size(MyComm, &NRanks);
+   MPI_Comm_rank(MyComm, &MyRank);
+
+   have_face_nbr_data = false;
+   pncmesh = NULL;
+
+   MFEM_VERIFY(!Nodes && !NURBSext && !ncmesh, "curved, NURBS and "
+               "nonconforming local meshes are not supported");
+
+   InitFromLocalParts(vert_global, refine);
+}
+
+// Split the 'dim'-dimensional grid of n[0] x ... x n[dim-1] cells into the
+// blocks of a grid of 'nranks' processors and return the cell range
+// [lo[d],hi[d]) owned by 'rank' in each direction.
+static void CartesianBlock(int nranks, int rank, int dim, const int *n,
+                           int *lo, int *hi)
+{
+   int dims[3] = { 0, 0, 0 }, p[3], dir[3] = { 0, 1, 2 };
+   MPI_Dims_create(nranks, dim, dims); // dims are in non-increasing order
+   // assign more processors to the directions with more cells
+   std::stable_sort(dir, dir + dim, [&](int a, int b) { return n[a] > n[b]; });
+   for (int d = 0; d < dim; d++) { p[dir[d]] = dims[d]; }
+   for (int d = 0; d < dim; d++)
+   {
+      MFEM_VERIFY(p[d] <= n[d], "too many MPI ranks for a " << n[d]
+                  << " cell wide Cartesian mesh");
+      const int c = rank % p[d];
+      rank /= p[d];
+      lo[d] = (int)(((long) c * n[d]) / p[d]);
+      hi[d] = (int)(((long) (c+1) * n[d]) / p[d]);
+   }
+}
+
+ParMesh::ParMesh(MPI_Comm comm, int nx, int ny, Element::Type type,
+                 double sx, double sy)
+   : glob_elem_offset(-1)
+   , glob_offset_sequence(-1)
+   , gtopo(comm)
+{
+   MyComm = comm;
+   MPI_Comm_size(MyComm, &NRanks);
+   MPI_Comm_rank(MyComm, &MyRank);
+
+   have_face_nbr_data = false;
+   pncmesh = NULL;
+
+   MFEM_VERIFY(type == Element::QUADRILATERAL || type == Element::TRIANGLE,
+               "unsupported element type");
+
+   const int n[2] = { nx, ny };
+   int lo[2], hi[2];
+   CartesianBlock(NRanks, MyRank, 2, n, lo, hi);
+   const int lx = hi[0]-lo[0], ly = hi[1]-lo[1];
+
+   const int tri = (type == Element::TRIANGLE);
+   int NBdrElem = 0;
+   if (lo[1] == 0) { NBdrElem += lx; }
+   if (hi[1] == ny) { NBdrElem += lx; }
+   if (lo[0] == 0) { NBdrElem += ly; }
+   if (hi[0] == nx) { NBdrElem += ly; }
+
+   InitMesh(2, 2, (lx+1)*(ly+1), (1+tri)*lx*ly, NBdrElem);
+
+   // global and local vertex numbers
+#define GVTX(XC, YC) ((XC)+(long)(YC)*(nx+1))
+#define VTX(XC, YC) ((XC)-lo[0]+((YC)-lo[1])*(lx+1))
+
+   Array<long> vert_global((lx+1)*(ly+1));
+   double coord[2];
+   for (int y = lo[1]; y <= hi[1]; y++)
+   {
+      coord[1] = ((double) y / ny) * sy;
+      for (int x = lo[0]; x <= hi[0]; x++)
+      {
+         coord[0] = ((double) x / nx) * sx;
+         vert_global[VTX(x, y)] = GVTX(x, y);
+         AddVertex(coord);
+      }
+   }
+
+   for (int y = lo[1]; y < hi[1]; y++)
+   {
+      for (int x = lo[0]; x < hi[0]; x++)
+      {
+         if (tri)
+         {
+            AddTriangle(VTX(x, y), VTX(x+1, y+1), VTX(x, y+1));
+            AddTriangle(VTX(x, y), VTX(x+1, y), VTX(x+1, y+1));
+         }
+         else
+         {
+            AddQuad(VTX(x, y), VTX(x+1, y), VTX(x+1, y+1), VTX(x, y+1));
+         }
+      }
+   }
+
+   // boundary elements on the global boundary, attributes as in Make2D()
+   for (int x = lo[0]; x < hi[0]; x++)
+   {
+      if (lo[1] == 0) { AddBdrSegment(VTX(x, 0), VTX(x+1, 0), 1); }
+      if (hi[1] == ny) { AddBdrSegment(VTX(x+1, ny), VTX(x, ny), 3); }
+   }
+   for (int y = lo[1]; y < hi[1]; y++)
+   {
+      if (lo[0] == 0) { AddBdrSegment(VTX(0, y+1), VTX(0, y), 4); }
+      if (hi[0] == nx) { AddBdrSegment(VTX(nx, y), VTX(nx, y+1), 2); }
+   }
+
+#undef VTX
+#undef GVTX
+
+   FinalizeTopology(false);
+   InitFromLocalParts(vert_global, true);
+}
+
+ParMesh::ParMesh(MPI_Comm comm, int nx, int ny, int nz, Element::Type type,
+                 double sx, double sy, double sz)
+   : glob_elem_offset(-1)
+   , glob_offset_sequence(-1)
+   , gtopo(comm)
+{
+   MyComm = comm;
+   MPI_Comm_size(MyComm, &NRanks);
+   MPI_Comm_rank(MyComm, &MyRank);
+
+   have_face_nbr_data = false;
+   pncmesh = NULL;
+
+   MFEM_VERIFY(type == Element::HEXAHEDRON || type == Element::TETRAHEDRON,
+               "unsupported element type");
+
+   const int n[3] = { nx, ny, nz };
+   int lo[3], hi[3];
+   CartesianBlock(NRanks, MyRank, 3, n, lo, hi);
+   const int lx = hi[0]-lo[0], ly = hi[1]-lo[1], lz = hi[2]-lo[2];
+
+   const bool tet = (type == Element::TETRAHEDRON);
+   int NBdrElem = 0;
+   if (lo[2] == 0) { NBdrElem += lx*ly; }
+   if (hi[2] == nz) { NBdrElem += lx*ly; }
+   if (lo[0] == 0) { NBdrElem += ly*lz; }
+   if (hi[0] == nx) { NBdrElem += ly*lz; }
+   if (lo[1] == 0) { NBdrElem += lx*lz; }
+   if (hi[1] == ny) { NBdrElem += lx*lz; }
+
+   InitMesh(3, 3, (lx+1)*(ly+1)*(lz+1), (tet ? 6 : 1)*lx*ly*lz,
+            (tet ? 2 : 1)*NBdrElem);
+
+   // global and local vertex numbers
+#define GVTX(XC, YC, ZC) ((XC)+((YC)+(long)(ZC)*(ny+1))*(nx+1))
+#define VTX(XC, YC, ZC) ((XC)-lo[0]+((YC)-lo[1]+((ZC)-lo[2])*(ly+1))*(lx+1))
+
+   Array<long> vert_global((lx+1)*(ly+1)*(lz+1));
+   double coord[3];
+   for (int z = lo[2]; z <= hi[2]; z++)
+   {
+      coord[2] = ((double) z / nz) * sz;
+      for (int y = lo[1]; y <= hi[1]; y++)
+      {
+         coord[1] = ((double) y / ny) * sy;
+         for (int x = lo[0]; x <= hi[0]; x++)
+         {
+            coord[0] = ((double) x / nx) * sx;
+            vert_global[VTX(x, y, z)] = GVTX(x, y, z);
+            AddVertex(coord);
+         }
+      }
+   }
+
+   int ind[8];
+   for (int z = lo[2]; z < hi[2]; z++)
+   {
+      for (int y = lo[1]; y < hi[1]; y++)
+      {
+         for (int x = lo[0]; x < hi[0]; x++)
+         {
+            ind[0] = VTX(x  , y  , z  );
+            ind[1] = VTX(x+1, y  , z  );
+            ind[2] = VTX(x+1, y+1, z  );
+            ind[3] = VTX(x  , y+1, z  );
+            ind[4] = VTX(x  , y  , z+1);
+            ind[5] = VTX(x+1, y  , z+1);
+            ind[6] = VTX(x+1, y+1, z+1);
+            ind[7] = VTX(x  , y+1, z+1);
+            if (tet) { AddHexAsTets(ind, 1); }
+            else { AddHex(ind, 1); }
+         }
+      }
+   }
+
+   // boundary elements on the global boundary, attributes as in Make3D()
+#define BDR_QUAD(ATTR)                                              \
+   if (tet) { AddBdrQuadAsTriangles(ind, ATTR); }                   \
+   else { AddBdrQuad(ind, ATTR); }
+
+   for (int y = lo[1]; y < hi[1]; y++)
+   {
+      for (int x = lo[0]; x < hi[0]; x++)
+      {
+         if (lo[2] == 0) // bottom, bdr. attribute 1
+         {
+            ind[0] = VTX(x  , y  , 0);
+            ind[1] = VTX(x  , y+1, 0);
+            ind[2] = VTX(x+1, y+1, 0);
+            ind[3] = VTX(x+1, y  , 0);
+            BDR_QUAD(1);
+         }
+         if (hi[2] == nz) // top, bdr. attribute 6
+         {
+            ind[0] = VTX(x  , y  , nz);
+            ind[1] = VTX(x+1, y  , nz);
+            ind[2] = VTX(x+1, y+1, nz);
+            ind[3] = VTX(x  , y+1, nz);
+            BDR_QUAD(6);
+         }
+      }
+   }
+   for (int z = lo[2]; z < hi[2]; z++)
+   {
+      for (int y = lo[1]; y < hi[1]; y++)
+      {
+         if (lo[0] == 0) // left, bdr. attribute 5
+         {
+            ind[0] = VTX(0  , y  , z  );
+            ind[1] = VTX(0  , y  , z+1);
+            ind[2] = VTX(0  , y+1, z+1);
+            ind[3] = VTX(0  , y+1, z  );
+            BDR_QUAD(5);
+         }
+         if (hi[0] == nx) // right, bdr. attribute 3
+         {
+            ind[0] = VTX(nx, y  , z  );
+            ind[1] = VTX(nx, y+1, z  );
+            ind[2] = VTX(nx, y+1, z+1);
+            ind[3] = VTX(nx, y  , z+1);
+            BDR_QUAD(3);
+         }
+      }
+   }
+   for (int x = lo[0]; x < hi[0]; x++)
+   {
+      for (int z = lo[2]; z < hi[2]; z++)
+      {
+         if (lo[1] == 0) // front, bdr. attribute 2
+         {
+            ind[0] = VTX(x  , 0, z  );
+            ind[1] = VTX(x+1, 0, z  );
+            ind[2] = VTX(x+1, 0, z+1);
+            ind[3] = VTX(x  , 0, z+1);
+            BDR_QUAD(2);
+         }
+         if (hi[1] == ny) // back, bdr. attribute 4
+         {
+            ind[0] = VTX(x  , ny, z  );
+            ind[1] = VTX(x  , ny, z+1);
+            ind[2] = VTX(x+1, ny, z+1);
+            ind[3] = VTX(x+1, ny, z  );
+            BDR_QUAD(4);
+         }
+      }
+   }
+
+#undef BDR_QUAD
+#undef VTX
+#undef GVTX
+
+   FinalizeTopology(false);
+   InitFromLocalParts(vert_global, true);
+}
+
+// Read the byte range of the text file 'filename' assigned to the calling rank
+// with MPI-IO and return it in 'text' as a sequence of complete lines,
+// terminated by '\0'. The ranks read contiguous slices of (at least) 64 KiB
+// and the partial line at the beginning of a slice is passed to the previous
+// rank. This is a collective operation.
+static void ReadFileSlice(MPI_Comm comm, const char *filename,
+                          Array<char> &text)
+{
+   int nranks, myrank;
+   MPI_Comm_size(comm, &nranks);
+   MPI_Comm_rank(comm, &myrank);
+
+   MPI_File fh;
+   int err = MPI_File_open(comm, const_cast<char*>(filename), MPI_MODE_RDONLY,
+                           MPI_INFO_NULL, &fh);
+   MFEM_VERIFY(err == MPI_SUCCESS, "unable to open mesh file: " << filename);
+   MPI_Offset fsize;
+   MPI_File_get_size(fh, &fsize);
+
+   const MPI_Offset chunk =
+      std::max<MPI_Offset>((fsize + nranks - 1)/nranks, 1 << 16);
+   const MPI_Offset start = std::min<MPI_Offset>(chunk*myrank, fsize);
+   const MPI_Offset end = std::min<MPI_Offset>(start + chunk, fsize);
+   // also read the byte before the slice to see if the slice starts a line
+   const MPI_Offset rstart = (start > 0) ? start-1 : 0;
+   MFEM_VERIFY(end - rstart < INT_MAX, "mesh file slice is too large");
+
+   Array<char> buf((int)(end - rstart));
+   MPI_File_read_at_all(fh, rstart, buf.GetData(), buf.Size(), MPI_CHAR,
+                        MPI_STATUS_IGNORE);
+   MPI_File_close(&fh);
+
+   // 'skip' is the number of leading bytes that do not belong to this rank
+   int skip = 0, frag_len = 0;
+   if (start > 0)
+   {
+      skip = 1;
+      if (start < end && buf[0] != '\n')
+      {
+         while (skip < buf.Size() && buf[skip] != '\n') { skip++; }
+         MFEM_VERIFY(skip < buf.Size(), "mesh file line is too long");
+         skip++;
+      }
+      frag_len = skip-1;
+   }
+
+   const int prev = (myrank > 0) ? myrank-1 : MPI_PROC_NULL;
+   const int next = (myrank < nranks-1) ? myrank+1 : MPI_PROC_NULL;
+   int next_len = 0;
+   MPI_Sendrecv(&frag_len, 1, MPI_INT, prev, 0, &next_len, 1, MPI_INT, next,
+                0, comm, MPI_STATUS_IGNORE);
+
+   const int own_len = buf.Size() - skip;
+   text.SetSize(own_len + next_len + 1);
+   std::copy(buf.GetData() + skip, buf.GetData() + buf.Size(), text.GetData());
+   MPI_Sendrecv(buf.GetData() + 1, frag_len, MPI_CHAR, prev, 1,
+                text.GetData() + own_len, next_len, MPI_CHAR, next, 1, comm,
+                MPI_STATUS_IGNORE);
+   text.Last() = '\0';
+}
+
+// Request the coordinates of the vertices with global numbers 'gids' from
+// their owners, where rank 'r' owns the vertices vert_off[r] to
+// vert_off[r+1]-1 and stores the coordinates of its vertices in 'my_coords'.
+// This is a collective operation.
+static void FetchVertexCoords(MPI_Comm comm, const Array<long> &vert_off,
+                              int sdim, const Array<double> &my_coords,
+                              const Array<long> &gids, Array<double> &coords)
+{
+   int nranks, myrank;
+   MPI_Comm_size(comm, &nranks);
+   MPI_Comm_rank(comm, &myrank);
+
+   const int n = gids.Size();
+   Array<int> owner(n), send_off(nranks+1), pos(nranks), recv_off;
+   send_off = 0;
+   for (int i = 0; i < n; i++)
+   {
+      owner[i] = std::upper_bound(vert_off.begin(), vert_off.end(), gids[i])
+                 - vert_off.begin() - 1;
+      MFEM_VERIFY(owner[i] >= 0 && owner[i] < nranks,
+                  "invalid vertex number: " << gids[i]);
+      send_off[owner[i]+1]++;
+   }
+   send_off.PartialSum();
+   Array<long> send_buf(n), recv_buf;
+   Array<int> sent(n);
+   for (int r = 0; r < nranks; r++) { pos[r] = send_off[r]; }
+   for (int i = 0; i < n; i++)
+   {
+      sent[pos[owner[i]]] = i;
+      send_buf[pos[owner[i]]++] = gids[i];
+   }
+   ExchangeAll(comm, MPI_LONG, send_buf, send_off, recv_buf, recv_off);
+
+   Array<double> reply(sdim*recv_buf.Size()), reply_recv;
+   Array<int> reply_off(nranks+1), reply_recv_off;
+   for (int i = 0; i < recv_buf.Size(); i++)
+   {
+      const int lv = (int) (recv_buf[i] - vert_off[myrank]);
+      for (int d = 0; d < sdim; d++)
+      {
+         reply[sdim*i+d] = my_coords[sdim*lv+d];
+      }
+   }
+   for (int r = 0; r <= nranks; r++) { reply_off[r] = sdim*recv_off[r]; }
+   ExchangeAll(comm, MPI_DOUBLE, reply, reply_off, reply_recv, reply_recv_off);
+
+   coords.SetSize(sdim*n);
+   for (int j = 0; j < n; j++)
+   {
+      for (int d = 0; d < sdim; d++)
+      {
+         coords[sdim*sent[j]+d] = reply_recv[sdim*j+d];
+      }
+   }
+}
+
+// Return the position of the point 'x' along a Morton (Z-order) space-filling
+// curve through the bounding box [bb_min, bb_min+bb_size].
+static unsigned long long MortonKey(const double *x, int sdim,
+                                    const double *bb_min,
+                                    const double *bb_size)
+{
+   const int bits = 62/sdim;
+   const unsigned long long nq = 1ull << bits;
+   unsigned long long q[3], key = 0;
+   for (int d = 0; d < sdim; d++)
+   {
+      const double t = (bb_size[d] > 0.0) ? (x[d]-bb_min[d])/bb_size[d] : 0.0;
+      q[d] = std::min((unsigned long long)(std::max(t, 0.0)*nq), nq-1);
+   }
+   for (int b = bits-1; b >= 0; b--)
+   {
+      for (int d = 0; d < sdim; d++)
+      {
+         key = (key << 1) | ((q[d] >> b) & 1ull);
+      }
+   }
+   return key;
+}
+
+// Partition the elements distributed over 'comm' into contiguous pieces of a
+// space-filling curve: the pairs (key, global element number) in 'elem_keys'
+// are sorted globally with a parallel sample sort and the sorted sequence is
+// split into pieces of equal size. On return, 'target[i]' is the rank assigned
+// to the local element elem_off[myrank]+i. This is a collective operation.
+static void PartitionSFC(MPI_Comm comm, const Array<long> &elem_off,
+                         Array<unsigned long long> &elem_keys,
+                         Array<int> &target)
+{
+   int nranks, myrank;
+   MPI_Comm_size(comm, &nranks);
+   MPI_Comm_rank(comm, &myrank);
+
+   typedef unsigned long long ull;
+   const int n = elem_keys.Size()/2;
+   const long glob_ne = elem_off[nranks];
+   auto pair_less = [](const ull *a, const ull *b)
+   {
+      return (a[0] < b[0]) || (a[0] == b[0] && a[1] < b[1]);
+   };
+   auto sort_pairs = [&](Array<ull> &keys)
+   {
+      const int m = keys.Size()/2;
+      Array<int> perm(m);
+      for (int i = 0; i < m; i++) { perm[i] = i; }
+      std::sort(perm.begin(), perm.end(), [&](int a, int b)
+      { return pair_less(&keys[2*a], &keys[2*b]); });
+      Array<ull> sorted(2*m);
+      for (int i = 0; i < m; i++)
+      {
+         sorted[2*i] = keys[2*perm[i]];
+         sorted[2*i+1] = keys[2*perm[i]+1];
+      }
+      Swap(keys, sorted);
+   };
+
+   // select nranks-1 splitters from regular samples of the sorted local keys
+   sort_pairs(elem_keys);
+   Array<ull> samples;
+   if (n > 0)
+   {
+      for (int i = 1; i < nranks; i++)
+      {
+         const int j = (int)(((long) i * n)/nranks);
+         samples.Append(elem_keys[2*j]);
+         samples.Append(elem_keys[2*j+1]);
+      }
+   }
+   int ns = samples.Size();
+   Array<int> all_ns(nranks), all_off(nranks+1);
+   MPI_Allgather(&ns, 1, MPI_INT, all_ns.GetData(), 1, MPI_INT, comm);
+   all_off[0] = 0;
+   for (int r = 0; r < nranks; r++) { all_off[r+1] = all_off[r] + all_ns[r]; }
+   Array<ull> all_samples(all_off[nranks]);
+   MPI_Allgatherv(samples.GetData(), ns, MPI_UNSIGNED_LONG_LONG,
+                  all_samples.GetData(), all_ns.GetData(), all_off.GetData(),
+                  MPI_UNSIGNED_LONG_LONG, comm);
+   sort_pairs(all_samples);
+   const int nall = all_samples.Size()/2;
+
+   // send the keys to the rank of their bucket
+   Array<int> send_off(nranks+1), recv_off;
+   send_off = 0;
+   for (int i = 0, b = 0; i < n; i++)
+   {
+      // splitter 'b' is the sample at position (b+1)*nall/nranks
+      while (b < nranks-1 &&
+             !pair_less(&elem_keys[2*i],
+                        &all_samples[2*(int)(((long)(b+1)*nall)/nranks)]))
+      {
+         b++;
+      }
+      send_off[b+1] += 2;
+   }
+   send_off.PartialSum();
+   Array<ull> bucket;
+   ExchangeAll(comm, MPI_UNSIGNED_LONG_LONG, elem_keys, send_off, bucket,
+               recv_off);
+   sort_pairs(bucket);
+
+   // split the globally sorted sequence into pieces of equal size and return
+   // the (global element number, target rank) pairs to the element owners
+   long nb = bucket.Size()/2, first = 0;
+   MPI_Exscan(&nb, &first, 1, MPI_LONG, MPI_SUM, comm);
+   if (myrank == 0) { first = 0; }
+   Array<int> owner(nb);
+   send_off = 0;
+   for (int i = 0; i < nb; i++)
+   {
+      owner[i] = std::upper_bound(elem_off.begin(), elem_off.end(),
+                                  (long) bucket[2*i+1])
+                 - elem_off.begin() - 1;
+      send_off[owner[i]+1] += 2;
+   }
+   send_off.PartialSum();
+   Array<long> reply(2*nb), reply_recv;
+   Array<int> pos(nranks);
+   for (int r = 0; r < nranks; r++) { pos[r] = send_off[r]; }
+   for (int i = 0; i < nb; i++)
+   {
+      long *rp = &reply[pos[owner[i]]];
+      pos[owner[i]] += 2;
+      rp[0] = (long) bucket[2*i+1];
+      rp[1] = ((first + i) * nranks) / glob_ne;
+   }
+   ExchangeAll(comm, MPI_LONG, reply, send_off, reply_recv, recv_off);
+
+   target.SetSize(n);
+   for (int i = 0; i < reply_recv.Size(); i += 2)
+   {
+      target[(int) (reply_recv[i] - elem_off[myrank])] = (int) reply_recv[i+1];
+   }
+}
+
+// Element records, stored consecutively in an Array<long>, have the form
+// [global number, attribute, geometry, vertex_1, ..., vertex_nv].
+static inline int ElementRecordSize(const long *rec)
+{
+   return 3 + Geometry::NumVerts[rec[2]];
+}
+
+ParMesh::ParMesh(MPI_Comm comm, const char *filename, bool refine)
+   : glob_elem_offset(-1)
+   , glob_offset_sequence(-1)
+   , gtopo(comm)
+{
+   MyComm = comm;
+   MPI_Comm_size(MyComm, &NRanks);
+   MPI_Comm_rank(MyComm, &MyRank);
+
+   have_face_nbr_data = false;
+   pncmesh = NULL;
+
+   // Phase 1: each rank reads and parses its own slice of the file.
+   Array<char> text;
+   ReadFileSlice(MyComm, filename, text);
+
+   // Split the text into lines and find the section headers.
+   enum { SEC_NONE, SEC_DIMENSION, SEC_ELEMENTS, SEC_BOUNDARY, SEC_VERTICES,
+          SEC_OTHER
+        };
+   Array<int> line_start, line_sec; // line_sec < 0 for data lines
+   int bad_format = 0, unsupported = 0;
+   for (int p = 0; p < text.Size()-1; )
+   {
+      int e = p;
+      while (text[e] != '\n' && text[e] != '\0') { e++; }
+      text[e] = '\0';
+      int b = p;
+      while (text[b] == ' ' || text[b] == '\t' || text[b] == '\r') { b++; }
+      if (text[b] != '\0' && text[b] != '#')
+      {
+         line_start.Append(b);
+         if (isalpha(text[b]))
+         {
+            string ident(&text[b]);
+            ident.erase(ident.find_last_not_of(" \t\r")+1);
+            const int sec =
+               (ident == "dimension") ? SEC_DIMENSION :
+               (ident == "elements") ? SEC_ELEMENTS :
+               (ident == "boundary") ? SEC_BOUNDARY :
+               (ident == "vertices") ? SEC_VERTICES : SEC_OTHER;
+            line_sec.Append(sec);
+            if (MyRank == 0 && line_start.Size() == 1 && p == 0)
+            {
+               bad_format = (ident != "MFEM mesh v1.0");
+            }
+            if (ident == "nodes" || ident == "vertex_parents" ||
+                ident == "coarse_elements")
+            {
+               unsupported = 1;
+            }
+         }
+         else
+         {
+            line_sec.Append(-1);
+         }
+      }
+      p = e+1;
+   }
+
+   // Determine the section and the line number within the section at the
+   // beginning of the slice from the summaries of the preceding slices:
+   // [has header, data lines before the first header, last header, data lines
+   // after the last header].
+   long summary[4] = { 0, 0, SEC_NONE, 0 };
+   for (int i = 0; i < line_sec.Size(); i++)
+   {
+      if (line_sec[i] >= 0)
+      {
+         summary[0] = 1;
+         summary[2] = line_sec[i];
+         summary[3] = 0;
+      }
+      else
+      {
+         summary[summary[0] ? 3 : 1]++;
+      }
+   }
+   Array<long> all_summary(4*NRanks);
+   MPI_Allgather(summary, 4, MPI_LONG, all_summary.GetData(), 4, MPI_LONG,
+                 MyComm);
+   int sec = SEC_NONE;
+   long k = 0;
+   for (int r = MyRank-1; r >= 0; r--)
+   {
+      const long *sr = &all_summary[4*r];
+      if (sr[0]) { sec = (int) sr[2]; k += sr[3]; break; }
+      k += sr[1];
+   }
+
+   // Parse the data lines: the first line of each section is the number of
+   // entries and the vertices section also has the space dimension.
+   long counts[5] = { -1, -1, -1, -1, -1 }; // dim, ne, nbe, nv, sdim
+   Array<long> elems, bdr;
+   Array<int> vert_lines;
+   for (int i = 0; i < line_start.Size(); i++)
+   {
+      const char *line = &text[line_start[i]];
+      if (line_sec[i] >= 0) { sec = line_sec[i]; k = 0; continue; }
+      switch (sec)
+      {
+         case SEC_DIMENSION:
+            if (k == 0) { counts[0] = atol(line); }
+            break;
+         case SEC_ELEMENTS:
+         case SEC_BOUNDARY:
+         {
+            Array<long> &recs = (sec == SEC_ELEMENTS) ? elems : bdr;
+            if (k == 0) { counts[sec == SEC_ELEMENTS ? 1 : 2] = atol(line); }
+            else
+            {
+               char *end;
+               const long attr = strtol(line, &end, 10);
+               const long geom = strtol(end, &end, 10);
+               if (geom < 0 || geom >= Geometry::NumGeom)
+               {
+                  bad_format = 1;
+                  break;
+               }
+               recs.Append(k-1);
+               recs.Append(attr);
+               recs.Append(geom);
+               for (int j = 0; j < Geometry::NumVerts[geom]; j++)
+               {
+                  recs.Append(strtol(end, &end, 10));
+               }
+            }
+            break;
+         }
+         case SEC_VERTICES:
+            if (k == 0) { counts[3] = atol(line); }
+            else if (k == 1) { counts[4] = atol(line); }
+            else
+            {
+               vert_lines.Append(line_start[i]);
+            }
+            break;
+         default:
+            break;
+      }
+      k++;
+   }
+   {
+      long flags[7] = { counts[0], counts[1], counts[2], counts[3], counts[4],
+                        bad_format, unsupported
+                      };
+      MPI_Allreduce(MPI_IN_PLACE, flags, 7, MPI_LONG, MPI_MAX, MyComm);
+      MFEM_VERIFY(!flags[5] && flags[0] > 0 && flags[1] >= 0 &&
+                  flags[2] >= 0 && flags[3] >= 0 && flags[4] > 0,
+                  "invalid MFEM v1.0 mesh file: " << filename);
+      MFEM_VERIFY(!flags[6], "curved and nonconforming meshes are not "
+                  "supported by the parallel reader");
+      for (int j = 0; j < 5; j++) { counts[j] = flags[j]; }
+      Dim = (int) counts[0];
+      spaceDim = (int) counts[4];
+   }
+   Array<double> vert_coords(spaceDim*vert_lines.Size());
+   for (int i = 0; i < vert_lines.Size(); i++)
+   {
+      char *p = &text[vert_lines[i]];
+      for (int d = 0; d < spaceDim; d++)
+      {
+         vert_coords[spaceDim*i+d] = strtod(p, &p);
+      }
+   }
+   text.DeleteAll();
+
+   // The elements and the vertices are distributed in contiguous ranges of
+   // their global numbers: rank 'r' has elem_off[r] to elem_off[r+1]-1, etc.
+   Array<int> elem_rec;
+   for (int p = 0; p < elems.Size(); p += ElementRecordSize(&elems[p]))
+   {
+      elem_rec.Append(p);
+   }
+   Array<long> elem_off(NRanks+1), vert_off(NRanks+1);
+   {
+      long loc[2] = { elem_rec.Size(), vert_lines.Size() };
+      Array<long> all(2*NRanks);
+      MPI_Allgather(loc, 2, MPI_LONG, all.GetData(), 2, MPI_LONG, MyComm);
+      elem_off[0] = vert_off[0] = 0;
+      for (int r = 0; r < NRanks; r++)
+      {
+         elem_off[r+1] = elem_off[r] + all[2*r];
+         vert_off[r+1] = vert_off[r] + all[2*r+1];
+      }
+      MFEM_VERIFY(elem_off[NRanks] == counts[1] &&
+                  vert_off[NRanks] == counts[3],
+                  "invalid MFEM v1.0 mesh file: " << filename);
+   }
+
+   // Phase 2: partition the elements along a space-filling curve through
+   // their centers.
+   Array<int> target;
+   {
+      Array<long> gids;
+      for (int p = 0; p < elem_rec.Size(); p++)
+      {
+         const long *rec = &elems[elem_rec[p]];
+         gids.Append(rec + 3, ElementRecordSize(rec) - 3);
+      }
+      Array<double> coords;
+      FetchVertexCoords(MyComm, vert_off, spaceDim, vert_coords, gids, coords);
+
+      // bb = [min(x), min(-x)]
+      double bb[6], bb_size[3];
+      for (int d = 0; d < 6; d++) { bb[d] = infinity(); }
+      for (int i = 0; i < vert_lines.Size(); i++)
+      {
+         for (int d = 0; d < spaceDim; d++)
+         {
+            bb[d] = std::min(bb[d], vert_coords[spaceDim*i+d]);
+            bb[3+d] = std::min(bb[3+d], -vert_coords[spaceDim*i+d]);
+         }
+      }
+      MPI_Allreduce(MPI_IN_PLACE, bb, 6, MPI_DOUBLE, MPI_MIN, MyComm);
+      for (int d = 0; d < spaceDim; d++) { bb_size[d] = -bb[3+d] - bb[d]; }
+
+      Array<unsigned long long> elem_keys(2*elem_rec.Size());
+      for (int i = 0, j = 0; i < elem_rec.Size(); i++)
+      {
+         const long *rec = &elems[elem_rec[i]];
+         const int nv = ElementRecordSize(rec) - 3;
+         double center[3] = { 0.0, 0.0, 0.0 };
+         for (int v = 0; v < nv; v++, j++)
+         {
+            for (int d = 0; d < spaceDim; d++)
+            {
+               center[d] += coords[spaceDim*j+d]/nv;
+            }
+         }
+         elem_keys[2*i] = MortonKey(center, spaceDim, bb, bb_size);
+         elem_keys[2*i+1] = rec[0];
+      }
+      PartitionSFC(MyComm, elem_off, elem_keys, target);
+   }
+
+   // Phase 3: send the elements to their target ranks. The received elements
+   // are ordered by their global numbers, since the senders own increasing
+   // ranges of elements.
+   Array<long> my_elems;
+   {
+      Array<int> send_off(NRanks+1), pos(NRanks), recv_off;
+      send_off = 0;
+      for (int i = 0; i < elem_rec.Size(); i++)
+      {
+         send_off[target[i]+1] += ElementRecordSize(&elems[elem_rec[i]]);
+      }
+      send_off.PartialSum();
+      Array<long> send_buf(send_off[NRanks]);
+      for (int r = 0; r < NRanks; r++) { pos[r] = send_off[r]; }
+      for (int i = 0; i < elem_rec.Size(); i++)
+      {
+         const long *rec = &elems[elem_rec[i]];
+         for (int j = 0; j < ElementRecordSize(rec); j++)
+         {
+            send_buf[pos[target[i]]++] = rec[j];
+         }
+      }
+      ExchangeAll(MyComm, MPI_LONG, send_buf, send_off, my_elems, recv_off);
+      elems.DeleteAll();
+   }
+
+   // Create the local elements and the local vertex numbering.
+   Array<long> vert_global;
+   for (int p = 0; p < my_elems.Size(); p += ElementRecordSize(&my_elems[p]))
+   {
+      vert_global.Append(&my_elems[p+3], ElementRecordSize(&my_elems[p]) - 3);
+   }
+   vert_global.Sort();
+   vert_global.Unique();
+   auto local_vertex = [&](long gv)
+   {
+      return (int) (std::lower_bound(vert_global.begin(), vert_global.end(),
+                                     gv) - vert_global.begin());
+   };
+
+   Array<long> elem_global;
+   for (int p = 0; p < my_elems.Size(); p += ElementRecordSize(&my_elems[p]))
+   {
+      elem_global.Append(my_elems[p]);
+   }
+   InitMesh(Dim, spaceDim, vert_global.Size(), elem_global.Size(), 0);
+   for (int p = 0; p < my_elems.Size(); p += ElementRecordSize(&my_elems[p]))
+   {
+      const long *rec = &my_elems[p];
+      Element *el = NewElement((int) rec[2]);
+      int *v = el->GetVertices();
+      for (int j = 0; j < el->GetNVertices(); j++)
+      {
+         v[j] = local_vertex(rec[3+j]);
+      }
+      el->SetAttribute((int) rec[1]);
+      AddElement(el);
+   }
+   my_elems.DeleteAll();
+
+   // Phase 4: assign each boundary element to the rank of the element with
+   // the smallest global number containing it (as in the serial mesh), using
+   // a distributed directory of the element faces keyed by their sorted
+   // global vertex numbers.
+   {
+      auto face_key = [](const long *gv, int nfv, long *key)
+      {
+         for (int j = 0; j < 4; j++) { key[j] = (j < nfv) ? gv[j] : -1; }
+         std::sort(key, key + 4);
+      };
+
+      // element faces: [key, global element number, rank]
+      Array<long> faces;
+      long key[6], fgv[4];
+      for (int i = 0; i < NumOfElements; i++)
+      {
+         const Element *el = elements[i];
+         const int *v = el->GetVertices();
+         const int nf = (Dim == 3) ? el->GetNFaces() :
+                        (Dim == 2) ? el->GetNEdges() : el->GetNVertices();
+         for (int f = 0; f < nf; f++)
+         {
+            const int nfv = (Dim == 3) ? el->GetNFaceVertices(f) : Dim;
+            const int *fv = (Dim == 3) ? el->GetFaceVertices(f) :
+                            (Dim == 2) ? el->GetEdgeVertices(f) : &f;
+            for (int j = 0; j < nfv; j++)
+            {
+               fgv[j] = vert_global[v[fv[j]]];
+            }
+            face_key(fgv, nfv, key);
+            key[4] = elem_global[i];
+            key[5] = MyRank;
+            faces.Append(key, 6);
+         }
+      }
+      Array<int> send_off(NRanks+1), pos(NRanks), recv_off;
+      send_off = 0;
+      for (int i = 0; i < faces.Size(); i += 6)
+      {
+         send_off[KeyDirectory(&faces[i], 4, NRanks)+1] += 6;
+      }
+      send_off.PartialSum();
+      Array<long> send_buf(send_off[NRanks]), dir_faces;
+      for (int r = 0; r < NRanks; r++) { pos[r] = send_off[r]; }
+      for (int i = 0; i < faces.Size(); i += 6)
+      {
+         const int r = KeyDirectory(&faces[i], 4, NRanks);
+         for (int j = 0; j < 6; j++) { send_buf[pos[r]++] = faces[i+j]; }
+      }
+      faces.DeleteAll();
+      ExchangeAll(MyComm, MPI_LONG, send_buf, send_off, dir_faces, recv_off);
+
+      // boundary elements: [key, boundary element record]
+      Array<int> bdr_rec;
+      for (int p = 0; p < bdr.Size(); p += ElementRecordSize(&bdr[p]))
+      {
+         bdr_rec.Append(p);
+      }
+      send_off = 0;
+      for (int i = 0; i < bdr_rec.Size(); i++)
+      {
+         const long *rec = &bdr[bdr_rec[i]];
+         face_key(rec + 3, ElementRecordSize(rec) - 3, key);
+         send_off[KeyDirectory(key, 4, NRanks)+1] +=
+            4 + ElementRecordSize(rec);
+      }
+      send_off.PartialSum();
+      send_buf.SetSize(send_off[NRanks]);
+      for (int r = 0; r < NRanks; r++) { pos[r] = send_off[r]; }
+      for (int i = 0; i < bdr_rec.Size(); i++)
+      {
+         const long *rec = &bdr[bdr_rec[i]];
+         face_key(rec + 3, ElementRecordSize(rec) - 3, key);
+         const int r = KeyDirectory(key, 4, NRanks);
+         for (int j = 0; j < 4; j++) { send_buf[pos[r]++] = key[j]; }
+         for (int j = 0; j < ElementRecordSize(rec); j++)
+         {
+            send_buf[pos[r]++] = rec[j];
+         }
+      }
+      bdr.DeleteAll();
+      Array<long> dir_bdr;
+      ExchangeAll(MyComm, MPI_LONG, send_buf, send_off, dir_bdr, recv_off);
+
+      // directory: match the boundary elements with the sorted faces
+      const int ndf = dir_faces.Size()/6;
+      Array<int> perm(ndf);
+      for (int i = 0; i < ndf; i++) { perm[i] = i; }
+      const long *df = dir_faces.GetData();
+      std::sort(perm.begin(), perm.end(), [&](int a, int b)
+      {
+         return std::lexicographical_compare(df + 6*a, df + 6*a + 5,
+                                             df + 6*b, df + 6*b + 5);
+      });
+      Array<int> bdr_target;
+      send_off = 0;
+      for (int p = 0; p < dir_bdr.Size(); )
+      {
+         const long *bkey = &dir_bdr[p];
+         const int *f = std::lower_bound(perm.begin(), perm.end(), bkey,
+                                         [&](int a, const long *b)
+         {
+            return std::lexicographical_compare(df + 6*a, df + 6*a + 4,
+                                                b, b + 4);
+         });
+         MFEM_VERIFY(f != perm.end() &&
+                     std::equal(df + 6*(*f), df + 6*(*f) + 4, bkey),
+                     "boundary element " << bkey[4] << " is not a face of "
+                     "the mesh");
+         const int r = (int) df[6*(*f)+5];
+         bdr_target.Append(r);
+         const int size = ElementRecordSize(bkey + 4);
+         send_off[r+1] += size;
+         p += 4 + size;
+      }
+      send_off.PartialSum();
+      send_buf.SetSize(send_off[NRanks]);
+      for (int r = 0; r < NRanks; r++) { pos[r] = send_off[r]; }
+      for (int p = 0, i = 0; p < dir_bdr.Size(); i++)
+      {
+         const long *rec = &dir_bdr[p+4];
+         const int size = ElementRecordSize(rec);
+         for (int j = 0; j < size; j++)
+         {
+            send_buf[pos[bdr_target[i]]++] = rec[j];
+         }
+         p += 4 + size;
+      }
+      ExchangeAll(MyComm, MPI_LONG, send_buf, send_off, bdr, recv_off);
+   }
+
+   // Create the local boundary elements, ordered by their global numbers.
+   {
+      Array<Pair<long, int> > bdr_order;
+      for (int p = 0; p < bdr.Size(); p += ElementRecordSize(&bdr[p]))
+      {
+         bdr_order.Append(Pair<long, int>(bdr[p], p));
+      }
+      SortPairs<long, int>(bdr_order, bdr_order.Size());
+      for (int i = 0; i < bdr_order.Size(); i++)
+      {
+         const long *rec = &bdr[bdr_order[i].two];
+         Element *el = NewElement((int) rec[2]);
+         int *v = el->GetVertices();
+         for (int j = 0; j < el->GetNVertices(); j++)
+         {
+            v[j] = local_vertex(rec[3+j]);
+         }
+         el->SetAttribute((int) rec[1]);
+         AddBdrElement(el);
+      }
+   }
+
+   // Get the coordinates of the local vertices.
+   {
+      Array<double> coords;
+      FetchVertexCoords(MyComm, vert_off, spaceDim, vert_coords, vert_global,
+                        coords);
+      for (int i = 0; i < vert_global.Size(); i++)
+      {
+         AddVertex(&coords[spaceDim*i]);
+      }
+   }
+
+   // Phase 5: finalize the local mesh and set up the parallel data.
+   CheckElementOrientation(true);
+   FinalizeTopology(false);
+   InitFromLocalParts(vert_global, refine);
+}
+
 ParMesh::ParMesh(ParMesh *orig_mesh, int ref_factor, int ref_type)
    : Mesh(orig_mesh, ref_factor, ref_type),
      MyComm(orig_mesh->GetComm()),
@@ -3391,7 +4787,13 @@ void ParMesh::Rebalance(const Array<int> &partition)
    RebalanceImpl(&partition);
 }
 
-void ParMesh::RebalanceImpl(const Array<int> *partition)
+void ParMesh::Rebalance(const Vector &elem_weights)
+{
+   RebalanceImpl(NULL, &elem_weights); // weighted SFC-based partition
+}
+
+void ParMesh::RebalanceImpl(const Array<int> *partition,
+                            const Vector *elem_weights)
 {
    if (Conforming())
    {
@@ -3418,7 +4820,7 @@ void ParMesh::RebalanceImpl(const Array<int> *partition)
 
    DeleteFaceNbrData();
 
-   pncmesh->Rebalance(partition);
+   pncmesh->Rebalance(partition, elem_weights);
 
    ParMesh* pmesh2 = new ParMesh(*pncmesh);
    pncmesh->OnMeshUpdated(pmesh2);
@@ -5294,7 +6696,7 @@ long ParMesh::ReduceInt(int value) const
    return global;
 }
 
-void ParMesh::ParPrint(ostream &out) const
+void ParMesh::ParPrint(ostream &out, bool binary) const
 {
    if (NURBSext || pncmesh)
    {
@@ -5306,7 +6708,14 @@ void ParMesh::ParPrint(ostream &out) const
    // Write out serial mesh.  Tell serial mesh to deliniate the end of it's
    // output with 'mfem_serial_mesh_end' instead of 'mfem_mesh_end', as we will
    // be adding additional parallel mesh information.
-   Printer(out, "mfem_serial_mesh_end");
+   if (binary)
+   {
+      BinaryPrinter(out, "mfem_serial_mesh_end");
+   }
+   else
+   {
+      Printer(out, "mfem_serial_mesh_end");
+   }
 
    // write out group topology info.
    gtopo.Save(out);
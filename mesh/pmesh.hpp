@@ -148,7 +148,8 @@ protected:
                                           double threshold, int nc_limit = 0,
                                           int op = 1);
 
-   void RebalanceImpl(const Array<int> *partition);
+   void RebalanceImpl(const Array<int> *partition,
+                      const Vector *elem_weights = NULL);
 
    void DeleteFaceNbrData();
 
@@ -202,6 +203,14 @@ protected:
    /// Ensure that bdr_attributes and attributes agree across processors
    void DistributeAttributes(Array<int> &attr);
 
+   /** Build the parallel data (group topology, shared vertices, edges and
+       faces) of a mesh whose local part has already been set up on each rank,
+       using only the global vertex numbers @a vert_global of the local
+       vertices. The shared entities are found through a distributed directory,
+       so no rank needs the global mesh. The @a refine parameter has the same
+       meaning as in Mesh::Finalize(). */
+   void InitFromLocalParts(const Array<long> &vert_global, bool refine);
+
 public:
    /** Copy constructor. Performs a deep copy of (almost) all data, so that the
        source mesh can be modified (e.g. deleted, refined) without affecting the
@@ -216,6 +225,46 @@ public:
    /** The @a refine parameter is passed to the method Mesh::Finalize(). */
    ParMesh(MPI_Comm comm, std::istream &input, bool refine = true);
 
+   /** @brief Read a serial MFEM mesh file (format v1.0) in parallel, without
+       reading the whole file on any rank. */
+   /** Each rank reads a contiguous byte range of the file with MPI-IO and
+       parses only its own lines. The elements are then partitioned along a
+       space-filling curve through their centers, using a parallel sort, and
+       sent to their ranks together with their vertices and boundary elements.
+       Curved and nonconforming meshes are not supported. The @a refine
+       parameter is passed to the method Mesh::Finalize(). */
+   ParMesh(MPI_Comm comm, const char *filename, bool refine = true);
+
+   /** @brief Create a parallel mesh from the local parts of a distributed mesh,
+       given on each rank by @a local_mesh. */
+   /** The vertices of @a local_mesh are identified across ranks through their
+       global numbers, @a vert_global, which must have size
+       local_mesh.GetNV(). The boundary of @a local_mesh should contain only
+       elements on the global boundary, i.e. no elements on the interfaces
+       between the local parts. The @a local_mesh must be finalized and must not
+       be curved, NURBS or nonconforming. The @a refine parameter is passed to
+       the method Mesh::Finalize(). */
+   ParMesh(MPI_Comm comm, const Mesh &local_mesh,
+           const Array<long> &vert_global, bool refine = true);
+
+   /** @brief Create a distributed Cartesian 2D mesh of quadrilaterals or
+       triangles covering the rectangle [0,sx]x[0,sy], see the equivalent
+       serial Mesh constructor. */
+   /** Each rank builds only its own block of a processor grid obtained from
+       MPI_Dims_create(), so the global (serial) mesh is never created. The
+       vertex numbering, element splitting and boundary attributes match those
+       of the serial Cartesian mesh. */
+   ParMesh(MPI_Comm comm, int nx, int ny, Element::Type type,
+           double sx = 1.0, double sy = 1.0);
+
+   /** @brief Create a distributed Cartesian 3D mesh of hexahedra or tetrahedra
+       covering the box [0,sx]x[0,sy]x[0,sz], see the equivalent serial Mesh
+       constructor. */
+   /** Each rank builds only its own block of a processor grid obtained from
+       MPI_Dims_create(), so the global (serial) mesh is never created. */
+   ParMesh(MPI_Comm comm, int nx, int ny, int nz, Element::Type type,
+           double sx = 1.0, double sy = 1.0, double sz = 1.0);
+
    /// Create a uniformly refined (by any factor) version of @a orig_mesh.
    /** @param[in] orig_mesh  The starting coarse mesh.
        @param[in] ref_factor The refinement factor, an integer > 1.
@@ -331,6 +380,18 @@ public:
        for 0 <= i < GetNE(). */
    void Rebalance(const Array<int> &partition);
 
+   /** Load balance a nonconforming mesh by splitting the global space-filling
+       sequence of elements into parts of equal total weight. The Vector
+       'elem_weights' contains a nonnegative cost (e.g., a measured run time)
+       for each local element, 0 <= i < GetNE(). */
+   void Rebalance(const Vector &elem_weights);
+
+   /** Return the load imbalance achieved by the last Rebalance(): the maximum
+       over all processors of the local (weighted) number of elements divided
+       by the average. Returns 1 if the mesh was not rebalanced yet. */
+   double GetRebalanceImbalance() const
+   { return pncmesh ? pncmesh->GetRebalanceImbalance() : 1.0; }
+
    /** Print the part of the mesh in the calling processor adding the interface
        as boundary (for visualization purposes) using the mfem v1.0 format. */
    virtual void Print(std::ostream &out = mfem::out) const;
@@ -364,8 +425,9 @@ public:
    /// Print various parallel mesh stats
    virtual void PrintInfo(std::ostream &out = mfem::out);
 
-   /// Save the mesh in a parallel mesh format.
-   void ParPrint(std::ostream &out) const;
+   /** @brief Save the mesh in a parallel mesh format. If @a binary is true,
+       the local serial mesh is written with Mesh::PrintBinary(). */
+   void ParPrint(std::ostream &out, bool binary = false) const;
 
    /** Print the mesh in parallel PVTU format. The PVTU and VTU files will be
        stored in the directory specified by @a pathname. If the directory does
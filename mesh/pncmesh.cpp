@@ -27,6 +27,7 @@ using namespace bin_io;
 
 ParNCMesh::ParNCMesh(MPI_Comm comm, const NCMesh &ncmesh, int *part)
    : NCMesh(ncmesh)
+   , rebalance_imbalance(1.0)
 {
    MyComm = comm;
    MPI_Comm_size(MyComm, &NRanks);
@@ -52,6 +53,7 @@ ParNCMesh::ParNCMesh(const ParNCMesh &other)
    , MyComm(other.MyComm)
    , NRanks(other.NRanks)
    , MyRank(other.MyRank)
+   , rebalance_imbalance(1.0)
 {
    Update(); // mark all secondary stuff for recalculation
 }
@@ -1434,6 +1436,8 @@ void ParNCMesh::Refine(const Array<Refinement> &refinements)
    // send the messages (overlap with local refinements)
    NeighborRefinementMessage::IsendAll(send_ref, MyComm);
 
+   ReserveRefinements(refinements);
+
    // do local refinements
    for (int i = 0; i < refinements.Size(); i++)
    {
@@ -1458,6 +1462,8 @@ void ParNCMesh::Refine(const Array<Refinement> &refinements)
       }
    }
 
+   if (NeedsCompaction()) { Compact(); }
+
    Update();
 
    // make sure we can delete the send buffers
@@ -1793,7 +1799,8 @@ void ParNCMesh::CheckDerefinementNCLevel(const Table &deref_table,
 
 //// Rebalance /////////////////////////////////////////////////////////////////
 
-void ParNCMesh::Rebalance(const Array<int> *custom_partition)
+void ParNCMesh::Rebalance(const Array<int> *custom_partition,
+                          const Vector *elem_weights)
 {
    send_rebalance_dofs.clear();
    recv_rebalance_dofs.clear();
@@ -1801,7 +1808,23 @@ void ParNCMesh::Rebalance(const Array<int> *custom_partition)
    Array<int> old_elements;
    leaf_elements.GetSubArray(0, NElements, old_elements);
 
-   if (!custom_partition) // SFC based partitioning
+   double imbalance = -1.0;
+
+   if (elem_weights) // SFC based partitioning, weighted
+   {
+      MFEM_VERIFY(!custom_partition, "a custom partition cannot be combined "
+                  "with element weights.");
+
+      Array<int> new_ranks(leaf_elements.Size());
+      new_ranks = -1;
+
+      imbalance = PartitionWeighted(*elem_weights, new_ranks);
+
+      // the number of elements we will receive is not known here, so use the
+      // termination algorithm of custom partitions
+      RedistributeElements(new_ranks, -1, true);
+   }
+   else if (!custom_partition) // SFC based partitioning
    {
       Array<int> new_ranks(leaf_elements.Size());
       new_ranks = -1;
@@ -1853,6 +1876,69 @@ void ParNCMesh::Rebalance(const Array<int> *custom_partition)
 
    // get rid of elements beyond the new ghost layer
    Prune();
+
+   if (imbalance < 0.0)
+   {
+      long local_elems = NElements, total_elems, max_elems;
+      MPI_Allreduce(&local_elems, &total_elems, 1, MPI_LONG, MPI_SUM, MyComm);
+      MPI_Allreduce(&local_elems, &max_elems, 1, MPI_LONG, MPI_MAX, MyComm);
+      imbalance = total_elems ? double(max_elems) * NRanks / total_elems : 1.0;
+   }
+   rebalance_imbalance = imbalance;
+}
+
+double ParNCMesh::PartitionWeighted(const Vector &elem_weights,
+                                    Array<int> &new_ranks)
+{
+   MFEM_VERIFY(elem_weights.Size() == NElements,
+               "Size of the weight vector must match the number of local "
+               "mesh elements (ParMesh::GetNE()).");
+
+   double local_weight = 0.0;
+   for (int i = 0; i < NElements; i++)
+   {
+      MFEM_VERIFY(elem_weights(i) >= 0.0, "element weights must be "
+                  "nonnegative.");
+      local_weight += elem_weights(i);
+   }
+
+   double total_weight = 0.0, first_weight = 0.0;
+   MPI_Allreduce(&local_weight, &total_weight, 1, MPI_DOUBLE, MPI_SUM, MyComm);
+   MPI_Scan(&local_weight, &first_weight, 1, MPI_DOUBLE, MPI_SUM, MyComm);
+   first_weight -= local_weight;
+
+   MFEM_VERIFY(total_weight > 0.0, "the total element weight is zero.");
+
+   // assign each element to the part containing the midpoint of its weight
+   // interval in the global SFC sequence, accumulating the part weights
+   Vector part_weight(NRanks);
+   part_weight = 0.0;
+
+   double w = first_weight;
+   for (int i = 0, j = 0; i < leaf_elements.Size(); i++)
+   {
+      if (elements[leaf_elements[i]].rank != MyRank) { continue; }
+
+      double wi = elem_weights(j++);
+      int rank = int((w + 0.5*wi) * NRanks / total_weight);
+      rank = std::min(std::max(rank, 0), NRanks-1);
+
+      new_ranks[i] = rank;
+      part_weight(rank) += wi;
+      w += wi;
+   }
+
+   // sum the contributions to each part, we get our own part's total weight
+   double my_weight;
+   Array<int> counts(NRanks);
+   counts = 1;
+   MPI_Reduce_scatter(part_weight.GetData(), &my_weight, counts.GetData(),
+                      MPI_DOUBLE, MPI_SUM, MyComm);
+
+   double max_weight;
+   MPI_Allreduce(&my_weight, &max_weight, 1, MPI_DOUBLE, MPI_MAX, MyComm);
+
+   return max_weight * NRanks / total_weight;
 }
 
 void ParNCMesh::RedistributeElements(Array<int> &new_ranks, int target_elements,
@@ -91,8 +91,16 @@ public:
        The default partitioning strategy is based on equal splitting of the
        space-filling sequence of leaf elements (custom_partition == NULL).
        Alternatively, a used-defined element-rank assignment array can be
-       passed. */
-   void Rebalance(const Array<int> *custom_partition = NULL);
+       passed. If 'elem_weights' is given (one nonnegative value per local
+       element), the space-filling sequence is instead split into parts of
+       equal total weight. */
+   void Rebalance(const Array<int> *custom_partition = NULL,
+                  const Vector *elem_weights = NULL);
+
+   /** Return the load imbalance after the last Rebalance(): the maximum over
+       all processors of the local (weighted) number of elements divided by the
+       average. */
+   double GetRebalanceImbalance() const { return rebalance_imbalance; }
 
 
    // interface for ParFiniteElementSpace
@@ -531,6 +539,14 @@ protected: // implementation
    RebalanceDofMessage::Map send_rebalance_dofs;
    RebalanceDofMessage::Map recv_rebalance_dofs;
 
+   /// Load imbalance achieved by the last Rebalance().
+   double rebalance_imbalance;
+
+   /** Assign new ranks to the local elements (in 'new_ranks') by splitting the
+       space-filling sequence into parts of equal total weight. Returns the
+       resulting load imbalance. */
+   double PartitionWeighted(const Vector &elem_weights, Array<int> &new_ranks);
+
    /** After Rebalance, this array holds the old element indices, or -1 if an
        element didn't exist in the mesh previously. After Derefine, it holds
        the ranks of the old (potentially non-existent) fine elements. */
@@ -110,7 +110,7 @@ void test_assembly_level(const char *meshname, int order, bool dg, const int pb,
 TEST_CASE("Assembly Levels", "[AssemblyLevel], [PartialAssembly]")
 {
    auto assembly = GENERATE(AssemblyLevel::PARTIAL, AssemblyLevel::ELEMENT,
-                            AssemblyLevel::FULL);
+                            AssemblyLevel::FULL, AssemblyLevel::AUTO);
    auto pb = GENERATE(0, 1, 2);
    auto dg = GENERATE(true, false);
    auto order_2d = GENERATE(2, 3, 4);
@@ -147,4 +147,100 @@ TEST_CASE("Assembly Levels", "[AssemblyLevel], [PartialAssembly]")
    }
 } // test case
 
+// Select the assembly level of a diffusion form with AssemblyLevel::AUTO and
+// compare its action with the legacy full assembly.
+AssemblyLevel test_auto_assembly(FiniteElementSpace &fespace,
+                                 double max_bytes, int bench_applies,
+                                 bool bdr_integ)
+{
+   ConstantCoefficient one(1.0);
+   BilinearForm k_test(&fespace), k_ref(&fespace);
+   for (BilinearForm *k : {&k_test, &k_ref})
+   {
+      k->AddDomainIntegrator(new DiffusionIntegrator(one));
+      if (bdr_integ) { k->AddBoundaryIntegrator(new MassIntegrator(one)); }
+   }
+   k_ref.Assemble();
+   k_ref.Finalize();
+
+   k_test.SetAssemblyLevel(AssemblyLevel::AUTO);
+   k_test.SetAutoAssemblyMemoryLimit(max_bytes);
+   k_test.SetAutoAssemblyBenchmark(bench_applies);
+   k_test.Assemble();
+   k_test.Finalize();
+   REQUIRE(k_test.GetAssemblyLevel() != AssemblyLevel::AUTO);
+
+   GridFunction x(&fespace), y_ref(&fespace), y_test(&fespace);
+   x.Randomize(1);
+   k_ref.Mult(x, y_ref);
+   k_test.Mult(x, y_test);
+   y_test -= y_ref;
+   REQUIRE(y_test.Normlinf() < 1.e-12 * y_ref.Normlinf());
+
+   return k_test.GetAssemblyLevel();
+}
+
+TEST_CASE("Assembly Level AUTO", "[AssemblyLevel], [PartialAssembly]")
+{
+   Mesh mesh(4, 4, 4, Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+   ConstantCoefficient one(1.0);
+   const double no_limit = infinity();
+
+   SECTION("Cost model")
+   {
+      // Low order: sparse matrix, high order: partial assembly
+      for (int order : {1, 5})
+      {
+         H1_FECollection fec(order, 3);
+         FiniteElementSpace fespace(&mesh, &fec);
+         BilinearForm k(&fespace);
+         k.AddDomainIntegrator(new DiffusionIntegrator(one));
+         REQUIRE(k.SupportsAssemblyLevel(AssemblyLevel::PARTIAL));
+         REQUIRE(k.SupportsAssemblyLevel(AssemblyLevel::ELEMENT));
+         const AssemblyCost pa = k.EstimateAssemblyCost(AssemblyLevel::PARTIAL);
+         const AssemblyCost ea = k.EstimateAssemblyCost(AssemblyLevel::ELEMENT);
+         REQUIRE(pa.storage > 0.0);
+         if (order > 1) { REQUIRE(pa.storage < ea.storage); }
+
+         const AssemblyLevel selected =
+            test_auto_assembly(fespace, no_limit, 0, false);
+         REQUIRE(selected == (order == 1 ? AssemblyLevel::LEGACYFULL :
+                              AssemblyLevel::PARTIAL));
+      }
+   }
+
+   SECTION("Memory limit")
+   {
+      // Nothing fits in one byte: the level with the smallest storage is used
+      H1_FECollection fec(3, 3);
+      FiniteElementSpace fespace(&mesh, &fec);
+      BilinearForm k(&fespace);
+      k.AddDomainIntegrator(new DiffusionIntegrator(one));
+      AssemblyLevel smallest = AssemblyLevel::LEGACYFULL;
+      for (AssemblyLevel level : {AssemblyLevel::ELEMENT,
+                                  AssemblyLevel::PARTIAL})
+      {
+         if (k.EstimateAssemblyCost(level).storage <
+             k.EstimateAssemblyCost(smallest).storage) { smallest = level; }
+      }
+      REQUIRE(test_auto_assembly(fespace, 1.0, 0, false) == smallest);
+   }
+
+   SECTION("Unsupported levels")
+   {
+      // Boundary integrators are only supported by the legacy assembly
+      H1_FECollection fec(5, 3);
+      FiniteElementSpace fespace(&mesh, &fec);
+      REQUIRE(test_auto_assembly(fespace, no_limit, 0, true) ==
+              AssemblyLevel::LEGACYFULL);
+   }
+
+   SECTION("Benchmark")
+   {
+      H1_FECollection fec(3, 3);
+      FiniteElementSpace fespace(&mesh, &fec);
+      test_auto_assembly(fespace, no_limit, 2, false);
+   }
+}
+
 } // namespace pa_kernels
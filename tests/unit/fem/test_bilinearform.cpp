@@ -65,3 +65,189 @@ TEST_CASE("Test order of boundary integrators",
       delete D;
    }
 }
+
+static void skew_map(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.1*x(1)*x(1);
+   y(1) += 0.05*sin(M_PI*x(0));
+   if (x.Size() == 3) { y(2) += 0.1*x(0)*x(1); }
+}
+
+static double sf_coeff(const Vector &x) { return 1.0 + x(0) + x(1)*x(1); }
+
+static void sf_vcoeff(const Vector &x, Vector &v)
+{
+   for (int d = 0; d < v.Size(); d++) { v(d) = 1.0 + (d+1)*x(d)*x(d); }
+}
+
+static void sf_mcoeff(const Vector &x, DenseMatrix &m)
+{
+   const int dim = x.Size();
+   for (int j = 0; j < dim; j++)
+   {
+      for (int i = 0; i < dim; i++)
+      {
+         m(i,j) = (i == j) ? 2.0 + x(i) : 0.1*(i + 2*j)*x(0);
+      }
+   }
+}
+
+TEST_CASE("Sum factorized element matrices",
+          "[BilinearForm]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = (dim == 2) ?
+                   new Mesh(2, 2, Element::QUADRILATERAL, true) :
+                   new Mesh(2, 2, 2, Element::HEXAHEDRON, true);
+      mesh->SetCurvature(2);
+      mesh->Transform(skew_map);
+
+      FunctionCoefficient q(sf_coeff);
+      VectorFunctionCoefficient vq(dim, sf_vcoeff);
+      MatrixFunctionCoefficient mq(dim, sf_mcoeff);
+
+      for (int order = 2; order <= 3; order++)
+      {
+         H1_FECollection h1_fec(order, dim);
+         L2_FECollection l2_fec(order, dim);
+         FiniteElementCollection *fecs[2] = { &h1_fec, &l2_fec };
+         for (int f = 0; f < 2; f++)
+         {
+            FiniteElementSpace fes(mesh, fecs[f]);
+            const FiniteElement &el = *fes.GetFE(0);
+            ElementTransformation &T = *mesh->GetElementTransformation(1);
+
+            // Swapping two points keeps the rule but hides its tensor
+            // structure, which selects the point-by-point assembly
+            const IntegrationRule &ir =
+               IntRules.Get(el.GetGeomType(), 2*order + 3);
+            IntegrationRule ir_swap(ir.GetNPoints());
+            for (int i = 0; i < ir.GetNPoints(); i++)
+            {
+               ir_swap.IntPoint(i) = ir.IntPoint(i < 2 ? 1 - i : i);
+            }
+
+            BilinearFormIntegrator *integs[2][5] =
+            {
+               {
+                  new MassIntegrator, new MassIntegrator(q),
+                  new DiffusionIntegrator(q), new DiffusionIntegrator(vq),
+                  new DiffusionIntegrator(mq)
+               },
+               {
+                  new MassIntegrator, new MassIntegrator(q),
+                  new DiffusionIntegrator(q), new DiffusionIntegrator(vq),
+                  new DiffusionIntegrator(mq)
+               }
+            };
+            for (int k = 0; k < 5; k++)
+            {
+               integs[0][k]->SetIntRule(&ir);
+               integs[1][k]->SetIntRule(&ir_swap);
+               DenseMatrix elmat, elmat_ref;
+               integs[0][k]->AssembleElementMatrix(el, T, elmat);
+               integs[1][k]->AssembleElementMatrix(el, T, elmat_ref);
+               REQUIRE(elmat.Height() == el.GetDof());
+               elmat_ref -= elmat;
+               REQUIRE(elmat_ref.MaxMaxNorm() == MFEM_Approx(0.0, 1e-10));
+               delete integs[0][k];
+               delete integs[1][k];
+            }
+         }
+      }
+      delete mesh;
+   }
+}
+
+// Return the true dofs of @a fes on the whole boundary.
+static void GetBoundaryTrueDofs(FiniteElementSpace &fes, Array<int> &ess_tdofs)
+{
+   Array<int> ess_bdr(fes.GetMesh()->bdr_attributes.Max());
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdofs);
+}
+
+// Solve the system of the bilinear form @a a to high accuracy, with
+// homogeneous Dirichlet conditions on the true dofs @a ess_tdofs.
+static void SolveDirichlet(BilinearForm &a, LinearForm &b,
+                           const Array<int> &ess_tdofs, GridFunction &x)
+{
+   x = 0.0;
+   a.Assemble();
+   OperatorPtr A;
+   Vector B, X;
+   a.FormLinearSystem(ess_tdofs, x, b, A, X, B);
+   GSSmoother M((SparseMatrix&)(*A));
+   X = 0.0;
+   PCG(*A, M, B, X, 0, 2000, 1e-28, 0.0);
+   a.RecoverFEMSolution(X, b, x);
+}
+
+TEST_CASE("Static condensation and hybridization", "[BilinearForm]")
+{
+   // The element blocks are factored in batches of blocks of the same size
+   const int dim = 2, order = 3;
+   Mesh mesh(3, 4, Element::QUADRILATERAL, true, 1.0, 1.0);
+   ConstantCoefficient one(1.0);
+
+   SECTION("Static condensation")
+   {
+      // With nx = 40, the elements are factored in several chunks
+      auto nx = GENERATE(3, 40);
+      Mesh sc_mesh(nx, 30, Element::QUADRILATERAL, true, 1.0, 1.0);
+      H1_FECollection fec(order, dim);
+      FiniteElementSpace fes(&sc_mesh, &fec);
+      LinearForm b(&fes);
+      b.AddDomainIntegrator(new DomainLFIntegrator(one));
+      b.Assemble();
+
+      Array<int> ess_tdofs;
+      GetBoundaryTrueDofs(fes, ess_tdofs);
+      GridFunction x(&fes), x_sc(&fes);
+      for (GridFunction *y : {&x, &x_sc})
+      {
+         BilinearForm a(&fes);
+         a.AddDomainIntegrator(new DiffusionIntegrator(one));
+         if (y == &x_sc) { a.EnableStaticCondensation(); }
+         SolveDirichlet(a, b, ess_tdofs, *y);
+      }
+      x_sc -= x;
+      REQUIRE(x_sc.Normlinf() < 1e-9 * x.Normlinf());
+   }
+
+   SECTION("Hybridization")
+   {
+      RT_FECollection fec(order-1, dim);
+      FiniteElementSpace fes(&mesh, &fec);
+      DG_Interface_FECollection hfec(order-1, dim);
+      FiniteElementSpace hfes(&mesh, &hfec);
+      VectorFunctionCoefficient f(dim, [](const Vector &p, Vector &v)
+      {
+         v(0) = 1.0 + p(1);
+         v(1) = p(0)*p(0);
+      });
+      LinearForm b(&fes);
+      b.AddDomainIntegrator(new VectorFEDomainLFIntegrator(f));
+      b.Assemble();
+
+      Array<int> ess_tdofs;
+      GetBoundaryTrueDofs(fes, ess_tdofs);
+      GridFunction x(&fes), x_h(&fes);
+      for (GridFunction *y : {&x, &x_h})
+      {
+         BilinearForm a(&fes);
+         a.AddDomainIntegrator(new DivDivIntegrator(one));
+         a.AddDomainIntegrator(new VectorFEMassIntegrator(one));
+         if (y == &x_h)
+         {
+            a.EnableHybridization(&hfes, new NormalTraceJumpIntegrator(),
+                                  ess_tdofs);
+         }
+         SolveDirichlet(a, b, ess_tdofs, *y);
+      }
+      x_h -= x;
+      REQUIRE(x_h.Normlinf() < 1e-9 * x.Normlinf());
+   }
+}
@@ -233,3 +233,77 @@ TEST_CASE("CalcShape for several H1 FiniteElement instances",
    }
 
 }
+
+TEST_CASE("Reentrant tensor product shape functions",
+          "[H1_QuadrilateralElement]"
+          "[L2_QuadrilateralElement]"
+          "[Mesh]")
+{
+   // Orders above 31 use heap allocated scratch space for the 1D bases
+   SECTION("High order elements")
+   {
+      H1_QuadrilateralElement quad(40);
+      L2_QuadrilateralElement l2quad(35);
+
+      IntegrationPoint ip;
+      ip.Set2(0.3, 0.8);
+      Vector shape(quad.GetDof()), l2shape(l2quad.GetDof());
+      quad.CalcShape(ip, shape);
+      l2quad.CalcShape(ip, l2shape);
+      REQUIRE(shape.Sum() == MFEM_Approx(1.0, 1e-10));
+      REQUIRE(l2shape.Sum() == MFEM_Approx(1.0, 1e-10));
+
+      DenseMatrix dshape(quad.GetDof(), 2);
+      quad.CalcDShape(ip, dshape);
+      double dsum[2] = {0.0, 0.0};
+      for (int i = 0; i < quad.GetDof(); i++)
+      {
+         dsum[0] += dshape(i,0);
+         dsum[1] += dshape(i,1);
+      }
+      REQUIRE(dsum[0] == MFEM_Approx(0.0, 1e-8));
+      REQUIRE(dsum[1] == MFEM_Approx(0.0, 1e-8));
+   }
+
+   SECTION("Const element transformations")
+   {
+      Mesh mesh(4, 4, 4, Element::HEXAHEDRON, true);
+      mesh.SetCurvature(3);
+      const Mesh &cmesh = mesh;
+      const int NE = mesh.GetNE();
+      const IntegrationRule &ir = IntRules.Get(Geometry::CUBE, 6);
+
+      double vol = 0.0;
+      bool same = true;
+#ifdef _OPENMP
+      #pragma omp parallel for reduction(+:vol) reduction(&&:same)
+#endif
+      for (int e = 0; e < NE; e++)
+      {
+         IsoparametricTransformation T;
+         cmesh.GetElementTransformation(e, &T);
+         for (int q = 0; q < ir.GetNPoints(); q++)
+         {
+            const IntegrationPoint &ip = ir.IntPoint(q);
+            T.SetIntPoint(&ip);
+            vol += ip.weight * T.Weight();
+         }
+         same = same && T.ElementNo == e && T.GetFE()->GetOrder() == 3;
+      }
+      REQUIRE(same);
+      REQUIRE(vol == MFEM_Approx(1.0));
+
+      IsoparametricTransformation T;
+      for (int e = 0; e < NE; e++)
+      {
+         cmesh.GetElementTransformation(e, &T);
+         ElementTransformation *T_ref = mesh.GetElementTransformation(e);
+         const IntegrationPoint &ip = ir.IntPoint(e % ir.GetNPoints());
+         T.SetIntPoint(&ip);
+         T_ref->SetIntPoint(&ip);
+         DenseMatrix diff(T.Jacobian());
+         diff -= T_ref->Jacobian();
+         REQUIRE(diff.MaxMaxNorm() == MFEM_Approx(0.0));
+      }
+   }
+}
@@ -143,6 +143,70 @@ TEST_CASE("Save and load from collections", "[DataCollection]")
          REQUIRE(rmdir("base_00005") == 0);
       }
 
+      SECTION("Binary MFEM format")
+      {
+         std::cout<<"Testing binary MFEM format"<<std::endl;
+
+         VisItDataCollection dc("base", mesh);
+         dc.RegisterField("u", u);
+         dc.RegisterField("v", v);
+         dc.RegisterQField("qs",qs);
+         dc.RegisterQField("qv",qv);
+         dc.SetCycle(5);
+         dc.SetTime(8.0);
+
+         //Save the DataCollection in binary format and load it into a new
+         //DataCollection; the binary format is detected on load
+         dc.SetPadDigits(5);
+         dc.SetBinaryFormat(true);
+         dc.Save();
+
+         VisItDataCollection dc_new("base");
+         dc_new.SetPadDigits(5);
+         dc_new.Load(dc.GetCycle());
+         Mesh* mesh_new = dc_new.GetMesh();
+         GridFunction *u_new = dc_new.GetField("u");
+         GridFunction *v_new = dc_new.GetField("v");
+         QuadratureFunction *qs_new = dc_new.GetQField("qs");
+         QuadratureFunction *qv_new = dc_new.GetQField("qv");
+         REQUIRE(mesh_new);
+         REQUIRE(u_new);
+         REQUIRE(v_new);
+         REQUIRE(qs_new);
+         REQUIRE(qv_new);
+         REQUIRE(dc.GetTime() == dc_new.GetTime());
+
+         //The binary format stores the values exactly
+         REQUIRE(mesh->GetNE() == mesh_new->GetNE());
+         REQUIRE(mesh->GetNBE() == mesh_new->GetNBE());
+         Vector vert, vert_diff;
+         mesh->GetVertices(vert);
+         mesh_new->GetVertices(vert_diff);
+         vert_diff -= vert;
+         REQUIRE(vert_diff.Normlinf() == 0.0);
+
+         Vector u_diff(*u_new), v_diff(*v_new);
+         u_diff -= *u;
+         v_diff -= *v;
+         REQUIRE(u_diff.Normlinf() == 0.0);
+         REQUIRE(v_diff.Normlinf() == 0.0);
+
+         Vector qs_diff(*qs_new), qv_diff(*qv_new);
+         qs_diff -= *qs;
+         qv_diff -= *qv;
+         REQUIRE(qs_diff.Normlinf() == 0.0);
+         REQUIRE(qv_diff.Normlinf() == 0.0);
+
+         //Cleanup all the files
+         REQUIRE(remove("base_00005.mfem_root") == 0);
+         REQUIRE(remove("base_00005/mesh.00000") == 0);
+         REQUIRE(remove("base_00005/u.00000") == 0);
+         REQUIRE(remove("base_00005/v.00000") == 0);
+         REQUIRE(remove("base_00005/qs.00000") == 0);
+         REQUIRE(remove("base_00005/qv.00000") == 0);
+         REQUIRE(rmdir("base_00005") == 0);
+      }
+
 #ifdef MFEM_USE_ZLIB
       SECTION("Compressed MFEM format")
       {
@@ -235,3 +299,108 @@ TEST_CASE("Save and load from collections", "[DataCollection]")
    }
 
 }
+
+static bool FileExists(const char *fname)
+{
+   FILE *f = fopen(fname, "r");
+   if (f) { fclose(f); }
+   return f != NULL;
+}
+
+static std::string FileContents(const char *fname)
+{
+   std::ifstream f(fname);
+   std::stringstream contents;
+   contents << f.rdbuf();
+   return contents.str();
+}
+
+TEST_CASE("Save the mesh only when it changes", "[DataCollection]")
+{
+   Mesh mesh(2, 3, Element::QUADRILATERAL, 0, 2.0, 3.0);
+   H1_FECollection fec(1, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   GridFunction u(&fes);
+   u = 1.0;
+
+   Vector vert;
+   mesh.GetVertices(vert);
+   Vector moved(vert);
+   moved *= 1.5;
+
+   SECTION("VisIt data files")
+   {
+      VisItDataCollection dc("reuse", &mesh);
+      dc.SetMeshReuse(true);
+      dc.SetPadDigits(5);
+      dc.RegisterField("u", &u);
+      for (int cycle = 1; cycle <= 3; cycle++)
+      {
+         if (cycle == 3) { mesh.SetVertices(moved); }
+         dc.SetCycle(cycle);
+         dc.Save();
+      }
+      REQUIRE(FileExists("reuse_00001/mesh.00000"));
+      REQUIRE(!FileExists("reuse_00002/mesh.00000"));
+      REQUIRE(FileExists("reuse_00003/mesh.00000"));
+
+      // Cycle 2 refers to the mesh of cycle 1
+      VisItDataCollection dc_new("reuse");
+      dc_new.SetPadDigits(5);
+      dc_new.Load(2);
+      REQUIRE(dc_new.Error() == DataCollection::NO_ERROR);
+      REQUIRE(dc_new.GetCycle() == 2);
+      Vector vert_new;
+      dc_new.GetMesh()->GetVertices(vert_new);
+      vert_new -= vert;
+      REQUIRE(vert_new.Normlinf() < 1e-10);
+      REQUIRE(dc_new.GetField("u"));
+
+      const char *files[] =
+      {
+         "reuse_00001.mfem_root", "reuse_00002.mfem_root",
+         "reuse_00003.mfem_root", "reuse_00001/mesh.00000",
+         "reuse_00003/mesh.00000", "reuse_00001/u.00000",
+         "reuse_00002/u.00000", "reuse_00003/u.00000"
+      };
+      for (int i = 0; i < 8; i++) { REQUIRE(remove(files[i]) == 0); }
+      REQUIRE(rmdir("reuse_00001") == 0);
+      REQUIRE(rmdir("reuse_00002") == 0);
+      REQUIRE(rmdir("reuse_00003") == 0);
+   }
+
+   SECTION("ParaView data files")
+   {
+      {
+         ParaViewDataCollection dc("reuse_pv", &mesh);
+         dc.SetPadDigits(5);
+         dc.SetDataFormat(VTKFormat::ASCII);
+         dc.RegisterField("u", &u);
+         for (int cycle = 0; cycle < 3; cycle++)
+         {
+            if (cycle == 2) { mesh.SetVertices(moved); }
+            dc.SetCycle(cycle);
+            dc.Save();
+         }
+      }
+      const std::string vtu0 = FileContents("reuse_pv/Cycle00000/proc00000.vtu");
+      const std::string vtu1 = FileContents("reuse_pv/Cycle00001/proc00000.vtu");
+      const std::string vtu2 = FileContents("reuse_pv/Cycle00002/proc00000.vtu");
+      REQUIRE(vtu0.size() > 0);
+      REQUIRE(vtu0 == vtu1);
+      REQUIRE(vtu0 != vtu2);
+
+      const char *dirs[] =
+      {
+         "reuse_pv/Cycle00000", "reuse_pv/Cycle00001", "reuse_pv/Cycle00002"
+      };
+      for (int i = 0; i < 3; i++)
+      {
+         REQUIRE(remove((std::string(dirs[i]) + "/proc00000.vtu").c_str()) == 0);
+         REQUIRE(remove((std::string(dirs[i]) + "/data.pvtu").c_str()) == 0);
+         REQUIRE(rmdir(dirs[i]) == 0);
+      }
+      REQUIRE(remove("reuse_pv/reuse_pv.pvd") == 0);
+      REQUIRE(rmdir("reuse_pv") == 0);
+   }
+}
@@ -0,0 +1,82 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace dgmassinv
+{
+
+static double coeff(const Vector &x)
+{
+   return 1.0 + x(0)*x(0) + 0.5*x(1);
+}
+
+static void curve(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.1*sin(M_PI*x(1));
+   y(1) += 0.1*sin(M_PI*x(0));
+}
+
+// Apply DGMassInverse and return the relative residual with respect to the
+// fully assembled mass matrix.
+static double TestDGMassInverse(int dim, int order, bool curved,
+                                bool variable_coeff)
+{
+   Mesh *mesh = (dim == 2) ?
+                new Mesh(3, 3, Element::QUADRILATERAL, true, 1.0, 1.0) :
+                new Mesh(2, 2, 2, Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+   if (curved)
+   {
+      mesh->SetCurvature(2);
+      mesh->Transform(curve);
+   }
+   double res;
+   {
+      L2_FECollection fec(order, dim, BasisType::GaussLobatto);
+      FiniteElementSpace fes(mesh, &fec);
+
+      ConstantCoefficient one(1.0);
+      FunctionCoefficient f(coeff);
+      Coefficient &Q = variable_coeff ? static_cast<Coefficient&>(f) : one;
+
+      DGMassInverse minv(fes, Q);
+      BilinearForm m(&fes);
+      m.AddDomainIntegrator(new MassIntegrator(Q));
+      m.Assemble();
+      m.Finalize();
+
+      Vector b(fes.GetVSize()), x(fes.GetVSize()), r(fes.GetVSize());
+      b.Randomize(1);
+      minv.Mult(b, x);
+      m.SpMat().Mult(x, r);
+      r -= b;
+      res = r.Normlinf() / b.Normlinf();
+   }
+   delete mesh;
+   return res;
+}
+
+TEST_CASE("DGMassInverse", "[DGMassInverse]")
+{
+   auto dim = GENERATE(2, 3);
+   auto order = GENERATE(0, 1, 2, 3, 4);
+   auto curved = GENERATE(false, true);
+   auto variable_coeff = GENERATE(false, true);
+   INFO("dim = " << dim << ", order = " << order << ", curved = " << curved
+        << ", variable coefficient = " << variable_coeff);
+   REQUIRE(TestDGMassInverse(dim, order, curved, variable_coeff) < 1e-10);
+}
+
+} // namespace dgmassinv
@@ -435,4 +435,77 @@ TEST_CASE("Kelly Error Estimator on 3D NCMesh",
    delete pmesh;
 }
 
+TEST_CASE("Kelly Error Estimator on conforming meshes",
+          "[Parallel]")
+{
+   // The batched face kernels are used on conforming meshes, compare with the
+   // same mesh in non-conforming mode, which uses face transformations. Prism
+   // meshes, with triangle and quadrilateral faces, use face transformations
+   // in both modes.
+   const auto type = GENERATE(Element::QUADRILATERAL, Element::TETRAHEDRON,
+                              Element::WEDGE);
+   const auto order = GENERATE(1, 3);
+   const int dim = (type == Element::QUADRILATERAL) ? 2 : 3;
+
+   double total_error[2], weighted_error[2];
+   for (int nc = 0; nc < 2; nc++)
+   {
+      Mesh *mesh;
+      if (dim == 2)
+      {
+         mesh = new Mesh(4, 3, Element::QUADRILATERAL, true, 1.0, 1.0);
+      }
+      else
+      {
+         mesh = new Mesh(2, 3, 2, type, true, 1.0, 1.0, 1.0);
+      }
+      for (int i = 0; i < mesh->GetNV(); i++)
+      {
+         double *v = mesh->GetVertex(i);
+         v[0] += 0.05*sin(7.0*v[1]);
+      }
+      if (nc) { mesh->EnsureNCMesh(); }
+
+      int num_procs;
+      MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+      Array<int> partitioning(mesh->GetNE());
+      for (int i = 0; i < mesh->GetNE(); i++)
+      {
+         partitioning[i] = i * num_procs / mesh->GetNE();
+      }
+      ParMesh pmesh(MPI_COMM_WORLD, *mesh, partitioning.GetData());
+      delete mesh;
+
+      H1_FECollection fe_coll(order, dim);
+      ParFiniteElementSpace fespace(&pmesh, &fe_coll);
+      FunctionCoefficient u_analytic(testhelper::NonsmoothSolutionX);
+      ParGridFunction u_gf(&fespace);
+      u_gf.ProjectCoefficient(u_analytic);
+
+      L2_FECollection flux_fec(order, dim);
+      ParFiniteElementSpace flux_fes(&pmesh, &flux_fec, dim);
+      DiffusionIntegrator di;
+      KellyErrorEstimator estimator(di, u_gf, flux_fes);
+
+      // the element order may differ, weight the errors by position
+      const Vector &local_errors = estimator.GetLocalErrors();
+      double weighted = 0.0;
+      for (int i = 0; i < local_errors.Size(); i++)
+      {
+         Vector center;
+         pmesh.GetElementCenter(i, center);
+         weighted += local_errors(i) * (1.0 + center(0) + 10.0*center(1));
+      }
+      MPI_Allreduce(&weighted, &weighted_error[nc], 1, MPI_DOUBLE, MPI_SUM,
+                    MPI_COMM_WORLD);
+      total_error[nc] = estimator.GetTotalError();
+
+      // the estimator does not add nodes to the mesh
+      REQUIRE(pmesh.GetNodes() == NULL);
+   }
+   REQUIRE(total_error[0] > 0.0);
+   REQUIRE(total_error[0] == MFEM_Approx(total_error[1]));
+   REQUIRE(weighted_error[0] == MFEM_Approx(weighted_error[1]));
+}
+
 #endif
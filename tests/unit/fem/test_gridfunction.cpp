@@ -0,0 +1,181 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+TEST_CASE("Batched element Lp distances", "[GridFunction]")
+{
+   const auto dim = GENERATE(2, 3);
+   const auto type = GENERATE(0, 1);
+   const int order = 2;
+
+   Mesh *mesh;
+   if (dim == 2)
+   {
+      mesh = new Mesh(3, 4, type ? Element::TRIANGLE : Element::QUADRILATERAL,
+                      true, 1.0, 1.0);
+   }
+   else
+   {
+      mesh = new Mesh(2, 2, 3, type ? Element::TETRAHEDRON :
+                      Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+   }
+   for (int i = 0; i < mesh->GetNV(); i++)
+   {
+      double *v = mesh->GetVertex(i);
+      v[0] += 0.05*sin(4.0*v[1]);
+   }
+
+   H1_FECollection h1_fec(order, dim);
+   L2_FECollection l2_fec(order - 1, dim);
+   FiniteElementSpace h1_fes(mesh, &h1_fec, dim);
+   FiniteElementSpace l2_fes(mesh, &l2_fec, dim);
+
+   VectorFunctionCoefficient f1(dim, [](const Vector &x, Vector &y)
+   {
+      for (int i = 0; i < y.Size(); i++) { y(i) = sin(x(0) + i*x(1)); }
+   });
+   VectorFunctionCoefficient f2(dim, [](const Vector &x, Vector &y)
+   {
+      for (int i = 0; i < y.Size(); i++) { y(i) = x(0)*x(1) - i; }
+   });
+   GridFunction gf1(&h1_fes), gf2(&l2_fes);
+   gf1.ProjectCoefficient(f1);
+   gf2.ProjectCoefficient(f2);
+
+   for (double p : { 1.0, 2.0, infinity() })
+   {
+      Vector distances;
+      ComputeElementLpDistances(p, gf1, gf2, distances);
+      REQUIRE(distances.Size() == mesh->GetNE());
+      distances.HostRead();
+      for (int i = 0; i < mesh->GetNE(); i++)
+      {
+         double dist = ComputeElementLpDistance(p, i, gf1, gf2);
+         REQUIRE(distances(i) == MFEM_Approx(dist));
+      }
+   }
+
+   delete mesh;
+}
+
+TEST_CASE("Batched projection and Lp errors", "[GridFunction]")
+{
+   const auto dim = GENERATE(2, 3);
+   const auto type = GENERATE(0, 1);
+   const auto order = GENERATE(1, 3);
+
+   Mesh *mesh;
+   if (dim == 2)
+   {
+      mesh = new Mesh(3, 4, type ? Element::TRIANGLE : Element::QUADRILATERAL,
+                      true, 1.0, 1.0);
+   }
+   else
+   {
+      mesh = new Mesh(2, 2, 3, type ? Element::TETRAHEDRON :
+                      Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+   }
+   for (int i = 0; i < mesh->GetNV(); i++)
+   {
+      double *v = mesh->GetVertex(i);
+      v[0] += 0.05*sin(4.0*v[1]);
+   }
+   for (int i = 0; i < mesh->GetNE(); i++)
+   {
+      mesh->SetAttribute(i, 1 + i % 2);
+   }
+   mesh->SetAttributes();
+
+   H1_FECollection h1_fec(order, dim);
+   L2_FECollection l2_fec(order - 1, dim);
+   FiniteElementSpace h1_fes(mesh, &h1_fec);
+   FiniteElementSpace l2_fes(mesh, &l2_fec);
+
+   FunctionCoefficient f([](const Vector &x) { return sin(x(0) + 2*x(1)); });
+   Vector pw_vals(2);
+   pw_vals(0) = 1.0; pw_vals(1) = 3.0;
+   PWConstCoefficient pw(pw_vals);
+   ProductCoefficient fpw(f, pw);
+
+   for (FiniteElementSpace *fes : { &h1_fes, &l2_fes })
+   {
+      // Reference projection with the element loop
+      GridFunction gf(fes), gf_ref(fes);
+      gf = 0.0;
+      gf_ref = 0.0;
+      gf.ProjectCoefficient(fpw);
+      Array<int> vdofs;
+      Vector vals;
+      for (int i = 0; i < mesh->GetNE(); i++)
+      {
+         fes->GetElementVDofs(i, vdofs);
+         vals.SetSize(vdofs.Size());
+         fes->GetFE(i)->Project(fpw, *mesh->GetElementTransformation(i), vals);
+         gf_ref.SetSubVector(vdofs, vals);
+      }
+      gf.HostRead();
+      gf_ref -= gf;
+      REQUIRE(gf_ref.Normlinf() == MFEM_Approx(0.0));
+
+      // Reference Lp errors with the element loop
+      for (double p : { 1.0, 2.0, infinity() })
+      {
+         for (Coefficient *weight : { (Coefficient *) NULL, (Coefficient *) &pw })
+         {
+            Vector elem_ref(mesh->GetNE());
+            double error_ref = 0.0;
+            for (int i = 0; i < mesh->GetNE(); i++)
+            {
+               const FiniteElement *fe = fes->GetFE(i);
+               const IntegrationRule &ir =
+                  IntRules.Get(fe->GetGeomType(), 2*fe->GetOrder() + 3);
+               ElementTransformation *T = mesh->GetElementTransformation(i);
+               gf.GetValues(i, ir, vals);
+               double err_i = 0.0;
+               for (int j = 0; j < ir.GetNPoints(); j++)
+               {
+                  const IntegrationPoint &ip = ir.IntPoint(j);
+                  T->SetIntPoint(&ip);
+                  double err = fabs(vals(j) - f.Eval(*T, ip));
+                  if (p < infinity()) { err = pow(err, p); }
+                  if (weight) { err *= weight->Eval(*T, ip); }
+                  if (p < infinity())
+                  {
+                     err_i += ip.weight * T->Weight() * err;
+                  }
+                  else { err_i = std::max(err_i, err); }
+               }
+               error_ref = (p < infinity()) ? error_ref + err_i :
+                           std::max(error_ref, err_i);
+               elem_ref(i) = (p < infinity()) ? pow(err_i, 1.0/p) : err_i;
+            }
+            if (p < infinity()) { error_ref = pow(error_ref, 1.0/p); }
+
+            REQUIRE(gf.ComputeLpError(p, f, weight) == MFEM_Approx(error_ref));
+            Vector elem_err(mesh->GetNE());
+            gf.ComputeElementLpErrors(p, f, elem_err, weight);
+            elem_err.HostRead();
+            for (int i = 0; i < mesh->GetNE(); i++)
+            {
+               REQUIRE(elem_err(i) == MFEM_Approx(elem_ref(i)));
+            }
+         }
+      }
+   }
+   // The batched evaluation does not add nodes to the mesh
+   REQUIRE(mesh->GetNodes() == NULL);
+
+   delete mesh;
+}
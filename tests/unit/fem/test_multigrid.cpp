@@ -0,0 +1,132 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace multigrid
+{
+
+// Solve a diffusion problem with PCG preconditioned by a BilinearFormMultigrid
+// built on a hierarchy with geometric and order refinements, and return the
+// number of iterations. The solution is compared with a direct assembly. The
+// multigrid is built from a prototype form or, with use_factory, from a
+// function adding the integrators of each level.
+static int TestBilinearFormMultigrid(int dim, AssemblyLevel assembly,
+                                     bool use_factory)
+{
+   Mesh *mesh = (dim == 2) ?
+                new Mesh(2, 2, Element::QUADRILATERAL, true, 1.0, 1.0) :
+                new Mesh(2, 2, 2, Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+   H1_FECollection fec1(1, dim), fec2(2, dim), fec4(4, dim);
+   FiniteElementSpace *coarse_fespace = new FiniteElementSpace(mesh, &fec1);
+   FiniteElementSpaceHierarchy fespaces(mesh, coarse_fespace, true, true);
+   fespaces.AddUniformlyRefinedLevel();
+   fespaces.AddOrderRefinedLevel(&fec2);
+   fespaces.AddOrderRefinedLevel(&fec4);
+   FiniteElementSpace &fespace = fespaces.GetFinestFESpace();
+
+   Array<int> ess_bdr(mesh->bdr_attributes.Max());
+   ess_bdr = 1;
+
+   ConstantCoefficient one(1.0);
+   auto add_integrators = [&one](BilinearForm &form)
+   {
+      form.AddDomainIntegrator(new DiffusionIntegrator(one));
+   };
+   BilinearForm a(&fespace);
+   a.SetAssemblyLevel(assembly);
+   add_integrators(a);
+   BilinearFormMultigrid *mg_ptr;
+   if (use_factory)
+   {
+      mg_ptr = new BilinearFormMultigrid(fespaces, add_integrators, assembly,
+                                         ess_bdr);
+   }
+   else
+   {
+      mg_ptr = new BilinearFormMultigrid(fespaces, a, ess_bdr);
+   }
+   BilinearFormMultigrid &mg = *mg_ptr;
+   REQUIRE(mg.NumLevels() == 4);
+   // The coarsest level is always assembled; with the factory, the other
+   // levels use the given assembly level.
+   REQUIRE(dynamic_cast<SparseMatrix*>(mg.GetOperatorAtLevel(0)) != NULL);
+   for (int level = 1; level < 4; level++)
+   {
+      const bool assembled =
+         dynamic_cast<SparseMatrix*>(mg.GetOperatorAtLevel(level)) != NULL;
+      const bool pa_level = use_factory || level == 3;
+      REQUIRE(assembled ==
+              !(pa_level && assembly == AssemblyLevel::PARTIAL));
+   }
+
+   LinearForm b(&fespace);
+   b.AddDomainIntegrator(new DomainLFIntegrator(one));
+   b.Assemble();
+   GridFunction x(&fespace);
+   x = 0.0;
+
+   OperatorPtr A;
+   Vector B, X;
+   mg.FormFineLinearSystem(x, b, A, X, B);
+
+   CGSolver cg;
+   cg.SetRelTol(1e-10);
+   cg.SetMaxIter(100);
+   cg.SetOperator(*A);
+   cg.SetPreconditioner(mg);
+   cg.Mult(B, X);
+   REQUIRE(cg.GetConverged());
+   mg.RecoverFineFEMSolution(X, b, x);
+   const int iterations = cg.GetNumIterations();
+   delete mg_ptr;
+
+   // Reference solution using a separately assembled matrix
+   BilinearForm a_ref(&fespace);
+   a_ref.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a_ref.Assemble();
+   Array<int> ess_tdofs;
+   fespace.GetEssentialTrueDofs(ess_bdr, ess_tdofs);
+   GridFunction x_ref(&fespace);
+   x_ref = 0.0;
+   OperatorPtr A_ref;
+   Vector B_ref, X_ref;
+   a_ref.FormLinearSystem(ess_tdofs, x_ref, b, A_ref, X_ref, B_ref);
+   CGSolver cg_ref;
+   GSSmoother gs(*A_ref.As<SparseMatrix>());
+   cg_ref.SetRelTol(1e-12);
+   cg_ref.SetMaxIter(2000);
+   cg_ref.SetOperator(*A_ref);
+   cg_ref.SetPreconditioner(gs);
+   cg_ref.Mult(B_ref, X_ref);
+   a_ref.RecoverFEMSolution(X_ref, b, x_ref);
+
+   x -= x_ref;
+   REQUIRE(x.Normlinf() < 1e-8 * x_ref.Normlinf());
+
+   return iterations;
+}
+
+TEST_CASE("BilinearFormMultigrid", "[Multigrid]")
+{
+   auto dim = GENERATE(2, 3);
+   auto assembly = GENERATE(AssemblyLevel::PARTIAL, AssemblyLevel::LEGACYFULL);
+   auto use_factory = GENERATE(false, true);
+   INFO("dim = " << dim << ", partial assembly = "
+        << (assembly == AssemblyLevel::PARTIAL)
+        << ", use_factory = " << use_factory);
+   REQUIRE(TestBilinearFormMultigrid(dim, assembly, use_factory) < 15);
+}
+
+} // namespace multigrid
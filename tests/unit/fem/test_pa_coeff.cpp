@@ -849,4 +849,98 @@ TEST_CASE("Hcurl/Hdiv mixed pa_coeff",
    }
 }
 
+TEST_CASE("Batched coefficient evaluation", "[CUDA]")
+{
+   for (dimension = 2; dimension < 4; ++dimension)
+   {
+      Mesh *mesh = (dimension == 2) ?
+                   new Mesh(4, 3, Element::QUADRILATERAL, true) :
+                   new Mesh(3, 2, 2, Element::HEXAHEDRON, true);
+      for (int e = 0; e < mesh->GetNE(); e++)
+      {
+         mesh->SetAttribute(e, 1 + e % 3);
+      }
+      mesh->SetAttributes();
+      mesh->SetCurvature(2);
+      GridFunction &nodes = *mesh->GetNodes();
+      for (int i = 0; i < nodes.Size(); i++)
+      {
+         nodes(i) += 0.01 * sin(7.0 * nodes(i));
+      }
+
+      H1_FECollection h1_fec(2, dimension);
+      L2_FECollection l2_fec(1, dimension);
+      FiniteElementSpace h1_fes(mesh, &h1_fec);
+      FiniteElementSpace l2_fes(mesh, &l2_fec);
+      FunctionCoefficient f_coeff(coeffFunction);
+      FunctionCoefficient lin_coeff(linearFunction);
+      GridFunction h1_gf(&h1_fes), l2_gf(&l2_fes);
+      h1_gf.ProjectCoefficient(f_coeff);
+      l2_gf.ProjectCoefficient(lin_coeff);
+
+      Vector pw_vals(3);
+      pw_vals(0) = 1.0; pw_vals(1) = 2.5; pw_vals(2) = -0.5;
+      ConstantCoefficient c_coeff(3.0);
+      PWConstCoefficient pw_coeff(pw_vals);
+      GridFunctionCoefficient h1_coeff(&h1_gf), l2_coeff(&l2_gf);
+      SumCoefficient sum_coeff(h1_coeff, pw_coeff, 2.0, -1.0);
+      SumCoefficient sum_const_coeff(1.5, l2_coeff);
+      ProductCoefficient prod_coeff(sum_coeff, f_coeff);
+      ProductCoefficient prod_const_coeff(0.5, l2_coeff);
+
+      const IntegrationRule &ir =
+         IntRules.Get(mesh->GetElementBaseGeometry(0), 5);
+      QuadratureSpace qspace(mesh, 5);
+      QuadratureFunction qf(&qspace);
+      for (int i = 0; i < qf.Size(); i++) { qf(i) = 0.1 * i; }
+      QuadratureFunctionCoefficient qf_coeff(qf);
+      REQUIRE(&qspace.GetElementIntRule(0) == &ir);
+
+      Coefficient *coeffs[] = { &c_coeff, &pw_coeff, &f_coeff, &h1_coeff,
+                                &l2_coeff, &sum_coeff, &sum_const_coeff,
+                                &prod_coeff, &prod_const_coeff, &qf_coeff
+                              };
+      const int NE = mesh->GetNE(), NQ = ir.GetNPoints();
+      for (Coefficient *coeff : coeffs)
+      {
+         Vector batch;
+         coeff->EvalBatch(batch, *mesh, ir);
+         REQUIRE(batch.Size() == NQ*NE);
+         batch.HostRead();
+         double max_err = 0.0;
+         for (int e = 0; e < NE; e++)
+         {
+            ElementTransformation &T = *mesh->GetElementTransformation(e);
+            for (int q = 0; q < NQ; q++)
+            {
+               const IntegrationPoint &ip = ir.IntPoint(q);
+               T.SetIntPoint(&ip);
+               const double val = coeff->Eval(T, ip);
+               max_err = std::max(max_err, fabs(batch(q + e*NQ) - val));
+            }
+         }
+         REQUIRE(max_err < 1e-12);
+      }
+
+      // Partial assembly setup with a composite coefficient
+      Vector x(h1_fes.GetVSize()), y_pa(x.Size()), y_fa(x.Size());
+      x.Randomize(1);
+      BilinearForm pa_form(&h1_fes), fa_form(&h1_fes);
+      pa_form.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      pa_form.AddDomainIntegrator(new MassIntegrator(prod_coeff));
+      pa_form.AddDomainIntegrator(new DiffusionIntegrator(sum_const_coeff));
+      fa_form.AddDomainIntegrator(new MassIntegrator(prod_coeff));
+      fa_form.AddDomainIntegrator(new DiffusionIntegrator(sum_const_coeff));
+      pa_form.Assemble();
+      fa_form.Assemble();
+      fa_form.Finalize();
+      pa_form.Mult(x, y_pa);
+      fa_form.Mult(x, y_fa);
+      y_pa -= y_fa;
+      REQUIRE(y_pa.Normlinf() < 1e-11 * y_fa.Normlinf());
+
+      delete mesh;
+   }
+}
+
 } // namespace pa_coeff
@@ -11,6 +11,7 @@
 
 #include "unit_tests.hpp"
 #include "mfem.hpp"
+#include "linalg/simd.hpp"
 #include <fstream>
 #include <iostream>
 
@@ -459,4 +460,458 @@ TEST_CASE("PA Convection", "[PartialAssembly]")
 
 } // test case
 
+// DG face terms on L2 spaces are applied with the fused face kernels, on the
+// L-vectors. With the TransposeIntegrator, the transposed kernels are used.
+void test_pa_dg_trace(const char *meshname, int order, bool transpose_integ)
+{
+   INFO("mesh=" << meshname << ", order=" << order
+        << ", transpose_integ=" << transpose_integ);
+   Mesh mesh(meshname, 1, 1);
+   int dim = mesh.Dimension();
+   L2_FECollection fec(order, dim, BasisType::GaussLobatto);
+   FiniteElementSpace fespace(&mesh, &fec);
+
+   VectorFunctionCoefficient vel_coeff(dim, velocity_function);
+   FunctionCoefficient rho([](const Vector &x) { return 1.0 + x(0)*x(0); });
+
+   BilinearForm k_pa(&fespace), k_fa(&fespace);
+   for (BilinearForm *k : {&k_pa, &k_fa})
+   {
+      for (int bdr = 0; bdr < 2; bdr++)
+      {
+         BilinearFormIntegrator *integ =
+            new DGTraceIntegrator(rho, vel_coeff, 1.0, -0.5);
+         if (transpose_integ) { integ = new TransposeIntegrator(integ); }
+         if (bdr) { k->AddBdrFaceIntegrator(integ); }
+         else { k->AddInteriorFaceIntegrator(integ); }
+      }
+   }
+   k_fa.Assemble();
+   k_fa.Finalize();
+   k_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   k_pa.Assemble();
+
+   GridFunction x(&fespace), y_fa(&fespace), y_pa(&fespace);
+   x.Randomize(1);
+
+   k_fa.Mult(x, y_fa);
+   k_pa.Mult(x, y_pa);
+   y_pa -= y_fa;
+
+   REQUIRE(y_pa.Normlinf() < 1.e-12 * y_fa.Normlinf());
+}
+
+TEST_CASE("PA DG Trace", "[PartialAssembly]")
+{
+   auto order = GENERATE(0, 1, 3);
+   auto transpose_integ = GENERATE(false, true);
+
+   test_pa_dg_trace("../../data/star-q3.mesh", order, transpose_integ);
+   test_pa_dg_trace("../../data/fichera-q3.mesh", order, transpose_integ);
+}
+
+// With SetFusedFaces(true), a ConvectionIntegrator with DG face terms on an L2
+// space is applied with a single element kernel, which also evaluates the face
+// terms of each element. The transpose uses the fused face kernels.
+void test_pa_convection_dg_faces(const char *meshname, int order,
+                                 bool transpose_integ, bool bdr_faces,
+                                 bool fused)
+{
+   INFO("mesh=" << meshname << ", order=" << order
+        << ", transpose_integ=" << transpose_integ
+        << ", bdr_faces=" << bdr_faces << ", fused=" << fused);
+   Mesh mesh(meshname, 1, 1);
+   int dim = mesh.Dimension();
+   L2_FECollection fec(order, dim, BasisType::GaussLobatto);
+   FiniteElementSpace fespace(&mesh, &fec);
+
+   VectorFunctionCoefficient vel_coeff(dim, velocity_function);
+   FunctionCoefficient rho([](const Vector &x) { return 1.0 + x(0)*x(0); });
+
+   BilinearForm k_pa(&fespace), k_fa(&fespace);
+   for (BilinearForm *k : {&k_pa, &k_fa})
+   {
+      ConvectionIntegrator *conv = new ConvectionIntegrator(vel_coeff, -1.0);
+      conv->SetFusedFaces(fused);
+      k->AddDomainIntegrator(conv);
+      for (int bdr = 0; bdr < (bdr_faces ? 2 : 1); bdr++)
+      {
+         BilinearFormIntegrator *integ =
+            new DGTraceIntegrator(rho, vel_coeff, 1.0, -0.5);
+         if (transpose_integ) { integ = new TransposeIntegrator(integ); }
+         if (bdr) { k->AddBdrFaceIntegrator(integ); }
+         else { k->AddInteriorFaceIntegrator(integ); }
+      }
+   }
+   k_fa.Assemble();
+   k_fa.Finalize();
+   k_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   k_pa.Assemble();
+
+   GridFunction x(&fespace), y_fa(&fespace), y_pa(&fespace);
+   x.Randomize(1);
+
+   k_fa.Mult(x, y_fa);
+   k_pa.Mult(x, y_pa);
+   y_pa -= y_fa;
+   REQUIRE(y_pa.Normlinf() < 1.e-12 * y_fa.Normlinf());
+
+   k_fa.MultTranspose(x, y_fa);
+   k_pa.MultTranspose(x, y_pa);
+   y_pa -= y_fa;
+   REQUIRE(y_pa.Normlinf() < 1.e-12 * y_fa.Normlinf());
+}
+
+TEST_CASE("PA Convection with DG Faces", "[PartialAssembly]")
+{
+   auto order = GENERATE(0, 1, 2, 4);
+   auto transpose_integ = GENERATE(false, true);
+   auto bdr_faces = GENERATE(false, true);
+   auto fused = GENERATE(false, true);
+
+   test_pa_convection_dg_faces("../../data/inline-quad.mesh", order,
+                               transpose_integ, bdr_faces, fused);
+   test_pa_convection_dg_faces("../../data/star-q3.mesh", order,
+                               transpose_integ, bdr_faces, fused);
+   test_pa_convection_dg_faces("../../data/inline-hex.mesh", order,
+                               transpose_integ, bdr_faces, fused);
+   test_pa_convection_dg_faces("../../data/fichera-q3.mesh", order,
+                               transpose_integ, bdr_faces, fused);
+}
+
+void nonsymmetric_matrix_function(const Vector &x, DenseMatrix &K)
+{
+   K(0,0) = 2.0 + x(0); K(0,1) = 0.5*x(1); K(0,2) = 0.1;
+   K(1,0) = -0.2;       K(1,1) = 1.5;      K(1,2) = 0.3*x(2);
+   K(2,0) = 0.4*x(0);   K(2,1) = 0.0;      K(2,2) = 1.0 + x(1)*x(2);
+}
+
+void skew_transformation(const Vector &x, Vector &y)
+{
+   y(0) = x(0) + 0.1*x(1)*x(2);
+   y(1) = x(1) + 0.2*x(0);
+   y(2) = x(2) - 0.1*x(0)*x(1);
+}
+
+// The number of elements, 7, is not a multiple of the SIMD batch size used by
+// the host kernels, so the partially filled last batch is also tested.
+void test_pa_mass_diffusion_3d(int order, int coeff_type)
+{
+   INFO("order=" << order << ", coeff_type=" << coeff_type);
+   Mesh mesh(7, 1, 1, Element::HEXAHEDRON, false, 7.0, 1.0, 1.0);
+   mesh.Transform(skew_transformation);
+
+   H1_FECollection fec(order, 3);
+   FiniteElementSpace fespace(&mesh, &fec);
+
+   FunctionCoefficient q_coeff(
+      [](const Vector &x) { return 1.0 + x(0)*x(1) + x(2); });
+   MatrixFunctionCoefficient k_coeff(3, nonsymmetric_matrix_function);
+
+   BilinearForm k_pa(&fespace), k_fa(&fespace);
+   for (BilinearForm *k : {&k_pa, &k_fa})
+   {
+      k->AddDomainIntegrator(new MassIntegrator(q_coeff));
+      if (coeff_type == 0)
+      {
+         k->AddDomainIntegrator(new DiffusionIntegrator(q_coeff));
+      }
+      else
+      {
+         k->AddDomainIntegrator(new DiffusionIntegrator(k_coeff));
+      }
+   }
+   k_fa.Assemble();
+   k_fa.Finalize();
+   k_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   k_pa.Assemble();
+
+   GridFunction x(&fespace), y_fa(&fespace), y_pa(&fespace);
+   x.Randomize(1);
+   k_fa.Mult(x, y_fa);
+   k_pa.Mult(x, y_pa);
+   y_pa -= y_fa;
+
+   REQUIRE(y_pa.Normlinf() < 1.e-12 * y_fa.Normlinf());
+}
+
+TEST_CASE("PA Mass and Diffusion 3D", "[PartialAssembly]")
+{
+   // coeff_type: 0: scalar (symmetric qdata), 1: nonsymmetric matrix
+   auto coeff_type = GENERATE(0, 1);
+   auto order = GENERATE(1, 2, 3, 4, 5);
+   test_pa_mass_diffusion_3d(order, coeff_type);
+}
+
+#if defined(MFEM_SIMD_DISPATCH) && !defined(_WIN32)
+// Select the host SIMD kernels with the environment variable MFEM_SIMD, see
+// Device::GetSimdBytes(), and return the action of a 3D PA mass and diffusion
+// operator.
+static void pa_mass_diffusion_3d_simd(const char *isa, Vector &y)
+{
+   setenv("MFEM_SIMD", isa, 1);
+   Device::DetectSimd();
+
+   Mesh mesh(5, 1, 1, Element::HEXAHEDRON, false, 5.0, 1.0, 1.0);
+   mesh.Transform(skew_transformation);
+   H1_FECollection fec(3, 3);
+   FiniteElementSpace fespace(&mesh, &fec);
+   FunctionCoefficient q_coeff(
+      [](const Vector &x) { return 1.0 + x(0)*x(1) + x(2); });
+
+   BilinearForm k(&fespace);
+   k.AddDomainIntegrator(new MassIntegrator(q_coeff));
+   k.AddDomainIntegrator(new DiffusionIntegrator(q_coeff));
+   k.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   k.Assemble();
+
+   GridFunction x(&fespace);
+   x.Randomize(1);
+   y.SetSize(fespace.GetVSize());
+   k.Mult(x, y);
+}
+
+TEST_CASE("PA Host SIMD Kernel Selection", "[PartialAssembly]")
+{
+   const char *env = getenv("MFEM_SIMD");
+   const std::string saved_env(env ? env : "");
+   const bool has_avx2 =
+      __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+
+   // If the build itself uses AVX2, the AVX2 variant is always selected
+   const bool check_name = (MFEM_SIMD_BYTES < 32);
+
+   Vector y_generic, y_avx2;
+   pa_mass_diffusion_3d_simd("generic", y_generic);
+   REQUIRE(Device::GetSimdBytes() == MFEM_SIMD_BYTES);
+   if (check_name)
+   {
+      REQUIRE(std::string(Device::GetSimdName()) == "generic");
+   }
+
+   pa_mass_diffusion_3d_simd("avx2", y_avx2);
+   REQUIRE(Device::GetSimdBytes() ==
+           std::max(MFEM_SIMD_BYTES, has_avx2 ? 32 : 0));
+   if (check_name)
+   {
+      REQUIRE(std::string(Device::GetSimdName()) ==
+              (has_avx2 ? "avx2" : "generic"));
+   }
+
+   // The variants only differ by the rounding of the fused multiply-adds
+   y_avx2 -= y_generic;
+   REQUIRE(y_avx2.Normlinf() < 1.e-13 * y_generic.Normlinf());
+
+   if (env) { setenv("MFEM_SIMD", saved_env.c_str(), 1); }
+   else { unsetenv("MFEM_SIMD"); }
+   Device::DetectSimd();
+}
+#endif
+
+void nonsymmetric_matrix_function2d(const Vector &x, DenseMatrix &K)
+{
+   K(0,0) = 2.0 + x(0); K(0,1) = 0.3;
+   K(1,0) = -0.1;       K(1,1) = 1.0 + x(1)*x(1);
+}
+
+// NURBS spaces use the patch-wise tensor kernels of NURBSDofToQuad. The disc
+// mesh has rational weights, the pipe mesh is curved in 3D.
+void test_pa_nurbs(const char *meshname, int order)
+{
+   INFO("mesh=" << meshname << ", order=" << order);
+   Mesh mesh(meshname, 1, 1);
+   mesh.UniformRefinement();
+   int dim = mesh.Dimension();
+   NURBSFECollection fec(order);
+   FiniteElementSpace fespace(&mesh, new NURBSExtension(mesh.NURBSext, order),
+                              &fec);
+
+   FunctionCoefficient q_coeff(
+      [](const Vector &x) { return 1.0 + x(0)*x(0) + 0.5*x(1); });
+   MatrixFunctionCoefficient k_coeff(2, nonsymmetric_matrix_function2d);
+
+   BilinearForm k_pa(&fespace), k_fa(&fespace);
+   for (BilinearForm *k : {&k_pa, &k_fa})
+   {
+      k->AddDomainIntegrator(new MassIntegrator(q_coeff));
+      if (dim == 3)
+      {
+         k->AddDomainIntegrator(new DiffusionIntegrator(q_coeff));
+      }
+      else
+      {
+         k->AddDomainIntegrator(new DiffusionIntegrator(k_coeff));
+      }
+   }
+   k_fa.Assemble();
+   k_fa.Finalize();
+   k_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   k_pa.Assemble();
+
+   GridFunction x(&fespace), y_fa(&fespace), y_pa(&fespace);
+   x.Randomize(1);
+   k_fa.Mult(x, y_fa);
+   k_pa.Mult(x, y_pa);
+   y_pa -= y_fa;
+   REQUIRE(y_pa.Normlinf() < 1.e-12 * y_fa.Normlinf());
+
+   Vector diag_fa(fespace.GetVSize()), diag_pa(fespace.GetVSize());
+   k_fa.SpMat().GetDiag(diag_fa);
+   k_pa.AssembleDiagonal(diag_pa);
+   diag_pa -= diag_fa;
+   REQUIRE(diag_pa.Normlinf() < 1.e-12 * diag_fa.Normlinf());
+}
+
+TEST_CASE("PA NURBS Mass and Diffusion", "[PartialAssembly], [NURBS]")
+{
+   auto order = GENERATE(2, 3);
+   test_pa_nurbs("../../data/disc-nurbs.mesh", order);
+   test_pa_nurbs("../../data/pipe-nurbs.mesh", order);
+   test_pa_nurbs("../../data/beam-hex-nurbs.mesh", order);
+}
+
+void skew_transformation2d(const Vector &x, Vector &y)
+{
+   y(0) = x(0) + 0.1*x(1)*x(1);
+   y(1) = x(1) + 0.2*x(0);
+}
+
+// Single precision storage of the quadrature data and basis tables: the
+// action and the diagonal agree with double precision up to float round-off.
+// The 2D order 6 space uses the generic (not shared memory) kernels.
+void test_pa_single_precision(int dim, int order, int coeff_type)
+{
+   INFO("dim=" << dim << ", order=" << order << ", coeff_type=" << coeff_type);
+   Mesh *mesh = (dim == 2) ?
+                new Mesh(3, 2, Element::QUADRILATERAL, false, 3.0, 2.0) :
+                new Mesh(3, 2, 1, Element::HEXAHEDRON, false, 3.0, 2.0, 1.0);
+   mesh->Transform(dim == 2 ? skew_transformation2d : skew_transformation);
+
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fespace(mesh, &fec);
+
+   FunctionCoefficient q_coeff(
+      [](const Vector &x) { return 1.0 + x(0)*x(1); });
+   MatrixFunctionCoefficient k_coeff2(2, nonsymmetric_matrix_function2d);
+   MatrixFunctionCoefficient k_coeff3(3, nonsymmetric_matrix_function);
+
+   BilinearForm k_sp(&fespace), k_dp(&fespace);
+   for (BilinearForm *k : {&k_sp, &k_dp})
+   {
+      MassIntegrator *m = new MassIntegrator(q_coeff);
+      DiffusionIntegrator *d = (coeff_type == 0) ?
+                               new DiffusionIntegrator(q_coeff) :
+                               (dim == 2) ?
+                               new DiffusionIntegrator(k_coeff2) :
+                               new DiffusionIntegrator(k_coeff3);
+      m->SetSinglePrecisionPA(k == &k_sp);
+      d->SetSinglePrecisionPA(k == &k_sp);
+      k->AddDomainIntegrator(m);
+      k->AddDomainIntegrator(d);
+      k->SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      k->Assemble();
+   }
+
+   GridFunction x(&fespace), y_sp(&fespace), y_dp(&fespace);
+   x.Randomize(1);
+   k_dp.Mult(x, y_dp);
+   k_sp.Mult(x, y_sp);
+   y_sp -= y_dp;
+   REQUIRE(y_sp.Normlinf() < 1.e-5 * y_dp.Normlinf());
+
+   Vector diag_sp(fespace.GetVSize()), diag_dp(fespace.GetVSize());
+   k_dp.AssembleDiagonal(diag_dp);
+   k_sp.AssembleDiagonal(diag_sp);
+   diag_sp -= diag_dp;
+   REQUIRE(diag_sp.Normlinf() < 1.e-5 * diag_dp.Normlinf());
+
+   // Changing the option after the assembly takes effect at the next one
+   Array<BilinearFormIntegrator*> &integs = *k_sp.GetDBFI();
+   static_cast<MassIntegrator*>(integs[0])->SetSinglePrecisionPA(false);
+   static_cast<DiffusionIntegrator*>(integs[1])->SetSinglePrecisionPA(false);
+   k_sp.Mult(x, y_sp);
+   y_sp -= y_dp;
+   REQUIRE(y_sp.Normlinf() < 1.e-5 * y_dp.Normlinf());
+   k_sp.Assemble();
+   k_sp.Mult(x, y_sp);
+   y_sp -= y_dp;
+   REQUIRE(y_sp.Normlinf() < 1.e-12 * y_dp.Normlinf());
+   delete mesh;
+}
+
+TEST_CASE("PA Single Precision", "[PartialAssembly]")
+{
+   // coeff_type: 0: scalar (symmetric qdata), 1: nonsymmetric matrix
+   auto coeff_type = GENERATE(0, 1);
+   auto order = GENERATE(1, 2, 3);
+   test_pa_single_precision(2, order, coeff_type);
+   test_pa_single_precision(3, order, coeff_type);
+   test_pa_single_precision(2, 6, coeff_type);
+}
+
+// Iterative refinement with inner CG iterations on the single precision form
+// recovers the double precision solution.
+TEST_CASE("PA Single Precision Iterative Refinement", "[PartialAssembly]")
+{
+   Mesh mesh(4, 4, 4, Element::HEXAHEDRON, false, 1.0, 1.0, 1.0);
+   mesh.Transform(skew_transformation);
+   H1_FECollection fec(3, 3);
+   FiniteElementSpace fespace(&mesh, &fec);
+   Array<int> ess_bdr(mesh.bdr_attributes.Max()), ess_tdofs;
+   ess_bdr = 1;
+   fespace.GetEssentialTrueDofs(ess_bdr, ess_tdofs);
+
+   ConstantCoefficient one(1.0);
+   LinearForm b(&fespace);
+   b.AddDomainIntegrator(new DomainLFIntegrator(one));
+   b.Assemble();
+
+   BilinearForm a_sp(&fespace), a_dp(&fespace);
+   for (BilinearForm *a : {&a_sp, &a_dp})
+   {
+      DiffusionIntegrator *d = new DiffusionIntegrator(one);
+      d->SetSinglePrecisionPA(a == &a_sp);
+      a->AddDomainIntegrator(d);
+      a->SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      a->Assemble();
+   }
+
+   GridFunction x(&fespace);
+   x = 0.0;
+   OperatorPtr A_dp, A_sp;
+   Vector B, X, X_ref;
+   a_dp.FormLinearSystem(ess_tdofs, x, b, A_dp, X, B);
+   a_sp.FormSystemMatrix(ess_tdofs, A_sp);
+
+   // Reference: CG on the double precision operator
+   OperatorJacobiSmoother jacobi_dp(a_dp, ess_tdofs);
+   CGSolver cg_dp;
+   cg_dp.SetRelTol(1e-12);
+   cg_dp.SetMaxIter(1000);
+   cg_dp.SetOperator(*A_dp);
+   cg_dp.SetPreconditioner(jacobi_dp);
+   X_ref = X;
+   cg_dp.Mult(B, X_ref);
+   REQUIRE(cg_dp.GetConverged());
+
+   OperatorJacobiSmoother jacobi_sp(a_sp, ess_tdofs);
+   CGSolver cg_sp;
+   cg_sp.SetRelTol(1e-3);
+   cg_sp.SetMaxIter(100);
+   cg_sp.SetOperator(*A_sp);
+   cg_sp.SetPreconditioner(jacobi_sp);
+
+   IterativeRefinementSolver ir;
+   ir.SetRelTol(1e-12);
+   ir.SetMaxIter(20);
+   ir.SetOperator(*A_dp);
+   ir.SetInnerSolver(cg_sp);
+   ir.Mult(B, X);
+   REQUIRE(ir.GetConverged());
+   REQUIRE(ir.GetNumIterations() <= 6);
+
+   X -= X_ref;
+   REQUIRE(X.Normlinf() < 1e-9 * X_ref.Normlinf());
+}
+
 } // namespace pa_kernels
@@ -184,6 +184,110 @@ TEST_CASE("transfer")
    }
 }
 
+TEST_CASE("RefinementOperator", "[FiniteElementSpace]")
+{
+   auto mesh_fname = GENERATE("../../data/star-mixed.mesh",
+                              "../../data/fichera-mixed.mesh");
+
+   Mesh mesh(mesh_fname, 1, 1);
+   mesh.EnsureNCMesh();
+   const int dim = mesh.Dimension();
+
+   H1_FECollection h1_fec(2, dim);
+   ND_FECollection nd_fec(1, dim);
+   Array<FiniteElementSpace*> spaces;
+   spaces.Append(new FiniteElementSpace(&mesh, &h1_fec, 2, Ordering::byNODES));
+   spaces.Append(new FiniteElementSpace(&mesh, &h1_fec, 3, Ordering::byVDIM));
+   if (dim == 2) { spaces.Append(new FiniteElementSpace(&mesh, &nd_fec)); }
+
+   // Reference spaces using the assembled refinement matrix
+   Array<FiniteElementSpace*> ref_spaces;
+   for (int i = 0; i < spaces.Size(); i++)
+   {
+      ref_spaces.Append(new FiniteElementSpace(*spaces[i]));
+      ref_spaces[i]->SetUpdateOperatorType(Operator::MFEM_SPARSEMAT);
+   }
+
+   Array<int> refs;
+   for (int i = 0; i < mesh.GetNE(); i += 3) { refs.Append(i); }
+   mesh.GeneralRefinement(refs);
+
+   for (int i = 0; i < spaces.Size(); i++)
+   {
+      spaces[i]->Update();
+      ref_spaces[i]->Update();
+      const Operator *T = spaces[i]->GetUpdateOperator();
+      const Operator *T_ref = ref_spaces[i]->GetUpdateOperator();
+      REQUIRE(T->Height() == T_ref->Height());
+      REQUIRE(T->Width() == T_ref->Width());
+
+      Vector x(T->Width()), y(T->Height()), y_ref(T->Height());
+      x.Randomize(1);
+      T->Mult(x, y);
+      T_ref->Mult(x, y_ref);
+      y -= y_ref;
+      REQUIRE(y.Normlinf() < 1e-12 * y_ref.Normlinf());
+
+      Vector xt(T->Height()), yt(T->Width()), yt_ref(T->Width());
+      xt.Randomize(2);
+      T->MultTranspose(xt, yt);
+      T_ref->MultTranspose(xt, yt_ref);
+      yt -= yt_ref;
+      REQUIRE(yt.Normlinf() < 1e-12 * yt_ref.Normlinf());
+
+      delete ref_spaces[i];
+      delete spaces[i];
+   }
+}
+
+TEST_CASE("DerefinementOperator", "[FiniteElementSpace]")
+{
+   auto mesh_fname = GENERATE("../../data/star-mixed.mesh",
+                              "../../data/fichera-mixed.mesh");
+   auto l2 = GENERATE(false, true);
+
+   // Refine one element of the coarse mesh, so that it has hanging nodes and
+   // the H1 spaces have a conforming prolongation
+   Mesh coarse_mesh(mesh_fname, 1, 1);
+   coarse_mesh.EnsureNCMesh();
+   Array<int> coarse_refs(1);
+   coarse_refs[0] = 1;
+   coarse_mesh.GeneralRefinement(coarse_refs);
+   const int dim = coarse_mesh.Dimension();
+   Mesh fine_mesh(coarse_mesh);
+   Array<int> refs;
+   for (int i = 0; i < fine_mesh.GetNE(); i += 2) { refs.Append(i); }
+   fine_mesh.GeneralRefinement(refs);
+
+   H1_FECollection h1_fec(2, dim);
+   L2_FECollection l2_fec(1, dim);
+   FiniteElementCollection *fec = l2 ? (FiniteElementCollection*) &l2_fec :
+                                  (FiniteElementCollection*) &h1_fec;
+   FiniteElementSpace c_fes(&coarse_mesh, fec, 2);
+   FiniteElementSpace f_fes(&fine_mesh, fec, 2);
+
+   // The L2 projection of the interpolated coarse function is exact
+   InterpolationGridTransfer transfer(c_fes, f_fes);
+   Vector x(c_fes.GetVSize()), y(f_fes.GetVSize()), z(c_fes.GetVSize());
+   if (l2)
+   {
+      x.Randomize(1);
+   }
+   else
+   {
+      // use a conforming function on the nonconforming mesh
+      Vector xt(c_fes.GetTrueVSize());
+      xt.Randomize(1);
+      const SparseMatrix *P = c_fes.GetConformingProlongation();
+      if (P) { P->Mult(xt, x); }
+      else { x = xt; }
+   }
+   transfer.ForwardOperator().Mult(x, y);
+   transfer.BackwardOperator().Mult(y, z);
+   z -= x;
+   REQUIRE(z.Normlinf() < 1e-10);
+}
+
 #ifdef MFEM_USE_MPI
 
 TEST_CASE("partransfer", "[Parallel]")
@@ -0,0 +1,240 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+namespace mfem
+{
+
+#ifdef MFEM_USE_MPI
+
+namespace communication
+{
+
+// Number of ldofs of the group of ranks @a set, the same on all its ranks.
+static int GroupNumLDofs(const Array<int> &set)
+{
+   int sum = 0;
+   for (int i = 0; i < set.Size(); i++) { sum += set[i]; }
+   return 1 + sum % 3;
+}
+
+// Add the group of ranks @a set to @a groups and its ldofs to @a ldof_group,
+// preceded by one local (group 0) ldof.
+static void AddGroup(ListOfIntegerSets &groups, Array<int> &set,
+                     Array<int> &ldof_group)
+{
+   set.Sort();
+   set.Unique();
+   IntegerSet group(set.Size(), set.GetData());
+   const int g = groups.Insert(group);
+   ldof_group.Append(0);
+   for (int i = 0; i < GroupNumLDofs(set); i++) { ldof_group.Append(g); }
+}
+
+// Create a group topology on MPI_COMM_WORLD in which the first 'na' ranks
+// share pairwise groups along a ring and, for na >= 3, a group of the first
+// three ranks. With 3 or more ranks, na = np-1, so that the last rank has no
+// neighbors and no shared groups.
+static void MakeTopology(GroupTopology &gt, Array<int> &ldof_group)
+{
+   const int rank = gt.MyRank(), np = gt.NRanks();
+   const int na = (np >= 3) ? np-1 : np;
+
+   ListOfIntegerSets groups;
+   IntegerSet local(1, &rank);
+   groups.Insert(local);
+   ldof_group.SetSize(0);
+
+   Array<int> set;
+   if (rank < na && na >= 2)
+   {
+      // the ring groups {rank, rank+1} and {rank-1, rank}; for na = 2 they
+      // are the same group
+      for (int k = 0; k < ((na == 2) ? 1 : 2); k++)
+      {
+         const int other = (k == 0) ? (rank+1) % na : (rank+na-1) % na;
+         set.SetSize(2);
+         set[0] = rank;
+         set[1] = other;
+         AddGroup(groups, set, ldof_group);
+      }
+      if (na >= 3 && rank < 3)
+      {
+         set.SetSize(3);
+         set[0] = 0; set[1] = 1; set[2] = 2;
+         AddGroup(groups, set, ldof_group);
+      }
+   }
+   ldof_group.Append(0);
+
+   gt.Create(groups, 1822);
+}
+
+// Local true dof numbering: ldofs in group 0 or in groups owned by this rank.
+static void MakeLTDofs(const GroupTopology &gt, const Array<int> &ldof_group,
+                       Array<int> &ldof_ltdof)
+{
+   int n = 0;
+   ldof_ltdof.SetSize(ldof_group.Size());
+   for (int i = 0; i < ldof_group.Size(); i++)
+   {
+      ldof_ltdof[i] = gt.IAmMaster(ldof_group[i]) ? n++ : -1;
+   }
+}
+
+// Check that the Bcast and Reduce operations of the communication mode
+// @a mode, with all data layouts, give the same result as mode byNeighbor.
+template <typename T>
+static void CompareWithByNeighbor(GroupCommunicator::Mode mode)
+{
+   GroupTopology gt(MPI_COMM_WORLD);
+   Array<int> ldof_group, ldof_ltdof;
+   MakeTopology(gt, ldof_group);
+   MakeLTDofs(gt, ldof_group, ldof_ltdof);
+
+   GroupCommunicator gc_ref(gt), gc(gt, mode);
+   for (GroupCommunicator *c : {&gc_ref, &gc})
+   {
+      c->Create(ldof_group);
+      c->SetLTDofTable(ldof_ltdof);
+   }
+
+   const int rank = gt.MyRank(), n = ldof_group.Size();
+   int nltdofs = 0;
+   for (int i = 0; i < n; i++) { nltdofs += (ldof_ltdof[i] >= 0); }
+   const int nsdofs = gc.GroupLDofTable().Size_of_connections();
+   Array<T> x(n), xt(nltdofs);
+   for (int i = 0; i < n; i++)
+   {
+      x[i] = T(1 + i + 100*rank) / T(2);
+      if (ldof_ltdof[i] >= 0) { xt[ldof_ltdof[i]] = x[i]; }
+   }
+   Array<T> y_ref, y;
+
+   // Bcast, layout 0
+   y_ref = x; gc_ref.Bcast(y_ref);
+   y = x; gc.Bcast(y);
+   for (int i = 0; i < n; i++) { REQUIRE(y[i] == y_ref[i]); }
+
+   // Bcast, input layout 2 and output layout 0
+   y_ref = x;
+   gc_ref.BcastBegin(xt.GetData(), 2);
+   gc_ref.BcastEnd(y_ref.GetData(), 0);
+   y = x;
+   gc.BcastBegin(xt.GetData(), 2);
+   gc.BcastEnd(y.GetData(), 0);
+   for (int i = 0; i < n; i++) { REQUIRE(y[i] == y_ref[i]); }
+
+   // Bcast, layout 1 (array on the shared ldofs)
+   Array<T> s_ref(nsdofs), s(nsdofs);
+   for (int i = 0; i < nsdofs; i++) { s_ref[i] = s[i] = T(i + 10*rank); }
+   gc_ref.Bcast(s_ref.GetData(), 1);
+   gc.Bcast(s.GetData(), 1);
+   for (int i = 0; i < nsdofs; i++) { REQUIRE(s[i] == s_ref[i]); }
+
+   // Reduce (sum), layout 0
+   y_ref = x; gc_ref.Reduce<T>(y_ref, GroupCommunicator::Sum);
+   y = x; gc.Reduce<T>(y, GroupCommunicator::Sum);
+   for (int i = 0; i < n; i++) { REQUIRE(y[i] == MFEM_Approx(y_ref[i])); }
+
+   // Reduce (max), output layout 2
+   Array<T> yt_ref(xt), yt(xt);
+   gc_ref.ReduceBegin(x.GetData());
+   gc_ref.ReduceEnd(yt_ref.GetData(), 2, GroupCommunicator::Max);
+   gc.ReduceBegin(x.GetData());
+   gc.ReduceEnd(yt.GetData(), 2, GroupCommunicator::Max);
+   for (int i = 0; i < nltdofs; i++) { REQUIRE(yt[i] == yt_ref[i]); }
+
+   if (mode == GroupCommunicator::byNeighborShared)
+   {
+      // without the shared memory window, the communicator still works
+      gc.FreeSharedWindow();
+      REQUIRE(gc.GetMode() == GroupCommunicator::byNeighbor);
+      y = x; gc.Reduce<T>(y, GroupCommunicator::Sum);
+      y_ref = x; gc_ref.Reduce<T>(y_ref, GroupCommunicator::Sum);
+      for (int i = 0; i < n; i++) { REQUIRE(y[i] == MFEM_Approx(y_ref[i])); }
+   }
+}
+
+TEST_CASE("GroupCommunicator modes", "[Parallel], [GroupCommunicator]")
+{
+   auto mode = GENERATE(GroupCommunicator::byGroup,
+                        GroupCommunicator::byNeighborCollective,
+                        GroupCommunicator::byNeighborShared);
+   INFO("mode = " << mode);
+   CompareWithByNeighbor<int>(mode);
+   CompareWithByNeighbor<double>(mode);
+}
+
+// After FreeSharedWindow(), a byNeighborShared communicator can be destroyed
+// on each rank independently, here on rank 0 first.
+TEST_CASE("GroupCommunicator FreeSharedWindow",
+          "[Parallel], [GroupCommunicator]")
+{
+   GroupTopology gt(MPI_COMM_WORLD);
+   Array<int> ldof_group;
+   MakeTopology(gt, ldof_group);
+
+   GroupCommunicator *gc =
+      new GroupCommunicator(gt, GroupCommunicator::byNeighborShared);
+   gc->Create(ldof_group);
+   Array<double> x(ldof_group.Size());
+   x = 1.0;
+   gc->Bcast(x);
+   gc->FreeSharedWindow();
+
+   if (gt.MyRank() == 0) { delete gc; }
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (gt.MyRank() != 0) { delete gc; }
+}
+
+// The mode selected with ParFiniteElementSpace::SetGroupCommMode() is used by
+// the spaces constructed afterwards, and gives the same assembled vectors.
+static void CompareSpaceGroupComm(GroupCommunicator::Mode mode)
+{
+   ParMesh pmesh(MPI_COMM_WORLD, 5, 4, Element::QUADRILATERAL, 2.0, 1.0);
+   H1_FECollection fec(2, 2);
+   ParFiniteElementSpace fes_ref(&pmesh, &fec);
+   ParFiniteElementSpace::SetGroupCommMode(mode);
+   ParFiniteElementSpace fes(&pmesh, &fec);
+   ParFiniteElementSpace::SetGroupCommMode(GroupCommunicator::byNeighbor);
+#if MPI_VERSION >= 3
+   REQUIRE(fes.GroupComm().GetMode() == mode);
+#endif
+
+   Vector x(fes.GetVSize()), y_ref(x.Size()), y(x.Size());
+   x.Randomize(1);
+   y_ref = x;
+   fes_ref.GroupComm().Reduce<double>(y_ref.GetData(), GroupCommunicator::Sum);
+   fes_ref.GroupComm().Bcast(y_ref.GetData());
+   y = x;
+   fes.GroupComm().Reduce<double>(y.GetData(), GroupCommunicator::Sum);
+   fes.GroupComm().Bcast(y.GetData());
+   y -= y_ref;
+   REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+}
+
+TEST_CASE("ParFiniteElementSpace GroupComm mode",
+          "[Parallel], [GroupCommunicator]")
+{
+   auto mode = GENERATE(GroupCommunicator::byNeighborCollective,
+                        GroupCommunicator::byNeighborShared);
+   INFO("mode = " << mode);
+   CompareSpaceGroupComm(mode);
+}
+
+} // namespace communication
+
+#endif // MFEM_USE_MPI
+
+} // namespace mfem
@@ -13,6 +13,8 @@
 #include "unit_tests.hpp"
 #include "linalg/dtensor.hpp"
 
+#include <vector>
+
 using namespace mfem;
 
 TEST_CASE("DenseMatrix LinearSolve methods",
@@ -293,3 +295,92 @@ TEST_CASE("DenseTensor LinearSolve methods",
       }
    }
 }
+
+TEST_CASE("DenseTensor batched factorizations",
+          "[DenseMatrix]")
+{
+   // The batch size is not a multiple of the SIMD width
+   const int m = 7, NE = 13;
+   DenseTensor A(m,m,NE), A_lu(m,m,NE), A_chol(m,m,NE);
+   Vector X(m*NE), X_lu(m*NE), X_chol(m*NE);
+   X.Randomize(1);
+   X_lu = X;
+   X_chol = X;
+
+   // Nonsymmetric matrices B for LU and symmetric positive definite matrices
+   // B.B^t + I for Cholesky
+   DenseMatrix B(m), BBt(m);
+   for (int e = 0; e < NE; e++)
+   {
+      Vector b(B.Data(), m*m);
+      b.Randomize(e+1);
+      A_lu(e) = B;
+      MultAAt(B, BBt);
+      for (int i = 0; i < m; i++) { BBt(i,i) += 1.0; }
+      A(e) = BBt;
+      A_chol(e) = BBt;
+   }
+
+   Array<int> P;
+   BatchLUFactor(A_lu, P);
+   BatchLUSolve(A_lu, P, X_lu);
+   BatchCholeskyFactor(A_chol);
+   BatchCholeskySolve(A_chol, X_chol);
+
+   Vector x, x_lu, x_chol, r(m);
+   for (int e = 0; e < NE; e++)
+   {
+      x.SetDataAndSize(X.HostReadWrite() + e*m, m);
+      x_lu.SetDataAndSize(X_lu.HostReadWrite() + e*m, m);
+      x_chol.SetDataAndSize(X_chol.HostReadWrite() + e*m, m);
+
+      Vector b(B.Data(), m*m);
+      b.Randomize(e+1);
+      B.Mult(x_lu, r);
+      r -= x;
+      REQUIRE(r.Normlinf() < 1e-10 * x.Normlinf());
+
+      A(e).Mult(x_chol, r);
+      r -= x;
+      REQUIRE(r.Normlinf() < 1e-10 * x.Normlinf());
+   }
+}
+
+TEST_CASE("Batched LU factorization of matrices of different sizes",
+          "[DenseMatrix]")
+{
+   // Sizes shared by several matrices are batched, size 4 is factored alone
+   int sizes_[] = {3, 5, 3, 1, 5, 5, 4, 0, 3};
+   const int n = sizeof(sizes_)/sizeof(int);
+   Array<int> sizes(sizes_, n);
+
+   std::vector<DenseMatrix> A(n), A_lu(n);
+   std::vector<Array<int>> ipiv(n);
+   Array<double*> data(n);
+   Array<int*> ipiv_data(n);
+   for (int k = 0; k < n; k++)
+   {
+      A[k].SetSize(sizes[k]);
+      Vector a(A[k].Data(), sizes[k]*sizes[k]);
+      a.Randomize(k+1);
+      for (int i = 0; i < sizes[k]; i++) { A[k](i,i) += 1.0; }
+      A_lu[k] = A[k];
+      ipiv[k].SetSize(sizes[k]);
+      data[k] = A_lu[k].Data();
+      ipiv_data[k] = ipiv[k].GetData();
+   }
+   BatchLUFactor(sizes, data, ipiv_data);
+
+   for (int k = 0; k < n; k++)
+   {
+      const int m = sizes[k];
+      Vector x(m), y(m), r(m);
+      x.Randomize(k+7);
+      y = x;
+      LUFactors lu(data[k], ipiv_data[k]);
+      lu.Solve(m, 1, y.GetData());
+      A[k].Mult(y, r);
+      r -= x;
+      REQUIRE(r.Normlinf() <= 1e-10 * x.Normlinf());
+   }
+}
@@ -99,6 +99,61 @@ TEST_CASE("HypreParMatrixAbsMult",  "[Parallel], [HypreParMatrixAbsMult]")
    }
 }
 
+TEST_CASE("HypreAgglomeratedSolver", "[Parallel], [HypreAgglomeratedSolver]")
+{
+   int num_procs;
+   MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+   Mesh *mesh = new Mesh(8, 8, Element::QUADRILATERAL, true, 1.0, 1.0);
+   ParMesh *pmesh = new ParMesh(MPI_COMM_WORLD, *mesh);
+   delete mesh;
+   H1_FECollection fec(2, 2);
+   ParFiniteElementSpace fespace(pmesh, &fec);
+   const HYPRE_Int glob_size = fespace.GlobalTrueVSize();
+
+   ParBilinearForm a(&fespace);
+   ConstantCoefficient one(1.0);
+   a.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a.AddDomainIntegrator(new MassIntegrator(one));
+   a.Assemble();
+   a.Finalize();
+   HypreParMatrix *A = a.ParallelAssemble();
+
+   // Agglomerate onto at most two ranks
+   const int min_dofs = (int) (glob_size / 2);
+   for (int iterative = 0; iterative <= 1; iterative++)
+   {
+      HypreAgglomeratedSolver agg(*A, min_dofs);
+      int num_active, active = agg.IsActive();
+      MPI_Allreduce(&active, &num_active, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+      REQUIRE(num_active == std::min(num_procs, 2));
+
+      CGSolver *cg = NULL;
+      if (agg.IsActive())
+      {
+         HypreParMatrix &A_agg = *agg.GetAgglomeratedMatrix();
+         REQUIRE(A_agg.GetGlobalNumRows() == glob_size);
+         cg = new CGSolver(agg.GetSubComm());
+         cg->SetRelTol(1e-12);
+         cg->SetMaxIter(1000);
+         cg->SetOperator(A_agg);
+         agg.SetSolver(*cg, true);
+      }
+
+      Vector B(A->Height()), X(A->Height()), R(A->Height());
+      B.Randomize(1);
+      X = 0.0;
+      agg.iterative_mode = iterative;
+      agg.Mult(B, X);
+      A->Mult(X, R);
+      R -= B;
+      REQUIRE(InnerProduct(MPI_COMM_WORLD, R, R) <
+              1e-16 * InnerProduct(MPI_COMM_WORLD, B, B));
+   }
+
+   delete A;
+   delete pmesh;
+}
+
 #endif // MFEM_USE_MPI
 
 } // namespace mfem
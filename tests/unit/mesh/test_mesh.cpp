@@ -14,6 +14,12 @@ using namespace mfem;
 
 #include "unit_tests.hpp"
 
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <algorithm>
+#include <functional>
+
 TEST_CASE("Element-wise construction", "[Mesh]")
 {
    SECTION("Quadrilateral")
@@ -145,3 +151,152 @@ TEST_CASE("Gecko integration in MFEM", "[Mesh]")
       }
    }
 }
+
+static void CompareMeshes(const Mesh &mesh, const Mesh &mesh_new)
+{
+   REQUIRE(mesh_new.GetNE() == mesh.GetNE());
+   REQUIRE(mesh_new.GetNBE() == mesh.GetNBE());
+   REQUIRE(mesh_new.GetNV() == mesh.GetNV());
+   REQUIRE(mesh_new.Nonconforming() == mesh.Nonconforming());
+
+   Array<int> v, v_new;
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      REQUIRE(mesh_new.GetAttribute(i) == mesh.GetAttribute(i));
+      mesh.GetElementVertices(i, v);
+      mesh_new.GetElementVertices(i, v_new);
+      REQUIRE((v_new == v));
+   }
+   for (int i = 0; i < mesh.GetNBE(); i++)
+   {
+      REQUIRE(mesh_new.GetBdrAttribute(i) == mesh.GetBdrAttribute(i));
+      mesh.GetBdrElementVertices(i, v);
+      mesh_new.GetBdrElementVertices(i, v_new);
+      REQUIRE((v_new == v));
+   }
+
+   Vector vert, vert_new;
+   mesh.GetVertices(vert);
+   mesh_new.GetVertices(vert_new);
+   vert_new -= vert;
+   REQUIRE(vert_new.Normlinf() == 0.0);
+   if (mesh.GetNodes())
+   {
+      Vector nodes_diff(*mesh_new.GetNodes());
+      nodes_diff -= *mesh.GetNodes();
+      REQUIRE(nodes_diff.Normlinf() == 0.0);
+   }
+}
+
+TEST_CASE("Binary mesh format", "[Mesh]")
+{
+   auto type = GENERATE(Element::TETRAHEDRON, Element::HEXAHEDRON);
+   auto curved = GENERATE(false, true);
+
+   Mesh mesh(2, 3, 2, type);
+   mesh.EnsureNCMesh();
+   Array<int> refs;
+   refs.Append(0);
+   refs.Append(mesh.GetNE() - 1);
+   mesh.GeneralRefinement(refs);
+   if (curved) { mesh.SetCurvature(2); }
+
+   const char *fname = "binary_mesh_test.mesh";
+   {
+      std::ofstream out(fname, std::ios::binary);
+      mesh.PrintBinary(out);
+   }
+
+   // Loading may reorder the vertices of the elements, so compare with the
+   // mesh loaded from the text format, written with full precision
+   std::stringstream text;
+   text.precision(17);
+   mesh.Print(text);
+   Mesh mesh_text(text);
+
+   SECTION("Load from a file stream")
+   {
+      Mesh mesh_new(fname);
+      CompareMeshes(mesh_text, mesh_new);
+   }
+
+   SECTION("Load from a mapped file")
+   {
+      mapped_ifstream in(fname);
+      REQUIRE(in);
+      Mesh mesh_new(in);
+      CompareMeshes(mesh_text, mesh_new);
+      if (curved)
+      {
+         // the nodes reference the mapped file
+         REQUIRE(!mesh_new.GetNodes()->GetMemory().OwnsHostPtr());
+      }
+   }
+
+   REQUIRE(remove(fname) == 0);
+}
+
+namespace
+{
+
+// Error estimator returning a fixed vector of local errors.
+class FixedErrorEstimator : public ErrorEstimator
+{
+   Vector errors;
+public:
+   FixedErrorEstimator(const Vector &err) : errors(err) { }
+   virtual const Vector &GetLocalErrors() { return errors; }
+   virtual void Reset() { }
+};
+
+}
+
+TEST_CASE("ThresholdRefiner marking strategies", "[Mesh]")
+{
+   const int NE = 1000;
+   Vector errors(NE);
+   for (int i = 0; i < NE; i++)
+   {
+      // distinct errors in a shuffled order, spanning several decades
+      errors(i) = std::pow(10.0, -4.0 * ((i * 379) % NE) / NE);
+   }
+   Vector sorted(errors);
+   std::sort(sorted.GetData(), sorted.GetData() + NE, std::greater<double>());
+
+   FixedErrorEstimator estimator(errors);
+
+   SECTION("Fixed fraction")
+   {
+      for (double fraction : { 0.01, 0.1, 0.333, 1.0 })
+      {
+         Mesh mesh(NE, 1.0);
+         ThresholdRefiner refiner(estimator);
+         refiner.SetFixedFractionMarking(fraction);
+         refiner.Apply(mesh);
+
+         const long expected = (long) std::ceil(fraction * NE - 1e-12);
+         REQUIRE(refiner.GetNumMarkedElements() == expected);
+         REQUIRE(mesh.GetNE() == NE + expected);
+      }
+   }
+
+   SECTION("Dorfler")
+   {
+      const double total = errors * errors;
+      for (double theta : { 0.1, 0.5, 0.9, 0.999 })
+      {
+         Mesh mesh(NE, 1.0);
+         ThresholdRefiner refiner(estimator);
+         refiner.SetDorflerMarking(theta);
+         refiner.Apply(mesh);
+
+         // the smallest set of the largest errors reaching theta
+         long expected = 0;
+         for (double sum = 0.0; sum < theta * total; expected++)
+         {
+            sum += sorted(expected) * sorted(expected);
+         }
+         REQUIRE(refiner.GetNumMarkedElements() == expected);
+      }
+   }
+}
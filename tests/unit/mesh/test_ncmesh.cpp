@@ -111,6 +111,94 @@ TEST_CASE("NCMesh PA diagonal", "[NCMesh]")
 
 } // test case
 
+static double compact_test_func(const Vector &x)
+{
+   double r = x(0)*x(0) - 2*x(0)*x(1) + 3*x(1);
+   if (x.Size() == 3) { r += x(2)*x(2) + x(1)*x(2); }
+   return r;
+}
+
+static double ElementVertexSum(Mesh &mesh, int i)
+{
+   Array<int> v;
+   mesh.GetElementVertices(i, v);
+   double sum = 0.0;
+   for (int j = 0; j < v.Size(); j++)
+   {
+      const double *c = mesh.GetVertex(v[j]);
+      for (int d = 0; d < mesh.SpaceDimension(); d++) { sum += (d+1)*c[d]; }
+   }
+   return sum;
+}
+
+// Test case: Verify that NCMesh compaction (renumbering of the internal nodes,
+//            faces and elements) does not change the resulting Mesh or the
+//            refinement/derefinement transfer of a GridFunction.
+TEST_CASE("NCMesh compaction", "[NCMesh]")
+{
+   const char *mesh_files[] = { "../../data/star-mixed.mesh",
+                                "../../data/fichera-mixed.mesh"
+                              };
+
+   for (int m = 0; m < 2; m++)
+   {
+      Mesh mesh(mesh_files[m]), ref_mesh(mesh_files[m]);
+      mesh.EnsureNCMesh();
+      ref_mesh.EnsureNCMesh();
+
+      mesh.ncmesh->SetCompactionThreshold(0.0); // compact always
+      ref_mesh.ncmesh->SetCompactionThreshold(1.0); // never
+
+      H1_FECollection fec(2, mesh.Dimension());
+      FiniteElementSpace fes(&mesh, &fec), ref_fes(&ref_mesh, &fec);
+      GridFunction x(&fes), ref_x(&ref_fes);
+
+      FunctionCoefficient coeff(compact_test_func);
+      x.ProjectCoefficient(coeff);
+      ref_x.ProjectCoefficient(coeff);
+
+      for (int it = 0; it < 4; it++)
+      {
+         if (it < 3)
+         {
+            Array<int> refs;
+            for (int i = it; i < mesh.GetNE(); i += 3) { refs.Append(i); }
+            mesh.GeneralRefinement(refs, 1);
+            ref_mesh.GeneralRefinement(refs, 1);
+         }
+         else
+         {
+            Array<double> error(mesh.GetNE());
+            error = 0.0;
+            mesh.DerefineByError(error, 1.0);
+            ref_mesh.DerefineByError(error, 1.0);
+         }
+
+         fes.Update();
+         ref_fes.Update();
+         x.Update();
+         ref_x.Update();
+
+         REQUIRE(mesh.GetNE() == ref_mesh.GetNE());
+         REQUIRE(mesh.GetNV() == ref_mesh.GetNV());
+         REQUIRE(mesh.GetNEdges() == ref_mesh.GetNEdges());
+         REQUIRE(mesh.GetNFaces() == ref_mesh.GetNFaces());
+         for (int i = 0; i < mesh.GetNE(); i++)
+         {
+            REQUIRE(ElementVertexSum(mesh, i) ==
+                    MFEM_Approx(ElementVertexSum(ref_mesh, i)));
+         }
+
+         REQUIRE(x.ComputeL2Error(coeff) == MFEM_Approx(0.0, EPS));
+         REQUIRE(ref_x.ComputeL2Error(coeff) == MFEM_Approx(0.0, EPS));
+      }
+
+      // the derefinement leaves unused IDs behind in the reference NCMesh
+      REQUIRE(mesh.ncmesh->MemoryUsage() < ref_mesh.ncmesh->MemoryUsage());
+   }
+
+} // test case
+
 #ifdef MFEM_USE_MPI
 
 // Test case: Verify that a conforming mesh yields the same norm for the
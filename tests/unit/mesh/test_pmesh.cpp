@@ -0,0 +1,155 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+namespace mfem
+{
+
+#ifdef MFEM_USE_MPI
+
+// Compare a parallel mesh created without a serial mesh, 'dmesh', with the
+// partitioned serial mesh, 'pmesh': the number of elements, the number of true
+// vertices, the volume and the boundary measure must agree, also after a
+// uniform refinement which uses the shared entities.
+static void CompareParMeshes(ParMesh &dmesh, ParMesh &pmesh)
+{
+   for (int ref = 0; ref < 2; ref++)
+   {
+      H1_FECollection fec(1, dmesh.Dimension());
+      ParFiniteElementSpace dfes(&dmesh, &fec), pfes(&pmesh, &fec);
+
+      REQUIRE(dmesh.GetGlobalNE() == pmesh.GetGlobalNE());
+      REQUIRE(dfes.GlobalTrueVSize() == pfes.GlobalTrueVSize());
+
+      ConstantCoefficient one(1.0);
+      ParGridFunction dx(&dfes), px(&pfes);
+      dx = 1.0;
+      px = 1.0;
+      ParLinearForm dvol(&dfes), pvol(&pfes);
+      dvol.AddDomainIntegrator(new DomainLFIntegrator(one));
+      pvol.AddDomainIntegrator(new DomainLFIntegrator(one));
+      dvol.Assemble();
+      pvol.Assemble();
+      REQUIRE(dvol(dx) == MFEM_Approx(pvol(px)));
+
+      for (int attr = 1; attr <= pmesh.bdr_attributes.Max(); attr++)
+      {
+         Array<int> marker(pmesh.bdr_attributes.Max());
+         marker = 0;
+         marker[attr-1] = 1;
+         ParLinearForm dbdr(&dfes), pbdr(&pfes);
+         dbdr.AddBoundaryIntegrator(new BoundaryLFIntegrator(one), marker);
+         pbdr.AddBoundaryIntegrator(new BoundaryLFIntegrator(one), marker);
+         dbdr.Assemble();
+         pbdr.Assemble();
+         REQUIRE(dbdr(dx) == MFEM_Approx(pbdr(px)));
+      }
+
+      dmesh.UniformRefinement();
+      pmesh.UniformRefinement();
+   }
+}
+
+TEST_CASE("ParMesh Cartesian", "[Parallel], [ParMesh]")
+{
+   SECTION("2D")
+   {
+      auto type = GENERATE(Element::QUADRILATERAL, Element::TRIANGLE);
+
+      ParMesh dmesh(MPI_COMM_WORLD, 5, 4, type, 2.0, 1.0);
+      Mesh mesh(5, 4, type, true, 2.0, 1.0);
+      ParMesh pmesh(MPI_COMM_WORLD, mesh);
+      CompareParMeshes(dmesh, pmesh);
+   }
+
+   SECTION("3D")
+   {
+      auto type = GENERATE(Element::HEXAHEDRON, Element::TETRAHEDRON);
+
+      ParMesh dmesh(MPI_COMM_WORLD, 3, 4, 5, type, 1.0, 2.0, 3.0);
+      Mesh mesh(3, 4, 5, type, true, 1.0, 2.0, 3.0);
+      ParMesh pmesh(MPI_COMM_WORLD, mesh);
+      CompareParMeshes(dmesh, pmesh);
+   }
+}
+
+TEST_CASE("ParMesh parallel reader", "[Parallel], [ParMesh]")
+{
+   auto mesh_file = GENERATE(as<std::string> {},
+                             "../../data/star-mixed.mesh",
+                             "../../data/beam-tet.mesh",
+                             "../../data/fichera-mixed.mesh");
+
+   ParMesh dmesh(MPI_COMM_WORLD, mesh_file.c_str());
+   Mesh mesh(mesh_file.c_str(), 1, 1);
+   ParMesh pmesh(MPI_COMM_WORLD, mesh);
+   CompareParMeshes(dmesh, pmesh);
+}
+
+// Element weights for the weighted rebalancing test: elements in the left half
+// of the domain are ten times more expensive.
+static void LeftHeavyWeights(ParMesh &pmesh, Vector &weights)
+{
+   Vector center(pmesh.SpaceDimension());
+   weights.SetSize(pmesh.GetNE());
+   for (int i = 0; i < pmesh.GetNE(); i++)
+   {
+      pmesh.GetElementCenter(i, center);
+      weights(i) = (center(0) < 0.0) ? 10.0 : 1.0;
+   }
+}
+
+static double WeightImbalance(ParMesh &pmesh)
+{
+   Vector weights;
+   LeftHeavyWeights(pmesh, weights);
+   double local = weights.Sum(), total, max;
+   MPI_Allreduce(&local, &total, 1, MPI_DOUBLE, MPI_SUM, pmesh.GetComm());
+   MPI_Allreduce(&local, &max, 1, MPI_DOUBLE, MPI_MAX, pmesh.GetComm());
+   return max * pmesh.GetNRanks() / total;
+}
+
+TEST_CASE("ParMesh weighted Rebalance", "[Parallel], [ParMesh]")
+{
+   auto mesh_file = GENERATE(as<std::string> {},
+                             "../../data/star-mixed.mesh",
+                             "../../data/fichera-mixed.mesh");
+
+   Mesh mesh(mesh_file.c_str());
+   mesh.EnsureNCMesh();
+   mesh.UniformRefinement();
+   mesh.UniformRefinement();
+
+   ParMesh pmesh(MPI_COMM_WORLD, mesh);
+   long global_ne = pmesh.GetGlobalNE();
+
+   pmesh.Rebalance();
+   REQUIRE(pmesh.GetGlobalNE() == global_ne);
+   double max_imbalance = 1.0 + double(pmesh.GetNRanks()) / global_ne;
+   REQUIRE(pmesh.GetRebalanceImbalance() <= max_imbalance);
+
+   Vector weights;
+   LeftHeavyWeights(pmesh, weights);
+
+   Rebalancer rebalancer;
+   rebalancer.SetElementWeights(&weights);
+   rebalancer.Apply(pmesh);
+
+   REQUIRE(pmesh.GetGlobalNE() == global_ne);
+   REQUIRE(rebalancer.GetImbalance() == MFEM_Approx(WeightImbalance(pmesh)));
+   REQUIRE(rebalancer.GetImbalance() < 1.05);
+}
+
+#endif // MFEM_USE_MPI
+
+} // namespace mfem